@@ -88,22 +88,15 @@ void IsisMain() {
   // Get the MatchDEM Flag
   m.SetMatchDEM(ui.GetBoolean("MATCHDEM"));
 
-  bool mosaicCreated = false;
+  QStringList outside = m.StartProcess(list);
   for (int i = 0; i < list.size(); i++) {
-    if (!m.StartProcess(list[i].toString())) {
+    if (outside.contains(list[i].toString())) {
       PvlGroup outsiders("Outside");
       outsiders += PvlKeyword("File", list[i].toString());
       Application::Log(outsiders);
     }
-    else {
-      mosaicCreated = true;
-      if(olistFlag) {
-        os << list[i].toString() << endl;
-      }
-    }
-    if(mosaicCreated) {
-      // Mosaic is already created, use the existing mosaic
-      m.SetCreateFlag(false);
+    else if(olistFlag) {
+      os << list[i].toString() << endl;
     }
   }
   // Logs the input file location in the mosaic
@@ -2,6 +2,9 @@
 
 #include "crop.h"
 
+#include "Application.h"
+#include "ProgramLauncher.h"
+
 using namespace std;
 using namespace Isis;
 
@@ -93,9 +96,9 @@ PvlGroup crop(UserInterface &ui) {
   el = sl + (nl - 1) * linc;
 
   // Allocate the output file and make sure things get propogated nicely
-  p.SetInputCube("FROM");
+  p.SetInputCube(from, inAtt);
   p.PropagateTables(false);
-  Cube *ocube = p.SetOutputCube("TO", ns, nl, nb);
+  Cube *ocube = p.SetOutputCube(ui.GetFileName("TO"), ui.GetOutputAttribute("TO"), ns, nl, nb);
   p.ClearInputCubes();
 
   // propagate tables manually
@@ -208,3 +211,19 @@ PvlGroup crop(UserInterface &ui) {
   // Write the results to the log
   return results;
 }
+
+
+/**
+ * Runs crop and logs its results. This is the entry point ProgramLauncher uses
+ * to run crop inside of another process, such as a Pipeline.
+ *
+ * @param ui The User Interface to parse the parameters from
+ */
+static void cropEntry(UserInterface &ui) {
+  PvlGroup results = crop(ui);
+  if (iApp) {
+    Application::Log(results);
+  }
+}
+
+static bool cropRegistered = ProgramLauncher::RegisterIsisProgram("crop", cropEntry);
@@ -0,0 +1,27 @@
+#include "Isis.h"
+
+#include "Cube.h"
+#include "IString.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+
+using namespace std;
+using namespace Isis;
+
+void IsisMain() {
+  UserInterface &ui = Application::GetUserInterface();
+
+  Cube cube;
+  cube.open(ui.GetFileName("FROM"), "rw");
+  cube.createOverviews(ui.GetInteger("MINSIZE"));
+
+  PvlGroup results("Results");
+  PvlKeyword reductions("Reductions");
+  foreach (int reduction, cube.overviewReductions()) {
+    reductions.addValue(toString(reduction));
+  }
+  results += reductions;
+  Application::Log(results);
+
+  cube.close();
+}
@@ -5,6 +5,7 @@
 #include <QFile>
 
 #include "FourierTransform.h"
+#include "LineManager.h"
 #include "ProcessByTile.h"
 #include "Statistics.h"
 #include "AlphaCube.h"
@@ -14,6 +15,8 @@ using namespace Isis;
 
 void FFT1(vector<Buffer *> &in, vector<Buffer *> &out);
 void FFT2(vector<Buffer *> &in, vector<Buffer *> &out);
+void TransformInMemory(Cube &icube, Cube &magCube, Cube &phaseCube, Progress &progress);
+double Replace(double pixel);
 void getMinMax(Buffer &in);
 
 FourierTransform fft;
@@ -55,6 +58,22 @@ void IsisMain() {
     HPixel = stats.Maximum();
     NPixel = 0.0;
   }
+
+  // Transform whole bands in memory when they fit, skipping the temporary cubes
+  BigInt bandBytes = (BigInt)numSamples * numLines * sizeof(double) +
+                     (BigInt)(numSamples / 2 + 1) * numLines * sizeof(complex<double>);
+  if (bandBytes <= fft.MemoryLimit()) {
+    Cube *magCube = sProc.SetOutputCube("MAGNITUDE", numSamples, numLines, numBands);
+    Cube *phaseCube = sProc.SetOutputCube("PHASE", numSamples, numLines, numBands);
+
+    sProc.Progress()->SetText("Transforming");
+    TransformInMemory(*icube, *magCube, *phaseCube, *sProc.Progress());
+
+    aCube.UpdateGroup(*magCube);
+    sProc.Finalize();
+    return;
+  }
+
   sProc.Progress()->SetText("First pass");
 
   // The output cube with no attributes and real pixel type
@@ -105,12 +124,7 @@ void FFT1(vector<Buffer *> &in, vector<Buffer *> &out) {
 
   // copy the input data into a complex vector
   for(int i = 0; i < n; i++) {
-    if(IsSpecial(image[i])) {
-      if(IsHrsPixel(image[i]) || IsHisPixel(image[i])) input[i] = HPixel;
-      else if(IsLrsPixel(image[i]) || IsLisPixel(image[i])) input[i] = LPixel;
-      else input[i] = NPixel;
-    }
-    else input[i] = std::complex<double>(image[i]);
+    input[i] = std::complex<double>(Replace(image[i]));
   }
 
   // perform the fourier transform
@@ -161,6 +175,93 @@ void FFT2(vector<Buffer *> &in, vector<Buffer *> &out) {
   }
 }
 
+/**
+ * Transforms each band of the input cube in memory with a real-to-complex 2D
+ * transform, and writes the magnitude and phase of the spectrum centered at
+ * the origin like the two passes through the temporary cubes do. The input
+ * is padded with zeroes to the size of the output cubes.
+ *
+ * @param icube The input cube
+ * @param magCube The magnitude cube
+ * @param phaseCube The phase cube
+ * @param progress The progress of the transform
+ */
+void TransformInMemory(Cube &icube, Cube &magCube, Cube &phaseCube, Progress &progress) {
+  int numSamples = magCube.sampleCount();
+  int numLines = magCube.lineCount();
+  int spectrumSamples = numSamples / 2 + 1;
+
+  std::vector<double> image((BigInt)numSamples * numLines);
+  std::vector< std::complex<double> > spectrum((BigInt)spectrumSamples * numLines);
+
+  LineManager inLine(icube);
+  LineManager magLine(magCube);
+  LineManager phaseLine(phaseCube);
+
+  progress.SetMaximumSteps(magCube.bandCount());
+  progress.CheckStatus();
+
+  for (int band = 1; band <= magCube.bandCount(); band++) {
+    std::fill(image.begin(), image.end(), 0.0);
+    for (int line = 1; line <= icube.lineCount(); line++) {
+      inLine.SetLine(line, band);
+      icube.read(inLine);
+
+      double *row = &image[(BigInt)(line - 1) * numSamples];
+      for (int i = 0; i < icube.sampleCount(); i++) {
+        row[i] = Replace(inLine[i]);
+      }
+    }
+
+    fft.RealTransform2D(&image[0], &spectrum[0], numSamples, numLines);
+
+    // The spectrum of real data only holds the first half of each line, the
+    // rest are the complex conjugates of the values mirrored through the origin
+    for (int line = 1; line <= numLines; line++) {
+      magLine.SetLine(line, band);
+      phaseLine.SetLine(line, band);
+
+      int v = (line - 1 + numLines / 2) % numLines;
+      for (int i = 0; i < numSamples; i++) {
+        int u = (i + numSamples / 2) % numSamples;
+        std::complex<double> value;
+        if (u < spectrumSamples) {
+          value = spectrum[(BigInt)v * spectrumSamples + u];
+        }
+        else {
+          value = conj(spectrum[(BigInt)((numLines - v) % numLines) * spectrumSamples +
+                                numSamples - u]);
+        }
+        magLine[i] = abs(value);
+        phaseLine[i] = arg(value);
+      }
+
+      magCube.write(magLine);
+      phaseCube.write(phaseLine);
+    }
+
+    progress.CheckStatus();
+  }
+}
+
+
+/**
+ * Replaces a special pixel with the value chosen by REPLACEMENT.
+ *
+ * @param pixel The input pixel
+ *
+ * @return double The value to transform
+ */
+double Replace(double pixel) {
+  if(IsSpecial(pixel)) {
+    if(IsHrsPixel(pixel) || IsHisPixel(pixel)) return HPixel;
+    else if(IsLrsPixel(pixel) || IsLisPixel(pixel)) return LPixel;
+    else return NPixel;
+  }
+  return pixel;
+}
+
+
 void getMinMax(Buffer &in) {
   stats.AddData(in.DoubleBuffer(), in.size());
 }
@@ -48,6 +48,9 @@ void IsisMain() {
   if (ui.GetString("LIMBTEST") == "ELLIPSOID") {
     poly.EllipsoidLimb(true);
   }
+  if (ui.WasEntered("TOLERANCE")) {
+    poly.AdaptiveTolerance(ui.GetDouble("TOLERANCE"));
+  }
 
   int sinc = 1;
   int linc = 1;
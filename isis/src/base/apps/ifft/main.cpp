@@ -4,6 +4,7 @@
 
 #include "AlphaCube.h"
 #include "FourierTransform.h"
+#include "LineManager.h"
 #include "ProcessByTile.h"
 
 using namespace std;
@@ -11,6 +12,8 @@ using namespace Isis;
 
 void IFFT1(vector<Buffer *> &in, vector<Buffer *> &out);
 void IFFT2(vector<Buffer *> &in, vector<Buffer *> &out);
+void InverseInMemory(Cube &magCube, Cube &phaseCube, Cube &outputCube, Progress &progress);
+void RemoveAlphaCube(Cube &outputCube, AlphaCube &acube, int initSamples, int initLines);
 
 FourierTransform fft;
 QString tmpMagFileName = "Temporary_IFFT_Magnitude.cub";
@@ -44,6 +47,19 @@ void IsisMain() {
     return;
   }
 
+  // Invert whole bands in memory when they fit, skipping the temporary cubes
+  BigInt bandBytes = (BigInt)numSamples * numLines * sizeof(complex<double>);
+  if (bandBytes <= fft.MemoryLimit()) {
+    Cube *outputCube = lProc.SetOutputCube("TO", initSamples, initLines, numBands);
+
+    lProc.Progress()->SetText("Inverting");
+    InverseInMemory(*magCube, *phaseCube, *outputCube, *lProc.Progress());
+
+    RemoveAlphaCube(*outputCube, acube, initSamples, initLines);
+    lProc.Finalize();
+    return;
+  }
+
   lProc.SetTileSize(numSamples, 1);
 
   Isis::CubeAttributeOutput cao;
@@ -72,20 +88,7 @@ void IsisMain() {
   //Start the sample proccessing
   sProc.ProcessCubes(&IFFT1);
 
-  // Remove the AlphaCube if the alpha and beta dimensions match the output cube dimensions
-  // (i.e. remove this group if it didn't exist before running fft).
-  int outputSamples = outputCube->sampleCount();
-  int outputLines = outputCube->lineCount();
-  if (initSamples == outputSamples
-      && initLines == outputLines 
-      && acube.AlphaSamples() == outputSamples
-      && acube.AlphaLines() == outputLines) {
-    Pvl *label = outputCube->label();
-    PvlObject &isisCube = label->findObject("IsisCube");
-    if (isisCube.hasGroup("AlphaCube")) {
-      isisCube.deleteGroup("AlphaCube");
-    }
-  }
+  RemoveAlphaCube(*outputCube, acube, initSamples, initLines);
 
   sProc.Finalize();
 
@@ -144,3 +147,82 @@ void IFFT2(vector<Buffer *> &in, vector<Buffer *> &out) {
     imagCube[i] = imag(output[i]);
   }
 }
+
+
+/**
+ * Inverts each band of the magnitude and phase cubes in memory with a 2D
+ * transform, and writes the real part of the result cropped to the size of
+ * the output cube like the two passes through the temporary cubes do.
+ *
+ * @param magCube The magnitude cube, centered at the origin
+ * @param phaseCube The phase cube, centered at the origin
+ * @param outputCube The output cube
+ * @param progress The progress of the inverse
+ */
+void InverseInMemory(Cube &magCube, Cube &phaseCube, Cube &outputCube, Progress &progress) {
+  int numSamples = magCube.sampleCount();
+  int numLines = magCube.lineCount();
+
+  vector< complex<double> > spectrum((BigInt)numSamples * numLines);
+
+  LineManager magLine(magCube);
+  LineManager phaseLine(phaseCube);
+  LineManager outLine(outputCube);
+
+  progress.SetMaximumSteps(outputCube.bandCount());
+  progress.CheckStatus();
+
+  for (int band = 1; band <= outputCube.bandCount(); band++) {
+    // rearrange the data to fit the algorithm
+    // the image is centered at zero, the array begins at zero
+    for (int line = 1; line <= numLines; line++) {
+      magLine.SetLine(line, band);
+      phaseLine.SetLine(line, band);
+      magCube.read(magLine);
+      phaseCube.read(phaseLine);
+
+      int v = (line - 1 + numLines / 2) % numLines;
+      for (int i = 0; i < numSamples; i++) {
+        int u = (i + numSamples / 2) % numSamples;
+        spectrum[(BigInt)v * numSamples + u] = polar(magLine[i], phaseLine[i]);
+      }
+    }
+
+    fft.Inverse2D(&spectrum[0], numSamples, numLines);
+
+    for (int line = 1; line <= outputCube.lineCount(); line++) {
+      outLine.SetLine(line, band);
+      for (int i = 0; i < outputCube.sampleCount(); i++) {
+        outLine[i] = real(spectrum[(BigInt)(line - 1) * numSamples + i]);
+      }
+      outputCube.write(outLine);
+    }
+
+    progress.CheckStatus();
+  }
+}
+
+
+/**
+ * Removes the AlphaCube if the alpha and beta dimensions match the output cube dimensions
+ * (i.e. remove this group if it didn't exist before running fft).
+ *
+ * @param outputCube The output cube
+ * @param acube The AlphaCube of the magnitude cube
+ * @param initSamples The number of samples before fft
+ * @param initLines The number of lines before fft
+ */
+void RemoveAlphaCube(Cube &outputCube, AlphaCube &acube, int initSamples, int initLines) {
+  int outputSamples = outputCube.sampleCount();
+  int outputLines = outputCube.lineCount();
+  if (initSamples == outputSamples
+      && initLines == outputLines 
+      && acube.AlphaSamples() == outputSamples
+      && acube.AlphaLines() == outputLines) {
+    Pvl *label = outputCube.label();
+    PvlObject &isisCube = label->findObject("IsisCube");
+    if (isisCube.hasGroup("AlphaCube")) {
+      isisCube.deleteGroup("AlphaCube");
+    }
+  }
+}
@@ -4,6 +4,7 @@
 #include "Camera.h"
 #include "Cube.h"
 #include "FileName.h"
+#include "GeometryBackplanes.h"
 #include "IException.h"
 #include "ProjectionFactory.h"
 #include "ProcessByBrick.h"
@@ -51,8 +52,11 @@ bool bodyFixedZ;
 
 int raBandNum;
 
+GeometryBackplanes *backplanes;
+
 void phocubeDN(Buffer &in, Buffer &out);
 void phocube(Buffer &out);
+void phocubeBackplanes(Buffer &out);
 
 
 // Function to create a keyword with same values of a specified count
@@ -298,6 +302,19 @@ void IsisMain() {
                                 icube->lineCount(), nbands);
   p.SetBrickSize(64, 64, nbands);
 
+  // Bricks with only angle bands are computed at once
+  backplanes = NULL;
+  if (!noCamera && !latitude && !longitude && !pixelResolution &&
+      !lineResolution && !sampleResolution && !detectorResolution &&
+      !obliqueDetectorResolution && !northAzimuth && !sunAzimuth &&
+      !spacecraftAzimuth && !offnadirAngle && !subSpacecraftGroundAzimuth &&
+      !subSolarGroundAzimuth && !morphologyRank && !albedoRank && !ra &&
+      !declination && !bodyFixedX && !bodyFixedY && !bodyFixedZ) {
+    backplanes = new GeometryBackplanes(cam);
+    backplanes->setTolerance(ui.GetDouble("TOLERANCE"));
+    backplanes->setLocalAngles(localEmission || localIncidence);
+  }
+
   if (dn) {
     // Process with input and output buffers
     p.StartProcess(phocubeDN);
@@ -336,6 +353,9 @@ void IsisMain() {
 
 
   p.EndProcess();
+
+  delete backplanes;
+  backplanes = NULL;
 }
 
 
@@ -353,7 +373,10 @@ void phocubeDN(Buffer &in, Buffer &out) {
 //  knowledge of the buffers size is assumed below, so ensure the buffer
 //  is still of the expected size.
 void phocube(Buffer &out) {
-
+  if (backplanes) {
+    phocubeBackplanes(out);
+    return;
+  }
 
   // If the DN option is selected, it is already added by the phocubeDN
   // function.  We must compute the offset to start at the second band.
@@ -550,6 +573,51 @@ void phocube(Buffer &out) {
 }
 
 
+//  Computes the angle bands for the output buffer from the backplanes of the
+//  whole brick.  This gives the same bands as phocube() when only angle bands
+//  are selected.
+void phocubeBackplanes(Buffer &out) {
+  int skipDN = (dn) ? 64 * 64   :  0;
+
+  backplanes->compute(out.Sample(skipDN), out.Line(skipDN), 64, 64);
+
+  for (int i = 0; i < 64 * 64; i++) {
+    int index = i + skipDN;
+
+    if (backplanes->isValid(i)) {
+      if (phase) {
+        out[index] = backplanes->phase(i);
+        index += 64 * 64;
+      }
+      if (emission) {
+        out[index] = backplanes->emission(i);
+        index += 64 * 64;
+      }
+      if (incidence) {
+        out[index] = backplanes->incidence(i);
+        index += 64 * 64;
+      }
+      if (localEmission) {
+        out[index] = backplanes->localEmission(i);
+        index += 64 * 64;
+      }
+      if (localIncidence) {
+        out[index] = backplanes->localIncidence(i);
+        index += 64 * 64;
+      }
+    }
+
+    // Trim outer space
+    else {
+      for (int b = (skipDN) ? 1 : 0; b < nbands; b++) {
+        out[index] = Isis::NULL8;
+        index += 64 * 64;
+      }
+    }
+  }
+}
+
+
 // Function to create a keyword with same values of a specified count
 template <typename T>
   PvlKeyword makeKey(const QString &name, const int &nvals,
@@ -7,14 +7,19 @@
 #include <QString>
 
 #include "Angle.h"
+#include "AtmosModel.h"
 #include "Camera.h"
 #include "Cube.h"
+#include "GeometryBackplanes.h"
 #include "IException.h"
+#include "PhotoModel.h"
 #include "Photometry.h"
 #include "ProcessByLine.h"
 #include "Pvl.h"
 #include "PvlGroup.h"
+#include "ShapeModel.h"
 #include "SpecialPixel.h"
+#include "Target.h"
 
 #include <QDebug>
 
@@ -49,6 +54,9 @@ bool useEmissionfile = false;
 double phaseAngle;
 double incidenceAngle;
 double emissionAngle;
+GeometryBackplanes *backplanes = NULL;
+GeometryBackplanes *trimBackplanes = NULL;
+Cube *backplaneFile = NULL;
 
 void photometWithBackplane(std::vector<Isis::Buffer *> &in, std::vector<Isis::Buffer *> &out);
 void photomet(Buffer &in, Buffer &out);
@@ -1764,6 +1772,23 @@ void IsisMain() {
     // Set up the input cube
     icube = p.SetInputCube("FROM");
     cam = icube->camera();
+
+    backplanes = new GeometryBackplanes(cam);
+    backplanes->setTolerance(ui.GetDouble("ANGLE_TOLERANCE"));
+    backplanes->setLocalAngles(angleSource == "DEM");
+
+    // Trimming without the DEM needs the angles on the ellipsoid
+    if (!usedem && cam->target()->shape()->isDEM()) {
+      trimBackplanes = new GeometryBackplanes(cam);
+      trimBackplanes->setTolerance(ui.GetDouble("ANGLE_TOLERANCE"));
+    }
+
+    if (ui.WasEntered("BACKPLANE_FILE")) {
+      backplaneFile = new Cube;
+      GeometryBackplanes::createSidecar(*backplaneFile,
+                                        ui.GetFileName("BACKPLANE_FILE"),
+                                        icube->sampleCount(), icube->lineCount());
+    }
   }
   else {
     p.SetInputCube("FROM");
@@ -1843,6 +1868,7 @@ void IsisMain() {
   }
   pho = new Photometry(par);
   pho->SetPhotomWl(wl);
+  pho->SetTabulation(ui.GetDouble("TABLE_STEP"));
 
   // Start the processing
   if (useBackplane) {
@@ -1852,6 +1878,28 @@ void IsisMain() {
     p.StartProcess(photomet);
   }
   p.EndProcess();
+
+  if (pho->GetPhotoModel()->TabulationStep() > 0.0) {
+    PvlGroup tabulationLog("Tabulation");
+    tabulationLog += PvlKeyword("TableStep", toString(ui.GetDouble("TABLE_STEP")));
+    tabulationLog += PvlKeyword("MaximumPhotometricError",
+                                toString(pho->GetPhotoModel()->TabulationError()));
+    if (pho->GetAtmosModel()) {
+      tabulationLog += PvlKeyword("MaximumAtmosphericError",
+                                  toString(pho->GetAtmosModel()->TabulationError()));
+    }
+    Application::Log(tabulationLog);
+  }
+
+  if (backplaneFile) {
+    backplaneFile->close();
+  }
+  delete backplaneFile;
+  backplaneFile = NULL;
+  delete backplanes;
+  backplanes = NULL;
+  delete trimBackplanes;
+  trimBackplanes = NULL;
 }
 
 /**
@@ -1870,6 +1918,15 @@ void photomet(Buffer &in, Buffer &out) {
   double deminc=0., demema=0., mult=0., base=0.;
   double ellipsoidpha=0., ellipsoidinc=0., ellipsoidema=0.;
 
+  // Compute the photometric angles of the whole line at once
+  if (backplanes) {
+    backplanes->compute(in.Sample(), in.Line(), in.SampleDimension(),
+                        in.LineDimension());
+    if (backplaneFile) {
+      backplanes->writeSidecar(*backplaneFile);
+    }
+  }
+
   for (int i = 0; i < in.size(); i++) {
 
     // if special pixel, copy to output
@@ -1878,9 +1935,7 @@ void photomet(Buffer &in, Buffer &out) {
     }
 
     // if off the target, set to null
-    else if((angleSource == "ELLIPSOID" || angleSource == "DEM" ||
-            angleSource == "CENTER_FROM_IMAGE") &&
-            (!cam->SetImage(in.Sample(i), in.Line(i)))) {
+    else if(backplanes && !backplanes->isValid(i)) {
       out[i] = NULL8;
     }
 
@@ -1897,15 +1952,14 @@ void photomet(Buffer &in, Buffer &out) {
         demema = centerEmission;
       } else {
         // calculate photometric angles
-        ellipsoidpha = cam->PhaseAngle();
-        ellipsoidinc = cam->IncidenceAngle();
-        ellipsoidema = cam->EmissionAngle();
+        ellipsoidpha = backplanes->phase(i);
+        ellipsoidinc = backplanes->incidence(i);
+        ellipsoidema = backplanes->emission(i);
         if (angleSource == "DEM") {
-          Angle phase, incidence, emission;
-          cam->LocalPhotometricAngles(phase, incidence, emission, success);
+          success = !IsSpecial(backplanes->localIncidence(i));
           if (success) {
-            deminc = incidence.degrees();
-            demema = emission.degrees();
+            deminc = backplanes->localIncidence(i);
+            demema = backplanes->localEmission(i);
           }
         } else if (angleSource == "ELLIPSOID") {
           deminc = ellipsoidinc;
@@ -1924,27 +1978,35 @@ void photomet(Buffer &in, Buffer &out) {
     }
   }
   // Trim
-  if (!usedem) {
+  if (!backplanes) {
+    return;
+  }
+
+  // Without a DEM shape the angles on the ellipsoid are already known
+  GeometryBackplanes *trim = backplanes;
+  if (trimBackplanes) {
     cam->IgnoreElevationModel(true);
+    trimBackplanes->compute(in.Sample(), in.Line(), in.SampleDimension(),
+                            in.LineDimension());
+    cam->IgnoreElevationModel(false);
+    trim = trimBackplanes;
   }
+
   double trimInc = 0, trimEma = 0;
-  //bool success = true;
   for (int i = 0; i < in.size(); i++) {
     // if off the target, set to null
-    if(!cam->SetImage(in.Sample(i), in.Line(i))) {
+    if(!trim->isValid(i)) {
       out[i] = NULL8;
-      //success = false;
     }
     else {
-      trimInc = cam->IncidenceAngle();
-      trimEma = cam->EmissionAngle();
+      trimInc = trim->incidence(i);
+      trimEma = trim->emission(i);
     }
     
     if(trimInc > maxinc || trimEma > maxema) {
         out[i] = NULL8;
     }
   }
-  cam->IgnoreElevationModel(false);
 }
 
 /**
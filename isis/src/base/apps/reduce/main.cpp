@@ -68,7 +68,18 @@ void IsisMain() {
 
     // Start the processing
     PvlGroup results;
-    if(alg == "AVERAGE"){
+    // Averaging whole blocks of any valid pixels can read the input's overviews
+    int reduction = (int)sscale;
+    bool blockAverage = (alg == "AVERAGE" && vper == 0.0 && replaceMode == "NULL" &&
+                         sscale == lscale && sscale == reduction && reduction > 1 &&
+                         ins % reduction == 0 && inl % reduction == 0);
+
+    if(blockAverage) {
+      BlockAverage average(&inCube, reduction);
+      p.ProcessCubeInPlace(average, false);
+      results = average.UpdateOutputLabel(ocube);
+    }
+    else if(alg == "AVERAGE"){
       Average average(&inCube, sscale, lscale, vper, replaceMode);
       p.ProcessCubeInPlace(average, false);
       results = average.UpdateOutputLabel(ocube);
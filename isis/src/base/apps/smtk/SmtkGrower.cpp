@@ -0,0 +1,505 @@
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "SmtkGrower.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+
+#include "Camera.h"
+#include "Cube.h"
+#include "IException.h"
+#include "SmtkMatcher.h"
+#include "SmtkPoint.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * The images and matcher a partition is grown with.  A worker is only used
+   * by one thread at a time.
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class SmtkGrower::Worker {
+    public:
+      Worker(const SmtkGrower &grower) {
+        m_lhImage.setVirtualBands(grower.m_lhBands);
+        m_lhImage.open(grower.m_lhFile, "r");
+        m_rhImage.setVirtualBands(grower.m_rhBands);
+        m_rhImage.open(grower.m_rhFile, "r");
+
+        // Matching must not use a DEM, see IsisMain()
+        m_lhImage.camera()->IgnoreElevationModel(true);
+        m_rhImage.camera()->IgnoreElevationModel(true);
+
+        m_matcher = new SmtkMatcher(grower.m_regdef, &m_lhImage, &m_rhImage);
+      }
+
+
+      ~Worker() {
+        delete m_matcher;
+      }
+
+
+      //! Returns the matcher of the worker
+      SmtkMatcher &matcher() {
+        return *m_matcher;
+      }
+
+    private:
+      Q_DISABLE_COPY(Worker);
+
+      Cube m_lhImage;         //!< Left image
+      Cube m_rhImage;         //!< Right image
+      SmtkMatcher *m_matcher; //!< Matcher of the images
+  };
+
+
+  /**
+   * Grows a partition on a thread of the global thread pool.
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class SmtkGrower::GrowFunctor :
+      public std::unary_function<Partition * const &, void> {
+    public:
+      GrowFunctor(SmtkGrower *grower) : m_grower(grower) { }
+
+
+      void operator()(Partition * const &partition) const {
+        Worker *worker = NULL;
+        try {
+          worker = m_grower->acquireWorker();
+          m_grower->growPartition(*partition, worker->matcher());
+        }
+        catch (IException &e) {
+          partition->failed = true;
+          partition->error = e;
+        }
+
+        if (worker) {
+          m_grower->releaseWorker(worker);
+        }
+      }
+
+    private:
+      SmtkGrower *m_grower; //!< The grower of the partitions
+  };
+
+
+  /**
+   * Constructs a grower for a pair of images.
+   *
+   * The partitions are made at least twice as large as the farthest a point
+   * reaches, the larger of SPACE and half of SUBCBOX, so that partitions of
+   * the same phase never reach the same point.
+   *
+   * @param regdef Gruen registration definition file
+   * @param lhFile Left image, opened once for each thread
+   * @param lhBands Virtual bands of the left image
+   * @param rhFile Right image, opened once for each thread
+   * @param rhBands Virtual bands of the right image
+   * @param lines Number of lines of the left image
+   * @param samples Number of samples of the left image
+   * @param partitionSize Lines and samples of a partition
+   * @param space Spacing of grown points
+   * @param subcbox Size of the box filled with clones of a matched point
+   */
+  SmtkGrower::SmtkGrower(const QString &regdef,
+                         const QString &lhFile, const vector<QString> &lhBands,
+                         const QString &rhFile, const vector<QString> &rhBands,
+                         int lines, int samples, int partitionSize,
+                         int space, int subcbox) :
+      m_regdef(regdef), m_lhFile(lhFile), m_lhBands(lhBands),
+      m_rhFile(rhFile), m_rhBands(rhBands) {
+    m_space = space;
+    m_halfBox = (subcbox - 1) / 2;
+
+    int reach = max(m_space, m_halfBox);
+    m_partitionSize = max(partitionSize, 2 * reach + 1);
+    m_partitionRows = max(1, (lines + m_partitionSize - 1) / m_partitionSize);
+    m_partitionColumns = max(1, (samples + m_partitionSize - 1) / m_partitionSize);
+
+    m_partitions.resize(m_partitionRows * m_partitionColumns);
+    for (int i = 0; i < m_partitions.size(); i++) {
+      m_partitions[i].index = i;
+    }
+  }
+
+
+  //! Closes the images of the workers
+  SmtkGrower::~SmtkGrower() {
+    qDeleteAll(m_workers);
+  }
+
+
+  /**
+   * Grows the seed points into the matched points.
+   *
+   * @param seeds Points to grow from, registered or not
+   *
+   * @return SmtkQStack The matched points, in partition order
+   */
+  SmtkQStack SmtkGrower::grow(const SmtkQStack &seeds) {
+    for (SmtkQStackConstIter seed = seeds.begin(); seed != seeds.end(); ++seed) {
+      m_partitions[partitionOf(seed.key())].grow.insert(seed.key(), seed.value());
+    }
+
+    // Cameras are created while the workers are made, so make the workers for
+    // the threads here rather than on the threads. The calling thread also
+    // grows partitions while it waits for the pool.
+    int threads = min(QThreadPool::globalInstance()->maxThreadCount() + 1,
+                      m_partitions.size());
+    while (m_workers.size() < threads) {
+      Worker *worker = new Worker(*this);
+      m_workers.append(worker);
+      m_idleWorkers.append(worker);
+    }
+
+    bool growing = true;
+    while (growing) {
+      growing = false;
+
+      for (int phase = 0; phase < 4; phase++) {
+        QList<Partition *> active;
+        BigInt onStack = 0;
+        for (int i = 0; i < m_partitions.size(); i++) {
+          if (phaseOf(i) == phase && !m_partitions[i].grow.isEmpty()) {
+            active.append(&m_partitions[i]);
+            onStack += m_partitions[i].grow.size();
+          }
+        }
+
+        if (active.isEmpty()) continue;
+        growing = true;
+        cout << "Number on Stack: " << onStack << "\n";
+
+        // Start the partitions with the most points first so that threads
+        // pick up the smaller ones as they finish
+        QList<Partition *> largestFirst(active);
+        std::stable_sort(largestFirst.begin(), largestFirst.end(), hasMoreToGrow);
+        QtConcurrent::blockingMap(largestFirst, GrowFunctor(this));
+
+        for (int i = 0; i < active.size(); i++) {
+          if (active[i]->failed) {
+            throw active[i]->error;
+          }
+        }
+
+        for (int i = 0; i < active.size(); i++) {
+          mergeOut(*active[i]);
+        }
+      }
+    }
+
+    SmtkQStack matched;
+    for (int i = 0; i < m_partitions.size(); i++) {
+      matched.unite(m_partitions[i].matched);
+    }
+    return matched;
+  }
+
+
+  /**
+   * @return BigInt The number of points that were registered while growing
+   */
+  BigInt SmtkGrower::grownCount() const {
+    BigInt grown = 0;
+    for (int i = 0; i < m_partitions.size(); i++) {
+      grown += m_partitions[i].grown;
+    }
+    return grown;
+  }
+
+
+  /**
+   * Adds the error counts and registration statistics of the matchers used to
+   * grow to another matcher.
+   *
+   * @param matcher Matcher that receives the statistics
+   */
+  void SmtkGrower::mergeStatistics(SmtkMatcher &matcher) const {
+    for (int i = 0; i < m_workers.size(); i++) {
+      matcher.MergeStatistics(m_workers[i]->matcher());
+    }
+  }
+
+
+  /**
+   * Returns the partition a point belongs to.  Points outside of the image
+   * belong to the nearest partition.
+   *
+   * @param key Line and sample of the point in the left image
+   *
+   * @return int Index of the partition
+   */
+  int SmtkGrower::partitionOf(const SmtkQPair &key) const {
+    int row = (key.first - 1) / m_partitionSize;
+    int column = (key.second - 1) / m_partitionSize;
+    row = min(max(row, 0), m_partitionRows - 1);
+    column = min(max(column, 0), m_partitionColumns - 1);
+    return row * m_partitionColumns + column;
+  }
+
+
+  /**
+   * Returns the phase a partition is grown in.  Partitions next to each other
+   * are never in the same phase.
+   *
+   * @param index Index of the partition
+   *
+   * @return int The phase, 0 to 3
+   */
+  int SmtkGrower::phaseOf(int index) const {
+    int row = index / m_partitionColumns;
+    int column = index % m_partitionColumns;
+    return (row % 2) * 2 + column % 2;
+  }
+
+
+  /**
+   * Orders partitions by the number of points they have left to grow.
+   *
+   * @param a A partition
+   * @param b Another partition
+   *
+   * @return bool True if partition a has more points to grow than b
+   */
+  bool SmtkGrower::hasMoreToGrow(const Partition *a, const Partition *b) {
+    return a->grow.size() > b->grow.size();
+  }
+
+
+  /**
+   * Grows the points of a partition until its grow stack is empty.  This is
+   * the growing smtk has always done, with the points outside of the partition
+   * kept aside until the phase ends.
+   *
+   * @param partition The partition to grow
+   * @param matcher Matcher to register and clone the points with
+   */
+  void SmtkGrower::growPartition(Partition &partition,
+                                 SmtkMatcher &matcher) const {
+    while (!partition.grow.isEmpty()) {
+      SmtkQStackIter cstack = matcher.FindSmallestEV(partition.grow);
+      SmtkQPair key = cstack.key();
+
+      // Test to see if already determined
+      if (!findMatched(partition, key)) {
+        //  Register if its not already registered
+        SmtkPoint spnt = cstack.value();
+        if (!spnt.isRegistered()) {
+          spnt = matcher.Register(spnt, spnt.getAffine());
+        }
+
+        // Still must check for validity if the point was just registered,
+        // otherwise should be good
+        if (spnt.isValid()) {
+          partition.grown++;
+          addMatched(partition, key, spnt);
+          int line   = key.first;
+          int sample = key.second;
+
+          //  Determine match points
+          double eigen(spnt.GoodnessOfFit());
+          for (int sampBox = -m_halfBox ; sampBox <= m_halfBox ; sampBox++) {
+            int csamp = sample + sampBox;
+            for (int lineBox = -m_halfBox ; lineBox <= m_halfBox ; lineBox++) {
+              int cline = line + lineBox;
+              if ( !((sampBox == 0) && (lineBox == 0)) ) {
+                SmtkQPair dupPair(cline, csamp);
+                const SmtkPoint *temp = findMatched(partition, dupPair);
+                SmtkPoint bmfpnt;
+                if (!temp || temp->GoodnessOfFit() > eigen) {
+                  // Create cloned point with better fit
+                  bmfpnt = matcher.Clone(spnt, Coordinate(cline, csamp));
+                }
+
+                //  Add if good point
+                if (bmfpnt.isValid()) {
+                  addMatched(partition, dupPair, bmfpnt);
+                }
+              }
+            }
+          }
+
+          // Grow stack with spacing adding info to stack
+          for (int i = -1 ; i <= 1 ; i++) {  // Sample
+            for (int j = -1 ; j <= 1 ; j++) {  // Line
+              // Don't re-add the original sample, line
+              if ( !((i == 0) && (j == 0)) ) {
+                //  Grow based upon spacing
+                double ssamp = sample + (i * m_space);
+                double sline = line   + (j * m_space);
+                SmtkPoint gpnt = matcher.Clone(spnt, Coordinate(sline, ssamp));
+
+                if (gpnt.isValid()) {
+                  SmtkQPair growpt((int) sline, (int) ssamp);
+
+                  // double check we don't have a finalized result here
+                  if (!findMatched(partition, growpt)) {
+                    addGrow(partition, growpt, gpnt);
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+
+      // Remove the current point from the grow stack (hole)
+      partition.grow.remove(key);
+    }
+  }
+
+
+  /**
+   * Finds a matched point as a partition sees it while it grows.  Matched
+   * points of other partitions are read from the partition they belong to,
+   * which is not growing in the same phase.
+   *
+   * @param partition The growing partition
+   * @param key Line and sample of the point
+   *
+   * @return const SmtkPoint* The matched point, or NULL if there is none
+   */
+  const SmtkPoint *SmtkGrower::findMatched(const Partition &partition,
+                                           const SmtkQPair &key) const {
+    int index = partitionOf(key);
+    const SmtkQStack *matched = &m_partitions[index].matched;
+    if (index != partition.index) {
+      QMap<int, SmtkQStack>::const_iterator out = partition.matchedOut.find(index);
+      if (out != partition.matchedOut.end() && out.value().contains(key)) {
+        matched = &out.value();
+      }
+    }
+
+    SmtkQStackConstIter point = matched->find(key);
+    return (point != matched->end()) ? &point.value() : NULL;
+  }
+
+
+  /**
+   * Adds a matched point for a growing partition.
+   *
+   * @param partition The growing partition
+   * @param key Line and sample of the point
+   * @param point The matched point
+   */
+  void SmtkGrower::addMatched(Partition &partition, const SmtkQPair &key,
+                              const SmtkPoint &point) const {
+    int index = partitionOf(key);
+    if (index == partition.index) {
+      partition.matched.insert(key, point);
+    }
+    else {
+      partition.matchedOut[index].insert(key, point);
+    }
+  }
+
+
+  /**
+   * Adds a point to grow for a growing partition.
+   *
+   * @param partition The growing partition
+   * @param key Line and sample of the point
+   * @param point The point to grow
+   */
+  void SmtkGrower::addGrow(Partition &partition, const SmtkQPair &key,
+                           const SmtkPoint &point) const {
+    int index = partitionOf(key);
+    if (index == partition.index) {
+      partition.grow.insert(key, point);
+    }
+    else {
+      partition.growOut[index].insert(key, point);
+    }
+  }
+
+
+  /**
+   * Moves the points a partition kept aside for other partitions into those
+   * partitions.
+   *
+   * @param partition A partition that has finished growing for the phase
+   */
+  void SmtkGrower::mergeOut(Partition &partition) {
+    QMap<int, SmtkQStack>::const_iterator out;
+    for (out = partition.matchedOut.constBegin(); out != partition.matchedOut.constEnd();
+         ++out) {
+      SmtkQStack &matched = m_partitions[out.key()].matched;
+      for (SmtkQStackConstIter point = out.value().constBegin();
+           point != out.value().constEnd(); ++point) {
+        matched.insert(point.key(), point.value());
+      }
+    }
+
+    for (out = partition.growOut.constBegin(); out != partition.growOut.constEnd(); ++out) {
+      SmtkQStack &grow = m_partitions[out.key()].grow;
+      for (SmtkQStackConstIter point = out.value().constBegin();
+           point != out.value().constEnd(); ++point) {
+        grow.insert(point.key(), point.value());
+      }
+    }
+
+    partition.matchedOut.clear();
+    partition.growOut.clear();
+  }
+
+
+  /**
+   * Takes an idle worker. grow() makes a worker for every thread that can
+   * grow a partition at once, because making one here would create cameras
+   * on several threads.
+   *
+   * @return Worker* A worker for the calling thread only
+   *
+   * @throws IException::Programmer "There is no idle worker"
+   */
+  SmtkGrower::Worker *SmtkGrower::acquireWorker() {
+    QMutexLocker lock(&m_workerMutex);
+    if (m_idleWorkers.isEmpty()) {
+      QString msg = "There is no idle worker for growing a partition";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+    return m_idleWorkers.takeLast();
+  }
+
+
+  /**
+   * Returns a worker to the idle workers.
+   *
+   * @param worker A worker taken with acquireWorker()
+   */
+  void SmtkGrower::releaseWorker(Worker *worker) {
+    QMutexLocker lock(&m_workerMutex);
+    m_idleWorkers.append(worker);
+  }
+}
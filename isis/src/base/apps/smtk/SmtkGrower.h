@@ -0,0 +1,141 @@
+#ifndef SmtkGrower_h
+#define SmtkGrower_h
+
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <functional>
+#include <vector>
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include "Constants.h"
+#include "IException.h"
+#include "SmtkStack.h"
+
+namespace Isis {
+  class Cube;
+  class SmtkMatcher;
+
+  /**
+   * @brief Grows stereo matches from seed points in parallel
+   *
+   * The left image is divided into square partitions.  Each partition keeps
+   * its own grow stack and the matched points that fall within it.  A
+   * partition grows its points exactly as smtk always has: the point with the
+   * smallest eigenvalue is registered, the subcbox around it is filled with
+   * clones and its neighbors at SPACE are added to the grow stack.
+   *
+   * A point reaches at most into the partitions next to its own, so the
+   * partitions are processed in four phases, one for each corner of a two by
+   * two block of partitions.  The partitions of a phase never touch the same
+   * point.  They are grown in parallel on the global thread pool, each with
+   * a matcher of its own.  Points a partition adds to another partition are
+   * held until the phase ends and are then merged in partition order.  The
+   * phases are repeated until no partition has points left to grow.
+   *
+   * The result only depends on the seed points and the partition size, not
+   * on the number of threads or on how the threads are scheduled.
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class SmtkGrower {
+    public:
+      SmtkGrower(const QString &regdef,
+                 const QString &lhFile, const std::vector<QString> &lhBands,
+                 const QString &rhFile, const std::vector<QString> &rhBands,
+                 int lines, int samples, int partitionSize,
+                 int space, int subcbox);
+      ~SmtkGrower();
+
+      SmtkQStack grow(const SmtkQStack &seeds);
+
+      BigInt grownCount() const;
+      void mergeStatistics(SmtkMatcher &matcher) const;
+
+    private:
+      Q_DISABLE_COPY(SmtkGrower);
+
+      class Worker;
+      class GrowFunctor;
+
+      /**
+       * A partition of the left image with the points it grows
+       *
+       * @author 2026-10-19 ISIS Development Team
+       *
+       * @internal
+       */
+      struct Partition {
+        Partition() : index(0), grown(0), failed(false) { }
+
+        int index;                       //!< Index of the partition
+        SmtkQStack grow;                 //!< Points left to grow
+        SmtkQStack matched;              //!< Matched points in the partition
+        QMap<int, SmtkQStack> growOut;   //!< Points to grow in other partitions
+        QMap<int, SmtkQStack> matchedOut;//!< Matched points in other partitions
+        BigInt grown;                    //!< Number of points registered
+        bool failed;                     //!< Growing stopped with an error
+        IException error;                //!< The error, if failed
+      };
+
+      int partitionOf(const SmtkQPair &key) const;
+      int phaseOf(int index) const;
+      static bool hasMoreToGrow(const Partition *a, const Partition *b);
+
+      void growPartition(Partition &partition, SmtkMatcher &matcher) const;
+      const SmtkPoint *findMatched(const Partition &partition,
+                                   const SmtkQPair &key) const;
+      void addMatched(Partition &partition, const SmtkQPair &key,
+                      const SmtkPoint &point) const;
+      void addGrow(Partition &partition, const SmtkQPair &key,
+                   const SmtkPoint &point) const;
+      void mergeOut(Partition &partition);
+
+      Worker *acquireWorker();
+      void releaseWorker(Worker *worker);
+
+      QString m_regdef;               //!< Gruen registration definition file
+      QString m_lhFile;               //!< Left image
+      std::vector<QString> m_lhBands; //!< Virtual bands of the left image
+      QString m_rhFile;               //!< Right image
+      std::vector<QString> m_rhBands; //!< Virtual bands of the right image
+
+      int m_partitionSize;            //!< Lines and samples of a partition
+      int m_partitionRows;            //!< Number of rows of partitions
+      int m_partitionColumns;         //!< Number of columns of partitions
+      int m_space;                    //!< Spacing of grown points
+      int m_halfBox;                  //!< Half size of the subcbox
+
+      QVector<Partition> m_partitions;//!< The partitions of the left image
+      QList<Worker *> m_workers;      //!< All the workers created
+      QList<Worker *> m_idleWorkers;  //!< Workers not in use
+      QMutex m_workerMutex;           //!< Guards the idle workers
+  };
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include "Progress.h"
 #include "PvlGroup.h"
 #include "SerialNumber.h"
+#include "SmtkGrower.h"
 #include "SmtkMatcher.h"
 #include "SmtkPoint.h"
 #include "Statistics.h"
@@ -311,103 +312,18 @@ void IsisMain() {
     cout << "Number of Manual Seed Points:   " << gstack.size() << "\n";
   }
 
-  // Use seed points (in stack) to grow
-  SmtkQStack bmf;
-  bmf.reserve(gstack.size());  // Probably need much more but for starters...
-
+  // Use seed points (in stack) to grow.  Partitions of the image are grown in
+  // parallel, each thread with its own matcher.
   BigInt numOrigPoints = gstack.size();
-  BigInt passpix2 = 0;
-
-  int subcbox = ui.GetInteger("SUBCBOX");
-  int halfBox((subcbox-1)/2);
-  while (!gstack.isEmpty()) {
-
-    SmtkQStackIter cstack = matcher.FindSmallestEV(gstack);
-
-    // Print number on stack
-    if ((gstack.size() % 1000) == 0) {
-      cout << "Number on Stack: " << gstack.size()
-           << ". " << cstack.value().GoodnessOfFit() << "\n";
-    }
 
-    // Test to see if already determined
-    SmtkQStackIter bmfPt = bmf.find(cstack.key());
-    if (bmfPt == bmf.end()) {
-      // Its not in the final stack, process it
-
-      //  Retrieve the point
-      SmtkPoint spnt = cstack.value();
-      //  Register if its not already registered
-      if (!spnt.isRegistered()) {
-        spnt = matcher.Register(spnt, spnt.getAffine());
-      }
-
-      // Still must check for validity if the point was just registered,
-      // otherwise should be good
-      if ( spnt.isValid() ) {
-        passpix2++;
-        bmf.insert(cstack.key(), spnt);  // inserts (0,0) offset excluded below
-        int line   = cstack.key().first;
-        int sample = cstack.key().second;
-
-        //  Determine match points
-        double eigen(spnt.GoodnessOfFit());
-        for (int sampBox = -halfBox ; sampBox <= halfBox ; sampBox++ ) {
-          int csamp = sample + sampBox;
-          for (int lineBox = -halfBox ; lineBox <= halfBox ; lineBox++) {
-            int cline = line + lineBox;
-            if ( !( (sampBox == 0) && (lineBox == 0)) ) {// Already added above
-              SmtkQPair dupPair(cline, csamp);
-              SmtkQStackIter temp = bmf.find(dupPair);
-              SmtkPoint bmfpnt;
-              if (temp != bmf.end()) {
-                if (temp.value().GoodnessOfFit() > eigen) {
-                  // Create cloned point with better fit
-                  bmfpnt = matcher.Clone(spnt, Coordinate(cline,csamp));
-                }
-              }
-              else {  // ISIS2 is BMF(SAMP,LINE,7) .EQ VALID_MAX4)
-                // Clone new point for insert
-                bmfpnt = matcher.Clone(spnt, Coordinate(cline,csamp));
-              }
-
-              //  Add if good point
-              if (bmfpnt.isValid()) {
-                bmf.insert(dupPair, bmfpnt);
-              }
-            }
-          }
-        }
-
-        // Grow stack with spacing adding info to stack
-        for (int i = -1 ; i <= 1 ; i ++) {  // Sample
-          for (int j = -1 ; j <= 1 ; j ++) {  // Line
-            // Don't re-add the original sample, line
-            if ( !((i == 0) && (j == 0)) ) {
-              //  Grow based upon spacing
-              double ssamp = sample + (i * space);
-              double sline = line   + (j * space);
-              Coordinate pnt = Coordinate(sline, ssamp);
-              SmtkPoint gpnt = matcher.Clone(spnt, pnt);
-
-              if ( gpnt.isValid() ) {
-                SmtkQPair growpt((int) sline, (int) ssamp);
-
-                // double check we don't have a finalized result at this position
-                SmtkQStackIter temp = bmf.find(growpt);
-                if (temp == bmf.end()) {
-                  gstack.insert(growpt, gpnt);
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-
-    // Remove the current point from the grow stack (hole)
-    gstack.erase(cstack);
-  }
+  SmtkGrower grower(ui.GetFileName("REGDEF"),
+                    ui.GetFileName("FROM"), bandLeft,
+                    ui.GetFileName("MATCH"), bandRight,
+                    nl, ns, ui.GetInteger("PARTITION"),
+                    space, ui.GetInteger("SUBCBOX"));
+  SmtkQStack bmf = grower.grow(gstack);
+  BigInt passpix2 = grower.grownCount();
+  grower.mergeStatistics(matcher);
 
 /////////////////////////////////////////////////////////////////////////
 // All done with creating points.  Perform output options.
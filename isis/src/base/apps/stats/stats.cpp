@@ -8,6 +8,7 @@
 #include "Cube.h"
 #include "FileName.h"
 #include "Histogram.h"
+#include "ProgramLauncher.h"
 #include "Pvl.h"
 #include "UserInterface.h"
 
@@ -172,4 +173,16 @@ namespace Isis {
     }
   }
 
+
+  /**
+   * The entry point ProgramLauncher uses to run stats inside of another
+   * process, such as a Pipeline.
+   *
+   * @param ui The User Interface to parse the parameters from
+   */
+  static void statsEntry(UserInterface &ui) {
+    stats(ui);
+  }
+
+  static bool statsRegistered = ProgramLauncher::RegisterIsisProgram("stats", statsEntry);
 }
@@ -2,7 +2,9 @@
 
 #include <QString>
 
+#include "IException.h"
 #include "ImageImporter.h"
+#include "JP2Importer.h"
 #include "UserInterface.h"
 
 using namespace Isis;
@@ -14,6 +16,33 @@ void IsisMain() {
   FileName inputName = ui.GetFileName("FROM");
   ImageImporter *importer = ImageImporter::fromFileName(inputName);
 
+  // Decode only a subarea or a reduced resolution of a JPEG 2000 image
+  bool subarea = ui.GetInteger("SAMPLE") != 1 || ui.GetInteger("LINE") != 1 ||
+                 ui.WasEntered("NSAMPLES") || ui.WasEntered("NLINES");
+  int reduction = ui.GetInteger("REDUCTION");
+  if (subarea || reduction > 0) {
+    JP2Importer *jp2Importer = dynamic_cast<JP2Importer *>(importer);
+    if (jp2Importer == NULL) {
+      delete importer;
+      QString msg = "Only a JPEG 2000 image can be imported in part or at a "
+                    "reduced resolution";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    if (subarea) {
+      int sample = ui.GetInteger("SAMPLE");
+      int line = ui.GetInteger("LINE");
+      int samples = ui.WasEntered("NSAMPLES") ?
+                    ui.GetInteger("NSAMPLES") : importer->samples() - sample + 1;
+      int lines = ui.WasEntered("NLINES") ?
+                  ui.GetInteger("NLINES") : importer->lines() - line + 1;
+      jp2Importer->setRegion(sample, line, samples, lines);
+    }
+    if (reduction > 0) {
+      jp2Importer->setResolutionReduction(reduction);
+    }
+  }
+
   // Explicitly set band dimension if a specific color mode is desired
   IString mode = ui.GetString("MODE");
   if (mode != "AUTO") {
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include "Pvl.h"
@@ -6,6 +7,7 @@
 #include "NumericalApproximation.h"
 #include "NumericalAtmosApprox.h"
 #include "PhotoModel.h"
+#include "PhotometricTable.h"
 #include "Minnaert.h"
 #include "LunarLambert.h"
 #include "Plugin.h"
@@ -64,6 +66,7 @@ namespace Isis {
     p_trans0 = 0.0;
     p_transs = 0.0;
     p_standardConditions = false;
+    p_table = NULL;
 
     PvlGroup &algorithm = pvl.findObject("AtmosphericModel").findGroup("Algorithm", Pvl::Traverse);
 
@@ -125,6 +128,12 @@ namespace Isis {
     }
   }
 
+  //! Destroys the AtmosModel object
+  AtmosModel::~AtmosModel() {
+    delete p_table;
+    p_table = NULL;
+  }
+
  /**
    * Perform Chandra and Van de Hulst's series approximation
    * for the g'11 function needed in second order scattering
@@ -477,8 +486,21 @@ namespace Isis {
     //  throw IException::Message(IException::Programmer,msg,_FILEINFO_);
     //}
 
-    // Apply atmospheric function
-    AtmosModelAlgorithm(pha, inc, ema);
+    // Use the table unless tau is swapped for standard conditions
+    double values[5];
+    if (p_table && !p_standardConditions &&
+        p_table->evaluate(pha, inc, ema, values)) {
+      p_pstd = values[0];
+      p_trans = values[1];
+      p_trans0 = values[2];
+      p_sbar = values[3];
+      p_transs = values[4];
+    }
+    else {
+      // Apply atmospheric function
+      AtmosModelAlgorithm(pha, inc, ema);
+    }
+
     *pstd = p_pstd;
     *trans = p_trans;
     *trans0 = p_trans0;
@@ -486,6 +508,74 @@ namespace Isis {
     *transs = p_transs;
   }
 
+  /**
+   * Interpolate the terms computed by CalcAtmEffect() in a table of the
+   * atmospheric function, with nodes about step degrees apart in phase,
+   * incidence and emission angle. This replaces the Hapke and
+   * Henyey-Greenstein integrals and splines of each pixel by a trilinear
+   * interpolation. The nodes are evaluated as they are needed. Angles outside
+   * of the table and standard conditions still use the atmospheric function
+   * directly. Call this again after changing the parameters of the model,
+   * since that clears the table.
+   *
+   * @param step The node spacing in degrees, 0 to use the atmospheric
+   *             function for every pixel
+   *
+   * @see PhotometricTable
+   */
+  void AtmosModel::SetTabulation(double step) {
+    delete p_table;
+    p_table = NULL;
+
+    if (step > 0.0) {
+      p_table = new PhotometricTable(5, TabulatedAtmEffect, this);
+      p_table->setStep(step);
+    }
+  }
+
+  /**
+   * @return The node spacing of the scattering table in degrees, 0 if the
+   *         scattering terms are not tabulated
+   */
+  double AtmosModel::TabulationStep() const {
+    return p_table ? p_table->step() : 0.0;
+  }
+
+  /**
+   * @return The largest interpolation error of any of the scattering terms
+   *         seen so far, measured at the center of each table cell used
+   */
+  double AtmosModel::TabulationError() const {
+    double error = 0.0;
+    if (p_table) {
+      for (int i = 0; i < p_table->valueCount(); i++) {
+        error = max(error, p_table->maximumError(i));
+      }
+    }
+    return error;
+  }
+
+  /**
+   * The function tabulated by SetTabulation().
+   *
+   * @param model The AtmosModel
+   * @param phase Phase angle
+   * @param incidence Incidence angle
+   * @param emission Emission angle
+   * @param values Receives pstd, trans, trans0, sbar and transs
+   */
+  void AtmosModel::TabulatedAtmEffect(void *model, double phase,
+                                      double incidence, double emission,
+                                      double *values) {
+    AtmosModel *atmos = (AtmosModel *)model;
+    atmos->AtmosModelAlgorithm(phase, incidence, emission);
+    values[0] = atmos->p_pstd;
+    values[1] = atmos->p_trans;
+    values[2] = atmos->p_trans0;
+    values[3] = atmos->p_sbar;
+    values[4] = atmos->p_transs;
+  }
+
   /**
    * Used to calculate atmosphere at standard conditions
    */
@@ -31,6 +31,7 @@
 
 using namespace std;
 namespace Isis {
+  class PhotometricTable;
   class Pvl;
 
   /**
@@ -72,12 +73,13 @@ namespace Isis {
    *           angle) value in the atmospheric classes. Added a setter method
    *           for setting the p_atmosEstTau variable which is used by the
    *           atmospheric classes.
+   *  @history 2026-10-19 ISIS Development Team - Added SetTabulation() to
+   *           interpolate CalcAtmEffect() in a PhotometricTable.
    */
   class AtmosModel {
     public:
       AtmosModel(Pvl &pvl, PhotoModel &pmodel);
-      //! Empty destructor
-      virtual ~AtmosModel() {};
+      virtual ~AtmosModel();
 
       // These methods were moved here from the NumericalMethods class
       static double G11Prime(double tau);
@@ -86,6 +88,10 @@ namespace Isis {
       // Calculate atmospheric scattering effect
       void CalcAtmEffect(double pha, double inc, double ema, double *pstd,
                          double *trans, double *trans0, double *sbar, double *transs);
+      // Interpolate the atmospheric scattering effect in a table
+      void SetTabulation(double step);
+      double TabulationStep() const;
+      double TabulationError() const;
       // Used to calculate atmosphere at standard conditions
       virtual void SetStandardConditions(bool standard);
       // Obtain hemispheric and bihemispheric albedo by integrating the photometric function
@@ -303,8 +309,14 @@ namespace Isis {
       NumericalApproximation p_atmosHahgt0Spline;
 
     private:
+      static void TabulatedAtmEffect(void *model, double phase, double incidence,
+                                     double emission, double *values);
+
       bool p_standardConditions;
 
+      //! The tabulated scattering terms, or NULL if they are not tabulated
+      PhotometricTable *p_table;
+
       string p_atmosAlgorithmName;
 
       PhotoModel *p_atmosPM;
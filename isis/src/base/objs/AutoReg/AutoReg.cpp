@@ -1219,6 +1219,27 @@ namespace Isis {
     return (AlgorithmStatistics(pvl));
   }
 
+  /**
+   * Adds the cumulative registration statistics of another AutoReg to the
+   * statistics of this one. This allows registrations to be run in parallel,
+   * each thread with its own AutoReg, and reported as a whole with
+   * RegistrationStatistics().
+   *
+   * @param other The AutoReg whose statistics are added
+   */
+  void AutoReg::MergeStatistics(const AutoReg &other) {
+    p_totalRegistrations += other.p_totalRegistrations;
+    p_pixelSuccesses += other.p_pixelSuccesses;
+    p_subpixelSuccesses += other.p_subpixelSuccesses;
+    p_patternChipNotEnoughValidDataCount += other.p_patternChipNotEnoughValidDataCount;
+    p_patternZScoreNotMetCount += other.p_patternZScoreNotMetCount;
+    p_fitChipNoDataCount += other.p_fitChipNoDataCount;
+    p_fitChipToleranceNotMetCount += other.p_fitChipToleranceNotMetCount;
+    p_surfaceModelNotEnoughValidDataCount += other.p_surfaceModelNotEnoughValidDataCount;
+    p_surfaceModelSolutionInvalidCount += other.p_surfaceModelSolutionInvalidCount;
+    p_surfaceModelDistanceInvalidCount += other.p_surfaceModelDistanceInvalidCount;
+  }
+
   /**
    * This function returns the keywords that this object was
    * created from.
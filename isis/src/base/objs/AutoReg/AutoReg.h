@@ -179,6 +179,9 @@ namespace Isis {
    *                            caused the previous registration to be returned. If sub-pixel 
    *                            registration fails now it will return to the whole pixel 
    *                            registration values. Fixes #5248.
+   *    @history 2026-10-19 ISIS Development Team - Added MergeStatistics() to
+   *                            combine the registration statistics of
+   *                            registrations run on separate threads.
    */
   class AutoReg {
     public:
@@ -379,6 +382,7 @@ namespace Isis {
       }
 
       Pvl RegistrationStatistics();
+      void MergeStatistics(const AutoReg &other);
 
       /**
        * Minimum tolerance specific to algorithm
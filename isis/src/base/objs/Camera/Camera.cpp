@@ -50,6 +50,7 @@
 #include "Latitude.h"
 #include "Longitude.h"
 #include "NaifStatus.h"
+#include "Preference.h"
 #include "Projection.h"
 #include "ProjectionFactory.h"
 #include "RingPlaneProjection.h"
@@ -118,6 +119,12 @@ namespace Isis {
     p_raDecRangeComputed = false;
     p_ringRangeComputed = false;
     p_pointComputed = false;
+
+    p_rangeTolerance = 0.0;
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    if (performancePrefs.hasKeyword("CameraRangeTolerance")) {
+      p_rangeTolerance = toDouble(performancePrefs["CameraRangeTolerance"][0]);
+    }
   }
 
   //! Destroys the Camera Object
@@ -792,48 +799,17 @@ namespace Isis {
     for (int band = 1; band <= eband; band++) {
       SetBand(band);
 
-      // Loop for each line testing the left and right sides of the image
-      for (int line = 1; line <= p_lines + 1; line++) {
-        // Look for the first good lat/lon on the left edge of the image
-        // If it is the first or last line then test the whole line
-        int samp;
-        for (samp = 1; samp <= p_samples + 1; samp++) {
-
-          if (SetImage((double)samp - 0.5, (double)line - 0.5)) {
-            double lat = UniversalLatitude();
-            double lon = UniversalLongitude();
-            if (lat < p_minlat) p_minlat = lat;
-            if (lat > p_maxlat) p_maxlat = lat;
-            if (lon < p_minlon) p_minlon = lon;
-            if (lon > p_maxlon) p_maxlon = lon;
-
-            if (lon > 180.0) lon -= 360.0;
-            if (lon < p_minlon180) p_minlon180 = lon;
-            if (lon > p_maxlon180) p_maxlon180 = lon;
-
-            double res = PixelResolution();
-            if (res > 0.0) {
-              if (res < p_minres) p_minres = res;
-              if (res > p_maxres) p_maxres = res;
-            }
-            //  Determine min/max oblique resolution
-            double obliqueres = ObliquePixelResolution();
-            if (obliqueres > 0.0) {
-                if (obliqueres < p_minobliqueres) p_minobliqueres = obliqueres;
-                if (obliqueres > p_maxobliqueres) p_maxobliqueres = obliqueres;
-
-            }
-            if ((line != 1) && (line != p_lines + 1)) break;
-          }
-        } // end loop through samples
-
-        //We've already checked the first and last lines.
-        if (line == 1) continue;
-        if (line == p_lines + 1) continue;
+      if (p_rangeTolerance > 0.0) {
+        adaptiveRangeScan(false);
+      }
+      else {
+        // Loop for each line testing the left and right sides of the image
+        for (int line = 1; line <= p_lines + 1; line++) {
+          // Look for the first good lat/lon on the left edge of the image
+          // If it is the first or last line then test the whole line
+          int samp;
+          for (samp = 1; samp <= p_samples + 1; samp++) {
 
-        // Look for the first good lat/lon on the right edge of the image
-        if (samp < p_samples + 1) {
-          for (samp = p_samples + 1; samp >= 1; samp--) {
             if (SetImage((double)samp - 0.5, (double)line - 0.5)) {
               double lat = UniversalLatitude();
               double lon = UniversalLongitude();
@@ -851,7 +827,6 @@ namespace Isis {
                 if (res < p_minres) p_minres = res;
                 if (res > p_maxres) p_maxres = res;
               }
-
               //  Determine min/max oblique resolution
               double obliqueres = ObliquePixelResolution();
               if (obliqueres > 0.0) {
@@ -859,11 +834,48 @@ namespace Isis {
                   if (obliqueres > p_maxobliqueres) p_maxobliqueres = obliqueres;
 
               }
-              break;
+              if ((line != 1) && (line != p_lines + 1)) break;
+            }
+          } // end loop through samples
+
+          //We've already checked the first and last lines.
+          if (line == 1) continue;
+          if (line == p_lines + 1) continue;
+
+          // Look for the first good lat/lon on the right edge of the image
+          if (samp < p_samples + 1) {
+            for (samp = p_samples + 1; samp >= 1; samp--) {
+              if (SetImage((double)samp - 0.5, (double)line - 0.5)) {
+                double lat = UniversalLatitude();
+                double lon = UniversalLongitude();
+                if (lat < p_minlat) p_minlat = lat;
+                if (lat > p_maxlat) p_maxlat = lat;
+                if (lon < p_minlon) p_minlon = lon;
+                if (lon > p_maxlon) p_maxlon = lon;
+
+                if (lon > 180.0) lon -= 360.0;
+                if (lon < p_minlon180) p_minlon180 = lon;
+                if (lon > p_maxlon180) p_maxlon180 = lon;
+
+                double res = PixelResolution();
+                if (res > 0.0) {
+                  if (res < p_minres) p_minres = res;
+                  if (res > p_maxres) p_maxres = res;
+                }
+
+                //  Determine min/max oblique resolution
+                double obliqueres = ObliquePixelResolution();
+                if (obliqueres > 0.0) {
+                    if (obliqueres < p_minobliqueres) p_minobliqueres = obliqueres;
+                    if (obliqueres > p_maxobliqueres) p_maxobliqueres = obliqueres;
+
+                }
+                break;
+              }
             }
           }
-        }
-      } // end loop through lines
+        } // end loop through lines
+      }
 
       // Test at the sub-spacecraft point to see if we have a
       // better resolution
@@ -1029,41 +1041,18 @@ namespace Isis {
     for (int band = 1; band <= eband; band++) {
       SetBand(band);
 
-      // Loop for each line testing the left and right sides of the image
-      for (int line = 1; line <= p_lines + 1; line++) {
-
-        // Look for the first good radius/azimuth on the left edge of the image
-        // If it is the first or last line then test the whole line
-        int samp;
-        for (samp = 1; samp <= p_samples + 1; samp++) {
-
-          if (SetImage((double)samp - 0.5, (double)line - 0.5)) {
-            double radius = LocalRadius().meters();
-            double azimuth = UniversalLongitude();
-            if (radius < p_minRingRadius) p_minRingRadius = radius;
-            if (radius > p_maxRingRadius) p_maxRingRadius = radius;
-            if (azimuth < p_minRingLongitude) p_minRingLongitude = azimuth;
-            if (azimuth > p_maxRingLongitude) p_maxRingLongitude = azimuth;
-
-            if (azimuth > 180.0) azimuth -= 360.0;
-            if (azimuth < p_minRingLongitude180) p_minRingLongitude180 = azimuth;
-            if (azimuth > p_maxRingLongitude180) p_maxRingLongitude180 = azimuth;
+      if (p_rangeTolerance > 0.0) {
+        adaptiveRangeScan(true);
+      }
+      else {
+        // Loop for each line testing the left and right sides of the image
+        for (int line = 1; line <= p_lines + 1; line++) {
 
-            double res = PixelResolution();
-            if (res > 0.0) {
-              if (res < p_minres) p_minres = res;
-              if (res > p_maxres) p_maxres = res;
-            }
-            if ((line != 1) && (line != p_lines + 1)) break;
-          }
-        }
-        //We've already checked the first and last lines.
-        if (line == 1) continue;
-        if (line == p_lines + 1) continue;
+          // Look for the first good radius/azimuth on the left edge of the image
+          // If it is the first or last line then test the whole line
+          int samp;
+          for (samp = 1; samp <= p_samples + 1; samp++) {
 
-        // Look for the first good rad/azimuth on the right edge of the image
-        if (samp < p_samples + 1) {
-          for(samp = p_samples + 1; samp >= 1; samp--) {
             if (SetImage((double)samp - 0.5, (double)line - 0.5)) {
               double radius = LocalRadius().meters();
               double azimuth = UniversalLongitude();
@@ -1081,7 +1070,35 @@ namespace Isis {
                 if (res < p_minres) p_minres = res;
                 if (res > p_maxres) p_maxres = res;
               }
-              break;
+              if ((line != 1) && (line != p_lines + 1)) break;
+            }
+          }
+          //We've already checked the first and last lines.
+          if (line == 1) continue;
+          if (line == p_lines + 1) continue;
+
+          // Look for the first good rad/azimuth on the right edge of the image
+          if (samp < p_samples + 1) {
+            for(samp = p_samples + 1; samp >= 1; samp--) {
+              if (SetImage((double)samp - 0.5, (double)line - 0.5)) {
+                double radius = LocalRadius().meters();
+                double azimuth = UniversalLongitude();
+                if (radius < p_minRingRadius) p_minRingRadius = radius;
+                if (radius > p_maxRingRadius) p_maxRingRadius = radius;
+                if (azimuth < p_minRingLongitude) p_minRingLongitude = azimuth;
+                if (azimuth > p_maxRingLongitude) p_maxRingLongitude = azimuth;
+
+                if (azimuth > 180.0) azimuth -= 360.0;
+                if (azimuth < p_minRingLongitude180) p_minRingLongitude180 = azimuth;
+                if (azimuth > p_maxRingLongitude180) p_maxRingLongitude180 = azimuth;
+
+                double res = PixelResolution();
+                if (res > 0.0) {
+                  if (res < p_minres) p_minres = res;
+                  if (res > p_maxres) p_maxres = res;
+                }
+                break;
+              }
             }
           }
         }
@@ -1173,6 +1190,272 @@ namespace Isis {
   }
 
 
+  /**
+   * @brief Tests the edges of the image for the ground or ring range without
+   * testing every edge pixel
+   *
+   * The first and last lines are tested at every 32nd sample, and the first
+   * good points from the left and right sides of the image are found for every
+   * 32nd line in between. Each interval between tested points is split until
+   * the point in its middle is where a straight line between its ends puts
+   * it, to within the range tolerance. Intervals that cross the limb of the
+   * target are split down to single pixels, so the limb is found exactly.
+   *
+   * @param rings True to compute the ring range, false for the ground range
+   */
+  void Camera::adaptiveRangeScan(bool rings) {
+    // The number of pixels between the tested points before refining
+    const int step = 32;
+
+    // Test the whole first and last lines
+    for (int line = 1; line <= p_lines + 1; line += p_lines) {
+      int startSample = 1;
+      RangePoint start = rangePoint(0.5, line - 0.5, rings);
+
+      while (startSample < p_samples + 1) {
+        int endSample = min(startSample + step, p_samples + 1);
+        RangePoint end = rangePoint(endSample - 0.5, line - 0.5, rings);
+        refineRow(line, startSample, start, endSample, end, rings);
+
+        startSample = endSample;
+        start = end;
+      }
+    }
+
+    // Test the left and right sides of the lines in between
+    if (p_lines < 2) return;
+
+    int startLine = 2;
+    RangePoint start[2];
+    lineEdges(startLine, rings, start);
+
+    while (startLine < p_lines) {
+      int endLine = min(startLine + step, p_lines);
+      RangePoint end[2];
+      lineEdges(endLine, rings, end);
+      refineEdges(startLine, start, endLine, end, rings);
+
+      startLine = endLine;
+      start[0] = end[0];
+      start[1] = end[1];
+    }
+  }
+
+
+  /**
+   * @brief Tests the points of a line between two tested samples, where the
+   * ground does not change linearly between them
+   *
+   * @param line The line being tested
+   * @param startSample The first tested sample
+   * @param start The point at the first tested sample
+   * @param endSample The last tested sample
+   * @param end The point at the last tested sample
+   * @param rings True to compute the ring range, false for the ground range
+   */
+  void Camera::refineRow(int line, int startSample, const RangePoint &start,
+                         int endSample, const RangePoint &end, bool rings) {
+    if (endSample - startSample <= 1) return;
+
+    int middleSample = (startSample + endSample) / 2;
+    RangePoint middle = rangePoint(middleSample - 0.5, line - 0.5, rings);
+    double fraction = (double)(middleSample - startSample) / (endSample - startSample);
+
+    if (isLinear(start, middle, end, fraction, rings)) return;
+
+    refineRow(line, startSample, start, middleSample, middle, rings);
+    refineRow(line, middleSample, middle, endSample, end, rings);
+  }
+
+
+  /**
+   * @brief Tests the left and right sides of the lines between two tested
+   * lines, where the ground does not change linearly between them
+   *
+   * @param startLine The first tested line
+   * @param start The left and right points of the first tested line
+   * @param endLine The last tested line
+   * @param end The left and right points of the last tested line
+   * @param rings True to compute the ring range, false for the ground range
+   */
+  void Camera::refineEdges(int startLine, const RangePoint start[2],
+                           int endLine, const RangePoint end[2], bool rings) {
+    if (endLine - startLine <= 1) return;
+
+    int middleLine = (startLine + endLine) / 2;
+    RangePoint middle[2];
+    lineEdges(middleLine, rings, middle);
+    double fraction = (double)(middleLine - startLine) / (endLine - startLine);
+
+    if (isLinear(start[0], middle[0], end[0], fraction, rings) &&
+        isLinear(start[1], middle[1], end[1], fraction, rings)) {
+      return;
+    }
+
+    refineEdges(startLine, start, middleLine, middle, rings);
+    refineEdges(middleLine, middle, endLine, end, rings);
+  }
+
+
+  /**
+   * @brief Finds the first good points from the left and right sides of a
+   * line, the same way the full scan of the image edges does
+   *
+   * @param line The line to test
+   * @param rings True to compute the ring range, false for the ground range
+   * @param edges Returns the left and right points, which are not valid if
+   *              the line does not intersect the target
+   */
+  void Camera::lineEdges(int line, bool rings, RangePoint edges[2]) {
+    edges[0].valid = false;
+    edges[1].valid = false;
+
+    int samp;
+    for (samp = 1; samp <= p_samples + 1; samp++) {
+      edges[0] = rangePoint((double)samp - 0.5, (double)line - 0.5, rings);
+      if (edges[0].valid) break;
+    }
+
+    if (samp < p_samples + 1) {
+      for (samp = p_samples + 1; samp >= 1; samp--) {
+        edges[1] = rangePoint((double)samp - 0.5, (double)line - 0.5, rings);
+        if (edges[1].valid) break;
+      }
+    }
+  }
+
+
+  /**
+   * @brief Tests a point on the image and adds it to the ground or ring range
+   * and the resolution range
+   *
+   * @param sample The sample to test
+   * @param line The line to test
+   * @param rings True to compute the ring range, false for the ground range
+   *
+   * @return @b RangePoint The point on the target
+   */
+  Camera::RangePoint Camera::rangePoint(double sample, double line, bool rings) {
+    RangePoint point;
+    point.valid = SetImage(sample, line);
+    point.first = 0.0;
+    point.longitude = 0.0;
+
+    if (!point.valid) return point;
+
+    double lon = UniversalLongitude();
+    point.longitude = lon;
+
+    if (rings) {
+      double radius = LocalRadius().meters();
+      point.first = radius;
+      if (radius < p_minRingRadius) p_minRingRadius = radius;
+      if (radius > p_maxRingRadius) p_maxRingRadius = radius;
+      if (lon < p_minRingLongitude) p_minRingLongitude = lon;
+      if (lon > p_maxRingLongitude) p_maxRingLongitude = lon;
+
+      if (lon > 180.0) lon -= 360.0;
+      if (lon < p_minRingLongitude180) p_minRingLongitude180 = lon;
+      if (lon > p_maxRingLongitude180) p_maxRingLongitude180 = lon;
+    }
+    else {
+      double lat = UniversalLatitude();
+      point.first = lat;
+      if (lat < p_minlat) p_minlat = lat;
+      if (lat > p_maxlat) p_maxlat = lat;
+      if (lon < p_minlon) p_minlon = lon;
+      if (lon > p_maxlon) p_maxlon = lon;
+
+      if (lon > 180.0) lon -= 360.0;
+      if (lon < p_minlon180) p_minlon180 = lon;
+      if (lon > p_maxlon180) p_maxlon180 = lon;
+    }
+
+    double res = PixelResolution();
+    if (res > 0.0) {
+      if (res < p_minres) p_minres = res;
+      if (res > p_maxres) p_maxres = res;
+    }
+
+    if (!rings) {
+      //  Determine min/max oblique resolution
+      double obliqueres = ObliquePixelResolution();
+      if (obliqueres > 0.0) {
+        if (obliqueres < p_minobliqueres) p_minobliqueres = obliqueres;
+        if (obliqueres > p_maxobliqueres) p_maxobliqueres = obliqueres;
+      }
+    }
+
+    return point;
+  }
+
+
+  /**
+   * @brief Checks if the ground changes linearly between two tested points
+   *
+   * @param start The point at the start of the interval
+   * @param middle The point inside of the interval
+   * @param end The point at the end of the interval
+   * @param fraction How far into the interval the middle point is
+   * @param rings True if the points are ring radii and longitudes
+   *
+   * @return @b bool True if all of the points hit the target and the middle
+   *              point is within the range tolerance of the straight line
+   *              between the ends. Intervals that miss the target are never
+   *              linear, since the target may be hit between the points.
+   */
+  bool Camera::isLinear(const RangePoint &start, const RangePoint &middle,
+                        const RangePoint &end, double fraction, bool rings) const {
+    if (!start.valid || !middle.valid || !end.valid) return false;
+
+    double firstError = fabs(middle.first - (start.first + fraction * (end.first - start.first)));
+
+    // Compare ring radii as the angle they span at the middle radius
+    if (rings) {
+      if (middle.first <= 0.0) return false;
+      firstError = firstError / middle.first * RAD2DEG;
+    }
+
+    // Longitudes are compared across the 0/360 seam
+    double endDelta = end.longitude - start.longitude;
+    endDelta -= 360.0 * floor((endDelta + 180.0) / 360.0);
+    double middleDelta = middle.longitude - start.longitude;
+    middleDelta -= 360.0 * floor((middleDelta + 180.0) / 360.0);
+    double longitudeError = fabs(middleDelta - fraction * endDelta);
+
+    return firstError <= p_rangeTolerance && longitudeError <= p_rangeTolerance;
+  }
+
+
+  /**
+   * @brief Sets how closely the ground and ring ranges must match testing
+   * every pixel on the edges of the image
+   *
+   * With a tolerance of zero, every pixel on the first and last lines and the
+   * first good pixels from the left and right of every line are tested. With
+   * a positive tolerance, fewer pixels are tested where the ground changes
+   * linearly along the edges of the image. The default comes from the
+   * CameraRangeTolerance keyword of the Performance preferences group.
+   *
+   * @param tolerance The allowed error in degrees of latitude and longitude
+   */
+  void Camera::SetRangeTolerance(double tolerance) {
+    p_rangeTolerance = tolerance;
+    p_groundRangeComputed = false;
+    p_ringRangeComputed = false;
+  }
+
+
+  /**
+   * @brief Returns the allowed error of the ground and ring ranges
+   *
+   * @return @b double The tolerance in degrees
+   */
+  double Camera::RangeTolerance() const {
+    return p_rangeTolerance;
+  }
+
+
   /**
    * Checks whether the ground range intersects the longitude domain or not
    *
@@ -285,6 +285,8 @@ namespace Isis {
       bool ringRange(double &minRingRadius, double &maxRingRadius,
                      double &minRingLongitude, double &maxRingLongitude, Pvl &pvl);
       bool IntersectsLongitudeDomain(Pvl &pvl);
+      void SetRangeTolerance(double tolerance);
+      double RangeTolerance() const;
 
       double PixelResolution();
       double LineResolution();
@@ -511,8 +513,27 @@ namespace Isis {
 
 
     private:
+      /**
+       * A point on the edge of the image tested while computing the ground or
+       * ring range.
+       */
+      struct RangePoint {
+        bool valid;       //!< True if the point intersected the target
+        double first;     //!< The latitude, or the ring radius in meters
+        double longitude; //!< The longitude, or the ring longitude
+      };
+
       void GroundRangeResolution();
       void ringRangeResolution();
+      void adaptiveRangeScan(bool rings);
+      void refineRow(int line, int startSample, const RangePoint &start,
+                     int endSample, const RangePoint &end, bool rings);
+      void refineEdges(int startLine, const RangePoint start[2],
+                       int endLine, const RangePoint end[2], bool rings);
+      void lineEdges(int line, bool rings, RangePoint edges[2]);
+      RangePoint rangePoint(double sample, double line, bool rings);
+      bool isLinear(const RangePoint &start, const RangePoint &middle,
+                    const RangePoint &end, double fraction, bool rings) const;
       double ComputeAzimuth(const double lat, const double lon);
       bool RawFocalPlanetoImage();
       // SetImage helper functions: 
@@ -565,6 +586,8 @@ namespace Isis {
       double p_maxRingLongitude180;          //!< The maximum ring longitude in the 180 domain
       /** Flag showing if ring range was computed successfully.*/
       bool p_ringRangeComputed;
+      /** The allowed error, in degrees, of ground and ring ranges (0 tests every edge pixel)*/
+      double p_rangeTolerance;
 
       AlphaCube *p_alphaCube;                //!< A pointer to the AlphaCube
       double p_childSample;                  //!< Sample value for child
@@ -26,6 +26,7 @@
 
 
 
+#include "Brick.h"
 #include "Camera.h"
 #include "Cube.h"
 #include "IException.h"
@@ -957,12 +958,20 @@ namespace Isis {
    * @see GetReadInterpolator()
    * @internal
    *   @history 2010-06-15 Jeannie Walldren - Modified to allow any interpolator type except "None"
+   *   @history 2026-10-19 ISIS Development Team - Without a clipping polygon, the pixels are
+   *                           interpolated together from one tile of the cube.
    */
   void Chip::Read(Cube &cube, const int band) {
     // Create an interpolator and portal for geoming
     Interpolator interp(m_readInterpolator);
     Portal port(interp.Samples(), interp.Lines(), cube.pixelType(),
                 interp.HotSample(), interp.HotLine());
+
+    // Cube positions of the chip pixels that are interpolated from one tile
+    std::vector<int> pixels;
+    std::vector<double> samples;
+    std::vector<double> lines;
+
     // Loop through the pixels in the chip and geom them
     for (int line = 1; line <= Lines(); line++) {
       for (int samp = 1; samp <= Samples(); samp++) {
@@ -975,10 +984,9 @@ namespace Isis {
           m_buf[line-1][samp-1] = Isis::NULL8;
         }
         else if (m_clipPolygon == NULL) {
-          port.SetPosition(CubeSample(), CubeLine(), band);
-          cube.read(port);
-          m_buf[line-1][samp-1] =
-            interp.Interpolate(CubeSample(), CubeLine(), port.DoubleBuffer());
+          pixels.push_back((line - 1) * Samples() + samp - 1);
+          samples.push_back(CubeSample());
+          lines.push_back(CubeLine());
         }
         else {
           geos::geom::Point *pnt = globalFactory.createPoint(
@@ -996,6 +1004,39 @@ namespace Isis {
         }
       }
     }
+
+    if (pixels.empty()) {
+      return;
+    }
+
+    int count = (int) pixels.size();
+
+    // Find the cube tile that holds the interpolation windows of the pixels
+    int startSample, startLine, tileSamples, tileLines;
+    interp.TileExtent(&samples[0], &lines[0], count, startSample, startLine,
+                      tileSamples, tileLines);
+
+    std::vector<double> values(count);
+
+    // A chip that spreads thinly over the cube is read a pixel at a time
+    if ((double) tileSamples * tileLines > 4.0 * std::max(count, 1024)) {
+      for (int i = 0; i < count; i++) {
+        port.SetPosition(samples[i], lines[i], band);
+        cube.read(port);
+        values[i] = interp.Interpolate(samples[i], lines[i], port.DoubleBuffer());
+      }
+    }
+    else {
+      Brick tile(tileSamples, tileLines, 1, cube.pixelType());
+      tile.SetBasePosition(startSample, startLine, band);
+      cube.read(tile);
+      interp.Interpolate(&samples[0], &lines[0], count, tile.DoubleBuffer(),
+                         tileSamples, tileLines, startSample, startLine, &values[0]);
+    }
+
+    for (int i = 0; i < count; i++) {
+      m_buf[pixels[i] / Samples()][pixels[i] % Samples()] = values[i];
+    }
   }
 
 
@@ -98,6 +98,8 @@ namespace Isis {
    *   @history 2015-07-06 David Miller - Modified code to better reflect current Coding Standards.
    *                           Updated truth data. Fixes #2273
    *   @history 2017-08-30 Summer Stapleton - Updated documentation. References #4807.
+   *   @history 2026-10-19 ISIS Development Team - Read() reads one tile of the cube and
+   *                           interpolates the chip from it with the batch Interpolate.
    */
   class Chip {
     public:
@@ -23,6 +23,7 @@
 #include "IsisDebug.h"
 #include "Cube.h"
 
+#include <algorithm>
 #include <sstream>
 #include <unistd.h>
 
@@ -33,10 +34,14 @@
 #include <QMutex>
 
 #include "Application.h"
+#include "Brick.h"
 #include "Camera.h"
 #include "CameraFactory.h"
 #include "CubeAttribute.h"
 #include "CubeBsqHandler.h"
+#include "CubeCompressedTileHandler.h"
+#include "CubeMemoryHandler.h"
+#include "CubeOverviews.h"
 #include "CubeTileHandler.h"
 #include "Endian.h"
 #include "FileName.h"
@@ -47,6 +52,8 @@
 #include "Preference.h"
 #include "ProgramLauncher.h"
 #include "Projection.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
 #include "SpecialPixel.h"
 #include "Statistics.h"
 #include "TProjection.h"
@@ -175,8 +182,19 @@ namespace Isis {
    * removed/deleted.
    */
   void Cube::close(bool removeIt) {
-    if (isOpen() && isReadWrite())
+    if (isOpen() && isReadWrite()) {
+      // The tile index of compressed tiles is only known once every tile is written
+      if (m_format == CompressedTile && m_storesDnData && !removeIt) {
+        m_ioHandler->clearCache();
+        m_ioHandler->updateLabels(*m_label);
+      }
+
+      if (m_createOverviews && m_storesDnData && !removeIt) {
+        createOverviews(m_overviewSize);
+      }
+
       writeLabels();
+    }
 
     cleanUp(removeIt);
   }
@@ -484,6 +502,14 @@ namespace Isis {
       m_ioHandler = new CubeBsqHandler(dataFile(), m_virtualBandList, realDataFileLabel(),
                                        dataAlreadyOnDisk);
     }
+    else if (m_format == CompressedTile) {
+      m_ioHandler = new CubeCompressedTileHandler(dataFile(), m_virtualBandList,
+                                                  realDataFileLabel(), dataAlreadyOnDisk);
+    }
+    else if (m_storesDnData && CubeMemoryHandler::hasFile(dataFile()->fileName())) {
+      m_ioHandler = new CubeMemoryHandler(dataFile(), m_virtualBandList, realDataFileLabel(),
+                                          dataAlreadyOnDisk);
+    }
     else {
       m_ioHandler = new CubeTileHandler(dataFile(), m_virtualBandList, realDataFileLabel(),
                                         dataAlreadyOnDisk);
@@ -492,6 +518,12 @@ namespace Isis {
     if (m_storesDnData)
       m_ioHandler->updateLabels(*m_label);
 
+    // Overviews of a created cube are made when it is closed, if wanted
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    if (performancePrefs.hasKeyword("CubeOverviews")) {
+      m_createOverviews = (performancePrefs["CubeOverviews"][0].toUpper() == "ALWAYS");
+    }
+
     // Write the labels
     writeLabels();
   }
@@ -666,6 +698,14 @@ namespace Isis {
       m_ioHandler = new CubeBsqHandler(dataFile(), m_virtualBandList,
           realDataFileLabel(), true);
     }
+    else if (m_format == CompressedTile) {
+      m_ioHandler = new CubeCompressedTileHandler(dataFile(), m_virtualBandList,
+          realDataFileLabel(), true);
+    }
+    else if (m_storesDnData && CubeMemoryHandler::hasFile(dataFile()->fileName())) {
+      m_ioHandler = new CubeMemoryHandler(dataFile(), m_virtualBandList,
+          realDataFileLabel(), true);
+    }
     else {
       m_ioHandler = new CubeTileHandler(dataFile(), m_virtualBandList,
           realDataFileLabel(), true);
@@ -676,6 +716,7 @@ namespace Isis {
       dataLabel.second = NULL;
     }
 
+    openOverviews();
     applyVirtualBandsToLabel();
   }
 
@@ -754,6 +795,81 @@ namespace Isis {
   }
 
 
+  /**
+   * This method will read a buffer of data from the cube at a reduced
+   * resolution. The sample and line of the buffer are positions in the cube
+   * reduced by the reduction factor; a reduction of 2 makes a cube of 1000
+   * samples 500 samples wide. Each pixel is the average of the valid pixels
+   * of a reduction by reduction block of cube pixels, or NULL if there are
+   * none.
+   *
+   * The pixels come from the cube's overview with the reduction if it has
+   * one, which is much faster than reading the full resolution data. See
+   * createOverviews().
+   *
+   * @param bufferToFill Buffer to be loaded
+   * @param reduction The factor to reduce the cube by, 1 for full resolution
+   */
+  void Cube::read(Buffer &bufferToFill, int reduction) const {
+    if (!isOpen()) {
+      string msg = "Try opening a file before you read it";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (reduction < 1) {
+      QString msg = "The reduction [" + toString(reduction) + "] must be at least 1";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (reduction == 1) {
+      read(bufferToFill);
+      return;
+    }
+
+    int samples = bufferToFill.SampleDimension();
+    int lines = bufferToFill.LineDimension();
+
+    QList<int> virtualBands;
+    QList<int> physicalBands;
+    for (int band = 0; band < bufferToFill.BandDimension(); band++) {
+      int virtualBand = bufferToFill.Band(band * samples * lines);
+      bool inCube = (virtualBand >= 1 && virtualBand <= bandCount());
+      virtualBands.append(virtualBand);
+      physicalBands.append(inCube ? physicalBand(virtualBand) : 0);
+    }
+
+    // The overviews are replaced by writes, so check them under the lock
+    {
+      QMutexLocker locker(m_mutex);
+      if (m_overviews && m_overviews->hasReduction(reduction)) {
+        m_overviews->read(bufferToFill, reduction, physicalBands);
+        return;
+      }
+    }
+
+    // Without an overview the full resolution pixels are reduced the same way
+    Brick pixels(samples * reduction, reduction, 1, bufferToFill.PixelType());
+    for (int band = 0; band < bufferToFill.BandDimension(); band++) {
+      for (int line = 0; line < lines; line++) {
+        double *reduced = bufferToFill.DoubleBuffer() + (band * lines + line) * samples;
+
+        if (physicalBands[band] == 0) {
+          for (int i = 0; i < samples; i++) {
+            reduced[i] = Null;
+          }
+          continue;
+        }
+
+        pixels.SetBasePosition((bufferToFill.Sample() - 1) * reduction + 1,
+                               (bufferToFill.Line() + line - 1) * reduction + 1,
+                               virtualBands[band]);
+        read(pixels);
+        CubeOverviews::reduce(pixels.DoubleBuffer(), samples, reduction, reduced);
+      }
+    }
+  }
+
+
   /**
    * This method will write a blob of data (e.g. History, Table, etc)
    * to the cube as specified by the contents of the Blob object.
@@ -849,6 +965,21 @@ namespace Isis {
     }
 
     QMutexLocker locker(m_mutex);
+
+    // Overviews no longer match DN data that changes, so they are made again
+    // at the same sizes when the cube is closed
+    if (m_overviews) {
+      QList<int> reductions = m_overviews->reductions();
+      if (!reductions.isEmpty()) {
+        int coarsest = reductions.last();
+        m_overviewSize = max(CubeOverviews::reducedSize(sampleCount(), coarsest),
+                             CubeOverviews::reducedSize(lineCount(), coarsest));
+      }
+      delete m_overviews;
+      m_overviews = NULL;
+      m_createOverviews = true;
+    }
+
     m_ioHandler->write(bufferToWrite);
   }
 
@@ -976,7 +1107,7 @@ namespace Isis {
    * either band, sequential or tiled.
    * If not invoked, a tiled file will be created.
    *
-   * @param format An enumeration of either Bsq or Tile.
+   * @param format An enumeration of Bsq, Tile or CompressedTile.
    */
   void Cube::setFormat(Format format) {
     openCheck();
@@ -1551,6 +1682,88 @@ namespace Isis {
   }
 
 
+  /**
+   * Makes overviews of the cube, copies of its DN data at reduced resolution,
+   * so that read(Buffer &, int) can read them instead of the full resolution
+   * data. The cube is reduced by 2, 4, 8 and so on until the coarsest
+   * overview is no larger than minimumSize in either direction. Existing
+   * overviews are replaced.
+   *
+   * The overviews are written after the DN data of a cube with attached
+   * labels, or to a file with the extension .ovr next to detached labels.
+   * The labels describe them once the cube is closed.
+   *
+   * @param minimumSize The largest size of the coarsest overview
+   */
+  void Cube::createOverviews(int minimumSize) {
+    if (!isOpen()) {
+      string msg = "The cube is not opened so overviews can't be created";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (!isReadWrite() || !m_storesDnData) {
+      QString msg = "Overviews can only be created for a cube that stores its DN data and is "
+                    "opened in read/write mode [" + fileName() + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    delete m_overviews;
+    m_overviews = NULL;
+
+    // Everything written so far must be on disk to know where the data ends
+    m_ioHandler->clearCache();
+    dataFile()->flush();
+    m_labelFile->flush();
+
+    QString overviewFile;
+    BigInt startByte = 0;
+    if (m_attached) {
+      overviewFile = m_labelFileName->expanded();
+      BigInt dataEnd = (BigInt)m_labelBytes + m_ioHandler->getDataSize();
+      startByte = max((BigInt)QFileInfo(overviewFile).size(), dataEnd);
+
+      // Replace old overviews in place if nothing follows them
+      if (m_label->hasObject("Overviews")) {
+        const PvlObject &oldOverviews = m_label->findObject("Overviews");
+        BigInt oldStart = toBigInt(oldOverviews["StartByte"][0]) - 1;
+        BigInt oldBytes = toBigInt(oldOverviews["Bytes"][0]);
+        if (oldStart >= dataEnd && oldStart + oldBytes == startByte) {
+          startByte = oldStart;
+        }
+      }
+    }
+    else {
+      overviewFile = m_labelFileName->removeExtension().addExtension("ovr").expanded();
+      QFile::remove(overviewFile);
+    }
+
+    PvlObject overviews = CubeOverviews::write(*this, overviewFile, startByte, minimumSize);
+
+    if (m_label->hasObject("Overviews")) {
+      m_label->deleteObject("Overviews");
+    }
+
+    if (overviews.groups() > 0) {
+      if (!m_attached) {
+        overviews.addKeyword(PvlKeyword("^Overviews", FileName(overviewFile).name()));
+      }
+      m_label->addObject(overviews);
+      openOverviews();
+    }
+  }
+
+
+  /**
+   * @return The reductions that the cube has overviews for, finest first
+   */
+  QList<int> Cube::overviewReductions() const {
+    if (m_overviews) {
+      return m_overviews->reductions();
+    }
+    return QList<int>();
+  }
+
+
   /**
    * This will add the given caching algorithm to the list of attempted caching
    *   algorithms. The algorithms are tried in the opposite order that they
@@ -1741,6 +1954,11 @@ namespace Isis {
       m_ioHandler = NULL;
     }
 
+    delete m_overviews;
+    m_overviews = NULL;
+    m_createOverviews = false;
+    m_overviewSize = 256;
+
     // Always remove a temporary file
     if (m_tempCube) {
       QFile::remove(m_tempCube->expanded());
@@ -1751,7 +1969,11 @@ namespace Isis {
     }
 
     if (removeIt) {
+      CubeMemoryHandler::discard(m_dataFileName->expanded());
       QFile::remove(m_labelFileName->expanded());
+      if (!m_attached) {
+        QFile::remove(m_labelFileName->removeExtension().addExtension("ovr").expanded());
+      }
 
       if (*m_labelFileName != *m_dataFileName)
         QFile::remove(m_dataFileName->expanded());
@@ -1800,6 +2022,10 @@ namespace Isis {
 
     m_virtualBandList = NULL;
 
+    m_overviews = NULL;
+    m_createOverviews = false;
+    m_overviewSize = 256;
+
     m_mutex = new QMutex();
     m_formatTemplateFile =
          new FileName("$base/templates/labels/CubeFormatTemplate.pft");
@@ -1940,6 +2166,9 @@ namespace Isis {
       if ((QString) core["Format"] == "BandSequential") {
         m_format = Bsq;
       }
+      else if ((QString) core["Format"] == "CompressedTile") {
+        m_format = CompressedTile;
+      }
       else {
         m_format = Tile;
       }
@@ -2067,6 +2296,37 @@ namespace Isis {
   }
 
 
+  /**
+   * Opens the overviews that the labels describe. A cube whose overviews
+   * can't be opened is read as if it had none.
+   */
+  void Cube::openOverviews() {
+    delete m_overviews;
+    m_overviews = NULL;
+
+    if (!m_label->hasObject("Overviews")) {
+      return;
+    }
+
+    const PvlObject &overviews = m_label->findObject("Overviews");
+    FileName overviewFile = *m_labelFileName;
+    if (overviews.hasKeyword("^Overviews")) {
+      overviewFile = FileName(m_labelFileName->path() + "/" +
+                              overviews["^Overviews"][0]);
+    }
+    else if (!m_attached) {
+      return;
+    }
+
+    try {
+      m_overviews = new CubeOverviews(overviewFile.expanded(), overviews);
+    }
+    catch (IException &) {
+      m_overviews = NULL;
+    }
+  }
+
+
   /**
    * Throw an exception if the cube is not open.
    */
@@ -42,6 +42,7 @@ namespace Isis {
   class CubeAttributeOutput;
   class CubeCachingAlgorithm;
   class CubeIoHandler;
+  class CubeOverviews;
   class FileName;
   class Projection;
   class Pvl;
@@ -166,6 +167,15 @@ namespace Isis {
    *                           an IsisPreference file cannot be found. Fixes #5145.
    *   @history 2018-11-16 Jesse Mapel - Made several methods virtual for mocking.
    *   @history 2019-06-15 Kristin Berry - Added latLonRange method to return the valid lat/lon rage of the cube. The values in the mapping group are not sufficiently accurate for some purposes. 
+   *   @history 2026-10-19 ISIS Development Team - Added the CompressedTile format.
+   *   @history 2026-10-19 ISIS Development Team - Added overviews, reduced resolution copies of
+   *                           the DN data. Added createOverviews(), overviewReductions() and
+   *                           read(Buffer &, int), which reads a buffer at a reduction. Cubes
+   *                           that are created get overviews when they are closed if the
+   *                           CubeOverviews preference is Always.
+   *   @history 2026-10-19 ISIS Development Team - Writing to a cube with overviews now stops
+   *                           reads from using them and makes them again when the cube is
+   *                           closed, so they never hold stale DN data.
    */
   class Cube {
     public:
@@ -231,7 +241,14 @@ namespace Isis {
          * The symbol '*' denotes tile boundaries.
          * The symbols '-' and '|' denote cube boundaries.
          */
-        Tile
+        Tile,
+        /**
+         * Cubes are stored in compressed tiles. The tiles are laid out like
+         *   the Tile format, but each tile is compressed on its own and its
+         *   position in the file is kept in a tile index. Tiles that are
+         *   entirely NULL take no space. See CubeCompressedTileHandler.
+         */
+        CompressedTile
       };
 
       bool isOpen() const;
@@ -249,6 +266,7 @@ namespace Isis {
 
       void read(Blob &blob) const;
       void read(Buffer &rbuf) const;
+      void read(Buffer &rbuf, int reduction) const;
       void write(Blob &blob);
       void write(Buffer &wbuf);
 
@@ -294,6 +312,9 @@ namespace Isis {
                              QString msg = "Gathering statistics");
       bool storesDnData() const;
 
+      void createOverviews(int minimumSize = 256);
+      QList<int> overviewReductions() const;
+
       void addCachingAlgorithm(CubeCachingAlgorithm *);
       void clearIoCache();
       bool deleteBlob(QString BlobType, QString BlobName);
@@ -316,6 +337,7 @@ namespace Isis {
       void initialize();
       void initCoreFromLabel(const Pvl &label);
       void initLabelFromFile(FileName labelFileName, bool readWrite);
+      void openOverviews();
       void openCheck();
       Pvl realDataFileLabel() const;
       void reformatOldIsisLabel(const QString &oldCube);
@@ -429,6 +451,15 @@ namespace Isis {
 
       //! If allocated, converts from physical on-disk band # to virtual band #
       QList<int> *m_virtualBandList;
+
+      //! The overviews of the open cube, if it has any
+      CubeOverviews *m_overviews;
+
+      //! True if overviews are made when the cube is closed
+      bool m_createOverviews;
+
+      //! The largest size of the coarsest overview made when the cube is closed
+      int m_overviewSize;
   };
 }
 
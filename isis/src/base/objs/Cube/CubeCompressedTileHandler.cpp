@@ -0,0 +1,427 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "CubeCompressedTileHandler.h"
+
+#include <algorithm>
+
+#include <QDataStream>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
+#include "Endian.h"
+#include "IException.h"
+#include "IString.h"
+#include "Pvl.h"
+#include "PvlObject.h"
+#include "PvlKeyword.h"
+#include "RawCubeChunk.h"
+
+using namespace std;
+
+namespace Isis {
+  namespace {
+    /**
+     * @param data The first byte of a 16 bit pixel
+     * @param msb True if the most significant byte comes first
+     *
+     * @return The pixel as an unsigned value
+     */
+    inline quint16 readPixel(const char *data, bool msb) {
+      quint16 first = (unsigned char)data[0];
+      quint16 second = (unsigned char)data[1];
+      return msb ? (quint16)((first << 8) | second) :
+                   (quint16)((second << 8) | first);
+    }
+
+
+    /**
+     * @param data The first byte of a 16 bit pixel
+     * @param value The pixel as an unsigned value
+     * @param msb True if the most significant byte comes first
+     */
+    inline void writePixel(char *data, quint16 value, bool msb) {
+      data[msb ? 0 : 1] = (char)(value >> 8);
+      data[msb ? 1 : 0] = (char)(value & 0xff);
+    }
+  }
+
+
+  /**
+   * Construct a compressed tile handler. New cubes get tiles of up to 256 by
+   *   256 pixels; tiles that do not divide the cube only cost a few bytes of
+   *   compressed NULLs.
+   *
+   * @param dataFile The file with cube DN data in it
+   * @param virtualBandList The mapping from virtual band to physical band, see
+   *          CubeIoHandler's description.
+   * @param labels The Pvl labels for the cube
+   * @param alreadyOnDisk True if the cube is allocated on the disk, false
+   *          otherwise
+   */
+  CubeCompressedTileHandler::CubeCompressedTileHandler(QFile * dataFile,
+      const QList<int> *virtualBandList, const Pvl &labels, bool alreadyOnDisk)
+      : CubeIoHandler(dataFile, virtualBandList, labels, alreadyOnDisk) {
+
+    const PvlObject &core = labels.findObject("IsisCube").findObject("Core");
+    const PvlGroup &pixelGroup = core.findGroup("Pixels");
+
+    m_msb = (ByteOrderEnumeration(pixelGroup["ByteOrder"]) == Msb);
+    m_predict = (pixelType() == SignedWord || pixelType() == UnsignedWord);
+    if (core.hasKeyword("Predictor")) {
+      m_predict = ((QString)core["Predictor"] == "Horizontal");
+    }
+
+    m_indexChanged = false;
+    m_indexStartByte = -1;
+    m_dataEndByte = getDataStartByte();
+
+    if (core.hasKeyword("TileSamples")) {
+      setChunkSizes(core["TileSamples"], core["TileLines"], 1);
+    }
+    else {
+      setChunkSizes(min(256, sampleCount()), min(256, lineCount()), 1);
+    }
+
+    TileLocation nullTile;
+    nullTile.startByte = 0;
+    nullTile.bytes = 0;
+    m_tiles.fill(nullTile, getChunkCountInSampleDimension() *
+                           getChunkCountInLineDimension() *
+                           getChunkCountInBandDimension());
+
+    if (alreadyOnDisk) {
+      readIndex(labels);
+    }
+  }
+
+
+  /**
+   * Writes all data from memory to disk.
+   */
+  CubeCompressedTileHandler::~CubeCompressedTileHandler() {
+    clearCache();
+    finishPendingTiles(0);
+  }
+
+
+  /**
+   * @return The number of bytes used by the compressed tiles and the tile
+   *   index, including the space of tiles that were written again
+   */
+  BigInt CubeCompressedTileHandler::getDataSize() const {
+    return m_dataEndByte - getDataStartByte();
+  }
+
+
+  /**
+   * Update the cube labels with the tile size, the compression and the
+   *   location of the tile index. The tile index is written first if tiles
+   *   were written since it was last written, so the cache must be cleared
+   *   before this is called for the labels to describe every tile.
+   *
+   * @param labels The "Core" object in this Pvl will be updated
+   */
+  void CubeCompressedTileHandler::updateLabels(Pvl &labels) {
+    if (m_indexChanged || !m_pendingTiles.isEmpty()) {
+      writeIndex();
+    }
+
+    PvlObject &core = labels.findObject("IsisCube").findObject("Core");
+    core.addKeyword(PvlKeyword("Format", "CompressedTile"),
+                    PvlContainer::Replace);
+    core.addKeyword(PvlKeyword("TileSamples", toString(getSampleCountInChunk())),
+                    PvlContainer::Replace);
+    core.addKeyword(PvlKeyword("TileLines", toString(getLineCountInChunk())),
+                    PvlContainer::Replace);
+    core.addKeyword(PvlKeyword("Compression", "Zlib"),
+                    PvlContainer::Replace);
+    core.addKeyword(PvlKeyword("Predictor", m_predict ? "Horizontal" : "None"),
+                    PvlContainer::Replace);
+
+    if (m_indexStartByte >= 0) {
+      // Start bytes are 1-based, like StartByte
+      core.addKeyword(PvlKeyword("TileIndexStartByte",
+                                 toString(m_indexStartByte + 1)),
+                      PvlContainer::Replace);
+      core.addKeyword(PvlKeyword("TileIndexBytes",
+                                 toString((BigInt)m_tiles.size() * 16)),
+                      PvlContainer::Replace);
+    }
+  }
+
+
+  void CubeCompressedTileHandler::readRaw(RawCubeChunk &chunkToFill) {
+    int index = getChunkIndex(chunkToFill);
+
+    foreach (const PendingTile &pending, m_pendingTiles) {
+      if (pending.index == index) {
+        finishPendingTiles(0);
+        break;
+      }
+    }
+
+    const TileLocation &tile = m_tiles[index];
+    if (tile.bytes == 0) {
+      chunkToFill.setRawData(nullChunkData());
+      return;
+    }
+
+    QFile * dataFile = getDataFile();
+    QByteArray encoded;
+    if (dataFile->seek(tile.startByte)) {
+      encoded = dataFile->read(tile.bytes);
+    }
+
+    if (encoded.size() != tile.bytes) {
+      IString msg = "Reading from the file [" + dataFile->fileName() + "] "
+          "failed with reading [" + QString::number(tile.bytes) +
+          "] bytes at position [" + QString::number(tile.startByte) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    QByteArray rawData = qUncompress(encoded);
+    if (rawData.size() != chunkToFill.getByteCount()) {
+      IString msg = "Decompressing the tile at position [" +
+          QString::number(tile.startByte) + "] of the file [" +
+          dataFile->fileName() + "] failed";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    if (m_predict) {
+      decodePredictor(rawData, m_msb, getSampleCountInChunk());
+    }
+
+    chunkToFill.setRawData(rawData);
+  }
+
+
+  void CubeCompressedTileHandler::writeRaw(const RawCubeChunk &chunkToWrite) {
+    int index = getChunkIndex(chunkToWrite);
+    const QByteArray &rawData = chunkToWrite.getRawData();
+
+    if (rawData == nullChunkData()) {
+      // An older copy still being compressed must not replace the NULLs
+      for (int i = m_pendingTiles.size() - 1; i >= 0; i--) {
+        if (m_pendingTiles[i].index == index) {
+          m_pendingTiles.removeAt(i);
+        }
+      }
+
+      m_tiles[index].startByte = 0;
+      m_tiles[index].bytes = 0;
+      m_indexChanged = true;
+      return;
+    }
+
+    // The chunk writes into its buffer directly, so compress a deep copy
+    PendingTile pending;
+    pending.index = index;
+    pending.encoded = QtConcurrent::run(&CubeCompressedTileHandler::encodeTile,
+                                        QByteArray(rawData.constData(),
+                                                   rawData.size()),
+                                        m_predict, m_msb,
+                                        getSampleCountInChunk());
+    m_pendingTiles.append(pending);
+
+    finishPendingTiles(2 * QThreadPool::globalInstance()->maxThreadCount());
+  }
+
+
+  /**
+   * Compress a tile. This is run on the global thread pool.
+   *
+   * @param rawData The tile in file byte order
+   * @param predict True to apply the horizontal predictor to 16 bit pixels
+   * @param msb True if the most significant byte comes first
+   * @param samplesPerLine The number of samples in a line of the tile
+   *
+   * @return The compressed tile
+   */
+  QByteArray CubeCompressedTileHandler::encodeTile(QByteArray rawData,
+      bool predict, bool msb, int samplesPerLine) {
+    if (predict) {
+      // Replace every pixel but the first of each line with its difference
+      //   from the pixel before it, so smooth data compresses better
+      char *data = rawData.data();
+      int lineBytes = 2 * samplesPerLine;
+
+      for (int line = 0; line < rawData.size() / lineBytes; line++) {
+        char *lineData = data + line * lineBytes;
+
+        for (int sample = samplesPerLine - 1; sample > 0; sample--) {
+          quint16 difference = readPixel(lineData + 2 * sample, msb) -
+                               readPixel(lineData + 2 * (sample - 1), msb);
+          writePixel(lineData + 2 * sample, difference, msb);
+        }
+      }
+    }
+
+    return qCompress(rawData);
+  }
+
+
+  /**
+   * Undo the horizontal predictor applied by encodeTile().
+   *
+   * @param rawData The decompressed tile, which is restored in place
+   * @param msb True if the most significant byte comes first
+   * @param samplesPerLine The number of samples in a line of the tile
+   */
+  void CubeCompressedTileHandler::decodePredictor(QByteArray &rawData,
+      bool msb, int samplesPerLine) {
+    char *data = rawData.data();
+    int lineBytes = 2 * samplesPerLine;
+
+    for (int line = 0; line < rawData.size() / lineBytes; line++) {
+      char *lineData = data + line * lineBytes;
+
+      for (int sample = 1; sample < samplesPerLine; sample++) {
+        quint16 value = readPixel(lineData + 2 * sample, msb) +
+                        readPixel(lineData + 2 * (sample - 1), msb);
+        writePixel(lineData + 2 * sample, value, msb);
+      }
+    }
+  }
+
+
+  /**
+   * Write data at the end of the data file. Blobs may have been written
+   *   after the last tile, so the end of the file is used rather than the end
+   *   of the tiles.
+   *
+   * @param data The bytes to write
+   *
+   * @return The 0-based position of the data in the file
+   */
+  BigInt CubeCompressedTileHandler::append(const QByteArray &data) {
+    QFile * dataFile = getDataFile();
+    BigInt startByte = max((BigInt)dataFile->size(), getDataStartByte());
+
+    // Blobs are written with another stream, so they must see these bytes
+    if (!dataFile->seek(startByte) ||
+        dataFile->write(data) != data.size() || !dataFile->flush()) {
+      IString msg = "Writing to the file [" + dataFile->fileName() + "] "
+          "failed with writing [" + QString::number(data.size()) +
+          "] bytes at position [" + QString::number(startByte) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    m_dataEndByte = max(m_dataEndByte, startByte + data.size());
+    return startByte;
+  }
+
+
+  /**
+   * Write compressed tiles to the file, oldest first, until no more than the
+   *   given number are still being compressed.
+   *
+   * @param maxPending The number of tiles that may still be compressing
+   */
+  void CubeCompressedTileHandler::finishPendingTiles(int maxPending) {
+    while (m_pendingTiles.size() > maxPending) {
+      PendingTile pending = m_pendingTiles.takeFirst();
+      QByteArray encoded = pending.encoded.result();
+
+      m_tiles[pending.index].startByte = append(encoded);
+      m_tiles[pending.index].bytes = encoded.size();
+      m_indexChanged = true;
+    }
+  }
+
+
+  /**
+   * Read the tile index located by the labels. Without the TileIndexStartByte
+   *   keyword every tile is NULL.
+   *
+   * @param labels The Pvl labels for the cube
+   */
+  void CubeCompressedTileHandler::readIndex(const Pvl &labels) {
+    const PvlObject &core = labels.findObject("IsisCube").findObject("Core");
+    if (!core.hasKeyword("TileIndexStartByte")) {
+      return;
+    }
+
+    BigInt startByte = toBigInt(core["TileIndexStartByte"][0]) - 1;
+    BigInt bytes = toBigInt(core["TileIndexBytes"][0]);
+
+    QFile * dataFile = getDataFile();
+    if (bytes != (BigInt)m_tiles.size() * 16) {
+      IString msg = "The tile index of the file [" + dataFile->fileName() +
+          "] has [" + QString::number(bytes) + "] bytes, but [" +
+          QString::number(m_tiles.size()) + "] tiles need [" +
+          QString::number((BigInt)m_tiles.size() * 16) + "] bytes";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    QByteArray index;
+    if (dataFile->seek(startByte)) {
+      index = dataFile->read(bytes);
+    }
+
+    if (index.size() != bytes) {
+      IString msg = "Reading from the file [" + dataFile->fileName() + "] "
+          "failed with reading [" + QString::number(bytes) +
+          "] bytes at position [" + QString::number(startByte) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    QDataStream stream(index);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    for (int i = 0; i < m_tiles.size(); i++) {
+      qint64 tileStartByte;
+      qint64 tileBytes;
+      stream >> tileStartByte >> tileBytes;
+
+      m_tiles[i].startByte = tileStartByte;
+      m_tiles[i].bytes = tileBytes;
+      m_dataEndByte = max(m_dataEndByte, (BigInt)(tileStartByte + tileBytes));
+    }
+
+    m_indexStartByte = startByte;
+    m_dataEndByte = max(m_dataEndByte, startByte + bytes);
+  }
+
+
+  /**
+   * Finish the pending tiles and write the tile index at the end of the data
+   *   file.
+   */
+  void CubeCompressedTileHandler::writeIndex() {
+    QMutexLocker locker(dataFileMutex());
+    finishPendingTiles(0);
+
+    QByteArray index;
+    QDataStream stream(&index, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    foreach (const TileLocation &tile, m_tiles) {
+      stream << (qint64)tile.startByte << (qint64)tile.bytes;
+    }
+
+    m_indexStartByte = append(index);
+    m_indexChanged = false;
+  }
+}
@@ -0,0 +1,129 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#ifndef CubeCompressedTileHandler_h
+#define CubeCompressedTileHandler_h
+
+#include "CubeIoHandler.h"
+
+#include <QByteArray>
+#include <QFuture>
+#include <QList>
+#include <QVector>
+
+namespace Isis {
+
+  /**
+   * @brief IO Handler for Isis Cubes using the compressed tile format.
+   *
+   * The cube is divided into tiles like CubeTileHandler does, but each tile
+   * is compressed with zlib on its own and appended to the data file. Tiles
+   * of 16 bit pixels are run through a horizontal difference predictor
+   * first. Tiles that are entirely NULL take no space in the file at all.
+   *
+   * The position and compressed size of every tile is kept in a tile index,
+   * which is written to the data file when the cube is closed. The Core
+   * object of the labels locates the index with the TileIndexStartByte and
+   * TileIndexBytes keywords, so any tile can be read without reading the
+   * others.
+   *
+   * Tiles are compressed on the global thread pool while the next tiles are
+   * being written. A tile that is written again is appended again; the space
+   * of the old copy is not reused.
+   *
+   * @ingroup LowLevelCubeIO
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class CubeCompressedTileHandler : public CubeIoHandler {
+    public:
+      CubeCompressedTileHandler(QFile * dataFile,
+          const QList<int> *virtualBandList, const Pvl &label,
+          bool alreadyOnDisk);
+      ~CubeCompressedTileHandler();
+
+      BigInt getDataSize() const;
+      void updateLabels(Pvl &label);
+
+    protected:
+      virtual void readRaw(RawCubeChunk &chunkToFill);
+      virtual void writeRaw(const RawCubeChunk &chunkToWrite);
+
+    private:
+      /**
+       * Disallow copying of this object.
+       *
+       * @param other The object to copy.
+       */
+      CubeCompressedTileHandler(const CubeCompressedTileHandler &other);
+
+      /**
+       * Disallow assignments of this object
+       *
+       * @param other The CubeCompressedTileHandler on the right-hand side of
+       *              the assignment that we are copying into *this.
+       * @return A reference to *this.
+       */
+      CubeCompressedTileHandler &operator=(
+          const CubeCompressedTileHandler &other);
+
+      /**
+       * Where a tile is in the data file. A tile with no bytes is all NULL.
+       */
+      struct TileLocation {
+        BigInt startByte; //!< The 0-based position of the tile in the file
+        BigInt bytes;     //!< The number of compressed bytes
+      };
+
+      /**
+       * A tile that is being compressed on the global thread pool.
+       */
+      struct PendingTile {
+        int index;                     //!< The chunk index of the tile
+        QFuture<QByteArray> encoded;   //!< The compressed tile
+      };
+
+      static QByteArray encodeTile(QByteArray rawData, bool predict, bool msb,
+                                   int samplesPerLine);
+      static void decodePredictor(QByteArray &rawData, bool msb,
+                                  int samplesPerLine);
+
+      BigInt append(const QByteArray &data);
+      void finishPendingTiles(int maxPending);
+      void readIndex(const Pvl &label);
+      void writeIndex();
+
+      bool m_predict;  //!< True if the horizontal predictor is used
+      bool m_msb;      //!< True if the pixels are most significant byte first
+
+      QVector<TileLocation> m_tiles;     //!< The tile index by chunk index
+      QList<PendingTile> m_pendingTiles; //!< The tiles still being compressed
+      bool m_indexChanged;    //!< True if tiles were written since writeIndex()
+      BigInt m_indexStartByte;//!< The 0-based position of the index, or -1
+      BigInt m_dataEndByte;   //!< The end of the tiles and index in the file
+  };
+}
+
+#endif
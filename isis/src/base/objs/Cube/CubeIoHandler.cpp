@@ -446,6 +446,20 @@ namespace Isis {
   }
 
 
+  /**
+   * @return The raw data of a chunk that is entirely NULL, in file byte
+   *   order. Formats can compare written chunks with this.
+   */
+  const QByteArray &CubeIoHandler::nullChunkData() const {
+    if(!m_nullChunkData) {
+      // Creating a null chunk remembers its data
+      delete getNullChunk(0);
+    }
+
+    return *m_nullChunkData;
+  }
+
+
   /**
    * This changes the virtual band list.
    *
@@ -31,6 +31,7 @@
 #include "Endian.h"
 #include "PixelType.h"
 
+class QByteArray;
 class QFile;
 class QMutex;
 class QTime;
@@ -121,6 +122,9 @@ namespace Isis {
    *                            References #971.
    *   @history 2018-08-13 Summer Stapleton - Fixed incoming buffer comparison values for 
    *                            unsigned int type in writeIntoRaw(...). 
+   *   @history 2026-10-19 ISIS Development Team - getDataSize() is now virtual for
+   *                            formats that do not store fixed size chunks. Added
+   *                            nullChunkData().
    */
   class CubeIoHandler {
     public:
@@ -133,7 +137,7 @@ namespace Isis {
 
       void addCachingAlgorithm(CubeCachingAlgorithm *algorithm);
       void clearCache(bool blockForWriteCache = true) const;
-      BigInt getDataSize() const;
+      virtual BigInt getDataSize() const;
       void setVirtualBands(const QList<int> *virtualBandList);
       /**
        * Function to update the labels with a Pvl object
@@ -159,6 +163,7 @@ namespace Isis {
       PixelType pixelType() const;
       int sampleCount() const;
       int getSampleCountInChunk() const;
+      const QByteArray &nullChunkData() const;
 
       void setChunkSizes(int numSamples, int numLines, int numBands);
 
@@ -0,0 +1,307 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "CubeMemoryHandler.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include "FileName.h"
+#include "IException.h"
+#include "IString.h"
+#include "Preference.h"
+#include "PvlGroup.h"
+#include "RawCubeChunk.h"
+
+using namespace std;
+
+namespace Isis {
+  namespace {
+    /**
+     * The DN data of the files added to CubeMemoryHandler. Chunks of each file
+     *   are keyed by the position they would have in the file.
+     */
+    struct MemoryStore {
+      //! Creates an empty store
+      MemoryStore() : bytes(0) {
+      }
+
+      QMutex mutex; //!< Guards the store
+      QHash< QString, QHash<BigInt, QByteArray> > files; //!< Chunks by file
+      BigInt bytes; //!< The number of bytes of chunk data held
+    };
+
+
+    /**
+     * @return The store shared by all of the memory handlers in this process
+     */
+    MemoryStore &memoryStore() {
+      static MemoryStore store;
+      return store;
+    }
+  }
+
+
+  /**
+   * Construct a memory handler. The chunk sizes are chosen the same way
+   *   CubeTileHandler chooses them, so the labels and any chunks written to
+   *   disk match a tiled cube.
+   *
+   * @param dataFile The file with cube DN data in it
+   * @param virtualBandList The mapping from virtual band to physical band, see
+   *          CubeIoHandler's description.
+   * @param labels The Pvl labels for the cube
+   * @param alreadyOnDisk True if the cube is allocated on the disk, false
+   *          otherwise
+   */
+  CubeMemoryHandler::CubeMemoryHandler(QFile * dataFile,
+      const QList<int> *virtualBandList, const Pvl &labels, bool alreadyOnDisk)
+      : CubeTileHandler(dataFile, virtualBandList, labels, alreadyOnDisk) {
+    m_storeKey = storeKey(dataFile->fileName());
+
+    int megabytes = 1024;
+    PvlGroup &performancePrefs =
+        Preference::Preferences().findGroup("Performance");
+    if (performancePrefs.hasKeyword("IntermediateCubeMemory")) {
+      megabytes = toInt(performancePrefs["IntermediateCubeMemory"][0]);
+    }
+    m_memoryLimit = (BigInt)megabytes * 1024 * 1024;
+
+    // A new cube replaces whatever was kept for the file before
+    if (!alreadyOnDisk) {
+      discard(m_storeKey);
+    }
+  }
+
+
+  /**
+   * Writes all data from the cache to the store. This must be done here because
+   *   the parent destructor can no longer reach our writeRaw().
+   */
+  CubeMemoryHandler::~CubeMemoryHandler() {
+    clearCache();
+  }
+
+
+  /**
+   * Keep the DN data of cubes created in the given file in memory from now on.
+   *
+   * @param fileName The cube file
+   */
+  void CubeMemoryHandler::addFile(const QString &fileName) {
+    MemoryStore &store = memoryStore();
+    QMutexLocker locker(&store.mutex);
+
+    QString key = storeKey(fileName);
+    if (!store.files.contains(key)) {
+      store.files.insert(key, QHash<BigInt, QByteArray>());
+    }
+  }
+
+
+  /**
+   * Stop keeping the DN data of the given file in memory and release the DN
+   *   data that was kept. The file itself is not touched.
+   *
+   * @param fileName The cube file
+   */
+  void CubeMemoryHandler::removeFile(const QString &fileName) {
+    discard(fileName);
+
+    MemoryStore &store = memoryStore();
+    QMutexLocker locker(&store.mutex);
+    store.files.remove(storeKey(fileName));
+  }
+
+
+  /**
+   * @param fileName The cube file
+   *
+   * @return True if the DN data of cubes in the given file is kept in memory
+   */
+  bool CubeMemoryHandler::hasFile(const QString &fileName) {
+    MemoryStore &store = memoryStore();
+    QMutexLocker locker(&store.mutex);
+    return store.files.contains(storeKey(fileName));
+  }
+
+
+  /**
+   * Release the DN data kept for the given file, for example because the file
+   *   was removed. Cubes created in the file afterwards are still kept in
+   *   memory.
+   *
+   * @param fileName The cube file
+   */
+  void CubeMemoryHandler::discard(const QString &fileName) {
+    MemoryStore &store = memoryStore();
+    QMutexLocker locker(&store.mutex);
+
+    QHash< QString, QHash<BigInt, QByteArray> >::iterator file =
+        store.files.find(storeKey(fileName));
+    if (file == store.files.end()) {
+      return;
+    }
+
+    foreach (const QByteArray &chunk, file.value()) {
+      store.bytes -= chunk.size();
+    }
+    file.value().clear();
+  }
+
+
+  /**
+   * Write the DN data kept for the given file to the file and release it. The
+   *   file is complete afterwards and can be read by other processes. The file
+   *   must not be open as a Cube while this is done.
+   *
+   * @param fileName The cube file
+   */
+  void CubeMemoryHandler::writeToDisk(const QString &fileName) {
+    MemoryStore &store = memoryStore();
+    QMutexLocker locker(&store.mutex);
+
+    QHash< QString, QHash<BigInt, QByteArray> >::iterator file =
+        store.files.find(storeKey(fileName));
+    if (file == store.files.end() || file.value().isEmpty()) {
+      return;
+    }
+
+    QFile dataFile(file.key());
+    if (!dataFile.open(QIODevice::ReadWrite)) {
+      QString msg = "Failed to open [" + dataFile.fileName() + "] for writing "
+          "the cube data kept in memory";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    QHash<BigInt, QByteArray>::iterator chunk = file.value().begin();
+    while (chunk != file.value().end()) {
+      if (!dataFile.seek(chunk.key()) ||
+          dataFile.write(chunk.value()) != chunk.value().size()) {
+        QString msg = "Writing to the file [" + dataFile.fileName() + "] "
+            "failed with writing [" + QString::number(chunk.value().size()) +
+            "] bytes at position [" + QString::number(chunk.key()) + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      store.bytes -= chunk.value().size();
+      chunk = file.value().erase(chunk);
+    }
+  }
+
+
+  /**
+   * @return The number of bytes of DN data kept in memory by all files
+   */
+  BigInt CubeMemoryHandler::memoryUsed() {
+    MemoryStore &store = memoryStore();
+    QMutexLocker locker(&store.mutex);
+    return store.bytes;
+  }
+
+
+  /**
+   * Read a chunk from the store, or from the data file if the chunk was not
+   *   kept in memory.
+   *
+   * @param chunkToFill The chunk to read
+   */
+  void CubeMemoryHandler::readRaw(RawCubeChunk &chunkToFill) {
+    MemoryStore &store = memoryStore();
+    QMutexLocker locker(&store.mutex);
+
+    QHash< QString, QHash<BigInt, QByteArray> >::const_iterator file =
+        store.files.constFind(m_storeKey);
+    if (file != store.files.constEnd()) {
+      QHash<BigInt, QByteArray>::const_iterator chunk =
+          file.value().constFind(getChunkStartByte(chunkToFill));
+
+      if (chunk != file.value().constEnd()) {
+        // The chunk shares the data until it is modified
+        chunkToFill.setRawData(chunk.value());
+        return;
+      }
+    }
+
+    locker.unlock();
+    CubeTileHandler::readRaw(chunkToFill);
+  }
+
+
+  /**
+   * Keep a chunk in the store. The chunk is written to the data file instead
+   *   if the store is full or the file is no longer kept in memory.
+   *
+   * @param chunkToWrite The chunk to write
+   */
+  void CubeMemoryHandler::writeRaw(const RawCubeChunk &chunkToWrite) {
+    MemoryStore &store = memoryStore();
+    QMutexLocker locker(&store.mutex);
+
+    QHash< QString, QHash<BigInt, QByteArray> >::iterator file =
+        store.files.find(m_storeKey);
+    if (file != store.files.end()) {
+      BigInt startByte = getChunkStartByte(chunkToWrite);
+      const QByteArray &data = chunkToWrite.getRawData();
+      QByteArray &kept = file.value()[startByte];
+
+      if (store.bytes - kept.size() + data.size() <= m_memoryLimit) {
+        store.bytes += data.size() - kept.size();
+        kept = data;
+        return;
+      }
+
+      // Spill this chunk; the copy on disk must not be shadowed by an old one
+      store.bytes -= kept.size();
+      file.value().remove(startByte);
+    }
+
+    locker.unlock();
+    CubeTileHandler::writeRaw(chunkToWrite);
+  }
+
+
+  /**
+   * @param fileName A file name, which may contain variables
+   *
+   * @return The absolute, expanded file name used to look up a file
+   */
+  QString CubeMemoryHandler::storeKey(const QString &fileName) {
+    return QFileInfo(FileName(fileName).expanded()).absoluteFilePath();
+  }
+
+
+  /**
+   * This goes from chunk to file position the same way CubeTileHandler does.
+   *
+   * @param chunk The chunk to locate in the file.
+   * @returns The position of the chunk in the data file
+   */
+  BigInt CubeMemoryHandler::getChunkStartByte(const RawCubeChunk &chunk) const {
+    return getDataStartByte() + getChunkIndex(chunk) * getBytesPerChunk();
+  }
+}
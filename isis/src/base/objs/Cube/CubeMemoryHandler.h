@@ -0,0 +1,97 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#ifndef CubeMemoryHandler_h
+#define CubeMemoryHandler_h
+
+#include "CubeTileHandler.h"
+
+#include <QString>
+
+namespace Isis {
+
+  /**
+   * @brief IO Handler for tiled Isis cubes that keeps DN data in memory
+   *
+   * This handler is used by Cube for files that have been added with
+   * addFile(), such as the intermediate cubes of a Pipeline that runs its
+   * programs in-process. Chunks are kept in a process wide store, keyed by the
+   * data file and the position the chunk would have in it, instead of being
+   * written to the data file. The labels and blobs of the cube are still
+   * written to the file, so the DN data area of the file is left as a hole.
+   *
+   * Once the store holds the number of megabytes given by the
+   * IntermediateCubeMemory keyword of the Performance preferences group,
+   * further chunks are written to the data file like CubeTileHandler does.
+   * writeToDisk() moves every chunk of a file to disk, which must be done
+   * before the file is read by anything outside of this process.
+   *
+   * @ingroup LowLevelCubeIO
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class CubeMemoryHandler : public CubeTileHandler {
+    public:
+      CubeMemoryHandler(QFile * dataFile, const QList<int> *virtualBandList,
+          const Pvl &label, bool alreadyOnDisk);
+      ~CubeMemoryHandler();
+
+      static void addFile(const QString &fileName);
+      static void removeFile(const QString &fileName);
+      static bool hasFile(const QString &fileName);
+      static void discard(const QString &fileName);
+      static void writeToDisk(const QString &fileName);
+      static BigInt memoryUsed();
+
+    protected:
+      virtual void readRaw(RawCubeChunk &chunkToFill);
+      virtual void writeRaw(const RawCubeChunk &chunkToWrite);
+
+    private:
+      /**
+       * Disallow copying of this object.
+       *
+       * @param other The object to copy.
+       */
+      CubeMemoryHandler(const CubeMemoryHandler &other);
+
+      /**
+       * Disallow assignments of this object
+       *
+       * @param other The CubeMemoryHandler on the right-hand side of the
+       *              assignment that we are copying into *this.
+       * @return A reference to *this.
+       */
+      CubeMemoryHandler &operator=(const CubeMemoryHandler &other);
+
+      static QString storeKey(const QString &fileName);
+      BigInt getChunkStartByte(const RawCubeChunk &chunk) const;
+
+      QString m_storeKey; //!< The key of the data file in the store
+      BigInt m_memoryLimit; //!< The number of bytes the store may hold
+  };
+}
+
+#endif
@@ -0,0 +1,381 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "CubeOverviews.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QFile>
+#include <QVector>
+#include <QtEndian>
+
+#include "Buffer.h"
+#include "Cube.h"
+#include "IException.h"
+#include "IString.h"
+#include "LineManager.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+  namespace {
+    /**
+     * Accumulates one line of an overview while the cube lines that it
+     * covers are read.
+     */
+    struct LevelLine {
+      QVector<double> sums;  //!< The sum of the valid pixels of each block
+      QVector<int> counts;   //!< The number of valid pixels of each block
+      QVector<quint32> data; //!< The line as it is written to the file
+    };
+
+
+    /**
+     * @param sum The sum of the valid pixels of a block
+     * @param count The number of valid pixels of the block
+     *
+     * @return The overview pixel of the block
+     */
+    inline double blockAverage(double sum, int count) {
+      return (count > 0) ? sum / count : Null;
+    }
+  }
+
+
+  /**
+   * Opens the overviews described by the Overviews object of a cube label.
+   *
+   * @param fileName The file that holds the overviews
+   * @param label The Overviews object
+   */
+  CubeOverviews::CubeOverviews(const QString &fileName, const PvlObject &label) {
+    m_file = NULL;
+
+    for (int i = 0; i < label.groups(); i++) {
+      const PvlGroup &group = label.group(i);
+      if (!group.isNamed("Overview")) continue;
+
+      Level level;
+      level.reduction = group["Reduction"];
+      level.samples = group["Samples"];
+      level.lines = group["Lines"];
+      level.bands = group["Bands"];
+      level.startByte = toBigInt(group["StartByte"][0]) - 1;
+      m_levels.append(level);
+    }
+
+    m_file = new QFile(fileName);
+    if (!m_file->open(QIODevice::ReadOnly)) {
+      QString msg = "Unable to open the overviews in [" + fileName + "]";
+      delete m_file;
+      m_file = NULL;
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+  }
+
+
+  //! Closes the overview file.
+  CubeOverviews::~CubeOverviews() {
+    delete m_file;
+    m_file = NULL;
+  }
+
+
+  /**
+   * @return The reductions of the overviews, finest first
+   */
+  QList<int> CubeOverviews::reductions() const {
+    QList<int> result;
+    foreach (const Level &level, m_levels) {
+      result.append(level.reduction);
+    }
+    return result;
+  }
+
+
+  /**
+   * @param reduction A reduction factor
+   *
+   * @return True if there is an overview with the reduction
+   */
+  bool CubeOverviews::hasReduction(int reduction) const {
+    return findLevel(reduction) != NULL;
+  }
+
+
+  /**
+   * Fills a buffer from an overview. The sample and line of the buffer are
+   * positions in the overview, not in the cube. Pixels outside of the
+   * overview are NULL.
+   *
+   * @param buffer The buffer to fill
+   * @param reduction The reduction of the overview to read
+   * @param physicalBands The physical band of each band of the buffer, 0 for
+   *     a band outside of the cube
+   */
+  void CubeOverviews::read(Buffer &buffer, int reduction,
+                           const QList<int> &physicalBands) const {
+    const Level *level = findLevel(reduction);
+    if (!level) {
+      QString msg = "There is no overview with a reduction of [" + toString(reduction) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int samples = buffer.SampleDimension();
+    int firstSample = buffer.Sample();
+    int startSample = max(1, firstSample);
+    int endSample = min(level->samples, firstSample + samples - 1);
+
+    QVector<quint32> data(max(0, endSample - startSample + 1));
+    double *pixels = buffer.DoubleBuffer();
+
+    for (int band = 0; band < buffer.BandDimension(); band++) {
+      int physicalBand = physicalBands[band];
+
+      for (int line = 0; line < buffer.LineDimension(); line++) {
+        double *linePixels = pixels + (band * buffer.LineDimension() + line) * samples;
+        int overviewLine = buffer.Line() + line;
+
+        for (int i = 0; i < samples; i++) {
+          linePixels[i] = Null;
+        }
+
+        if (physicalBand < 1 || physicalBand > level->bands ||
+            overviewLine < 1 || overviewLine > level->lines || data.isEmpty()) {
+          continue;
+        }
+
+        BigInt startByte = level->startByte +
+            (((BigInt)(physicalBand - 1) * level->lines + overviewLine - 1) * level->samples +
+             startSample - 1) * 4;
+        qint64 bytes = data.size() * 4;
+
+        if (!m_file->seek(startByte) || m_file->read((char *)data.data(), bytes) != bytes) {
+          QString msg = "Unable to read the overview with a reduction of [" +
+                        toString(reduction) + "] from [" + m_file->fileName() + "]";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        for (int i = 0; i < data.size(); i++) {
+          quint32 raw = qFromLittleEndian(data[i]);
+          float value;
+          memcpy(&value, &raw, 4);
+          linePixels[startSample - firstSample + i] = TestPixel(value);
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Writes the overviews of a cube. The cube is read a line at a time and
+   * all of the overviews are accumulated in the same pass. Overviews are
+   * made, halving the size each time, until the last one is no larger than
+   * minimumSize in either direction.
+   *
+   * @param cube The cube to make overviews of
+   * @param fileName The file to write the overviews to, which is created if
+   *     it does not exist
+   * @param startByte Where the overviews start in the file, 0 based
+   * @param minimumSize The largest size of the coarsest overview
+   *
+   * @return The Overviews object that describes the overviews
+   */
+  PvlObject CubeOverviews::write(Cube &cube, const QString &fileName, BigInt startByte,
+                                 int minimumSize) {
+    if (minimumSize < 1) {
+      QString msg = "The minimum overview size [" + toString(minimumSize) +
+                    "] must be at least 1";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int samples = cube.sampleCount();
+    int lines = cube.lineCount();
+    int bands = cube.bandCount();
+
+    QList<Level> levels;
+    BigInt levelStart = startByte;
+    for (int reduction = 2;
+         reduction <= (1 << 30) &&
+         (reducedSize(samples, reduction / 2) > minimumSize ||
+          reducedSize(lines, reduction / 2) > minimumSize);
+         reduction *= 2) {
+      Level level;
+      level.reduction = reduction;
+      level.samples = reducedSize(samples, reduction);
+      level.lines = reducedSize(lines, reduction);
+      level.bands = bands;
+      level.startByte = levelStart;
+      levels.append(level);
+
+      levelStart += (BigInt)level.samples * level.lines * level.bands * 4;
+    }
+
+    PvlObject label("Overviews");
+    label += PvlKeyword("StartByte", toString(startByte + 1));
+    label += PvlKeyword("Bytes", toString(levelStart - startByte));
+    label += PvlKeyword("ByteOrder", "Lsb");
+
+    foreach (const Level &level, levels) {
+      PvlGroup group("Overview");
+      group += PvlKeyword("Reduction", toString(level.reduction));
+      group += PvlKeyword("Samples", toString(level.samples));
+      group += PvlKeyword("Lines", toString(level.lines));
+      group += PvlKeyword("Bands", toString(level.bands));
+      group += PvlKeyword("StartByte", toString(level.startByte + 1));
+      label.addGroup(group);
+    }
+
+    if (levels.isEmpty()) {
+      return label;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadWrite)) {
+      QString msg = "Unable to open [" + fileName + "] to write overviews";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    QVector<LevelLine> levelLines(levels.size());
+    for (int i = 0; i < levels.size(); i++) {
+      levelLines[i].sums.resize(levels[i].samples);
+      levelLines[i].counts.resize(levels[i].samples);
+      levelLines[i].data.resize(levels[i].samples);
+    }
+
+    LineManager cubeLine(cube);
+    for (int band = 1; band <= bands; band++) {
+      for (int line = 1; line <= lines; line++) {
+        cubeLine.SetLine(line, band);
+        cube.read(cubeLine);
+
+        // Only the finest overview sees the cube pixels. Each finished line
+        // of an overview is added to the next coarser one.
+        LevelLine &finest = levelLines[0];
+        for (int i = 0; i < samples; i++) {
+          double pixel = cubeLine[i];
+          if (IsValidPixel(pixel)) {
+            finest.sums[i / 2] += pixel;
+            finest.counts[i / 2]++;
+          }
+        }
+
+        for (int i = 0; i < levels.size(); i++) {
+          const Level &level = levels[i];
+          if (line % level.reduction != 0 && line != lines) {
+            break;
+          }
+
+          LevelLine &levelLine = levelLines[i];
+          if (i + 1 < levels.size()) {
+            LevelLine &coarser = levelLines[i + 1];
+            for (int j = 0; j < level.samples; j++) {
+              coarser.sums[j / 2] += levelLine.sums[j];
+              coarser.counts[j / 2] += levelLine.counts[j];
+            }
+          }
+
+          for (int j = 0; j < level.samples; j++) {
+            float value = TestPixel(blockAverage(levelLine.sums[j], levelLine.counts[j]));
+            quint32 raw;
+            memcpy(&raw, &value, 4);
+            levelLine.data[j] = qToLittleEndian(raw);
+            levelLine.sums[j] = 0.0;
+            levelLine.counts[j] = 0;
+          }
+
+          int overviewLine = (line - 1) / level.reduction;
+          BigInt lineStart = level.startByte +
+              ((BigInt)(band - 1) * level.lines + overviewLine) * level.samples * 4;
+          qint64 bytes = level.samples * 4;
+          if (!file.seek(lineStart) ||
+              file.write((const char *)levelLine.data.constData(), bytes) != bytes) {
+            QString msg = "Unable to write overviews to [" + fileName + "]";
+            throw IException(IException::Io, msg, _FILEINFO_);
+          }
+        }
+      }
+    }
+
+    return label;
+  }
+
+
+  /**
+   * @param size A number of samples or lines of a cube
+   * @param reduction A reduction factor
+   *
+   * @return The number of samples or lines of an overview with the reduction
+   */
+  int CubeOverviews::reducedSize(int size, int reduction) {
+    return (int)(((BigInt)size + reduction - 1) / reduction);
+  }
+
+
+  /**
+   * Reduces cube pixels the same way the overviews are made.
+   *
+   * @param pixels reduction lines of samples * reduction cube pixels
+   * @param samples The number of reduced pixels
+   * @param reduction The reduction factor
+   * @param reduced Receives the samples reduced pixels
+   */
+  void CubeOverviews::reduce(const double *pixels, int samples, int reduction,
+                             double *reduced) {
+    int lineSize = samples * reduction;
+    for (int i = 0; i < samples; i++) {
+      double sum = 0.0;
+      int count = 0;
+      for (int line = 0; line < reduction; line++) {
+        const double *block = pixels + line * lineSize + i * reduction;
+        for (int sample = 0; sample < reduction; sample++) {
+          if (IsValidPixel(block[sample])) {
+            sum += block[sample];
+            count++;
+          }
+        }
+      }
+      reduced[i] = blockAverage(sum, count);
+    }
+  }
+
+
+  /**
+   * @param reduction A reduction factor
+   *
+   * @return The overview with the reduction, or NULL if there is none
+   */
+  const CubeOverviews::Level *CubeOverviews::findLevel(int reduction) const {
+    for (int i = 0; i < m_levels.size(); i++) {
+      if (m_levels[i].reduction == reduction) {
+        return &m_levels[i];
+      }
+    }
+    return NULL;
+  }
+}
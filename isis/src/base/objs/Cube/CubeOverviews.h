@@ -0,0 +1,126 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#ifndef CubeOverviews_h
+#define CubeOverviews_h
+
+#include <QList>
+#include <QString>
+
+#include "Constants.h"
+
+class QFile;
+
+namespace Isis {
+  class Buffer;
+  class Cube;
+  class PvlObject;
+
+  /**
+   * @brief Reduced resolution copies of the DN data of a cube
+   *
+   * An overview holds the DN data of a cube reduced by a power of two in
+   * both the sample and the line direction. Each overview pixel is the
+   * average of the valid pixels of its reduction by reduction block of cube
+   * pixels, or NULL if the block has no valid pixels. Overviews are stored
+   * as 32 bit, least significant byte first, band sequential pixels, one
+   * overview after the other.
+   *
+   * The Overviews object of the cube labels describes the overviews:
+   *
+   * @code
+   *   Object = Overviews
+   *     StartByte = 1180929
+   *     Bytes     = 349440
+   *     ByteOrder = Lsb
+   *
+   *     Group = Overview
+   *       Reduction = 2
+   *       Samples   = 256
+   *       Lines     = 256
+   *       Bands     = 1
+   *       StartByte = 1180929
+   *     End_Group
+   *   End_Object
+   * @endcode
+   *
+   * The overviews follow the DN data of a cube with attached labels. With
+   * detached labels they are in their own file, which the ^Overviews keyword
+   * names. Cube::createOverviews() writes the overviews and
+   * Cube::read(Buffer &, int) reads them.
+   *
+   * @ingroup LowLevelCubeIO
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class CubeOverviews {
+    public:
+      CubeOverviews(const QString &fileName, const PvlObject &label);
+      ~CubeOverviews();
+
+      QList<int> reductions() const;
+      bool hasReduction(int reduction) const;
+      void read(Buffer &buffer, int reduction, const QList<int> &physicalBands) const;
+
+      static PvlObject write(Cube &cube, const QString &fileName, BigInt startByte,
+                             int minimumSize);
+      static int reducedSize(int size, int reduction);
+      static void reduce(const double *pixels, int samples, int reduction, double *reduced);
+
+    private:
+      /**
+       * Disallow copying of this object.
+       *
+       * @param other The object to copy.
+       */
+      CubeOverviews(const CubeOverviews &other);
+
+      /**
+       * Disallow assigning this object.
+       *
+       * @param other The CubeOverviews on the right hand side of the assignment
+       *     that we are copying into *this.
+       *
+       * @return A reference to *this.
+       */
+      CubeOverviews &operator=(const CubeOverviews &other);
+
+      //! The size and position of one overview
+      struct Level {
+        int reduction;    //!< The factor the cube is reduced by
+        int samples;      //!< The number of samples
+        int lines;        //!< The number of lines
+        int bands;        //!< The number of bands
+        BigInt startByte; //!< The position of the first pixel in the file, 0 based
+      };
+
+      const Level *findLevel(int reduction) const;
+
+      QFile *m_file;        //!< The file that holds the overviews
+      QList<Level> m_levels; //!< The overviews, finest first
+  };
+}
+
+#endif
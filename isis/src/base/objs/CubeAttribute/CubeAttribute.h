@@ -484,6 +484,7 @@ namespace Isis {
    *                           coding standards. Added the "+External+ attribute. Added safety
    *                           checks for unrecognized attributes. References #961.
    *   @history 2018-07-27 Kaitlyn Lee - Added unsigned/signed integer handling.
+   *   @history 2026-10-19 ISIS Development Team - Added the CompressedTile file format.
 
    */
   class CubeAttributeOutput : public CubeAttribute<CubeAttributeOutput> {
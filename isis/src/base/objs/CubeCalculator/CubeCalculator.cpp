@@ -21,17 +21,157 @@
  */
 #include "CubeCalculator.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
 #include <QVector>
 
 #include "Angle.h"
 #include "Camera.h"
 #include "Distance.h"
 #include "IString.h"
+#include "SpecialPixel.h"
 #include "Statistics.h"
 
 using namespace std;
 
 namespace Isis {
+  namespace {
+    //! The number of pixels compiled calculations work on at a time
+    const int BlockSize = 256;
+
+    /**
+     * Rounds like Calculator's modulus operator does.
+     *
+     * @param a The value to round
+     *
+     * @return The rounded value
+     */
+    inline int roundOperand(double a) {
+      return (a > 0) ? (int)(a + 0.5) : (int)(a - 0.5);
+    }
+
+    // The operations of compiled calculations. Each one matches the
+    // Calculator operator of the same name.
+    struct NegateOp { double operator()(double a) const { return -1 * a; } };
+    struct AddOp { double operator()(double a, double b) const { return a + b; } };
+    struct SubtractOp { double operator()(double a, double b) const { return a - b; } };
+    struct MultiplyOp { double operator()(double a, double b) const { return a * b; } };
+    struct DivideOp { double operator()(double a, double b) const { return a / b; } };
+    struct ModulusOp {
+      double operator()(double a, double b) const {
+        return (double)(roundOperand(a) % roundOperand(b));
+      }
+    };
+    struct ExponentOp { double operator()(double a, double b) const { return pow(a, b); } };
+    struct SquareRootOp { double operator()(double a) const { return sqrt(a); } };
+    struct AbsoluteOp { double operator()(double a) const { return fabs(a); } };
+    struct LogOp { double operator()(double a) const { return log(a); } };
+    struct Log10Op { double operator()(double a) const { return log10(a); } };
+    struct SineOp { double operator()(double a) const { return sin(a); } };
+    struct CosineOp { double operator()(double a) const { return cos(a); } };
+    struct TangentOp { double operator()(double a) const { return tan(a); } };
+    struct SecantOp { double operator()(double a) const { return 1.0 / cos(a); } };
+    struct CosecantOp { double operator()(double a) const { return 1.0 / sin(a); } };
+    struct CotangentOp { double operator()(double a) const { return 1.0 / tan(a); } };
+    struct ArcsineOp { double operator()(double a) const { return asin(a); } };
+    struct ArccosineOp { double operator()(double a) const { return acos(a); } };
+    struct ArctangentOp { double operator()(double a) const { return atan(a); } };
+    struct Arctangent2Op { double operator()(double a, double b) const { return atan2(a, b); } };
+    struct SineHOp { double operator()(double a) const { return sinh(a); } };
+    struct CosineHOp { double operator()(double a) const { return cosh(a); } };
+    struct TangentHOp { double operator()(double a) const { return tanh(a); } };
+    struct LessThanOp {
+      double operator()(double a, double b) const { return a < b ? 1.0 : 0.0; }
+    };
+    struct GreaterThanOp {
+      double operator()(double a, double b) const { return a > b ? 1.0 : 0.0; }
+    };
+    struct LessThanOrEqualOp {
+      double operator()(double a, double b) const { return a <= b ? 1.0 : 0.0; }
+    };
+    struct GreaterThanOrEqualOp {
+      double operator()(double a, double b) const { return a >= b ? 1.0 : 0.0; }
+    };
+    struct EqualOp {
+      double operator()(double a, double b) const { return a == b ? 1.0 : 0.0; }
+    };
+    struct NotEqualOp {
+      double operator()(double a, double b) const { return a != b ? 1.0 : 0.0; }
+    };
+    struct MinimumOp {
+      double operator()(double a, double b) const {
+        if (std::isnan(a)) return a;
+        if (std::isnan(b)) return b;
+        return (a < b) ? a : b;
+      }
+    };
+    struct MaximumOp {
+      double operator()(double a, double b) const {
+        if (std::isnan(a)) return a;
+        if (std::isnan(b)) return b;
+        return (a > b) ? a : b;
+      }
+    };
+
+
+    /**
+     * Applies a one operand operation to a block of pixels.
+     *
+     * @param operation The operation
+     * @param a The operand
+     * @param result Receives count results
+     * @param count The number of pixels
+     */
+    template <typename Op>
+    inline void unaryBlock(Op operation, const double *a, double *result, int count) {
+      for (int i = 0; i < count; i++) {
+        result[i] = operation(a[i]);
+      }
+    }
+
+
+    /**
+     * Applies a two operand operation to a block of pixels. A scalar operand
+     * is used for every pixel. The loops are kept separate so the compiler
+     * can vectorize each one.
+     *
+     * @param operation The operation
+     * @param a The first operand
+     * @param aScalar True if a is a single value
+     * @param b The second operand
+     * @param bScalar True if b is a single value
+     * @param result Receives count results
+     * @param count The number of pixels
+     */
+    template <typename Op>
+    inline void binaryBlock(Op operation, const double *a, bool aScalar,
+                            const double *b, bool bScalar, double *result, int count) {
+      if (aScalar && bScalar) {
+        result[0] = operation(a[0], b[0]);
+      }
+      else if (aScalar) {
+        double aValue = a[0];
+        for (int i = 0; i < count; i++) {
+          result[i] = operation(aValue, b[i]);
+        }
+      }
+      else if (bScalar) {
+        double bValue = b[0];
+        for (int i = 0; i < count; i++) {
+          result[i] = operation(a[i], bValue);
+        }
+      }
+      else {
+        for (int i = 0; i < count; i++) {
+          result[i] = operation(a[i], b[i]);
+        }
+      }
+    }
+  }
+
 
   //! Constructs a CubeCalculator.
   CubeCalculator::CubeCalculator() {
@@ -50,6 +190,8 @@ namespace Isis {
     m_cameraBuffers   = new QVector<CameraBuffers *>();
 
     m_outputSamples = 0;
+    m_compiled = false;
+    m_vectorRegisters = 0;
   }
 
   
@@ -91,6 +233,13 @@ namespace Isis {
       m_dataDefinitions->clear();
     }
 
+    m_compiled = false;
+    m_program.clear();
+    m_vectorRegisters = 0;
+    m_scalarValues.clear();
+    m_vectorValues.clear();
+    m_sources.clear();
+
     // m_cubeStats contains pointers to dynamic memory - need to free
     if (m_cubeStats) {
       for (int i = 0; i < m_cubeStats->size(); i++) {
@@ -129,6 +278,22 @@ namespace Isis {
   QVector<double> CubeCalculator::runCalculations(QVector<Buffer *> &cubeData,
                                                   int curLine, 
                                                   int curBand) {
+    if (m_compiled) {
+      // Cube lines of a different size are left to the calculator to report
+      bool sizesMatch = true;
+      foreach (const Instruction &instruction, m_program) {
+        if (instruction.operation == LoadData &&
+            (*m_dataDefinitions)[instruction.data].type() == DataValue::CubeData) {
+          int cubeIndex = (*m_dataDefinitions)[instruction.data].cubeIndex();
+          sizesMatch = sizesMatch && (cubeData[cubeIndex]->size() == m_outputSamples);
+        }
+      }
+
+      if (sizesMatch) {
+        return runCompiledCalculations(cubeData, curLine, curBand);
+      }
+    }
+
     // For now we'll only process a single line in this method for our results. In order
     //    to do more powerful indexing, passing a list of cubes and the output cube will
     //    be necessary.
@@ -696,6 +861,473 @@ namespace Isis {
         throw IException(IException::Unknown, msg, _FILEINFO_);
       }
     } // while loop
+
+    compileCalculations();
+  }
+
+
+  /**
+   * Compiles the calculations built by prepareCalculations() into
+   *   instructions that runCompiledCalculations() performs on blocks of
+   *   pixels. Each position on the calculator stack becomes a vector register
+   *   of one block, so no lines are allocated while the calculations run.
+   *   Calculations that only depend on constants, the line and the band are
+   *   performed once per line.
+   *
+   * The calculations are left uncompiled if they use an operation that
+   *   needs a whole line, like linemin or a shift, or if they would leave the
+   *   calculator stack in an error state. runCalculations() then interprets
+   *   them, and reports any error, as before.
+   */
+  void CubeCalculator::compileCalculations() {
+    m_compiled = false;
+    m_program.clear();
+    m_vectorRegisters = 0;
+
+    // The scalar flag and the slot or register of each value on the stack
+    QVector< QPair<bool, int> > stack;
+    int methodIndex = 0;
+    int dataIndex = 0;
+
+    for (int i = 0; i < m_calculations->size(); i++) {
+      Instruction instruction;
+      instruction.data = -1;
+      instruction.leftScalar = true;
+      instruction.left = -1;
+      instruction.rightScalar = true;
+      instruction.right = -1;
+
+      if ((*m_calculations)[i] == PushNextData) {
+        DataValue::DataValueType type = (*m_dataDefinitions)[dataIndex].type();
+        instruction.operation = LoadData;
+        instruction.data = dataIndex;
+        // The angles at the center of the image are a single value per line
+        instruction.scalar = (type == DataValue::Constant || type == DataValue::Line ||
+                              type == DataValue::Band || type == DataValue::InacData ||
+                              type == DataValue::EmacData || type == DataValue::PhacData);
+        dataIndex++;
+      }
+      else {
+        int operands = 0;
+        instruction.operation = compiledOperation((*m_methods)[methodIndex], operands);
+        methodIndex++;
+
+        if (instruction.operation == UnknownOperation || stack.size() < operands) {
+          m_program.clear();
+          return;
+        }
+
+        if (operands == 2) {
+          instruction.rightScalar = stack.last().first;
+          instruction.right = stack.last().second;
+          stack.pop_back();
+        }
+        instruction.leftScalar = stack.last().first;
+        instruction.left = stack.last().second;
+        stack.pop_back();
+
+        instruction.scalar = instruction.leftScalar && instruction.rightScalar;
+      }
+
+      instruction.result = instruction.scalar ? m_program.size() : stack.size();
+      stack.push_back(qMakePair(instruction.scalar, instruction.result));
+      m_vectorRegisters = max(m_vectorRegisters, stack.size());
+      m_program.push_back(instruction);
+    }
+
+    if (stack.size() != 1) {
+      m_program.clear();
+      return;
+    }
+
+    m_scalarValues.fill(0.0, m_program.size());
+    m_vectorValues.fill(0.0, m_vectorRegisters * BlockSize);
+    m_sources.fill(NULL, m_program.size());
+    m_compiled = true;
+  }
+
+
+  /**
+   * Performs the compiled calculations for a line.
+   *
+   * @param cubeData The input cubes' data
+   * @param curLine The current line in the output cube
+   * @param curBand The current band in the output cube
+   *
+   * @return QVector<double> The results of the calculations (with Isis Special Pixels)
+   */
+  QVector<double> CubeCalculator::runCompiledCalculations(QVector<Buffer *> &cubeData,
+                                                          int curLine,
+                                                          int curBand) {
+    // Scalars and the data of the line first
+    for (int i = 0; i < m_program.size(); i++) {
+      const Instruction &instruction = m_program[i];
+
+      if (instruction.operation == LoadData) {
+        DataValue &data = (*m_dataDefinitions)[instruction.data];
+        m_sources[i] = NULL;
+
+        switch (data.type()) {
+          case DataValue::Constant:
+            m_scalarValues[i] = data.constant();
+            break;
+          case DataValue::Line:
+            m_scalarValues[i] = curLine;
+            break;
+          case DataValue::Band:
+            m_scalarValues[i] = curBand;
+            break;
+          case DataValue::Sample:
+            break;
+          case DataValue::CubeData:
+            m_sources[i] = cubeData[data.cubeIndex()]->DoubleBuffer();
+            break;
+          default: {
+            CameraBuffers *buffers = (*m_cameraBuffers)[data.cubeIndex()];
+            QVector<double> *cameraData = NULL;
+            switch (data.type()) {
+              case DataValue::InaData:
+                cameraData = buffers->inaBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::EmaData:
+                cameraData = buffers->emaBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::PhaData:
+                cameraData = buffers->phaBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::InalData:
+                cameraData = buffers->inalBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::EmalData:
+                cameraData = buffers->emalBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::PhalData:
+                cameraData = buffers->phalBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::LatData:
+                cameraData = buffers->latBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::LonData:
+                cameraData = buffers->lonBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::ResData:
+                cameraData = buffers->resBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::RadiusData:
+                cameraData = buffers->radiusBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::InacData:
+                cameraData = buffers->inacBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::EmacData:
+                cameraData = buffers->emacBuffer(curLine, m_outputSamples, curBand);
+                break;
+              case DataValue::PhacData:
+                cameraData = buffers->phacBuffer(curLine, m_outputSamples, curBand);
+                break;
+              default:
+                break;
+            }
+            if (instruction.scalar) {
+              m_scalarValues[i] = (*cameraData)[0];
+            }
+            else {
+              m_sources[i] = cameraData ? cameraData->constData() : NULL;
+            }
+            break;
+          }
+        }
+      }
+      else if (instruction.scalar) {
+        performOperation(instruction.operation,
+                         &m_scalarValues[instruction.left], true,
+                         &m_scalarValues[instruction.right < 0 ? 0 : instruction.right], true,
+                         &m_scalarValues[i], 1);
+      }
+    }
+
+    const Instruction &last = m_program.last();
+    QVector<double> results(last.scalar ? 1 : m_outputSamples);
+
+    if (last.scalar) {
+      results[0] = m_scalarValues[last.result];
+    }
+    else {
+      // Then the pixels, a block at a time
+      for (int start = 0; start < m_outputSamples; start += BlockSize) {
+        int count = min(BlockSize, m_outputSamples - start);
+
+        for (int i = 0; i < m_program.size(); i++) {
+          const Instruction &instruction = m_program[i];
+          if (instruction.scalar) continue;
+
+          double *result = &m_vectorValues[instruction.result * BlockSize];
+          if (instruction.operation == LoadData) {
+            loadData(i, start, count, result);
+          }
+          else {
+            const double *left = instruction.leftScalar ?
+                &m_scalarValues[instruction.left] :
+                &m_vectorValues[instruction.left * BlockSize];
+            const double *right = left;
+            if (instruction.right >= 0) {
+              right = instruction.rightScalar ?
+                  &m_scalarValues[instruction.right] :
+                  &m_vectorValues[instruction.right * BlockSize];
+            }
+            performOperation(instruction.operation, left, instruction.leftScalar,
+                             right, instruction.rightScalar, result, count);
+          }
+        }
+
+        memcpy(&results[start], &m_vectorValues[last.result * BlockSize],
+               count * sizeof(double));
+      }
+    }
+
+    // Convert to special pixels like Calculator::Pop(true)
+    for (int i = 0; i < results.size(); i++) {
+      if (std::isnan(results[i])) {
+        results[i] = Isis::Null;
+      }
+      else if (results[i] > DBL_MAX) {
+        results[i] = Isis::Hrs;
+      }
+      else if (results[i] < -DBL_MAX) {
+        results[i] = Isis::Lrs;
+      }
+    }
+
+    return results;
+  }
+
+
+  /**
+   * Loads a block of vector data for a load instruction. Special pixels of
+   *   cube data become NaN or infinities like they do in Calculator::Push.
+   *
+   * @param index The index of the load instruction
+   * @param start The first sample of the block, 0 based
+   * @param count The number of samples in the block
+   * @param result Receives the data
+   */
+  void CubeCalculator::loadData(int index, int start, int count, double *result) {
+    DataValue &data = (*m_dataDefinitions)[m_program[index].data];
+    const double *source = m_sources[index];
+
+    if (data.type() == DataValue::Sample) {
+      for (int i = 0; i < count; i++) {
+        result[i] = start + i + 1;
+      }
+    }
+    else if (data.type() == DataValue::CubeData) {
+      for (int i = 0; i < count; i++) {
+        double pixel = source[start + i];
+        if (!IsSpecial(pixel)) {
+          result[i] = pixel;
+        }
+        else if (IsNullPixel(pixel)) {
+          result[i] = sqrt(-1.0);
+        }
+        else if (IsHrsPixel(pixel) || IsHisPixel(pixel)) {
+          result[i] = DBL_MAX * 2;
+        }
+        else {
+          result[i] = -DBL_MAX * 2;
+        }
+      }
+    }
+    else {
+      memcpy(result, source + start, count * sizeof(double));
+    }
+  }
+
+
+  /**
+   * Finds the compiled operation that does what a Calculator method does.
+   *
+   * @param method The Calculator method
+   * @param operands Set to the number of operands the method takes
+   *
+   * @return The operation, or UnknownOperation if it can't be compiled
+   */
+  CubeCalculator::Operation CubeCalculator::compiledOperation(
+      void (Calculator::*method)(void), int &operands) {
+    struct MethodOperation {
+      void (Calculator::*method)(void);
+      Operation operation;
+      int operands;
+    };
+
+    // MinimumPixel and MaximumPixel compare the top of the stack to the value
+    // below it, so their operands are swapped when they are performed
+    static const MethodOperation methods[] = {
+      { &Calculator::Negative,           NegateOperation,             1 },
+      { &Calculator::Add,                AddOperation,                2 },
+      { &Calculator::Subtract,           SubtractOperation,           2 },
+      { &Calculator::Multiply,           MultiplyOperation,           2 },
+      { &Calculator::Divide,             DivideOperation,             2 },
+      { &Calculator::Modulus,            ModulusOperation,            2 },
+      { &Calculator::Exponent,           ExponentOperation,           2 },
+      { &Calculator::SquareRoot,         SquareRootOperation,         1 },
+      { &Calculator::AbsoluteValue,      AbsoluteOperation,           1 },
+      { &Calculator::Log,                LogOperation,                1 },
+      { &Calculator::Log10,              Log10Operation,              1 },
+      { &Calculator::Sine,               SineOperation,               1 },
+      { &Calculator::Cosine,             CosineOperation,             1 },
+      { &Calculator::Tangent,            TangentOperation,            1 },
+      { &Calculator::Secant,             SecantOperation,             1 },
+      { &Calculator::Cosecant,           CosecantOperation,           1 },
+      { &Calculator::Cotangent,          CotangentOperation,          1 },
+      { &Calculator::Arcsine,            ArcsineOperation,            1 },
+      { &Calculator::Arccosine,          ArccosineOperation,          1 },
+      { &Calculator::Arctangent,         ArctangentOperation,         1 },
+      { &Calculator::Arctangent2,        Arctangent2Operation,        2 },
+      { &Calculator::SineH,              SineHOperation,              1 },
+      { &Calculator::CosineH,            CosineHOperation,            1 },
+      { &Calculator::TangentH,           TangentHOperation,           1 },
+      { &Calculator::LessThan,           LessThanOperation,           2 },
+      { &Calculator::GreaterThan,        GreaterThanOperation,        2 },
+      { &Calculator::LessThanOrEqual,    LessThanOrEqualOperation,    2 },
+      { &Calculator::GreaterThanOrEqual, GreaterThanOrEqualOperation, 2 },
+      { &Calculator::Equal,              EqualOperation,              2 },
+      { &Calculator::NotEqual,           NotEqualOperation,           2 },
+      { &Calculator::MinimumPixel,       MinimumOperation,            2 },
+      { &Calculator::MaximumPixel,       MaximumOperation,            2 }
+    };
+
+    for (unsigned int i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+      if (methods[i].method == method) {
+        operands = methods[i].operands;
+        return methods[i].operation;
+      }
+    }
+
+    operands = 0;
+    return UnknownOperation;
+  }
+
+
+  /**
+   * Performs an operation on a block of pixels.
+   *
+   * @param operation The operation
+   * @param left The first operand, the deeper one on the calculator stack
+   * @param leftScalar True if left is a single value for every pixel
+   * @param right The second operand, ignored by one operand operations
+   * @param rightScalar True if right is a single value for every pixel
+   * @param result Receives the results, one value if both operands are scalars
+   * @param count The number of pixels
+   */
+  void CubeCalculator::performOperation(Operation operation,
+                                        const double *left, bool leftScalar,
+                                        const double *right, bool rightScalar,
+                                        double *result, int count) {
+    if (leftScalar && rightScalar) count = 1;
+
+    switch (operation) {
+      case NegateOperation:
+        unaryBlock(NegateOp(), left, result, count);
+        break;
+      case AddOperation:
+        binaryBlock(AddOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case SubtractOperation:
+        binaryBlock(SubtractOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case MultiplyOperation:
+        binaryBlock(MultiplyOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case DivideOperation:
+        binaryBlock(DivideOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case ModulusOperation:
+        binaryBlock(ModulusOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case ExponentOperation:
+        binaryBlock(ExponentOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case SquareRootOperation:
+        unaryBlock(SquareRootOp(), left, result, count);
+        break;
+      case AbsoluteOperation:
+        unaryBlock(AbsoluteOp(), left, result, count);
+        break;
+      case LogOperation:
+        unaryBlock(LogOp(), left, result, count);
+        break;
+      case Log10Operation:
+        unaryBlock(Log10Op(), left, result, count);
+        break;
+      case SineOperation:
+        unaryBlock(SineOp(), left, result, count);
+        break;
+      case CosineOperation:
+        unaryBlock(CosineOp(), left, result, count);
+        break;
+      case TangentOperation:
+        unaryBlock(TangentOp(), left, result, count);
+        break;
+      case SecantOperation:
+        unaryBlock(SecantOp(), left, result, count);
+        break;
+      case CosecantOperation:
+        unaryBlock(CosecantOp(), left, result, count);
+        break;
+      case CotangentOperation:
+        unaryBlock(CotangentOp(), left, result, count);
+        break;
+      case ArcsineOperation:
+        unaryBlock(ArcsineOp(), left, result, count);
+        break;
+      case ArccosineOperation:
+        unaryBlock(ArccosineOp(), left, result, count);
+        break;
+      case ArctangentOperation:
+        unaryBlock(ArctangentOp(), left, result, count);
+        break;
+      case Arctangent2Operation:
+        binaryBlock(Arctangent2Op(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case SineHOperation:
+        unaryBlock(SineHOp(), left, result, count);
+        break;
+      case CosineHOperation:
+        unaryBlock(CosineHOp(), left, result, count);
+        break;
+      case TangentHOperation:
+        unaryBlock(TangentHOp(), left, result, count);
+        break;
+      case LessThanOperation:
+        binaryBlock(LessThanOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case GreaterThanOperation:
+        binaryBlock(GreaterThanOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case LessThanOrEqualOperation:
+        binaryBlock(LessThanOrEqualOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case GreaterThanOrEqualOperation:
+        binaryBlock(GreaterThanOrEqualOp(), left, leftScalar, right, rightScalar, result,
+                    count);
+        break;
+      case EqualOperation:
+        binaryBlock(EqualOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case NotEqualOperation:
+        binaryBlock(NotEqualOp(), left, leftScalar, right, rightScalar, result, count);
+        break;
+      case MinimumOperation:
+        binaryBlock(MinimumOp(), right, rightScalar, left, leftScalar, result, count);
+        break;
+      case MaximumOperation:
+        binaryBlock(MaximumOp(), right, rightScalar, left, leftScalar, result, count);
+        break;
+      default: {
+        string msg = "Unidentified compiled operation";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+    }
   }
 
 
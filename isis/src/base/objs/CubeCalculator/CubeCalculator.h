@@ -68,6 +68,14 @@ namespace Isis {
    *                          changes for correctly calculating camera angles for band-dependent
    *                          images. Quick documentation and coding standards review (moved
    *                          inline implementations to cpp). Fixes #1301.
+   *  @history 2026-10-19 ISIS Development Team - prepareCalculations() now also compiles the
+   *                          equation into register based instructions. runCalculations()
+   *                          evaluates them on blocks of pixels in reused registers instead of
+   *                          pushing whole lines on the calculator stack. Equations with line
+   *                          shifts, linemin or linemax are still interpreted.
+   *  @history 2026-10-19 ISIS Development Team - The compiled calculations load phac, inac and
+   *                          emac as single values since their camera buffers hold only the
+   *                          angle at the center of the image.
    */
   class CubeCalculator : Calculator {
     public:
@@ -100,8 +108,80 @@ namespace Isis {
         PushNextData
       };
 
+      /**
+       * The operations that compiled calculations can perform on each pixel.
+       */
+      enum Operation {
+        LoadData,          //!< Load the next data definition
+        NegateOperation,   //!< -a
+        AddOperation,      //!< a + b
+        SubtractOperation, //!< a - b
+        MultiplyOperation, //!< a * b
+        DivideOperation,   //!< a / b
+        ModulusOperation,  //!< a % b of the rounded values
+        ExponentOperation, //!< a ^ b
+        SquareRootOperation,
+        AbsoluteOperation,
+        LogOperation,
+        Log10Operation,
+        SineOperation,
+        CosineOperation,
+        TangentOperation,
+        SecantOperation,
+        CosecantOperation,
+        CotangentOperation,
+        ArcsineOperation,
+        ArccosineOperation,
+        ArctangentOperation,
+        Arctangent2Operation,
+        SineHOperation,
+        CosineHOperation,
+        TangentHOperation,
+        LessThanOperation,
+        GreaterThanOperation,
+        LessThanOrEqualOperation,
+        GreaterThanOrEqualOperation,
+        EqualOperation,
+        NotEqualOperation,
+        MinimumOperation,  //!< The smaller of a and b, NaN if either is
+        MaximumOperation,  //!< The larger of a and b, NaN if either is
+        UnknownOperation   //!< Cannot be compiled
+      };
+
+      /**
+       * One step of the compiled calculations. An operand or result that is
+       *   the same for every pixel of a line is a scalar and kept in the
+       *   scalar slot of the instruction that computed it. Other results are
+       *   kept in the vector register of their position on the calculator
+       *   stack.
+       */
+      struct Instruction {
+        Operation operation; //!< What to compute
+        int data;            //!< The data definition to load, for LoadData
+        bool scalar;         //!< True if the result is a scalar
+        int result;          //!< The scalar slot or vector register of the result
+        bool leftScalar;     //!< True if the first operand is a scalar
+        int left;            //!< The scalar slot or vector register of the first operand
+        bool rightScalar;    //!< True if the second operand is a scalar
+        int right;           //!< The scalar slot or vector register of the second operand
+      };
+
       void addMethodCall(void (Calculator::*method)(void));
 
+      void compileCalculations();
+
+      QVector<double> runCompiledCalculations(QVector<Buffer *> &cubeData,
+                                              int line, int band);
+
+      void loadData(int index, int start, int count, double *result);
+
+      static Operation compiledOperation(void (Calculator::*method)(void), int &operands);
+
+      static void performOperation(Operation operation,
+                                   const double *left, bool leftScalar,
+                                   const double *right, bool rightScalar,
+                                   double *result, int count);
+
       int lastPushToCubeStats(QVector<Cube *> &inCubes);
 
       int lastPushToCubeCameras(QVector<Cube *> &inCubes);
@@ -135,6 +215,24 @@ namespace Isis {
       QVector<CameraBuffers *> *m_cameraBuffers;
 
       int m_outputSamples; //!< Number of samples in the output cube.
+
+      //! True if the calculations are compiled into m_program
+      bool m_compiled;
+
+      //! The compiled calculations, in the order they are performed
+      QVector<Instruction> m_program;
+
+      //! The number of vector registers m_program uses
+      int m_vectorRegisters;
+
+      //! The scalar slot of each instruction of m_program
+      QVector<double> m_scalarValues;
+
+      //! The vector registers, one block of pixels each
+      QVector<double> m_vectorValues;
+
+      //! The input data of each load instruction for the current line
+      QVector<const double *> m_sources;
   };
 
 
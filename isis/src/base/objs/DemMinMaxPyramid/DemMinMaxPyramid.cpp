@@ -0,0 +1,192 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "DemMinMaxPyramid.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include <QSharedPointer>
+
+#include "DemTileCache.h"
+#include "IException.h"
+#include "IString.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Builds the pyramid by reading every tile of a DEM once.
+   *
+   * @param demCache The DEM
+   * @param blockSize The number of samples and lines in a level 0 block
+   *
+   * @throws IException::Programmer "The block size must be positive"
+   */
+  DemMinMaxPyramid::DemMinMaxPyramid(DemTileCache &demCache, int blockSize) {
+    if (blockSize < 1) {
+      QString msg = "The block size must be positive, not [" + toString(blockSize) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_blockSize = blockSize;
+    int samples = demCache.sampleCount();
+    int lines = demCache.lineCount();
+    int columns = (samples + blockSize - 1) / blockSize;
+    int rows = (lines + blockSize - 1) / blockSize;
+
+    QVector<double> minimums(columns * rows, DBL_MAX);
+    QVector<double> maximums(columns * rows, -DBL_MAX);
+
+    // A pixel also counts toward the blocks it borders
+    int line = 1;
+    while (line <= lines) {
+      int sample = 1;
+      int tileLines = 0;
+      while (sample <= samples) {
+        QSharedPointer<const DemTileCache::Tile> tile = demCache.tile(sample, line);
+        tileLines = tile->lines;
+
+        for (int l = tile->startLine; l < tile->startLine + tile->lines; l++) {
+          int firstRow = max(0, (l - 2) / blockSize);
+          int lastRow = min(rows - 1, l / blockSize);
+
+          for (int s = tile->startSample; s < tile->startSample + tile->samples; s++) {
+            double value = tile->value(s, l);
+            if (IsSpecial(value)) {
+              continue;
+            }
+
+            int firstColumn = max(0, (s - 2) / blockSize);
+            int lastColumn = min(columns - 1, s / blockSize);
+            for (int row = firstRow; row <= lastRow; row++) {
+              for (int column = firstColumn; column <= lastColumn; column++) {
+                int index = row * columns + column;
+                minimums[index] = min(minimums[index], value);
+                maximums[index] = max(maximums[index], value);
+              }
+            }
+          }
+        }
+
+        sample += tile->samples;
+      }
+      line += tileLines;
+    }
+
+    m_columns.append(columns);
+    m_rows.append(rows);
+    m_minimums.append(minimums);
+    m_maximums.append(maximums);
+
+    while (columns > 1 || rows > 1) {
+      int coarseColumns = (columns + 1) / 2;
+      int coarseRows = (rows + 1) / 2;
+      QVector<double> coarseMinimums(coarseColumns * coarseRows, DBL_MAX);
+      QVector<double> coarseMaximums(coarseColumns * coarseRows, -DBL_MAX);
+
+      for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+          int index = (row / 2) * coarseColumns + column / 2;
+          coarseMinimums[index] = min(coarseMinimums[index], minimums[row * columns + column]);
+          coarseMaximums[index] = max(coarseMaximums[index], maximums[row * columns + column]);
+        }
+      }
+
+      columns = coarseColumns;
+      rows = coarseRows;
+      minimums = coarseMinimums;
+      maximums = coarseMaximums;
+
+      m_columns.append(columns);
+      m_rows.append(rows);
+      m_minimums.append(minimums);
+      m_maximums.append(maximums);
+    }
+  }
+
+
+  //! Destroys the pyramid
+  DemMinMaxPyramid::~DemMinMaxPyramid() {
+  }
+
+
+  /**
+   * @return int The number of samples and lines in a level 0 block
+   */
+  int DemMinMaxPyramid::blockSize() const {
+    return m_blockSize;
+  }
+
+
+  /**
+   * @return int The number of levels, the last of which is a single block
+   */
+  int DemMinMaxPyramid::levelCount() const {
+    return m_columns.size();
+  }
+
+
+  /**
+   * @param level The level
+   *
+   * @return int The number of columns of blocks in the level
+   */
+  int DemMinMaxPyramid::columnCount(int level) const {
+    return m_columns[level];
+  }
+
+
+  /**
+   * @param level The level
+   *
+   * @return int The number of rows of blocks in the level
+   */
+  int DemMinMaxPyramid::rowCount(int level) const {
+    return m_rows[level];
+  }
+
+
+  /**
+   * @param level The level of the block
+   * @param column The column of the block, starting at 0
+   * @param row The row of the block, starting at 0
+   *
+   * @return double The smallest valid pixel in or bordering the block
+   */
+  double DemMinMaxPyramid::minimum(int level, int column, int row) const {
+    return m_minimums[level][row * m_columns[level] + column];
+  }
+
+
+  /**
+   * @param level The level of the block
+   * @param column The column of the block, starting at 0
+   * @param row The row of the block, starting at 0
+   *
+   * @return double The largest valid pixel in or bordering the block
+   */
+  double DemMinMaxPyramid::maximum(int level, int column, int row) const {
+    return m_maximums[level][row * m_columns[level] + column];
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef DemMinMaxPyramid_h
+#define DemMinMaxPyramid_h
+
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QVector>
+
+namespace Isis {
+  class DemTileCache;
+
+  /**
+   * @brief Minimum and maximum values of a DEM over a hierarchy of blocks
+   *
+   * Level 0 divides the DEM into square blocks of pixels and holds the
+   * minimum and maximum valid pixel of each block.  Each following level
+   * combines two by two blocks of the level before it, up to a last level of
+   * a single block covering the whole DEM.
+   *
+   * The values of a block also cover the pixels bordering it, so they bound
+   * any value interpolated bilinearly at a position inside the block.  A ray
+   * above the maximum of a block cannot meet the DEM while it is over the
+   * block, which lets shape models skip over empty space in large steps and
+   * only read the DEM near the surface.
+   *
+   * A block with no valid pixels has a minimum greater than its maximum.
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class DemMinMaxPyramid {
+    public:
+      DemMinMaxPyramid(DemTileCache &demCache, int blockSize);
+      ~DemMinMaxPyramid();
+
+      int blockSize() const;
+      int levelCount() const;
+      int columnCount(int level) const;
+      int rowCount(int level) const;
+
+      double minimum(int level, int column, int row) const;
+      double maximum(int level, int column, int row) const;
+
+    private:
+      int m_blockSize; //!< Samples and lines of a level 0 block
+      QVector<int> m_columns; //!< Number of columns of blocks in each level
+      QVector<int> m_rows;    //!< Number of rows of blocks in each level
+      QVector< QVector<double> > m_minimums; //!< Block minimums of each level, row by row
+      QVector< QVector<double> > m_maximums; //!< Block maximums of each level, row by row
+  };
+}
+
+#endif
@@ -19,6 +19,7 @@
 
 #include "Cube.h"
 #include "CubeManager.h"
+#include "DemTileCache.h"
 #include "Distance.h"
 #include "EllipsoidShape.h"
 //#include "Geometry3D.h"
@@ -28,14 +29,12 @@
 //#include "LinearAlgebra.h"
 #include "Longitude.h"
 #include "NaifStatus.h"
-#include "Portal.h"
 #include "Projection.h"
 #include "Pvl.h"
 #include "Spice.h"
 #include "SurfacePoint.h"
 #include "Table.h"
 #include "Target.h"
-#include "UniqueIOCachingAlgorithm.h"
 
 using namespace std;
 
@@ -50,7 +49,6 @@ namespace Isis {
     m_demProj = NULL;
     m_demCube = NULL;
     m_interp = NULL;
-    m_portal = NULL;
   }
 
 
@@ -67,7 +65,6 @@ namespace Isis {
     m_demProj = NULL;
     m_demCube = NULL;
     m_interp = NULL;
-    m_portal = NULL;
 
     PvlGroup &kernels = pvl.findGroup("Kernels", Pvl::Traverse);
 
@@ -80,19 +77,11 @@ namespace Isis {
     }
 
     m_demCube = CubeManager::Open(demCubeFile);
-
-    // This caching algorithm works much better for DEMs than the default,
-    //   regional. This is because the uniqueIOCachingAlgorithm keeps track
-    //   of a history, which for something that isn't linearly processing a
-    //   cube is worth it. The regional caching algorithm tosses out results
-    //   from iteration 1 of setlookdirection (first algorithm) at iteration
-    //   4 and the next setimage has to re-read the data.
-    m_demCube->addCachingAlgorithm(new UniqueIOCachingAlgorithm(5));
     m_demProj = m_demCube->projection();
     m_interp = new Interpolator(Interpolator::BiLinearType);
-    m_portal = new Portal(m_interp->Samples(), m_interp->Lines(),
-                            m_demCube->pixelType(),
-                            m_interp->HotSample(), m_interp->HotLine());
+
+    // Radii are looked up from decoded tiles shared by every DemShape of the DEM
+    m_demCache = DemTileCache::cache(demCubeFile);
 
     // Read in the Scale of the DEM file in pixels/degree
     const PvlGroup &mapgrp = m_demCube->label()->findGroup("Mapping", Pvl::Traverse);
@@ -111,9 +100,6 @@ namespace Isis {
 
     delete m_interp;
     m_interp = NULL;
-
-    delete m_portal;
-    m_portal = NULL;
   }
 
 
@@ -267,13 +253,15 @@ namespace Isis {
       // if (!m_demProj->IsGood())
       //   return Distance();
 
-      m_portal->SetPosition(m_demProj->WorldX(), m_demProj->WorldY(), 1);
-
-      m_demCube->read(*m_portal);
+      // Read the window a Portal positioned at the pixel would hold
+      double buf[4];
+      m_demCache->readWindow((int) floor(m_demProj->WorldX() - m_interp->HotSample()),
+                             (int) floor(m_demProj->WorldY() - m_interp->HotLine()),
+                             m_interp->Samples(), m_interp->Lines(), buf, m_demTile);
 
       distance = Distance(m_interp->Interpolate(m_demProj->WorldX(),
                                                 m_demProj->WorldY(),
-                                                m_portal->DoubleBuffer()),
+                                                buf),
                                                 Distance::Meters);
     }
 
@@ -338,6 +326,28 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns the projection of the DEM. localRadius() sets its ground position
+   * on every call, so callers may move it freely.
+   *
+   * @return @b Projection* A pointer to the projection of the DEM cube.
+   */
+  Projection *DemShape::demProjection() {
+    return m_demProj;
+  }
+
+
+  /**
+   * Returns the decoded tiles of the DEM, shared with every other shape model
+   * of the same DEM.
+   *
+   * @return @b DemTileCache* A pointer to the tiles of the DEM cube.
+   */
+  DemTileCache *DemShape::demCache() {
+    return m_demCache.data();
+  }
+
+
   /**
    * Indicates that this shape model is from a DEM. Since this method returns
    * true for this class, the Camera class will calculate the local normal
@@ -22,6 +22,9 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <QSharedPointer>
+
+#include "DemTileCache.h"
 #include "ShapeModel.h"
 
 template<class T> class QVector;
@@ -29,7 +32,6 @@ template<class T> class QVector;
 namespace Isis {
   class Cube;
   class Interpolator;
-  class Portal;
   class Projection;
 
   /**
@@ -62,6 +64,11 @@ namespace Isis {
    *                           data areas. Fixes #4738.
    *   @history 2017-06-07 Kristin Berry - Added a using declaration so that the new 
    *                            intersectSurface methods in ShapeModel are accessible by DemShape.
+   *   @history 2026-10-19 ISIS Development Team - localRadius() reads the DEM from decoded
+   *                            tiles of a DemTileCache shared by all DemShapes of the DEM
+   *                            instead of reading a Portal from the cube for each lookup.
+   *   @history 2026-10-19 ISIS Development Team - Added demProjection() and demCache() for
+   *                            shapes that search the DEM themselves.
    *
    */
   class DemShape : public ShapeModel {
@@ -105,13 +112,16 @@ namespace Isis {
 
     protected:
      Cube *demCube();         //!< Returns the cube defining the shape model.
+     Projection *demProjection(); //!< Returns the projection of the shape model.
+     DemTileCache *demCache();    //!< Returns the decoded tiles of the shape model.
 
     private:
       Cube *m_demCube;        //!< The cube containing the model
       Projection *m_demProj;  //!< The projection of the model
       double m_pixPerDegree;  //!< Scale of DEM file in pixels per degree
-      Portal *m_portal;       //!< Buffer used to read from the model
       Interpolator *m_interp; //!< Use bilinear interpolation from dem
+      QSharedPointer<DemTileCache> m_demCache;            //!< Decoded tiles of the model
+      QSharedPointer<const DemTileCache::Tile> m_demTile; //!< Tile of the last lookup
   };
 }
 
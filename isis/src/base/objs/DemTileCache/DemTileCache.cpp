@@ -0,0 +1,276 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "DemTileCache.h"
+
+#include <algorithm>
+
+#include <QMutexLocker>
+
+#include "Brick.h"
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "DemMinMaxPyramid.h"
+#include "FileName.h"
+#include "IException.h"
+#include "IString.h"
+#include "Preference.h"
+#include "PvlGroup.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+  QMap< QString, QWeakPointer<DemTileCache> > DemTileCache::s_caches;
+  QMutex DemTileCache::s_cachesMutex;
+
+
+  /**
+   * Opens a DEM for caching.  No tiles are read until they are asked for.
+   *
+   * @param fileName The DEM cube, with any input attributes
+   * @param tileSize The number of samples and lines in a tile
+   * @param maxBytes The most memory the tiles may use. The whole DEM is kept
+   *                 if it fits, otherwise at least four tiles are kept.
+   *
+   * @throws IException::Programmer "The tile size must be positive"
+   */
+  DemTileCache::DemTileCache(const QString &fileName, int tileSize, BigInt maxBytes) :
+      m_cube(new Cube) {
+    if (tileSize < 1) {
+      QString msg = "The tile size must be positive, not [" + toString(tileSize) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Bands are the only thing input attributes can affect
+    CubeAttributeInput attIn(fileName);
+    m_cube->setVirtualBands(attIn.bands());
+    m_cube->open(fileName, "r");
+    m_samples = m_cube->sampleCount();
+    m_lines = m_cube->lineCount();
+    m_tileSize = tileSize;
+    m_tileColumns = (m_samples + tileSize - 1) / tileSize;
+    m_tileRows = (m_lines + tileSize - 1) / tileSize;
+
+    BigInt tileBytes = (BigInt)tileSize * tileSize * sizeof(double);
+    BigInt maxTiles = max((BigInt)4, maxBytes / tileBytes);
+    m_resident = ((BigInt)m_samples * m_lines * sizeof(double) <= maxBytes) ||
+                 ((BigInt)m_tileColumns * m_tileRows <= maxTiles);
+    m_maxTiles = (int) min(maxTiles, (BigInt)m_tileColumns * m_tileRows);
+
+    m_tiles.resize(m_tileColumns * m_tileRows);
+  }
+
+
+  //! Closes the DEM and releases the tiles
+  DemTileCache::~DemTileCache() {
+  }
+
+
+  /**
+   * Returns the cache of a DEM shared by the whole process, creating it if
+   * no one is using it.  The tile size is 256 and the memory the tiles may
+   * use is the DemTileCacheMemory keyword of the Performance preferences
+   * group, in megabytes.
+   *
+   * @param fileName The DEM cube, with any input attributes
+   *
+   * @return QSharedPointer<DemTileCache> The cache of the DEM
+   */
+  QSharedPointer<DemTileCache> DemTileCache::cache(const QString &fileName) {
+    CubeAttributeInput attIn(fileName);
+    QString key = FileName(fileName).expanded() + attIn.toString();
+
+    QMutexLocker lock(&s_cachesMutex);
+    QSharedPointer<DemTileCache> demCache = s_caches.value(key).toStrongRef();
+    if (demCache.isNull()) {
+      int megabytes = 1024;
+      PvlGroup &performancePrefs =
+          Preference::Preferences().findGroup("Performance");
+      if (performancePrefs.hasKeyword("DemTileCacheMemory")) {
+        megabytes = toInt(performancePrefs["DemTileCacheMemory"][0]);
+      }
+
+      demCache = QSharedPointer<DemTileCache>(
+          new DemTileCache(key, 256, (BigInt)megabytes * 1024 * 1024));
+      s_caches.insert(key, demCache);
+    }
+
+    return demCache;
+  }
+
+
+  /**
+   * @return int The number of samples in the DEM
+   */
+  int DemTileCache::sampleCount() const {
+    return m_samples;
+  }
+
+
+  /**
+   * @return int The number of lines in the DEM
+   */
+  int DemTileCache::lineCount() const {
+    return m_lines;
+  }
+
+
+  /**
+   * @return bool True if every tile is kept once it is read
+   */
+  bool DemTileCache::isResident() const {
+    return m_resident;
+  }
+
+
+  /**
+   * Returns the tile holding a pixel, reading it if it is not in memory.
+   * This is thread safe.
+   *
+   * @param sample The sample of the pixel
+   * @param line The line of the pixel
+   *
+   * @return QSharedPointer<const Tile> The tile, or null if the pixel is
+   *         outside of the DEM
+   */
+  QSharedPointer<const DemTileCache::Tile> DemTileCache::tile(int sample, int line) {
+    if (sample < 1 || line < 1 || sample > m_samples || line > m_lines) {
+      return QSharedPointer<const Tile>();
+    }
+
+    int column = (sample - 1) / m_tileSize;
+    int row = (line - 1) / m_tileSize;
+    int index = row * m_tileColumns + column;
+
+    QMutexLocker lock(&m_mutex);
+    if (!m_tiles[index].isNull()) {
+      return m_tiles[index];
+    }
+
+    QSharedPointer<Tile> newTile(new Tile);
+    newTile->startSample = column * m_tileSize + 1;
+    newTile->startLine = row * m_tileSize + 1;
+    newTile->samples = min(m_tileSize, m_samples - newTile->startSample + 1);
+    newTile->lines = min(m_tileSize, m_lines - newTile->startLine + 1);
+
+    Brick brick(newTile->samples, newTile->lines, 1, m_cube->pixelType());
+    brick.SetBasePosition(newTile->startSample, newTile->startLine, 1);
+    m_cube->read(brick);
+    newTile->data = QVector<double>(brick.size());
+    std::copy(brick.DoubleBuffer(), brick.DoubleBuffer() + brick.size(),
+              newTile->data.begin());
+
+    // Tiles still held by a caller stay valid after they are released here
+    if (!m_resident) {
+      if (m_readOrder.size() >= m_maxTiles) {
+        m_tiles[m_readOrder.dequeue()].clear();
+      }
+      m_readOrder.enqueue(index);
+    }
+
+    m_tiles[index] = newTile;
+    return m_tiles[index];
+  }
+
+
+  /**
+   * Returns the value of a pixel of the DEM.  This is thread safe.
+   *
+   * @param sample The sample of the pixel
+   * @param line The line of the pixel
+   *
+   * @return double The pixel value, NULL outside of the DEM
+   */
+  double DemTileCache::value(int sample, int line) {
+    QSharedPointer<const Tile> pixelTile = tile(sample, line);
+    if (pixelTile.isNull()) {
+      return Null;
+    }
+    return pixelTile->value(sample, line);
+  }
+
+
+  /**
+   * Copies a window of pixels out of the DEM, sample by sample and line by
+   * line, as a Portal would read it.  Pixels outside of the DEM are NULL.
+   *
+   * lastTile holds the tile the caller used last.  A window within it is
+   * copied without locking the cache, so each thread should keep its own.
+   *
+   * @param sample The first sample of the window
+   * @param line The first line of the window
+   * @param windowSamples The number of samples in the window
+   * @param windowLines The number of lines in the window
+   * @param buf Receives the pixels of the window
+   * @param lastTile The tile last used by the caller, replaced by the tile
+   *                 holding the window
+   */
+  void DemTileCache::readWindow(int sample, int line, int windowSamples, int windowLines,
+                                double buf[], QSharedPointer<const Tile> &lastTile) {
+    if (lastTile.isNull() || !lastTile->contains(sample, line, windowSamples, windowLines)) {
+      QSharedPointer<const Tile> windowTile = tile(sample, line);
+      if (!windowTile.isNull()) {
+        lastTile = windowTile;
+      }
+    }
+
+    if (!lastTile.isNull() && lastTile->contains(sample, line, windowSamples, windowLines)) {
+      for (int l = 0; l < windowLines; l++) {
+        for (int s = 0; s < windowSamples; s++) {
+          buf[l * windowSamples + s] = lastTile->value(sample + s, line + l);
+        }
+      }
+      return;
+    }
+
+    // The window crosses tiles or the edge of the DEM
+    for (int l = 0; l < windowLines; l++) {
+      for (int s = 0; s < windowSamples; s++) {
+        buf[l * windowSamples + s] = value(sample + s, line + l);
+      }
+    }
+  }
+
+
+  /**
+   * Returns the minimums and maximums of the DEM over a hierarchy of blocks,
+   * reading the whole DEM to build them the first time they are asked for.
+   * The level 0 blocks are 8 pixels square, or larger for big DEMs so that
+   * level 0 has no more than about a million blocks.  This is thread safe.
+   *
+   * @return QSharedPointer<const DemMinMaxPyramid> The pyramid of the DEM
+   */
+  QSharedPointer<const DemMinMaxPyramid> DemTileCache::pyramid() {
+    QMutexLocker lock(&m_pyramidMutex);
+    if (m_pyramid.isNull()) {
+      int blockSize = 8;
+      while ((BigInt)((m_samples + blockSize - 1) / blockSize) *
+             ((m_lines + blockSize - 1) / blockSize) > 1024 * 1024) {
+        blockSize *= 2;
+      }
+      m_pyramid = QSharedPointer<const DemMinMaxPyramid>(
+          new DemMinMaxPyramid(*this, blockSize));
+    }
+
+    return m_pyramid;
+  }
+}
@@ -0,0 +1,153 @@
+#ifndef DemTileCache_h
+#define DemTileCache_h
+
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QMap>
+#include <QMutex>
+#include <QQueue>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+#include <QWeakPointer>
+
+#include "Constants.h"
+
+namespace Isis {
+  class Cube;
+  class DemMinMaxPyramid;
+
+  /**
+   * @brief Decoded tiles of a DEM kept in memory
+   *
+   * Shape models look up the radius of a DEM many times for every ray they
+   * intersect, and each lookup reads a small window of the DEM.  This class
+   * reads the first band of a DEM in square tiles, converts them to double
+   * once, and keeps them so that the windows are copied out of memory.
+   *
+   * The tiles are read through a Cube of the cache's own, so the cache does
+   * not share file positions or buffers with other users of the DEM.  cache()
+   * returns one cache for each DEM file, shared by all the shape models of the
+   * process.  Tiles never change once they are read, so a tile can be used by
+   * any thread without locking, and readWindow() keeps the last tile a caller
+   * used so that most lookups do not touch the shared cache at all.
+   *
+   * When the whole DEM fits in the memory given by the DemTileCacheMemory
+   * keyword of the Performance preferences group, every tile stays in memory
+   * once it is read.  Otherwise the tiles read first are released first.
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   *   @history 2026-10-19 ISIS Development Team - Added pyramid() to share a
+   *                           DemMinMaxPyramid of the DEM.
+   */
+  class DemTileCache {
+    public:
+      /**
+       * A tile of decoded DEM pixels
+       *
+       * @author 2026-10-19 ISIS Development Team
+       *
+       * @internal
+       */
+      struct Tile {
+        Tile() : startSample(1), startLine(1), samples(0), lines(0), data() { }
+
+        /**
+         * Returns whether a window of pixels is entirely in the tile.
+         *
+         * @param sample The first sample of the window
+         * @param line The first line of the window
+         * @param windowSamples The number of samples in the window
+         * @param windowLines The number of lines in the window
+         *
+         * @return bool True if the window is in the tile
+         */
+        bool contains(int sample, int line, int windowSamples, int windowLines) const {
+          return (sample >= startSample) && (line >= startLine) &&
+                 (sample + windowSamples <= startSample + samples) &&
+                 (line + windowLines <= startLine + lines);
+        }
+
+        /**
+         * Returns the value of a pixel in the tile.
+         *
+         * @param sample The sample of the pixel
+         * @param line The line of the pixel
+         *
+         * @return double The pixel value
+         */
+        double value(int sample, int line) const {
+          return data[(line - startLine) * samples + sample - startSample];
+        }
+
+        int startSample;      //!< Sample of the first pixel of the tile
+        int startLine;        //!< Line of the first pixel of the tile
+        int samples;          //!< Number of samples in the tile
+        int lines;            //!< Number of lines in the tile
+        QVector<double> data; //!< Pixels of the tile, sample by sample
+      };
+
+      DemTileCache(const QString &fileName, int tileSize, BigInt maxBytes);
+      ~DemTileCache();
+
+      static QSharedPointer<DemTileCache> cache(const QString &fileName);
+
+      int sampleCount() const;
+      int lineCount() const;
+      bool isResident() const;
+
+      QSharedPointer<const Tile> tile(int sample, int line);
+      double value(int sample, int line);
+      void readWindow(int sample, int line, int windowSamples, int windowLines,
+                      double buf[], QSharedPointer<const Tile> &lastTile);
+
+      QSharedPointer<const DemMinMaxPyramid> pyramid();
+
+    private:
+      Q_DISABLE_COPY(DemTileCache);
+
+      QScopedPointer<Cube> m_cube;   //!< The DEM the tiles are read from
+      int m_samples;                 //!< Number of samples in the DEM
+      int m_lines;                   //!< Number of lines in the DEM
+      int m_tileSize;                //!< Samples and lines of a full tile
+      int m_tileColumns;             //!< Number of columns of tiles
+      int m_tileRows;                //!< Number of rows of tiles
+      int m_maxTiles;                //!< Most tiles kept at once
+      bool m_resident;               //!< Every tile is kept once read
+
+      QVector< QSharedPointer<const Tile> > m_tiles; //!< Tiles read, by index
+      QQueue<int> m_readOrder;       //!< Indexes of the kept tiles, oldest first
+      QMutex m_mutex;                //!< Guards the tiles and the cube
+
+      QSharedPointer<const DemMinMaxPyramid> m_pyramid; //!< Built on first use
+      QMutex m_pyramidMutex;         //!< Guards the pyramid while it is built
+
+      static QMap< QString, QWeakPointer<DemTileCache> > s_caches; //!< Caches by file
+      static QMutex s_cachesMutex;   //!< Guards the caches by file
+  };
+}
+
+#endif
@@ -46,9 +46,16 @@ namespace Isis {
  * count on that EmbreeTargetShape. If the EmbreeTargetShape is no longer used
  * by anything, then it is deleted.
  * 
+ * EmbreeTargetShapes are only shared within a process. Across processes,
+ * EmbreeTargetShape can keep the vertices and plates of each shape file in an
+ * on-disk cache, enabled by the EmbreeShapeCache preference, so later
+ * processes do not read the shape file again.
+ * 
  * @author 2017-05-08 Jesse mapel
  * @internal 
  *   @history 2017-05-08  Jesse Mapel - Original Version.
+ *   @history 2026-10-19  ISIS Development Team - Documented the on-disk cache of
+ *                            EmbreeTargetShape.
  */
   class EmbreeTargetManager {
     public:
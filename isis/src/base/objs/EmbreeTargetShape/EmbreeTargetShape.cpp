@@ -24,20 +24,53 @@
 
 #include "EmbreeTargetShape.h"
 
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <numeric>
 #include <sstream>
 
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStringList>
+#include <QVector>
+
 #include "NaifDskApi.h"
 
 #include "FileName.h"
 #include "IException.h"
 #include "IString.h"
 #include "NaifStatus.h"
+#include "Preference.h"
 #include "Pvl.h"
+#include "PvlGroup.h"
 
 namespace Isis {
+  //! Identifies shape cache files, "EMBC"
+  static const quint32 CacheMagic = 0x454D4243;
+
+  //! Changes whenever the layout of shape cache files changes
+  static const quint32 CacheVersion = 1;
+
+  /**
+   * The start of a shape cache file. It is followed by the stamp of the shape
+   * file, padded to a multiple of four bytes, then the x, y, z floats of each
+   * vertex and the three zero based vertex indices of each plate, all in the
+   * byte order of the machine that wrote it.
+   */
+  struct CacheHeader {
+    quint32 magic;       //!< CacheMagic
+    quint32 version;     //!< CacheVersion
+    quint32 stampBytes;  //!< Bytes of the UTF-8 stamp, without padding
+    qint32  vertices;    //!< Number of vertices
+    qint32  plates;      //!< Number of plates
+    quint32 reserved;    //!< Pads the header to a multiple of eight bytes
+  };
 
   /**
    * Default constructor for RTCMultiHitRay.
@@ -275,6 +308,10 @@ namespace Isis {
    * @param conf Pvl containing configuration settings for the target shape.
    *             Currently unused.
    * 
+   * If the shape file has a current cache file, the vertices and plates are
+   * read from it instead. Otherwise the cache file is rewritten once the
+   * shape file is read.
+   * 
    * @throws IException::Io
    */
   EmbreeTargetShape::EmbreeTargetShape(const QString &dem, const Pvl *conf)
@@ -289,19 +326,33 @@ namespace Isis {
     pcl::PolygonMesh::Ptr mesh;
     m_name = file.baseName();
 
+    QString cacheFile;
+    QString stamp;
+    bool cached = false;
+
     try {
       // DEMs (ISIS cubes) TODO implement this
       if (file.extension() == "cub") {
         QString msg = "DEMs cannot be used to create an EmbreeTargetShape.";
         throw IException(IException::Io, msg, _FILEINFO_);
       }
-      // DSKs
-      else if (file.extension() == "bds") {
-        mesh = readDSK(file);
+
+      cacheFile = cacheFileName(file);
+      if (!cacheFile.isEmpty() && file.fileExists()) {
+        stamp = cacheStamp(file);
+        mesh = readCache(cacheFile, stamp);
+        cached = mesh.get();
       }
-      // Let PCL try to handle other formats (obj, ply, etc.)
-      else {
-        mesh = readPC(file);
+
+      if (!cached) {
+        // DSKs
+        if (file.extension() == "bds") {
+          mesh = readDSK(file);
+        }
+        // Let PCL try to handle other formats (obj, ply, etc.)
+        else {
+          mesh = readPC(file);
+        }
       }
     }
     catch (IException &e) {
@@ -310,6 +361,10 @@ namespace Isis {
       throw IException(e, IException::Io, msg, _FILEINFO_);
     }
     initMesh(mesh);
+
+    if (!cached && !stamp.isEmpty()) {
+      writeCache(cacheFile, stamp);
+    }
   }
 
 
@@ -446,6 +501,195 @@ namespace Isis {
   }
 
 
+  /**
+   * Reads the vertices and plates of a shape from its cache file. The cache
+   * file is mapped into memory and its arrays are copied into the mesh without
+   * being parsed. Failing to read the cache file is not an error.
+   * 
+   * @param cacheFile The cache file of the shape
+   * @param stamp The current stamp of the shape file
+   * 
+   * @return @b pcl::PolygonMesh::Ptr A boost shared pointer to the mesh, or a
+   *                                   null pointer if the cache file is missing,
+   *                                   unreadable, or was written for a
+   *                                   different version of the shape file.
+   */
+  pcl::PolygonMesh::Ptr EmbreeTargetShape::readCache(const QString &cacheFile,
+                                                     const QString &stamp) {
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+      return pcl::PolygonMesh::Ptr();
+    }
+
+    qint64 fileBytes = file.size();
+    if (fileBytes < (qint64) sizeof(CacheHeader)) {
+      return pcl::PolygonMesh::Ptr();
+    }
+
+    const uchar *data = file.map(0, fileBytes);
+    if (!data) {
+      return pcl::PolygonMesh::Ptr();
+    }
+
+    const CacheHeader *header = (const CacheHeader *) data;
+    QByteArray stampBytes = stamp.toUtf8();
+    qint64 stampOffset = sizeof(CacheHeader);
+    qint64 vertexOffset = stampOffset + (((qint64) header->stampBytes + 3) / 4) * 4;
+    qint64 plateOffset = vertexOffset + (qint64) header->vertices * 3 * sizeof(float);
+    qint64 endOffset = plateOffset + (qint64) header->plates * 3 * sizeof(qint32);
+
+    if (header->magic != CacheMagic ||
+        header->version != CacheVersion ||
+        header->vertices < 0 ||
+        header->plates < 0 ||
+        header->stampBytes != (quint32) stampBytes.size() ||
+        endOffset != fileBytes ||
+        memcmp(data + stampOffset, stampBytes.constData(), stampBytes.size()) != 0) {
+      return pcl::PolygonMesh::Ptr();
+    }
+
+    const float *vertices = (const float *) (data + vertexOffset);
+    const qint32 *plates = (const qint32 *) (data + plateOffset);
+
+    pcl::PointCloud<pcl::PointXYZ> cloud;
+    cloud.points.resize(header->vertices);
+    cloud.width = header->vertices;
+    cloud.height = 1;
+    for (int vertexIndex = 0; vertexIndex < header->vertices; ++vertexIndex) {
+      cloud.points[vertexIndex].x = vertices[vertexIndex * 3];
+      cloud.points[vertexIndex].y = vertices[vertexIndex * 3 + 1];
+      cloud.points[vertexIndex].z = vertices[vertexIndex * 3 + 2];
+    }
+
+    pcl::PolygonMesh::Ptr mesh(new pcl::PolygonMesh);
+    mesh->polygons.resize(header->plates);
+    for (int plateIndex = 0; plateIndex < header->plates; ++plateIndex) {
+      const qint32 *plate = &plates[plateIndex * 3];
+      for (int corner = 0; corner < 3; ++corner) {
+        if (plate[corner] < 0 || plate[corner] >= header->vertices) {
+          return pcl::PolygonMesh::Ptr();
+        }
+      }
+      mesh->polygons[plateIndex].vertices.assign(plate, plate + 3);
+    }
+    pcl::toPCLPointCloud2(cloud, mesh->cloud);
+
+    return mesh;
+  }
+
+
+  /**
+   * Writes the vertices and plates of the internalized mesh to the cache file
+   * of its shape file. The whole file is written or nothing is, since other
+   * processes may be reading it. Failing to write the cache file is not an
+   * error.
+   * 
+   * @param cacheFile The cache file of the shape
+   * @param stamp The current stamp of the shape file
+   */
+  void EmbreeTargetShape::writeCache(const QString &cacheFile, const QString &stamp) {
+    if (!isValid()) {
+      return;
+    }
+
+    QByteArray stampBytes = stamp.toUtf8();
+    CacheHeader header;
+    header.magic = CacheMagic;
+    header.version = CacheVersion;
+    header.stampBytes = stampBytes.size();
+    header.vertices = numberOfVertices();
+    header.plates = numberOfPolygons();
+    header.reserved = 0;
+
+    QVector<float> vertices(header.vertices * 3);
+    for (int v = 0; v < header.vertices; ++v) {
+      vertices[v * 3] = m_cloud.points[v].x;
+      vertices[v * 3 + 1] = m_cloud.points[v].y;
+      vertices[v * 3 + 2] = m_cloud.points[v].z;
+    }
+
+    QVector<qint32> plates(header.plates * 3);
+    for (int t = 0; t < header.plates; ++t) {
+      plates[t * 3] = m_mesh->polygons[t].vertices[0];
+      plates[t * 3 + 1] = m_mesh->polygons[t].vertices[1];
+      plates[t * 3 + 2] = m_mesh->polygons[t].vertices[2];
+    }
+
+    // Pad the stamp so the arrays are aligned
+    stampBytes.append(QByteArray((4 - stampBytes.size() % 4) % 4, '\0'));
+
+    QSaveFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+      return;
+    }
+
+    qint64 vertexBytes = (qint64) vertices.size() * sizeof(float);
+    qint64 plateBytes = (qint64) plates.size() * sizeof(qint32);
+    bool written =
+        file.write((const char *) &header, sizeof(header)) == (qint64) sizeof(header) &&
+        file.write(stampBytes) == stampBytes.size() &&
+        file.write((const char *) vertices.constData(), vertexBytes) == vertexBytes &&
+        file.write((const char *) plates.constData(), plateBytes) == plateBytes;
+
+    if (written) {
+      file.commit();
+    }
+    else {
+      file.cancelWriting();
+    }
+  }
+
+
+  /**
+   * Returns the cache file name of a shape file. Cache files are named by a
+   * hash of the shape file path and kept in the directory given by the
+   * EmbreeShapeCache keyword of the Performance preferences group.
+   * 
+   * @param shapeFile The shape file
+   * 
+   * @return @b QString The cache file name, or an empty string if cache files
+   *                    are not enabled or the directory can not be created.
+   */
+  QString EmbreeTargetShape::cacheFileName(const FileName &shapeFile) {
+    Pvl &preferences = Preference::Preferences();
+    if (!preferences.hasGroup("Performance")) return "";
+
+    PvlGroup &performance = preferences.findGroup("Performance");
+    if (!performance.hasKeyword("EmbreeShapeCache")) return "";
+
+    QString cacheDir = performance["EmbreeShapeCache"];
+    if (cacheDir.isEmpty() || cacheDir.toUpper() == "NONE") return "";
+
+    cacheDir = FileName(cacheDir).expanded();
+    if (!QDir().mkpath(cacheDir)) return "";
+
+    QByteArray path = QFileInfo(shapeFile.expanded()).absoluteFilePath().toUtf8();
+    QString hash = QCryptographicHash::hash(path, QCryptographicHash::Md5).toHex();
+
+    return cacheDir + "/" + hash + ".embc";
+  }
+
+
+  /**
+   * Returns a string identifying the current contents of a shape file. It
+   * holds the path, size and modification time of the shape file.
+   * 
+   * @param shapeFile The shape file
+   * 
+   * @return @b QString The stamp stored in cache files
+   */
+  QString EmbreeTargetShape::cacheStamp(const FileName &shapeFile) {
+    QFileInfo shape(shapeFile.expanded());
+
+    QStringList stamp;
+    stamp << shape.absoluteFilePath()
+          << QString::number(shape.size())
+          << QString::number(shape.lastModified().toMSecsSinceEpoch());
+
+    return stamp.join("|");
+  }
+
+
   /**
    * Internalize a PointCloudLibrary polygon mesh in the target shape. The mesh
    * itself is stored along with a duplicate of the vertex point cloud because
@@ -148,9 +148,18 @@ namespace Isis {
  * are expected to be in the body-fixed reference frame for the target and all
  * positions are expected to be in kilometers.
  * 
+ * Reading a large shape file takes much longer than using it, so the vertices
+ * and plates read from a file can be kept in a cache file in the directory given
+ * by the EmbreeShapeCache keyword of the Performance preferences group, which
+ * is None by default. Later processes map the cache file into memory instead
+ * of reading the shape file, until the shape file changes.
+ * 
  * @author 2017-05-11 Jeannie Backer & Jesse Mapel
  * @internal 
  *   @history 2017-05-11 Jeannie Backer & Jesse Mapel - Original Version
+ *   @history 2026-10-19 ISIS Development Team - Shapes read from files are kept in cache
+ *                           files that later processes map into memory instead of reading
+ *                           the shape file again.
  */
   class EmbreeTargetShape {
     public:
@@ -176,14 +185,20 @@ namespace Isis {
       static void multiHitFilter(void* userDataPtr, RTCMultiHitRay& ray);
       static void occlusionFilter(void* userDataPtr, RTCOcclusionRay& ray);
 
+      static QString cacheFileName(const FileName &shapeFile);
+
     protected:
       pcl::PolygonMesh::Ptr readDSK(FileName file);
       pcl::PolygonMesh::Ptr readPC(FileName file);
+      pcl::PolygonMesh::Ptr readCache(const QString &cacheFile, const QString &stamp);
+      void writeCache(const QString &cacheFile, const QString &stamp);
       void initMesh(pcl::PolygonMesh::Ptr mesh);
       void addVertices(int geomID);
       void addIndices(int geomID);
 
     private:
+      static QString cacheStamp(const FileName &shapeFile);
+
       /**
        * Container for a vertex.
        * 
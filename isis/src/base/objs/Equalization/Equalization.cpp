@@ -1,11 +1,16 @@
 #include "Equalization.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <vector>
 
+#include <QFuture>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QString>
 #include <QStringList>
 #include <QVector>
+#include <QtConcurrentMap>
 
 #include "Buffer.h"
 #include "Cube.h"
@@ -17,6 +22,7 @@
 #include "OverlapStatistics.h"
 #include "Process.h"
 #include "ProcessByLine.h"
+#include "Progress.h"
 #include "Projection.h"
 #include "Pvl.h"
 #include "PvlGroup.h"
@@ -241,7 +247,12 @@ namespace Isis {
    * @brief Calculates the overlap statistics for each pair of input images
    * 
    * This method calculates any overlap statistics that have not been previously
-   * calculated for the input images.
+   * calculated for the input images. Only pairs of images whose mapping footprints
+   * overlap are considered. The statistics of the pairs are gathered in parallel on the
+   * global thread pool, and are then added to the normalizations in the order of the
+   * input images, so the solution does not depend on the order the pairs finish in.
+   *
+   * @throws IException::Unknown "Unable to gather the overlap statistics"
    */
   void Equalization::calculateOverlapStatistics() {
     // Add adjustments for all input images
@@ -249,53 +260,62 @@ namespace Isis {
       addAdjustment(new ImageAdjustment(m_sType));
     }
 
+    // Skip the pairs whose overlaps have already been calculated
+    QList< QPair<int, int> > pairs;
+    QList< QPair<int, int> > overlappingImages = findOverlappingImages();
+    for (int p = 0; p < overlappingImages.size(); p++) {
+      if (!m_alreadyCalculated[overlappingImages[p].first] ||
+          !m_alreadyCalculated[overlappingImages[p].second]) {
+        pairs.append(overlappingImages[p]);
+      }
+    }
+
+    Progress progress;
+    progress.SetText("Gathering Overlap Statistics");
+    progress.SetMaximumSteps(pairs.size());
+    progress.CheckStatus();
+
+    OverlapFunctor functor(m_imageList, m_samplingPercent);
+    QFuture<OverlapStatistics *> future = QtConcurrent::mapped(pairs, functor);
+
     // Find overlapping areas and add them to the set of known overlaps for
     // each band shared amongst cubes
-    for (int i = 0; i < m_imageList.size(); i++) {
-      Cube cube1; 
-      cube1.open(m_imageList[i].toString());
-
-      for (int j = (i + 1); j < m_imageList.size(); j++) {
-        // Skip if overlap already calculated
-        if (m_alreadyCalculated[i] == true && m_alreadyCalculated[j] == true) {
-          //cout << " *** Cube " << i << " vs Cube " << j << " already calculated." << endl;
-          //cout << endl << "    " << i << " = " << m_imageList[i].toString() << " ; " << j
-          //     << " = " << m_imageList[j].toString() << endl << endl;
-          continue;
-        }
-
-        Cube cube2;
-        cube2.open(m_imageList[j].toString());
-        QString cubeStr1 = toString((int)(i + 1));
-        QString cubeStr2 = toString((int)(j + 1));
-        QString statMsg = "Gathering Overlap Statisitcs for Cube " +
-                         cubeStr1 + " vs " + cubeStr2 + " of " +
-                         toString(m_maxCube);
-
-        // Get overlap statistics for new cubes
-        OverlapStatistics *oStats = new OverlapStatistics(cube1, cube2, statMsg, m_samplingPercent);
-        // Only push the stats onto the overlap statistics vector if there is an overlap in at
-        // least one of the bands
-        if (oStats->HasOverlap()) {
-          m_overlapStats.push_back(oStats);
-          oStats->SetMincount(m_mincnt);
-          for (int band = 1; band <= m_maxBand; band++) {
-            // Fill wt vector with 1's if the overlaps are not to be weighted, or
-            // fill the vector with the number of valid pixels in each overlap
-            int weight = 1;
-            if (m_wtopt) weight = oStats->GetMStats(band).ValidPixels();
-
-            // Make sure overlap has at least MINCOUNT valid pixels and add
-            if (oStats->GetMStats(band).ValidPixels() >= m_mincnt) {
-              m_overlapNorms[band - 1]->AddOverlap(
-                  oStats->GetMStats(band).X(), i,
-                  oStats->GetMStats(band).Y(), j, weight);
-              m_doesOverlapList[i] = true;
-              m_doesOverlapList[j] = true;
-            }
+    for (int p = 0; p < pairs.size(); p++) {
+      int i = pairs[p].first;
+      int j = pairs[p].second;
+      OverlapStatistics *oStats = future.resultAt(p);
+
+      // Only push the stats onto the overlap statistics vector if there is an overlap in at
+      // least one of the bands
+      if (oStats && oStats->HasOverlap()) {
+        m_overlapStats.push_back(oStats);
+        oStats->SetMincount(m_mincnt);
+        for (int band = 1; band <= m_maxBand; band++) {
+          // Fill wt vector with 1's if the overlaps are not to be weighted, or
+          // fill the vector with the number of valid pixels in each overlap
+          int weight = 1;
+          if (m_wtopt) weight = oStats->GetMStats(band).ValidPixels();
+
+          // Make sure overlap has at least MINCOUNT valid pixels and add
+          if (oStats->GetMStats(band).ValidPixels() >= m_mincnt) {
+            m_overlapNorms[band - 1]->AddOverlap(
+                oStats->GetMStats(band).X(), i,
+                oStats->GetMStats(band).Y(), j, weight);
+            m_doesOverlapList[i] = true;
+            m_doesOverlapList[j] = true;
           }
         }
       }
+      else {
+        delete oStats;
+      }
+
+      progress.CheckStatus();
+    }
+
+    if (functor.errorCount() > 0) {
+      QString msg = "Unable to gather the overlap statistics";
+      throw IException(functor.errors(), IException::Unknown, msg, _FILEINFO_);
     }
 
     // Compute the number valid and invalid overlaps
@@ -307,6 +327,58 @@ namespace Isis {
   }
 
 
+  /**
+   * @brief Finds the pairs of input images whose mapping footprints overlap
+   *
+   * The footprint of an image is the projection x/y range of its mapping label. The
+   * images are sorted by their minimum x and swept, so only images whose x ranges
+   * overlap are compared instead of every pair.
+   *
+   * @return QList< QPair<int, int> > The indices of the overlapping pairs, the first index
+   *                                  less than the second, sorted by the first index and
+   *                                  then the second
+   */
+  QList< QPair<int, int> > Equalization::findOverlappingImages() {
+    int images = m_imageList.size();
+    vector<double> minX(images), maxX(images), minY(images), maxY(images);
+
+    for (int img = 0; img < images; img++) {
+      Cube cube;
+      cube.open(m_imageList[img].toString());
+      Projection *proj = cube.projection();
+
+      minX[img] = proj->ToProjectionX(0.5);
+      maxY[img] = proj->ToProjectionY(0.5);
+      maxX[img] = proj->ToProjectionX(cube.sampleCount() + 0.5);
+      minY[img] = proj->ToProjectionY(cube.lineCount() + 0.5);
+    }
+
+    vector< pair<double, int> > order;
+    for (int img = 0; img < images; img++) {
+      order.push_back(make_pair(minX[img], img));
+    }
+    sort(order.begin(), order.end());
+
+    QList< QPair<int, int> > pairs;
+    for (int a = 0; a < images; a++) {
+      int i = order[a].second;
+
+      for (int b = a + 1; b < images && order[b].first < maxX[i]; b++) {
+        int j = order[b].second;
+
+        // The same test OverlapStatistics uses to find an overlap
+        if ((minX[i] < maxX[j]) && (maxX[i] > minX[j]) &&
+            (minY[i] < maxY[j]) && (maxY[i] > minY[j])) {
+          pairs.append(qMakePair(min(i, j), max(i, j)));
+        }
+      }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+  }
+
+
   /**
    * @brief Creates the results pvl containing statistics and corrective factors
    *
@@ -613,31 +685,30 @@ namespace Isis {
    * @throws IException::User "Mapping groups do not match between cubes"
    */
   void Equalization::errorCheck(QString fromListName) {
-    for (int i = 0; i < m_imageList.size(); i++) {
-      Cube cube1;
-      cube1.open(m_imageList[i].toString());
-
-      for (int j = (i + 1); j < m_imageList.size(); j++) {
-        Cube cube2;
-        cube2.open(m_imageList[j].toString());
-
-        // Make sure number of bands match
-        if (m_maxBand != cube2.bandCount()) {
-          QString msg = "Number of bands do not match between cubes [" +
-            m_imageList[i].toString() + "] and [" + m_imageList[j].toString() + "]";
-          throw IException(IException::User, msg, _FILEINFO_);
-        }
+    Cube cube1;
+    cube1.open(m_imageList[0].toString());
+    Projection *proj1 = cube1.projection();
+
+    // Each image is compared to the first one, so each image is only opened once
+    for (int j = 1; j < m_imageList.size(); j++) {
+      Cube cube2;
+      cube2.open(m_imageList[j].toString());
+
+      // Make sure number of bands match
+      if (m_maxBand != cube2.bandCount()) {
+        QString msg = "Number of bands do not match between cubes [" +
+          m_imageList[0].toString() + "] and [" + m_imageList[j].toString() + "]";
+        throw IException(IException::User, msg, _FILEINFO_);
+      }
 
-        //Create projection from each cube
-        Projection *proj1 = cube1.projection();
-        Projection *proj2 = cube2.projection();
+      //Create projection from each cube
+      Projection *proj2 = cube2.projection();
 
-        // Test to make sure projection parameters match
-        if (*proj1 != *proj2) {
-          QString msg = "Mapping groups do not match between cubes [" +
-            m_imageList[i].toString() + "] and [" + m_imageList[j].toString() + "]";
-          throw IException(IException::User, msg, _FILEINFO_);
-        }
+      // Test to make sure projection parameters match
+      if (*proj1 != *proj2) {
+        QString msg = "Mapping groups do not match between cubes [" +
+          m_imageList[0].toString() + "] and [" + m_imageList[j].toString() + "]";
+        throw IException(IException::User, msg, _FILEINFO_);
       }
     }
   }
@@ -971,6 +1042,65 @@ namespace Isis {
   }
 
 
+  /**
+   * Constructs an OverlapFunctor
+   *
+   * @param imageList The input images, which must outlive the functor
+   * @param percent Sampling percentage of the overlaps
+   */
+  Equalization::OverlapFunctor::OverlapFunctor(const FileList &imageList, double percent) :
+      m_errorsLock(new QMutex), m_errors(new IException), m_numErrors(new int(0)) {
+    m_imageList = &imageList;
+    m_percent = percent;
+  }
+
+
+  /**
+   * Calculates the statistics of the overlap of a pair of images. Errors are kept for
+   * errors() instead of being thrown, since they can not leave the thread pool.
+   *
+   * @param images The indices of the pair of images
+   *
+   * @return OverlapStatistics* The statistics, owned by the caller, or NULL on an error
+   */
+  OverlapStatistics *Equalization::OverlapFunctor::operator()(
+      const QPair<int, int> &images) const {
+    try {
+      Cube cube1;
+      cube1.open((*m_imageList)[images.first].toString());
+      Cube cube2;
+      cube2.open((*m_imageList)[images.second].toString());
+
+      // Progress of all of the pairs is reported by calculateOverlapStatistics()
+      return new OverlapStatistics(cube1, cube2, "", m_percent);
+    }
+    catch (IException &e) {
+      QMutexLocker locker(m_errorsLock.data());
+      m_errors->append(e);
+      (*m_numErrors)++;
+      return NULL;
+    }
+  }
+
+
+  /**
+   * @return int The number of calls that failed
+   */
+  int Equalization::OverlapFunctor::errorCount() const {
+    QMutexLocker locker(m_errorsLock.data());
+    return *m_numErrors;
+  }
+
+
+  /**
+   * @return IException The errors of the calls that failed
+   */
+  IException Equalization::OverlapFunctor::errors() const {
+    QMutexLocker locker(m_errorsLock.data());
+    return *m_errors;
+  }
+
+
   void Equalization::ApplyFunctor::operator()(Buffer &in, Buffer &out) const {
     int index = in.Band() - 1;
     for (int i = 0; i < in.size(); i++) {
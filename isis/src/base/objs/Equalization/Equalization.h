@@ -23,8 +23,11 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <functional>
 #include <vector>
 
+#include <QPair>
+#include <QSharedPointer>
 #include <QString>
 #include <QStringList>
 
@@ -34,8 +37,11 @@
 
 using namespace std;
 
+class QMutex;
+
 namespace Isis {
   class Buffer;
+  class IException;
   class OverlapStatistics;
   class Pvl;
   class PvlGroup;
@@ -134,6 +140,10 @@ namespace Isis {
    *                           in output PVL  on lines 100 and 123 to allow the test to pass when
    *                           not using the standard data areas. Added ReportError method to
    *                           remove paths when outputting errors. Fixes #4738.
+   *   @history 2026-10-19 ISIS Development Team - calculateOverlapStatistics() now only
+   *                           gathers statistics for images whose mapping footprints
+   *                           overlap, and gathers them on the global thread pool with
+   *                           OverlapFunctor. errorCheck() now opens each image once.
    */
   class Equalization {
     public:
@@ -302,8 +312,36 @@ namespace Isis {
       bool isSolved() const;
 
     private:
+      /**
+       * This class is used as a functor to calculate the statistics of the overlap of a
+       * pair of images on the global thread pool. Each call opens the pair of images and
+       * closes them before returning, so at most two images are open per thread.
+       *
+       * @author 2026-10-19 ISIS Development Team
+       *
+       * @internal
+       */
+      class OverlapFunctor :
+          public std::unary_function<const QPair<int, int> &, OverlapStatistics *> {
+        public:
+          OverlapFunctor(const FileList &imageList, double percent);
+
+          OverlapStatistics *operator()(const QPair<int, int> &images) const;
+
+          int errorCount() const;
+          IException errors() const;
+
+        private:
+          const FileList *m_imageList; //!< The input images
+          double m_percent; //!< Sampling percentage of the overlaps
+          QSharedPointer<QMutex> m_errorsLock; //!< Guards the errors between threads
+          QSharedPointer<IException> m_errors; //!< Errors from all of the calls
+          QSharedPointer<int> m_numErrors; //!< Number of calls that failed
+      };
+
       void init();
       QVector<int> validateInputStatistics(QString instatsFileName);
+      QList< QPair<int, int> > findOverlappingImages();
 
       bool m_normsSolved; //!< Indicates if corrective factors were solved
       bool m_recalculating; //!< Indicates if recalculating with loaded statistics
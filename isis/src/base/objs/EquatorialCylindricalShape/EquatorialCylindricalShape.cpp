@@ -14,12 +14,15 @@
 #include <SpiceZmc.h>
 
 #include "Cube.h"
+#include "DemMinMaxPyramid.h"
+#include "DemTileCache.h"
 #include "IException.h"
 // #include "Geometry3D.h"
 #include "Latitude.h"
 // #include "LinearAlgebra.h"
 #include "Longitude.h"
 #include "NaifStatus.h"
+#include "Projection.h"
 #include "SpecialPixel.h"
 #include "SurfacePoint.h"
 #include "Table.h"
@@ -249,6 +252,36 @@ namespace Isis {
         // Calculate the step size
         double dd = g1len * sin(dalpha) / sin(PI - psi2);
 
+        // Jump ahead while the ray stays above all of the DEM around it, and
+        // only step through the DEM a fraction of a pixel at a time near it
+        double skip = skipDistance(g1, ulookB);
+        if (skip > dd) {
+          d = d + skip;
+          g1[0] = observer[0] + d * ulookB[0];
+          g1[1] = observer[1] + d * ulookB[1];
+          g1[2] = observer[2] + d * ulookB[2];
+          g1len = vnorm_c(g1);
+
+          reclat_c(g1, &g1radius, &g1lon, &g1lat);
+          g1lat *= RAD2DEG;
+          g1lon *= RAD2DEG;
+
+          if (g1lon < 0.0) g1lon += 360.0;
+
+          r1 = (localRadius(Latitude(g1lat, Angle::Degrees),
+                            Longitude(g1lon, Angle::Degrees))).kilometers();
+
+          if (Isis::IsSpecial(r1)) {
+            setHasIntersection(false);
+            return hasIntersection();
+          }
+
+          vminus_c(g1, negg1);
+          psi1 = vsep_c(negg1, ulookB);
+          dalpha = MAX(cos(g1lat * DEG2RAD), cmin) / (2.0 * demScale() * RAD2DEG);
+          continue;
+        }
+
         // JAA:  If we are moving along the vector at a smaller increment than the pixel
         // tolerance we will be in an infinite loop.  The infinite loop is elimnated by
         // this test.  Now the algorithm produces a jagged limb in phocube.  This may
@@ -411,4 +444,137 @@ namespace Isis {
     return hasIntersection();
   }
   // Do nothing since the DEM intersection was already successful
+
+
+  /**
+   * Builds the radius pyramid of the DEM, or gets it from another shape model
+   * of the same DEM, and finds the latitudes and longitudes of the edges of
+   * its level 0 blocks.  The DEM is equatorial cylindrical, so the edges of a
+   * column of blocks are meridians and the edges of a row are parallels.
+   */
+  void EquatorialCylindricalShape::loadPyramid() {
+    DemTileCache *demTiles = demCache();
+    Projection *proj = demProjection();
+    m_pyramid = demTiles->pyramid();
+
+    int blockSize = m_pyramid->blockSize();
+    int samples = demTiles->sampleCount();
+    int lines = demTiles->lineCount();
+    double middleSample = (samples + 1) / 2.0;
+    double middleLine = (lines + 1) / 2.0;
+
+    bool northUp = true;
+    if (proj->SetWorld(middleSample, middleLine - 0.5)) {
+      double upperLatitude = proj->UniversalLatitude();
+      if (proj->SetWorld(middleSample, middleLine + 0.5)) {
+        northUp = (upperLatitude > proj->UniversalLatitude());
+      }
+    }
+
+    m_rowLatitudes.clear();
+    for (int row = 0; row <= m_pyramid->rowCount(0); row++) {
+      double edgeLine = min(row * blockSize, lines) + 0.5;
+      if (proj->SetWorld(middleSample, edgeLine)) {
+        m_rowLatitudes.append(proj->UniversalLatitude() * DEG2RAD);
+      }
+      else {
+        // The edge is in the padding beyond a pole
+        m_rowLatitudes.append(((edgeLine < middleLine) == northUp) ? HALFPI : -HALFPI);
+      }
+    }
+
+    m_columnLongitudes.clear();
+    for (int column = 0; column <= m_pyramid->columnCount(0); column++) {
+      double edgeSample = min(column * blockSize, samples) + 0.5;
+      proj->SetWorld(edgeSample, middleLine);
+      m_columnLongitudes.append(proj->UniversalLongitude() * DEG2RAD);
+    }
+  }
+
+
+  /**
+   * Finds how far a ray can go from a point without meeting the DEM.  Each
+   * level of the pyramid gives a bound: while the ray is above the highest
+   * radius of the block under the point, and has turned through less than the
+   * angle from the point to the edges of the block, it is over that block and
+   * above all of its terrain.  The longest of these distances is returned.
+   *
+   * @param point A point on the ray in body fixed coordinates, in kilometers
+   * @param look The unit direction of the ray
+   *
+   * @return @b double The distance in kilometers the ray can go from the point
+   *                   without meeting the DEM, 0 if it is not above the DEM
+   */
+  double EquatorialCylindricalShape::skipDistance(const double point[3], const double look[3]) {
+    if (m_pyramid.isNull()) {
+      loadPyramid();
+    }
+
+    SpiceDouble pointRadius, longitude, latitude;
+    reclat_c(point, &pointRadius, &longitude, &latitude);
+
+    double positiveLongitude = longitude * RAD2DEG;
+    if (positiveLongitude < 0.0) positiveLongitude += 360.0;
+
+    Projection *proj = demProjection();
+    if (!proj->SetUniversalGround(latitude * RAD2DEG, positiveLongitude)) {
+      return 0.0;
+    }
+
+    int sample = (int) floor(proj->WorldX() + 0.5);
+    int line = (int) floor(proj->WorldY() + 0.5);
+    if (sample < 1 || line < 1 ||
+        sample > demCache()->sampleCount() || line > demCache()->lineCount()) {
+      return 0.0;
+    }
+    int column = (sample - 1) / m_pyramid->blockSize();
+    int row = (line - 1) / m_pyramid->blockSize();
+
+    // The whole ray is at least closest from the center of the body
+    double along = vdot_c(point, look);
+    double closest = sqrt(MAX(0.0, pointRadius * pointRadius - along * along));
+    double cosLatitude = cos(latitude);
+
+    double skip = 0.0;
+    for (int level = 0; level < m_pyramid->levelCount(); level++) {
+      int levelColumn = column >> level;
+      int levelRow = row >> level;
+
+      // Coarser blocks are no lower and hold the same holes, so stop at the
+      // first block the ray is not above
+      double minRadius = m_pyramid->minimum(level, levelColumn, levelRow);
+      double maxRadius = m_pyramid->maximum(level, levelColumn, levelRow) / 1000.0;
+      if (minRadius > m_pyramid->maximum(level, levelColumn, levelRow) ||
+          pointRadius <= maxRadius) {
+        break;
+      }
+
+      // Distance to where the ray first comes down to the highest radius
+      double toTerrain = DBL_MAX;
+      double discriminant = along * along - pointRadius * pointRadius + maxRadius * maxRadius;
+      if (discriminant >= 0.0 && along < 0.0) {
+        toTerrain = -along - sqrt(discriminant);
+      }
+
+      // Angle from the point to the nearest edge of the block. The angle to a
+      // meridian is measured to its whole great circle, which is never farther.
+      int firstColumn = levelColumn << level;
+      int lastColumn = min((levelColumn + 1) << level, m_pyramid->columnCount(0));
+      int firstRow = levelRow << level;
+      int lastRow = min((levelRow + 1) << level, m_pyramid->rowCount(0));
+
+      double margin = min(fabs(latitude - m_rowLatitudes[firstRow]),
+                          fabs(latitude - m_rowLatitudes[lastRow]));
+      margin = min(margin,
+                   asin(fabs(sin(longitude - m_columnLongitudes[firstColumn])) * cosLatitude));
+      margin = min(margin,
+                   asin(fabs(sin(longitude - m_columnLongitudes[lastColumn])) * cosLatitude));
+
+      // Above the block, the ray turns through at most 1 / maxRadius radians
+      // per kilometer
+      skip = MAX(skip, min(margin * MAX(closest, maxRadius), toTerrain));
+    }
+
+    return skip;
+  }
 }
@@ -22,9 +22,13 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <QSharedPointer>
+#include <QVector>
+
 #include "DemShape.h"
 
 namespace Isis {
+  class DemMinMaxPyramid;
   class Pvl;
 
   /**
@@ -50,6 +54,10 @@ namespace Isis {
    *   @history 2018-01-05 Cole Neubauer - Fixed units conversion in intersectSurface so that the
    *                           loop is stepping by radians per pixel, as recommended by Jeff
    *                           Anderson (LROC team). Fixes #5245
+   *   @history 2026-10-19 ISIS Development Team - The iterative method of intersectSurface()
+   *                           skips along the ray wherever a DemMinMaxPyramid of the DEM shows
+   *                           it is above all of the terrain below it, so only the steps near
+   *                           the surface read the DEM.
    */
   class EquatorialCylindricalShape : public DemShape {
     public:
@@ -64,8 +72,15 @@ namespace Isis {
                             std::vector<double> lookDirection);
 
     private:
+      void loadPyramid();
+      double skipDistance(const double point[3], const double look[3]);
+
       Distance *m_minRadius;  //!< Minimum radius value in DEM file
       Distance *m_maxRadius;  //!< Maximum radius value in DEM file
+
+      QSharedPointer<const DemMinMaxPyramid> m_pyramid; //!< Radii of the DEM by block
+      QVector<double> m_columnLongitudes; //!< Longitudes of the level 0 block edges, radians
+      QVector<double> m_rowLatitudes;     //!< Latitudes of the level 0 block edges, radians
   };
 };
 
@@ -22,9 +22,315 @@
 
 #include "FourierTransform.h"
 
+#include <algorithm>
+#include <functional>
+
+#include <QList>
+#include <QtConcurrentMap>
+
+#include "IException.h"
+#include "IString.h"
+#include "Preference.h"
+#include "PvlGroup.h"
+
 using namespace std;
 
 namespace Isis {
+  namespace {
+    //! The number of values a task of a batched transform works on
+    const int TaskValues = 16384;
+
+    //! The number of columns gathered together by a column transform
+    const int ColumnBlock = 8;
+
+    /**
+     * The tables used to transform rows of one length.
+     */
+    struct FftPlan {
+      int n;                                   //!< The length of a row
+      std::vector<int> reversed;               //!< The bit reversed index of each index
+      std::vector< std::complex<double> > twiddles; //!< e^(-2 PI i k / n) for k < n / 2
+    };
+
+
+    /**
+     * Fills the tables for transforms of a length.
+     *
+     * @param n The length, a power of two
+     * @param plan Receives the tables
+     */
+    void makePlan(int n, FftPlan &plan) {
+      plan.n = n;
+      plan.reversed.resize(n);
+      plan.twiddles.resize(n / 2);
+
+      int bits = 0;
+      while ((1 << bits) < n) bits++;
+
+      for (int i = 0; i < n; i++) {
+        int reversed = 0;
+        for (int bit = 0; bit < bits; bit++) {
+          if (i & (1 << bit)) reversed |= 1 << (bits - 1 - bit);
+        }
+        plan.reversed[i] = reversed;
+      }
+
+      for (int k = 0; k < n / 2; k++) {
+        plan.twiddles[k] = polar(1.0, -2.0 * PI * k / n);
+      }
+    }
+
+
+    /**
+     * Transforms one row in place with the same iterative algorithm as
+     * FourierTransform::Transform(), using the tables of a plan.
+     *
+     * @param plan The tables for the length of the row
+     * @param row The row
+     * @param inverse True for the inverse transform, which is divided by n
+     */
+    void transformRow(const FftPlan &plan, std::complex<double> *row, bool inverse) {
+      int n = plan.n;
+
+      for (int i = 0; i < n; i++) {
+        int j = plan.reversed[i];
+        if (i < j) swap(row[i], row[j]);
+      }
+
+      for (int m = 1; m < n; m *= 2) {
+        int step = n / (2 * m);
+        for (int k = 0; k < n; k += 2 * m) {
+          for (int j = 0; j < m; j++) {
+            std::complex<double> w = plan.twiddles[j * step];
+            if (inverse) w = conj(w);
+            std::complex<double> t = w * row[k + j + m];
+            std::complex<double> u = row[k + j];
+            row[k + j] = u + t;
+            row[k + j + m] = u - t;
+          }
+        }
+      }
+
+      if (inverse) {
+        double scale = 1.0 / n;
+        for (int i = 0; i < n; i++) {
+          row[i] *= scale;
+        }
+      }
+    }
+
+
+    /**
+     * Transforms one row of real values into the first n / 2 + 1 values of
+     * its spectrum. The n real values are transformed as n / 2 complex
+     * values, which are then separated into the spectrum.
+     *
+     * @param plan The tables for length n / 2
+     * @param twiddles e^(-2 PI i k / n) for k < n / 2
+     * @param input The n real values
+     * @param output Receives n / 2 + 1 complex values
+     */
+    void realTransformRow(const FftPlan &plan,
+                          const std::vector< std::complex<double> > &twiddles,
+                          const double *input, std::complex<double> *output) {
+      int half = plan.n;
+      const std::complex<double> *pairs = reinterpret_cast<const std::complex<double> *>(input);
+      std::copy(pairs, pairs + half, output);
+      transformRow(plan, output, false);
+
+      std::complex<double> z = output[0];
+      output[0] = std::complex<double>(z.real() + z.imag(), 0.0);
+      output[half] = std::complex<double>(z.real() - z.imag(), 0.0);
+
+      for (int k = 1; k <= half / 2; k++) {
+        std::complex<double> a = output[k];
+        std::complex<double> b = output[half - k];
+        std::complex<double> even = 0.5 * (a + conj(b));
+        std::complex<double> odd = std::complex<double>(0.0, -0.5) * (a - conj(b));
+
+        output[k] = even + twiddles[k] * odd;
+        output[half - k] = conj(even) + twiddles[half - k] * conj(odd);
+      }
+    }
+
+
+    /**
+     * Inverts the first n / 2 + 1 values of the spectrum of a row of real
+     * values. The spectrum is combined into n / 2 complex values whose inverse
+     * transform holds the even and odd real values.
+     *
+     * @param plan The tables for length n / 2
+     * @param twiddles e^(-2 PI i k / n) for k < n / 2
+     * @param input The n / 2 + 1 complex values
+     * @param output Receives the n real values
+     */
+    void realInverseRow(const FftPlan &plan,
+                        const std::vector< std::complex<double> > &twiddles,
+                        const std::complex<double> *input, double *output) {
+      int half = plan.n;
+      std::complex<double> *pairs = reinterpret_cast<std::complex<double> *>(output);
+
+      for (int k = 0; k < half; k++) {
+        std::complex<double> a = input[k];
+        std::complex<double> b = conj(input[half - k]);
+        std::complex<double> even = 0.5 * (a + b);
+        std::complex<double> odd = 0.5 * (a - b) * conj(twiddles[k]);
+        pairs[k] = even + std::complex<double>(0.0, 1.0) * odd;
+      }
+
+      transformRow(plan, pairs, true);
+    }
+
+
+    /**
+     * Transforms a range of rows for QtConcurrent.
+     *
+     * @internal
+     */
+    class RowsFunctor : public std::unary_function<const int &, void> {
+      public:
+        //! The kinds of transform
+        enum Kind {
+          ComplexForward, //!< Complex rows, in place
+          ComplexInverse, //!< Complex rows, in place and divided by n
+          RealForward,    //!< Real rows into half spectra
+          RealInverse     //!< Half spectra into real rows
+        };
+
+        RowsFunctor(Kind kind, int n, int rows, int rowsPerTask,
+                    std::complex<double> *complexData, double *realData) {
+          m_kind = kind;
+          m_n = n;
+          m_rows = rows;
+          m_rowsPerTask = rowsPerTask;
+          m_complexData = complexData;
+          m_realData = realData;
+
+          if (kind == ComplexForward || kind == ComplexInverse || n == 1) {
+            makePlan(n, m_plan);
+          }
+          else {
+            makePlan(n / 2, m_plan);
+            for (int k = 0; k < n / 2; k++) {
+              m_twiddles.push_back(polar(1.0, -2.0 * PI * k / n));
+            }
+          }
+        }
+
+
+        void operator()(const int &task) const {
+          int first = task * m_rowsPerTask;
+          int last = min(m_rows, first + m_rowsPerTask);
+          int halfSpectrum = m_n / 2 + 1;
+
+          for (int row = first; row < last; row++) {
+            if (m_kind == ComplexForward || m_kind == ComplexInverse) {
+              transformRow(m_plan, m_complexData + (BigInt)row * m_n,
+                           m_kind == ComplexInverse);
+            }
+            else if (m_n == 1) {
+              if (m_kind == RealForward) {
+                m_complexData[row] = m_realData[row];
+              }
+              else {
+                m_realData[row] = m_complexData[row].real();
+              }
+            }
+            else if (m_kind == RealForward) {
+              realTransformRow(m_plan, m_twiddles, m_realData + (BigInt)row * m_n,
+                               m_complexData + (BigInt)row * halfSpectrum);
+            }
+            else {
+              realInverseRow(m_plan, m_twiddles, m_complexData + (BigInt)row * halfSpectrum,
+                             m_realData + (BigInt)row * m_n);
+            }
+          }
+        }
+
+      private:
+        Kind m_kind;                    //!< The kind of transform
+        int m_n;                        //!< The length of the real or complex rows
+        int m_rows;                     //!< The number of rows
+        int m_rowsPerTask;              //!< The number of rows in a task
+        std::complex<double> *m_complexData; //!< The complex rows or half spectra
+        double *m_realData;             //!< The real rows, if any
+        FftPlan m_plan;                 //!< The tables for the complex transforms
+        std::vector< std::complex<double> > m_twiddles; //!< The twiddles of real transforms
+    };
+
+
+    /**
+     * Transforms a block of neighbouring columns for QtConcurrent. The columns
+     * are gathered into rows, transformed and put back.
+     *
+     * @internal
+     */
+    class ColumnsFunctor : public std::unary_function<const int &, void> {
+      public:
+        ColumnsFunctor(std::complex<double> *data, int samples, int lines, bool inverse) {
+          m_data = data;
+          m_samples = samples;
+          m_lines = lines;
+          m_inverse = inverse;
+          makePlan(lines, m_plan);
+        }
+
+
+        void operator()(const int &block) const {
+          int first = block * ColumnBlock;
+          int columns = min(ColumnBlock, m_samples - first);
+          std::vector< std::complex<double> > rows((BigInt)columns * m_lines);
+
+          for (int line = 0; line < m_lines; line++) {
+            const std::complex<double> *values = m_data + (BigInt)line * m_samples + first;
+            for (int c = 0; c < columns; c++) {
+              rows[(BigInt)c * m_lines + line] = values[c];
+            }
+          }
+
+          for (int c = 0; c < columns; c++) {
+            transformRow(m_plan, &rows[(BigInt)c * m_lines], m_inverse);
+          }
+
+          for (int line = 0; line < m_lines; line++) {
+            std::complex<double> *values = m_data + (BigInt)line * m_samples + first;
+            for (int c = 0; c < columns; c++) {
+              values[c] = rows[(BigInt)c * m_lines + line];
+            }
+          }
+        }
+
+      private:
+        std::complex<double> *m_data; //!< The image
+        int m_samples;                //!< The number of samples in a line of the image
+        int m_lines;                  //!< The number of lines, the length of a column
+        bool m_inverse;               //!< True for the inverse transform
+        FftPlan m_plan;               //!< The tables for the length of a column
+    };
+
+
+    /**
+     * Runs a functor for each of a number of tasks, on the global thread pool
+     * if there is more than one.
+     *
+     * @param functor The functor
+     * @param tasks The number of tasks
+     */
+    template <typename Functor>
+    void runTasks(const Functor &functor, int tasks) {
+      if (tasks == 1) {
+        functor(0);
+        return;
+      }
+
+      QList<int> indices;
+      for (int i = 0; i < tasks; i++) {
+        indices.append(i);
+      }
+      QtConcurrent::blockingMap(indices, functor);
+    }
+  }
+
   //! Constructs the FourierTransform object.
   FourierTransform::FourierTransform() {};
 
@@ -104,6 +410,207 @@ namespace Isis {
     return output;
   }
 
+  /**
+   * Applies the Fourier transform in place to rows of complex data.
+   *
+   * @param data The rows, one after another
+   * @param n The length of a row, a power of two
+   * @param rows The number of rows
+   */
+  void FourierTransform::Transform(std::complex<double> *data, int n, int rows) const {
+    checkLength(n);
+    transformRows(data, n, rows, false);
+  }
+
+
+  /**
+   * Applies the inverse Fourier transform in place to rows of complex data.
+   * Like Inverse(), the result is divided by n.
+   *
+   * @param data The rows, one after another
+   * @param n The length of a row, a power of two
+   * @param rows The number of rows
+   */
+  void FourierTransform::Inverse(std::complex<double> *data, int n, int rows) const {
+    checkLength(n);
+    transformRows(data, n, rows, true);
+  }
+
+
+  /**
+   * Applies the Fourier transform to rows of real data. Only the first
+   * n / 2 + 1 values of the spectrum of each row are computed, since value
+   * n - k is the complex conjugate of value k.
+   *
+   * @param input The rows of n real values, one after another
+   * @param output Receives rows of n / 2 + 1 complex values
+   * @param n The length of a row, a power of two
+   * @param rows The number of rows
+   */
+  void FourierTransform::RealTransform(const double *input, std::complex<double> *output,
+                                       int n, int rows) const {
+    checkLength(n);
+    int rowsPerTask = max(1, TaskValues / n);
+    RowsFunctor functor(RowsFunctor::RealForward, n, rows, rowsPerTask,
+                        output, const_cast<double *>(input));
+    runTasks(functor, (rows + rowsPerTask - 1) / rowsPerTask);
+  }
+
+
+  /**
+   * Applies the inverse Fourier transform to the first n / 2 + 1 values of
+   * the spectra of rows of real data, the output of RealTransform(). The
+   * result is divided by n.
+   *
+   * @param input Rows of n / 2 + 1 complex values, one after another
+   * @param output Receives the rows of n real values
+   * @param n The length of a real row, a power of two
+   * @param rows The number of rows
+   */
+  void FourierTransform::RealInverse(const std::complex<double> *input, double *output,
+                                     int n, int rows) const {
+    checkLength(n);
+    int rowsPerTask = max(1, TaskValues / n);
+    RowsFunctor functor(RowsFunctor::RealInverse, n, rows, rowsPerTask,
+                        const_cast<std::complex<double> *>(input), output);
+    runTasks(functor, (rows + rowsPerTask - 1) / rowsPerTask);
+  }
+
+
+  /**
+   * Applies the 2D Fourier transform in place to an image of complex data.
+   *
+   * @param data The image, one line after another
+   * @param samples The number of samples in a line, a power of two
+   * @param lines The number of lines, a power of two
+   */
+  void FourierTransform::Transform2D(std::complex<double> *data, int samples,
+                                     int lines) const {
+    checkLength(samples);
+    checkLength(lines);
+    transformRows(data, samples, lines, false);
+    transformColumns(data, samples, lines, false);
+  }
+
+
+  /**
+   * Applies the inverse 2D Fourier transform in place to an image of complex
+   * data. The result is divided by the number of pixels.
+   *
+   * @param data The image, one line after another
+   * @param samples The number of samples in a line, a power of two
+   * @param lines The number of lines, a power of two
+   */
+  void FourierTransform::Inverse2D(std::complex<double> *data, int samples,
+                                   int lines) const {
+    checkLength(samples);
+    checkLength(lines);
+    transformRows(data, samples, lines, true);
+    transformColumns(data, samples, lines, true);
+  }
+
+
+  /**
+   * Applies the 2D Fourier transform to an image of real data. Only the
+   * first samples / 2 + 1 columns of the spectrum are computed. The rest are
+   * the complex conjugates of the values mirrored through the origin.
+   *
+   * @param input The image, one line after another
+   * @param output Receives lines rows of samples / 2 + 1 complex values
+   * @param samples The number of samples in a line, a power of two
+   * @param lines The number of lines, a power of two
+   */
+  void FourierTransform::RealTransform2D(const double *input, std::complex<double> *output,
+                                         int samples, int lines) const {
+    checkLength(lines);
+    RealTransform(input, output, samples, lines);
+    transformColumns(output, samples / 2 + 1, lines, false);
+  }
+
+
+  /**
+   * Applies the inverse 2D Fourier transform to the output of
+   * RealTransform2D(). The result is divided by the number of pixels.
+   *
+   * @param input The lines rows of samples / 2 + 1 complex values. They are
+   *              overwritten by the inverse transform of their columns.
+   * @param output Receives the image, one line after another
+   * @param samples The number of samples in a line, a power of two
+   * @param lines The number of lines, a power of two
+   */
+  void FourierTransform::RealInverse2D(std::complex<double> *input, double *output,
+                                       int samples, int lines) const {
+    checkLength(samples);
+    checkLength(lines);
+    transformColumns(input, samples / 2 + 1, lines, true);
+    RealInverse(input, output, samples, lines);
+  }
+
+
+  /**
+   * The number of bytes programs may use to transform images in memory with
+   * the 2D transforms, from the FourierTransformMemory performance
+   * preference. Larger images are transformed a line or a column at a time.
+   *
+   * @return BigInt The number of bytes
+   */
+  BigInt FourierTransform::MemoryLimit() const {
+    int megabytes = 1024;
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    if (performancePrefs.hasKeyword("FourierTransformMemory")) {
+      megabytes = toInt(performancePrefs["FourierTransformMemory"][0]);
+    }
+    return (BigInt)megabytes * 1024 * 1024;
+  }
+
+
+  /**
+   * Transforms rows of complex data in place on the global thread pool.
+   *
+   * @param data The rows, one after another
+   * @param n The length of a row, a power of two
+   * @param rows The number of rows
+   * @param inverse True for the inverse transform
+   */
+  void FourierTransform::transformRows(std::complex<double> *data, int n, int rows,
+                                       bool inverse) {
+    int rowsPerTask = max(1, TaskValues / n);
+    RowsFunctor functor(inverse ? RowsFunctor::ComplexInverse : RowsFunctor::ComplexForward,
+                        n, rows, rowsPerTask, data, NULL);
+    runTasks(functor, (rows + rowsPerTask - 1) / rowsPerTask);
+  }
+
+
+  /**
+   * Transforms the columns of an image of complex data in place on the
+   * global thread pool.
+   *
+   * @param data The image, one line after another
+   * @param samples The number of samples in a line
+   * @param lines The number of lines, the length of a column, a power of two
+   * @param inverse True for the inverse transform
+   */
+  void FourierTransform::transformColumns(std::complex<double> *data, int samples,
+                                          int lines, bool inverse) {
+    ColumnsFunctor functor(data, samples, lines, inverse);
+    runTasks(functor, (samples + ColumnBlock - 1) / ColumnBlock);
+  }
+
+
+  /**
+   * Checks that the length of a transform of an array is a power of two.
+   *
+   * @param n The length
+   */
+  void FourierTransform::checkLength(int n) {
+    if (n < 1 || (n & (n - 1)) != 0) {
+      QString msg = "The length of a Fourier transform of an array must be a power of two, "
+                    "not [" + toString(n) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+  }
+
+
   /**
    * Checks to see if the input integer is a power of two
    *
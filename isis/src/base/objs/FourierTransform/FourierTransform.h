@@ -39,11 +39,21 @@ namespace Isis {
    * If you would like to see FourierTransform being used
    *         in implementation, see fft.cpp or ifft.cpp.
    *
+   * The methods that take arrays transform many rows of a power of two length
+   * at once, in place or from real data, on the global thread pool. Real data
+   * of n values has a spectrum of n / 2 + 1 complex values per row, the rest
+   * of the spectrum being their complex conjugates. The 2D methods transform
+   * the rows and then the columns of an image held in memory, one line after
+   * another.
+   *
    * @ingroup Math and Statistics
    *
    * @author 2005-11-28 Jacob Danton
    *
    * @internal
+   *   @history 2026-10-19 ISIS Development Team - Added batched, real-to-complex
+   *                           and 2D transforms of arrays that run on the global
+   *                           thread pool, and MemoryLimit().
    */
   class FourierTransform {
     public:
@@ -51,10 +61,34 @@ namespace Isis {
       ~FourierTransform();
       std::vector< std::complex<double> > Transform(std::vector< std::complex<double> > input);
       std::vector< std::complex<double> > Inverse(std::vector< std::complex<double> > input);
+
+      void Transform(std::complex<double> *data, int n, int rows = 1) const;
+      void Inverse(std::complex<double> *data, int n, int rows = 1) const;
+      void RealTransform(const double *input, std::complex<double> *output,
+                         int n, int rows = 1) const;
+      void RealInverse(const std::complex<double> *input, double *output,
+                       int n, int rows = 1) const;
+
+      void Transform2D(std::complex<double> *data, int samples, int lines) const;
+      void Inverse2D(std::complex<double> *data, int samples, int lines) const;
+      void RealTransform2D(const double *input, std::complex<double> *output,
+                           int samples, int lines) const;
+      void RealInverse2D(std::complex<double> *input, double *output,
+                         int samples, int lines) const;
+
+      BigInt MemoryLimit() const;
+
       bool IsPowerOfTwo(int n);
       int lg(int n);
       int BitReverse(int n, int x);
       int NextPowerOfTwo(int n);
+
+    private:
+      static void transformRows(std::complex<double> *data, int n, int rows,
+                                bool inverse);
+      static void transformColumns(std::complex<double> *data, int samples,
+                                   int lines, bool inverse);
+      static void checkLength(int n);
   };
 }
 
@@ -0,0 +1,624 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "GeometryBackplanes.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <SpiceUsr.h>
+
+#include "Angle.h"
+#include "Brick.h"
+#include "Camera.h"
+#include "Cube.h"
+#include "Distance.h"
+#include "IException.h"
+#include "IString.h"
+#include "Latitude.h"
+#include "Longitude.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "ShapeModel.h"
+#include "SpecialPixel.h"
+#include "SurfacePoint.h"
+#include "Target.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Create backplanes for the given camera. The angles are evaluated exactly
+   * at every pixel until setTolerance() is called.
+   *
+   * @param camera The camera of the image, which must stay valid for the
+   *               lifetime of this object
+   */
+  GeometryBackplanes::GeometryBackplanes(Camera *camera) {
+    m_camera = camera;
+    m_tolerance = 0.0;
+    m_gridSpacing = 8;
+    m_localAngles = false;
+
+    m_startSample = 1;
+    m_startLine = 1;
+    m_samples = 0;
+    m_lines = 0;
+  }
+
+
+  //! Destroys the backplanes
+  GeometryBackplanes::~GeometryBackplanes() {
+  }
+
+
+  /**
+   * Set the allowed difference between interpolated and exact angles. A
+   * tolerance of 0 evaluates every pixel exactly.
+   *
+   * @param degrees The tolerance in degrees
+   */
+  void GeometryBackplanes::setTolerance(double degrees) {
+    m_tolerance = degrees;
+  }
+
+
+  /**
+   * @return The allowed difference between interpolated and exact angles, in
+   *         degrees
+   */
+  double GeometryBackplanes::tolerance() const {
+    return m_tolerance;
+  }
+
+
+  /**
+   * Set the distance between the grid nodes which are evaluated exactly when
+   * interpolating. The default is 8 pixels.
+   *
+   * @param pixels The distance in pixels, at least 2
+   */
+  void GeometryBackplanes::setGridSpacing(int pixels) {
+    if (pixels < 2) {
+      QString msg = "The backplane grid spacing must be at least 2 pixels, "
+                    "not [" + toString(pixels) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_gridSpacing = pixels;
+  }
+
+
+  /**
+   * @return The distance between the grid nodes in pixels
+   */
+  int GeometryBackplanes::gridSpacing() const {
+    return m_gridSpacing;
+  }
+
+
+  /**
+   * Set whether the local incidence and emission angles are computed. Local
+   * angles turn off interpolation.
+   *
+   * @param local True to compute the local angles
+   */
+  void GeometryBackplanes::setLocalAngles(bool local) {
+    m_localAngles = local;
+  }
+
+
+  /**
+   * @return True if the local incidence and emission angles are computed
+   */
+  bool GeometryBackplanes::localAngles() const {
+    return m_localAngles;
+  }
+
+
+  /**
+   * Compute the angles of a rectangle of pixels. The angles are indexed by
+   * pixel like a single band Buffer of the rectangle, so sample varies the
+   * fastest.
+   *
+   * @param startSample The first sample of the rectangle
+   * @param startLine The first line of the rectangle
+   * @param samples The number of samples in the rectangle
+   * @param lines The number of lines in the rectangle
+   */
+  void GeometryBackplanes::compute(int startSample, int startLine,
+                                   int samples, int lines) {
+    if (samples < 1 || lines < 1) {
+      QString msg = "Unable to compute backplanes for [" + toString(samples) +
+                    "] samples and [" + toString(lines) + "] lines";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_startSample = startSample;
+    m_startLine = startLine;
+    m_samples = samples;
+    m_lines = lines;
+
+    int pixels = samples * lines;
+    m_state.fill(0, pixels);
+    m_valid.fill(false, pixels);
+    m_phase.fill(Null, pixels);
+    m_incidence.fill(Null, pixels);
+    m_emission.fill(Null, pixels);
+    m_localIncidence.fill(Null, pixels);
+    m_localEmission.fill(Null, pixels);
+
+    if (m_localAngles) {
+      EdgePoint unset;
+      unset.state = 0;
+      unset.position[0] = unset.position[1] = unset.position[2] = 0.0;
+
+      m_lineEdges.fill(unset, (lines + 1) * samples);
+      m_sampleEdges.fill(unset, lines * (samples + 1));
+      m_centers.fill(unset, pixels);
+    }
+
+    if (m_localAngles || m_tolerance <= 0.0) {
+      for (int line = 0; line < m_lines; line++) {
+        for (int sample = 0; sample < m_samples; sample++) {
+          computePixel(sample, line);
+        }
+      }
+    }
+    else {
+      computeGrid();
+    }
+  }
+
+
+  /**
+   * @return The number of pixels in the last computed rectangle
+   */
+  int GeometryBackplanes::size() const {
+    return m_valid.size();
+  }
+
+
+  /**
+   * @param index The pixel index in the rectangle
+   *
+   * @return True if the pixel intersects the target
+   */
+  bool GeometryBackplanes::isValid(int index) const {
+    return m_valid[index];
+  }
+
+
+  /**
+   * @param index The pixel index in the rectangle
+   *
+   * @return The phase angle in degrees, Null if the pixel is not valid
+   */
+  double GeometryBackplanes::phase(int index) const {
+    return m_phase[index];
+  }
+
+
+  /**
+   * @param index The pixel index in the rectangle
+   *
+   * @return The incidence angle in degrees, Null if the pixel is not valid
+   */
+  double GeometryBackplanes::incidence(int index) const {
+    return m_incidence[index];
+  }
+
+
+  /**
+   * @param index The pixel index in the rectangle
+   *
+   * @return The emission angle in degrees, Null if the pixel is not valid
+   */
+  double GeometryBackplanes::emission(int index) const {
+    return m_emission[index];
+  }
+
+
+  /**
+   * @param index The pixel index in the rectangle
+   *
+   * @return The local incidence angle in degrees, Null if it could not be
+   *         computed or local angles are not computed
+   */
+  double GeometryBackplanes::localIncidence(int index) const {
+    return m_localIncidence[index];
+  }
+
+
+  /**
+   * @param index The pixel index in the rectangle
+   *
+   * @return The local emission angle in degrees, Null if it could not be
+   *         computed or local angles are not computed
+   */
+  double GeometryBackplanes::localEmission(int index) const {
+    return m_localEmission[index];
+  }
+
+
+  /**
+   * Create a cube for writeSidecar(). The cube has the bands Phase Angle,
+   * Incidence Angle, Emission Angle, Local Incidence Angle and Local Emission
+   * Angle.
+   *
+   * @param sidecar The cube to create
+   * @param fileName The file name of the cube
+   * @param samples The number of samples of the image
+   * @param lines The number of lines of the image
+   */
+  void GeometryBackplanes::createSidecar(Cube &sidecar, const QString &fileName,
+                                         int samples, int lines) {
+    sidecar.setDimensions(samples, lines, 5);
+    sidecar.setPixelType(Real);
+    sidecar.create(fileName);
+
+    PvlKeyword name("Name");
+    name += "Phase Angle";
+    name += "Incidence Angle";
+    name += "Emission Angle";
+    name += "Local Incidence Angle";
+    name += "Local Emission Angle";
+
+    PvlGroup bandBin("BandBin");
+    bandBin += name;
+    sidecar.putGroup(bandBin);
+  }
+
+
+  /**
+   * Write the angles of the last computed rectangle to a cube created with
+   * createSidecar().
+   *
+   * @param sidecar The cube to write to
+   */
+  void GeometryBackplanes::writeSidecar(Cube &sidecar) const {
+    Brick brick(m_samples, m_lines, 5, Real);
+    brick.SetBasePosition(m_startSample, m_startLine, 1);
+
+    int pixels = size();
+    for (int i = 0; i < pixels; i++) {
+      brick[i] = m_phase[i];
+      brick[i + pixels] = m_incidence[i];
+      brick[i + 2 * pixels] = m_emission[i];
+      brick[i + 3 * pixels] = m_localIncidence[i];
+      brick[i + 4 * pixels] = m_localEmission[i];
+    }
+
+    sidecar.write(brick);
+  }
+
+
+  /**
+   * Evaluate the grid nodes exactly and interpolate the cells between them
+   * where the angles are smooth enough.
+   */
+  void GeometryBackplanes::computeGrid() {
+    QVector<int> sampleNodes;
+    for (int sample = 0; sample < m_samples - 1; sample += m_gridSpacing) {
+      sampleNodes.append(sample);
+    }
+    sampleNodes.append(m_samples - 1);
+
+    QVector<int> lineNodes;
+    for (int line = 0; line < m_lines - 1; line += m_gridSpacing) {
+      lineNodes.append(line);
+    }
+    lineNodes.append(m_lines - 1);
+
+    for (int l = 0; l < lineNodes.size(); l++) {
+      for (int s = 0; s < sampleNodes.size(); s++) {
+        computePixel(sampleNodes[s], lineNodes[l]);
+      }
+    }
+
+    // A rectangle one pixel wide or high has cells without an extent
+    int lineCells = std::max(lineNodes.size() - 1, 1);
+    int sampleCells = std::max(sampleNodes.size() - 1, 1);
+
+    for (int l = 0; l < lineCells; l++) {
+      int line0 = lineNodes[l];
+      int line1 = lineNodes[std::min(l + 1, lineNodes.size() - 1)];
+
+      for (int s = 0; s < sampleCells; s++) {
+        int sample0 = sampleNodes[s];
+        int sample1 = sampleNodes[std::min(s + 1, sampleNodes.size() - 1)];
+
+        bool smooth = m_valid[line0 * m_samples + sample0] &&
+                      m_valid[line0 * m_samples + sample1] &&
+                      m_valid[line1 * m_samples + sample0] &&
+                      m_valid[line1 * m_samples + sample1];
+
+        // The center and the middles of the edges must be valid and close
+        // to the interpolated angles. The edge middles are shared with the
+        // neighboring cells.
+        if (smooth) {
+          int sample = (sample0 + sample1) / 2;
+          int line = (line0 + line1) / 2;
+          smooth = isInterpolated(sample0, line0, sample1, line1, sample, line) &&
+                   isInterpolated(sample0, line0, sample1, line1, sample, line0) &&
+                   isInterpolated(sample0, line0, sample1, line1, sample, line1) &&
+                   isInterpolated(sample0, line0, sample1, line1, sample0, line) &&
+                   isInterpolated(sample0, line0, sample1, line1, sample1, line);
+        }
+
+        for (int line = line0; line <= line1; line++) {
+          for (int sample = sample0; sample <= sample1; sample++) {
+            int index = line * m_samples + sample;
+            if (m_state[index] != 0) {
+              continue;
+            }
+
+            if (smooth) {
+              double angles[3];
+              interpolate(sample0, line0, sample1, line1, sample, line, angles);
+
+              m_state[index] = 2;
+              m_valid[index] = true;
+              m_phase[index] = angles[0];
+              m_incidence[index] = angles[1];
+              m_emission[index] = angles[2];
+            }
+            else {
+              computePixel(sample, line);
+            }
+          }
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Evaluate a pixel of a grid cell exactly and compare it to the angles
+   * interpolated from the corners of the cell.
+   *
+   * @param sample0 The first sample of the cell
+   * @param line0 The first line of the cell
+   * @param sample1 The last sample of the cell
+   * @param line1 The last line of the cell
+   * @param sample The sample of the pixel in the rectangle, starting at 0
+   * @param line The line of the pixel in the rectangle, starting at 0
+   *
+   * @return bool True if the pixel is valid and its angles are within the
+   *         tolerance of the interpolated ones
+   */
+  bool GeometryBackplanes::isInterpolated(int sample0, int line0, int sample1, int line1,
+                                          int sample, int line) {
+    int index = line * m_samples + sample;
+    computePixel(sample, line);
+    if (!m_valid[index]) {
+      return false;
+    }
+
+    double angles[3];
+    interpolate(sample0, line0, sample1, line1, sample, line, angles);
+
+    return fabs(angles[0] - m_phase[index]) <= m_tolerance &&
+           fabs(angles[1] - m_incidence[index]) <= m_tolerance &&
+           fabs(angles[2] - m_emission[index]) <= m_tolerance;
+  }
+
+
+  /**
+   * Evaluate the angles of a pixel with the camera, unless that was done
+   * already.
+   *
+   * @param sample The sample of the pixel in the rectangle, starting at 0
+   * @param line The line of the pixel in the rectangle, starting at 0
+   */
+  void GeometryBackplanes::computePixel(int sample, int line) {
+    int index = line * m_samples + sample;
+    if (m_state[index] == 1) {
+      return;
+    }
+
+    m_state[index] = 1;
+    if (!m_camera->SetImage(m_startSample + sample, m_startLine + line)) {
+      return;
+    }
+
+    m_valid[index] = true;
+    m_phase[index] = m_camera->PhaseAngle();
+    m_incidence[index] = m_camera->IncidenceAngle();
+    m_emission[index] = m_camera->EmissionAngle();
+
+    if (m_localAngles) {
+      double incidence, emission;
+      if (localPhotometricAngles(sample, line, incidence, emission)) {
+        m_localIncidence[index] = incidence;
+        m_localEmission[index] = emission;
+      }
+    }
+  }
+
+
+  /**
+   * Compute the local angles of the pixel the camera is set to. This gives
+   * the same results as Camera::LocalPhotometricAngles(), but the DEM points
+   * around the pixel are shared with its neighbors.
+   *
+   * @param sample The sample of the pixel in the rectangle, starting at 0
+   * @param line The line of the pixel in the rectangle, starting at 0
+   * @param incidence The local incidence angle in degrees
+   * @param emission The local emission angle in degrees
+   *
+   * @return bool False if the local normal could not be computed
+   */
+  bool GeometryBackplanes::localPhotometricAngles(int sample, int line,
+                                                  double &incidence,
+                                                  double &emission) {
+    // Shapes other than DEMs do not use the neighboring points
+    if (!m_camera->target()->shape()->isDEM()) {
+      Angle phaseAngle, incidenceAngle, emissionAngle;
+      bool success;
+      m_camera->LocalPhotometricAngles(phaseAngle, incidenceAngle,
+                                       emissionAngle, success);
+      incidence = incidenceAngle.degrees();
+      emission = emissionAngle.degrees();
+      return success;
+    }
+
+    // Keep the geometry of the pixel before the camera moves to its edges
+    double pB[3], sB[3], uB[3];
+    m_camera->GetSurfacePoint().ToNaifArray(pB);
+    m_camera->instrumentBodyFixedPosition(sB);
+    m_camera->sunPosition(uB);
+
+    double imageSample = m_startSample + sample;
+    double imageLine = m_startLine + line;
+    int index = line * m_samples + sample;
+
+    // order of points is top, bottom, left, right
+    const EdgePoint *neighbors[4] = {
+      &edgePoint(m_lineEdges, index, imageSample, imageLine - 0.5),
+      &edgePoint(m_lineEdges, index + m_samples, imageSample, imageLine + 0.5),
+      &edgePoint(m_sampleEdges, line * (m_samples + 1) + sample,
+                 imageSample - 0.5, imageLine),
+      &edgePoint(m_sampleEdges, line * (m_samples + 1) + sample + 1,
+                 imageSample + 0.5, imageLine)
+    };
+
+    // Both sides falling back to the pixel itself leaves no direction
+    if ((neighbors[0]->state != 1 && neighbors[1]->state != 1) ||
+        (neighbors[2]->state != 1 && neighbors[3]->state != 1)) {
+      return false;
+    }
+
+    for (int i = 0; i < 4; i++) {
+      if (neighbors[i]->state != 1) {
+        neighbors[i] = &edgePoint(m_centers, index, imageSample, imageLine);
+        if (neighbors[i]->state != 1) {
+          return false;
+        }
+      }
+    }
+
+    // The normal as computed by DemShape::calculateLocalNormal()
+    double topMinusBottom[3], rightMinusLeft[3], normal[3], mag;
+    vsub_c(neighbors[0]->position, neighbors[1]->position, topMinusBottom);
+    vsub_c(neighbors[3]->position, neighbors[2]->position, rightMinusLeft);
+    ucrss_c(topMinusBottom, rightMinusLeft, normal);
+
+    unorm_c(normal, normal, &mag);
+    if (mag == 0.0) {
+      return false;
+    }
+
+    double centerLookVect[3];
+    unorm_c(pB, centerLookVect, &mag);
+    if (vdot_c(normal, centerLookVect) < 0.0) {
+      vminus_c(normal, normal);
+    }
+
+    // The angles as computed by Camera::LocalPhotometricAngles()
+    unorm_c(normal, normal, &mag);
+
+    double surfSpaceVect[3], unitizedSurfSpaceVect[3], dist;
+    vsub_c(sB, pB, surfSpaceVect);
+    unorm_c(surfSpaceVect, unitizedSurfSpaceVect, &dist);
+
+    double surfaceSunVect[3], unitizedSurfSunVect[3];
+    vsub_c(uB, pB, surfaceSunVect);
+    unorm_c(surfaceSunVect, unitizedSurfSunVect, &dist);
+
+    emission = Angle(vsep_c(unitizedSurfSpaceVect, normal),
+                     Angle::Radians).degrees();
+    incidence = Angle(vsep_c(unitizedSurfSunVect, normal),
+                      Angle::Radians).degrees();
+    return true;
+  }
+
+
+  /**
+   * Find the DEM point of an image position the same way
+   * Camera::GetLocalNormal() does, unless that was done already.
+   *
+   * @param points The points the image position belongs to
+   * @param index The index of the image position in points
+   * @param sample The image sample
+   * @param line The image line
+   *
+   * @return The point, with a state of 2 if the position is not on the target
+   */
+  const GeometryBackplanes::EdgePoint &GeometryBackplanes::edgePoint(
+      QVector<EdgePoint> &points, int index, double sample, double line) {
+    EdgePoint &point = points[index];
+
+    if (point.state == 0) {
+      point.state = 2;
+
+      if (m_camera->SetImage(sample, line)) {
+        SurfacePoint surfacePoint = m_camera->GetSurfacePoint();
+        Latitude lat = surfacePoint.GetLatitude();
+        Longitude lon = surfacePoint.GetLongitude();
+        Distance radius = m_camera->LocalRadius(lat, lon);
+
+        latrec_c(radius.kilometers(), lon.radians(), lat.radians(),
+                 point.position);
+        point.state = 1;
+      }
+    }
+
+    return point;
+  }
+
+
+  /**
+   * Interpolate the phase, incidence and emission angles bilinearly between
+   * the corners of a grid cell.
+   *
+   * @param sample0 The first sample of the cell
+   * @param line0 The first line of the cell
+   * @param sample1 The last sample of the cell
+   * @param line1 The last line of the cell
+   * @param sample The sample to interpolate at
+   * @param line The line to interpolate at
+   * @param angles The phase, incidence and emission angles
+   */
+  void GeometryBackplanes::interpolate(int sample0, int line0,
+                                       int sample1, int line1,
+                                       int sample, int line,
+                                       double angles[3]) const {
+    double x = (sample1 > sample0) ?
+               (double)(sample - sample0) / (sample1 - sample0) : 0.0;
+    double y = (line1 > line0) ?
+               (double)(line - line0) / (line1 - line0) : 0.0;
+
+    int topLeft = line0 * m_samples + sample0;
+    int topRight = line0 * m_samples + sample1;
+    int bottomLeft = line1 * m_samples + sample0;
+    int bottomRight = line1 * m_samples + sample1;
+
+    const QVector<double> *planes[3] = { &m_phase, &m_incidence, &m_emission };
+    for (int i = 0; i < 3; i++) {
+      const QVector<double> &plane = *planes[i];
+      double top = plane[topLeft] + x * (plane[topRight] - plane[topLeft]);
+      double bottom = plane[bottomLeft] + x * (plane[bottomRight] - plane[bottomLeft]);
+      angles[i] = top + y * (bottom - top);
+    }
+  }
+}
@@ -0,0 +1,159 @@
+#ifndef GeometryBackplanes_h
+#define GeometryBackplanes_h
+
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QString>
+#include <QVector>
+
+namespace Isis {
+  class Camera;
+  class Cube;
+
+  /**
+   * @brief Photometric angles for a rectangle of image pixels
+   *
+   * This class computes the phase, incidence and emission angles, and
+   * optionally the local (DEM) incidence and emission angles, of every pixel
+   * in a rectangle of a camera image. Programs like phocube and photomet use
+   * it instead of calling Camera::SetImage() and the angle methods for each
+   * pixel.
+   *
+   * Without local angles and with a tolerance above 0, the angles are
+   * evaluated exactly on a grid of nodes gridSpacing() pixels apart. The
+   * angles of a grid cell are interpolated bilinearly from its corners when
+   * the corners are valid and the exact angles at the center of the cell and
+   * at the middles of its edges are valid and within tolerance() degrees of
+   * the interpolated ones. Every other cell, such as cells on the limb, is
+   * evaluated exactly. An invalid area smaller than half a cell that touches
+   * none of these pixels is not found, so the tolerance should only be used
+   * when the target fills the cells it touches, or with a smaller
+   * gridSpacing().
+   *
+   * Local angles are always evaluated exactly. The surface normal of a pixel
+   * comes from the DEM points at the middle of its four edges, the same points
+   * Camera::LocalPhotometricAngles() uses. These points are intersected with
+   * the camera, not read from a cached DEM tile. Each of them is shared by two
+   * neighboring pixels and is only intersected once for the rectangle.
+   *
+   * The angles can be written to a sidecar cube with the bands Phase Angle,
+   * Incidence Angle, Emission Angle, Local Incidence Angle and Local Emission
+   * Angle. Later runs of photomet can read the sidecar with
+   * ANGLESOURCE=BACKPLANE instead of computing the geometry again.
+   *
+   * <code>
+   * GeometryBackplanes backplanes(camera);
+   * backplanes.setTolerance(0.01);
+   * backplanes.compute(1, line, samples, 1);
+   *
+   * for (int i = 0; i < backplanes.size(); i++) {
+   *   if (backplanes.isValid(i)) {
+   *     double phase = backplanes.phase(i);
+   *   }
+   * }
+   * </code>
+   *
+   * The camera is used from the calling thread only, since the camera models
+   * and the NAIF toolkit can not be used from several threads at once.
+   *
+   * @ingroup Camera
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class GeometryBackplanes {
+    public:
+      GeometryBackplanes(Camera *camera);
+      ~GeometryBackplanes();
+
+      void setTolerance(double degrees);
+      double tolerance() const;
+      void setGridSpacing(int pixels);
+      int gridSpacing() const;
+      void setLocalAngles(bool local);
+      bool localAngles() const;
+
+      void compute(int startSample, int startLine, int samples, int lines);
+
+      int size() const;
+      bool isValid(int index) const;
+      double phase(int index) const;
+      double incidence(int index) const;
+      double emission(int index) const;
+      double localIncidence(int index) const;
+      double localEmission(int index) const;
+
+      static void createSidecar(Cube &sidecar, const QString &fileName,
+                                int samples, int lines);
+      void writeSidecar(Cube &sidecar) const;
+
+    private:
+      /**
+       * The body fixed position on the DEM of an image position, used for
+       * local surface normals.
+       */
+      struct EdgePoint {
+        int state;          //!< 0 if not evaluated yet, 1 if valid, 2 if not
+        double position[3]; //!< The body fixed position in kilometers
+      };
+
+      void computeGrid();
+      bool isInterpolated(int sample0, int line0, int sample1, int line1,
+                          int sample, int line);
+      void computePixel(int sample, int line);
+      bool localPhotometricAngles(int sample, int line, double &incidence,
+                                  double &emission);
+      const EdgePoint &edgePoint(QVector<EdgePoint> &points, int index,
+                                 double sample, double line);
+      void interpolate(int sample0, int line0, int sample1, int line1,
+                       int sample, int line, double angles[3]) const;
+
+      Camera *m_camera;      //!< The camera of the image
+      double m_tolerance;    //!< The allowed interpolation error in degrees
+      int m_gridSpacing;     //!< The pixels between grid nodes
+      bool m_localAngles;    //!< True if local angles are computed
+
+      int m_startSample;     //!< The first sample of the rectangle
+      int m_startLine;       //!< The first line of the rectangle
+      int m_samples;         //!< The number of samples in the rectangle
+      int m_lines;           //!< The number of lines in the rectangle
+
+      QVector<char> m_state;             //!< 0 not computed, 1 exact, 2 interpolated
+      QVector<bool> m_valid;             //!< True if a pixel intersects the target
+      QVector<double> m_phase;           //!< The phase angles
+      QVector<double> m_incidence;       //!< The incidence angles
+      QVector<double> m_emission;        //!< The emission angles
+      QVector<double> m_localIncidence;  //!< The local incidence angles
+      QVector<double> m_localEmission;   //!< The local emission angles
+
+      //! The DEM points at the top edge of each pixel, and below the last line
+      QVector<EdgePoint> m_lineEdges;
+      //! The DEM points at the left edge of each pixel, and right of the last sample
+      QVector<EdgePoint> m_sampleEdges;
+      //! The DEM points at the pixel centers, used when an edge point fails
+      QVector<EdgePoint> m_centers;
+  };
+}
+
+#endif
@@ -822,6 +822,39 @@ namespace Isis {
     return (regdef);
   }
 
+  /**
+   * @brief Add the statistics of another Gruen instance to this one
+   *
+   * The AutoReg statistics, the error counts and the Gruen statistics of the
+   * other instance are added to those of this one.  Each thread of a parallel
+   * matcher registers with its own Gruen instance; merging them afterwards
+   * gives the same RegistrationStatistics() as a single instance would have.
+   *
+   * @param other Gruen instance whose statistics are added
+   */
+  void Gruen::MergeStatistics(const Gruen &other) {
+    AutoReg::MergeStatistics(other);
+
+    m_callCount += other.m_callCount;
+    m_totalIterations += other.m_totalIterations;
+    m_unclassified += other.m_unclassified;
+
+    for (int e = 0 ; e < other.m_errors.size() ; e++) {
+      const ErrorCounter &counter = other.m_errors.getNth(e);
+      if (m_errors.exists(counter.Errno())) {
+        m_errors.get(counter.Errno()).m_count += counter.Count();
+      }
+      else {
+        m_unclassified += counter.Count();
+      }
+    }
+
+    m_eigenStat.AddStatistics(other.m_eigenStat);
+    m_iterStat.AddStatistics(other.m_iterStat);
+    m_shiftStat.AddStatistics(other.m_shiftStat);
+    m_gainStat.AddStatistics(other.m_gainStat);
+  }
+
   /**
    * @brief Create Gruen error and processing statistics Pvl output
    *
@@ -86,6 +86,9 @@ namespace Isis {
    *            setTransform to match changes in Chip class
    *   @history 2011-05-23 Kris Becker - Reworked major portions of
    *            implementation for a more modular support.
+   *   @history 2026-10-19 ISIS Development Team - Added MergeStatistics() so
+   *            that the statistics of Gruen instances used on separate
+   *            threads can be reported together.
    */
   class Gruen : public AutoReg {
     public:
@@ -100,6 +103,8 @@ namespace Isis {
       /** Returns the current call count */
       BigInt CallCount() const { return (m_callCount); }
 
+      void MergeStatistics(const Gruen &other);
+
       void WriteSubsearchChips(const QString &pattern = "SubChip");
 
       AffineTolerance getAffineTolerance() const;
@@ -0,0 +1,247 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "HistogramSketch.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "IException.h"
+#include "IString.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+  /**
+   * Create an empty histogram.
+   *
+   * @param bins The number of bins, rounded up to an even number
+   */
+  HistogramSketch::HistogramSketch(int bins) {
+    if (bins < 2) {
+      QString msg = "A histogram sketch needs at least two bins, not [" +
+                    toString(bins) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_counts.fill(0, bins + bins % 2);
+    m_start = 0.0;
+    m_binSize = 0.0;
+    m_validPixels = 0;
+    m_minimum = DBL_MAX;
+    m_maximum = -DBL_MAX;
+  }
+
+
+  //! Destroys the histogram
+  HistogramSketch::~HistogramSketch() {
+  }
+
+
+  /**
+   * Add an array of values to the histogram.
+   *
+   * @param data The values
+   * @param count The number of values
+   */
+  void HistogramSketch::AddData(const double *data, const unsigned int count) {
+    for (unsigned int i = 0; i < count; i++) {
+      AddData(data[i]);
+    }
+  }
+
+
+  /**
+   * Add a value to the histogram.
+   *
+   * @param data The value
+   */
+  void HistogramSketch::AddData(const double data) {
+    if (!IsValidPixel(data) || !std::isfinite(data)) {
+      return;
+    }
+
+    m_validPixels++;
+    m_minimum = min(m_minimum, data);
+    m_maximum = max(m_maximum, data);
+
+    if (m_binSize > 0.0) {
+      addToBin(data);
+    }
+    else {
+      m_buffer.push_back(data);
+      if ((int)m_buffer.size() >= m_counts.size()) {
+        placeBuffered();
+      }
+    }
+  }
+
+
+  /**
+   * @return The number of valid values added
+   */
+  BigInt HistogramSketch::ValidPixels() const {
+    return m_validPixels;
+  }
+
+
+  /**
+   * @return The smallest valid value added, or NULL8 if there is none
+   */
+  double HistogramSketch::Minimum() const {
+    return (m_validPixels > 0) ? m_minimum : NULL8;
+  }
+
+
+  /**
+   * @return The largest valid value added, or NULL8 if there is none
+   */
+  double HistogramSketch::Maximum() const {
+    return (m_validPixels > 0) ? m_maximum : NULL8;
+  }
+
+
+  /**
+   * Computes the value at a percentage of the histogram like
+   * Histogram::Percent() does.
+   *
+   * @param percent The percentage, from 0 to 100
+   *
+   * @return The value at the percentage, or NULL8 if no valid values were
+   *         added
+   */
+  double HistogramSketch::Percent(double percent) const {
+    if ((percent < 0.0) || (percent > 100.0)) {
+      QString msg = "Argument percent outside of the range 0 to 100 in"
+                    " [HistogramSketch::Percent]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (m_validPixels < 1) return NULL8;
+
+    // The values are all still known, so the answer is exact
+    if (m_binSize == 0.0) {
+      vector<double> sorted(m_buffer);
+      sort(sorted.begin(), sorted.end());
+
+      for (int i = 0; i < (int)sorted.size(); i++) {
+        if ((double)(i + 1) / (double)sorted.size() * 100.0 >= percent) {
+          return sorted[i];
+        }
+      }
+      return sorted.back();
+    }
+
+    BigInt currentPixels = 0;
+    int bin = m_counts.size() - 1;
+    for (int i = 0; i < m_counts.size(); i++) {
+      currentPixels += m_counts[i];
+      if ((double)currentPixels / (double)m_validPixels * 100.0 >= percent) {
+        bin = i;
+        break;
+      }
+    }
+
+    double middle = m_start + (bin + 0.5) * m_binSize;
+    return max(m_minimum, min(m_maximum, middle));
+  }
+
+
+  /**
+   * @return The median, or NULL8 if no valid values were added
+   */
+  double HistogramSketch::Median() const {
+    return Percent(50.0);
+  }
+
+
+  /**
+   * @return The number of bins
+   */
+  int HistogramSketch::Bins() const {
+    return m_counts.size();
+  }
+
+
+  /**
+   * @return The current width of a bin, which bounds the error of Percent(),
+   *         or 0 while Percent() is exact
+   */
+  double HistogramSketch::BinSize() const {
+    return m_binSize;
+  }
+
+
+  /**
+   * Set the bins from the range of the kept values and move the kept values
+   * into the bins. The range is centered in the bins so that the minimum and
+   * maximum are in the middle of the first and last bins.
+   */
+  void HistogramSketch::placeBuffered() {
+    int bins = m_counts.size();
+
+    m_binSize = (m_maximum - m_minimum) / (bins - 1);
+    if (m_binSize <= 0.0) {
+      m_binSize = max(fabs(m_minimum), 1.0) / bins;
+    }
+    m_start = m_minimum - 0.5 * m_binSize;
+
+    for (unsigned int i = 0; i < m_buffer.size(); i++) {
+      addToBin(m_buffer[i]);
+    }
+
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+  }
+
+
+  /**
+   * Count a value in its bin, doubling the size of the bins until the value
+   * fits.
+   *
+   * @param value The valid, finite value
+   */
+  void HistogramSketch::addToBin(const double value) {
+    int bins = m_counts.size();
+    int half = bins / 2;
+
+    while (value < m_start || value >= m_start + bins * m_binSize) {
+      // The old bins become one half of the new bins, on the side away from
+      // the value
+      int offset = (value < m_start) ? half : 0;
+      if (offset) {
+        m_start -= bins * m_binSize;
+      }
+
+      QVector<BigInt> merged(bins, 0);
+      for (int i = 0; i < half; i++) {
+        merged[offset + i] = m_counts[2 * i] + m_counts[2 * i + 1];
+      }
+      m_counts = merged;
+      m_binSize *= 2.0;
+    }
+
+    int index = (int)((value - m_start) / m_binSize);
+    m_counts[min(max(index, 0), bins - 1)]++;
+  }
+}
@@ -0,0 +1,89 @@
+#ifndef HistogramSketch_h
+#define HistogramSketch_h
+
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <vector>
+
+#include <QVector>
+
+#include "Constants.h"
+
+namespace Isis {
+  /**
+   * @brief A histogram that finds its own range in a single pass
+   *
+   * Histogram needs the range of the data before the data is added, so a
+   * histogram of floating point cube data takes one pass over the cube to
+   * find the minimum and maximum and a second pass to fill the bins. This
+   * class fills its bins in the same pass that finds the range.
+   *
+   * The first Bins() valid values are kept as they are. Their range sets the
+   * bins, which are then filled. A later value outside of the bins doubles
+   * the size of the bins, merging neighbouring pairs, until the value fits.
+   * The bins therefore end up at most a few times as wide as the bins of a
+   * Histogram with the same number of bins over the exact range. Percent()
+   * is accurate to within BinSize(), and exact while no more than Bins()
+   * values have been added.
+   *
+   * Special pixels are ignored.
+   *
+   * @ingroup Statistics
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class HistogramSketch {
+    public:
+      HistogramSketch(int bins = 65536);
+      ~HistogramSketch();
+
+      void AddData(const double *data, const unsigned int count);
+      void AddData(const double data);
+
+      BigInt ValidPixels() const;
+      double Minimum() const;
+      double Maximum() const;
+      double Percent(double percent) const;
+      double Median() const;
+
+      int Bins() const;
+      double BinSize() const;
+
+    private:
+      void placeBuffered();
+      void addToBin(const double value);
+
+      QVector<BigInt> m_counts;     //!< The count of each bin
+      double m_start;               //!< The lower edge of the first bin
+      double m_binSize;             //!< The width of a bin, 0 until the bins are used
+      std::vector<double> m_buffer; //!< The values added before the bins are used
+
+      BigInt m_validPixels;         //!< The number of valid values added
+      double m_minimum;             //!< The smallest valid value added
+      double m_maximum;             //!< The largest valid value added
+  };
+}
+
+#endif
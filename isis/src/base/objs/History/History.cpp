@@ -28,6 +28,7 @@
 
 #include "Application.h"
 #include "PvlObject.h"
+#include "PvlParser.h"
 
 using namespace std;
 
@@ -99,6 +100,13 @@ namespace Isis {
    */
   Pvl History::ReturnHist() {
     Pvl pvl;
+
+    PvlParser parser(p_buffer, p_nbytes);
+    if (parser.parse(pvl)) {
+      return pvl;
+    }
+
+    pvl.clear();
     stringstream os;
     for (int i = 0; i < p_nbytes; i++) os << p_buffer[i];
     os >> pvl;
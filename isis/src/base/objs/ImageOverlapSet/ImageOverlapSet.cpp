@@ -5,8 +5,14 @@
 #include <string>
 #include <vector>
 
+#include <QHash>
+#include <QThreadPool>
+#include <QtConcurrentFilter>
+
 #include "Cube.h"
 #include "FileName.h"
+#include "geos/geom/Envelope.h"
+#include "geos/index/strtree/STRtree.h"
 #include "geos/operation/distance/DistanceOp.h"
 #include "geos/util/IllegalArgumentException.h"
 #include "geos/geom/Point.h"
@@ -531,6 +537,111 @@ namespace Isis {
   }
 
 
+  /**
+   * Indexes the overlaps by the starting polygon (footprint) they were split
+   * from. Every overlap created by FindAllOverlaps() is contained in its
+   * footprint, so an overlap can only intersect the overlaps split from
+   * footprints whose envelopes intersect its own envelope.
+   *
+   * @author 2026-10-19 ISIS Development Team
+   */
+  class ImageOverlapSet::FootprintIndex {
+    public:
+      /**
+       * Indexes the starting polygons. Empty polygons have no envelope to
+       * index and are always returned by Nearby().
+       *
+       * @param overlaps The starting overlaps
+       */
+      FootprintIndex(const QList<ImageOverlap *> &overlaps) {
+        m_envelopes.reserve(overlaps.size());
+
+        for (int i = 0; i < overlaps.size(); i++) {
+          const geos::geom::MultiPolygon *footprint = overlaps[i]->Polygon();
+          if (footprint->isEmpty()) {
+            m_unindexed.insert(overlaps[i]);
+            continue;
+          }
+
+          m_footprintOf.insert(overlaps[i], m_envelopes.size());
+          m_overlapsOf.append(QList<const ImageOverlap *>() << overlaps[i]);
+          m_envelopes.push_back(*footprint->getEnvelopeInternal());
+          m_tree.insert(&m_envelopes.back(), &m_envelopes.back());
+        }
+      }
+
+
+      /**
+       * Adds an overlap split from another overlap to the footprint of that
+       * overlap.
+       *
+       * @param overlap The new overlap
+       * @param from The overlap it was split from
+       */
+      void AddSplit(const ImageOverlap *overlap, const ImageOverlap *from) {
+        QHash<const ImageOverlap *, int>::const_iterator footprint = m_footprintOf.find(from);
+        if (footprint == m_footprintOf.end()) {
+          m_unindexed.insert(overlap);
+          return;
+        }
+
+        m_footprintOf.insert(overlap, footprint.value());
+        m_overlapsOf[footprint.value()].append(overlap);
+      }
+
+
+      /**
+       * Removes an overlap that was erased from the overlap list.
+       *
+       * @param overlap The erased overlap
+       */
+      void Remove(const ImageOverlap *overlap) {
+        if (m_unindexed.remove(overlap)) return;
+
+        QHash<const ImageOverlap *, int>::iterator footprint = m_footprintOf.find(overlap);
+        if (footprint == m_footprintOf.end()) return;
+
+        m_overlapsOf[footprint.value()].removeOne(overlap);
+        m_footprintOf.erase(footprint);
+      }
+
+
+      /**
+       * Returns the overlaps split from the footprints whose envelopes
+       * intersect a polygon's envelope, and the overlaps that are not indexed.
+       *
+       * @param polygon The polygon to find the nearby overlaps of
+       *
+       * @return QList<const ImageOverlap *> The nearby overlaps
+       */
+      QList<const ImageOverlap *> Nearby(const geos::geom::Geometry *polygon) {
+        QList<const ImageOverlap *> nearby = m_unindexed.toList();
+        if (polygon->isEmpty()) return nearby;
+
+        std::vector<void *> found;
+        m_tree.query(polygon->getEnvelopeInternal(), found);
+
+        for (unsigned int i = 0; i < found.size(); i++) {
+          nearby.append(m_overlapsOf[(const geos::geom::Envelope *) found[i] - &m_envelopes[0]]);
+        }
+
+        return nearby;
+      }
+
+    private:
+      //! The envelopes of the indexed footprints
+      std::vector<geos::geom::Envelope> m_envelopes;
+      //! The index of the footprint envelopes
+      geos::index::strtree::STRtree m_tree;
+      //! The footprint each indexed overlap was split from
+      QHash<const ImageOverlap *, int> m_footprintOf;
+      //! The overlaps split from each footprint
+      QList< QList<const ImageOverlap *> > m_overlapsOf;
+      //! The overlaps with no footprint to index
+      QSet<const ImageOverlap *> m_unindexed;
+  };
+
+
   /**
    * Find the overlaps between all the existing ImageOverlap Objects
    *
@@ -549,10 +660,17 @@ namespace Isis {
 
     geos::geom::MultiPolygon *emptyPolygon = Isis::globalFactory.createMultiPolygon();
 
+    // Index the overlaps by the starting polygon they are split from
+    FootprintIndex footprints(p_lonLatOverlaps);
+
     // Compare each polygon with all of the others
     for (int outside = 0; outside < p_lonLatOverlaps.size() - 1; ++outside) {
       p_calculatedSoFar = outside - 1;
 
+      // The overlap the candidates were found for, and the candidates
+      const ImageOverlap *candidatesFor = NULL;
+      QSet<const ImageOverlap *> candidates;
+
       // unblock the writing process after every 10 polygons if we need to write
       if (p_calculatedSoFar % 10 == 0 && (!snlist || (p_lonLatOverlaps.size() > snlist->size()))) {
         if (p_threadedCalculate) {
@@ -565,6 +683,17 @@ namespace Isis {
       // below it
       for (int inside = outside + 1; inside < p_lonLatOverlaps.size(); ++inside) {
         try {
+          // Find the polygons that can overlap this one whenever the outside polygon
+          // changes. The outside polygon only shrinks while it is compared, so the
+          // candidates stay valid until a different polygon moves into its position.
+          if (p_lonLatOverlaps.at(outside) != candidatesFor) {
+            candidatesFor = p_lonLatOverlaps.at(outside);
+            candidates = FindOverlapCandidates(outside, footprints);
+          }
+
+          if (!candidates.contains(p_lonLatOverlaps.at(inside)))
+            continue;
+
           if (p_lonLatOverlaps.at(outside)->HasAnySameSerialNumber(*p_lonLatOverlaps.at(inside))) 
             continue;
 
@@ -575,19 +704,15 @@ namespace Isis {
           // Check to see if the two poygons are equivalent.
           // If they are, then we can get rid of one of them
           if (PolygonTools::Equal(poly1, poly2)) {
-            p_lonLatOverlapsMutex.lock();
             AddSerialNumbers(p_lonLatOverlaps[outside], p_lonLatOverlaps[inside]);
-            p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
-            p_lonLatOverlapsMutex.unlock();
+            EraseOverlap(inside, footprints);
             inside --;
             continue;
           }
 
           // We can get empty polygons in our list sometimes; try to avoid extra processing
           if (poly2->isEmpty() || poly2->getArea() < 1.0e-14) {
-            p_lonLatOverlapsMutex.lock();
-            p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
-            p_lonLatOverlapsMutex.unlock();
+            EraseOverlap(inside, footprints);
             inside --;      
             continue;
           }
@@ -615,17 +740,13 @@ namespace Isis {
               if (poly1->getArea() > poly2->getArea()) {
                 error += " The first polygon will be removed.";
                 HandleError(e, snlist, error, inside, outside);
-                p_lonLatOverlapsMutex.lock();
-                p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
-                p_lonLatOverlapsMutex.unlock();
+                EraseOverlap(inside, footprints);
                 inside --;
               }
               else {
                 error += " The second polygon will be removed.";
                 HandleError(e, snlist, error, inside, outside);
-                p_lonLatOverlapsMutex.lock();
-                p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + outside);
-                p_lonLatOverlapsMutex.unlock();
+                EraseOverlap(outside, footprints);
                 inside = outside;
               }
             }
@@ -633,10 +754,8 @@ namespace Isis {
               error += " Both polygons will be removed to prevent the "
                        "possibility of double counted areas.";
               HandleError(e, snlist, error, inside, outside);
-              p_lonLatOverlapsMutex.lock();
-              p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
-              p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + outside);
-              p_lonLatOverlapsMutex.unlock();
+              EraseOverlap(inside, footprints);
+              EraseOverlap(outside, footprints);
               inside = outside;
             }
 
@@ -707,9 +826,7 @@ namespace Isis {
 
               // Delete outside polygon directly and reset outside loop
               //   - current outside is thrown out!
-              p_lonLatOverlapsMutex.lock();
-              p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + outside);
-              p_lonLatOverlapsMutex.unlock();
+              EraseOverlap(outside, footprints);
               inside = outside;
               continue;
             }
@@ -728,9 +845,7 @@ namespace Isis {
                                      "The second polygon will be removed.", inside, outside);
 
               // Delete inside polygon directly and process next inside
-              p_lonLatOverlapsMutex.lock();
-              p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
-              p_lonLatOverlapsMutex.unlock();
+              EraseOverlap(inside, footprints);
               inside --;
               continue;
             }
@@ -773,7 +888,12 @@ namespace Isis {
               int newSteps = newSize - oldSize;
               p.AddSteps(newSteps);
               foundOverlap = true;
-              if (newSize != oldSize) inside++;
+              if (newSize != oldSize) {
+                inside++;
+
+                // The new overlap is part of the outside polygon
+                footprints.AddSplit(p_lonLatOverlaps[inside], p_lonLatOverlaps[outside]);
+              }
             }
           } // End of partial overlap else
         }
@@ -793,6 +913,11 @@ namespace Isis {
         }
       }
 
+      // The overlap at this position is final and is never compared again
+      if (outside < p_lonLatOverlaps.size()) {
+        footprints.Remove(p_lonLatOverlaps.at(outside));
+      }
+
       p.CheckStatus();
     }
 
@@ -814,6 +939,114 @@ namespace Isis {
   }
 
 
+  /**
+   * Tests whether an overlap intersects a polygon for QtConcurrent. Failed tests
+   * count as intersecting so that FindAllOverlaps() handles the failure.
+   *
+   * @author 2026-10-19 ISIS Development Team
+   */
+  class ImageOverlapSet::IntersectsFunctor :
+      public std::unary_function<const ImageOverlap * const &, bool> {
+    public:
+      /**
+       * @param polygon The polygon to test overlaps against
+       */
+      IntersectsFunctor(const geos::geom::Geometry *polygon) {
+        m_polygon = polygon;
+      }
+
+
+      /**
+       * @param overlap The overlap to test
+       *
+       * @return bool True if the overlap may intersect the polygon
+       */
+      bool operator()(const ImageOverlap * const &overlap) const {
+        try {
+          return m_polygon->intersects(overlap->Polygon());
+        }
+        catch (...) {
+          return true;
+        }
+      }
+
+    private:
+      const geos::geom::Geometry *m_polygon; //!< The polygon to test against
+  };
+
+
+  /**
+   * Find the overlaps after a position that need to be compared with the overlap
+   * at that position. Only the overlaps the footprint index finds near the
+   * outside overlap are checked, and the exact intersection tests of those are
+   * run in the global thread pool. FindAllOverlaps() removes overlaps from the
+   * index once they are final, so the index only holds the overlaps after the
+   * position. Nearby empty overlaps are always candidates so that
+   * FindAllOverlaps() still removes them.
+   *
+   * @param outside The position of the overlap to find candidates for
+   * @param footprints The index of the overlaps by starting polygon
+   *
+   * @return QSet<const ImageOverlap *> The overlaps that may intersect the outside overlap
+   */
+  QSet<const ImageOverlap *> ImageOverlapSet::FindOverlapCandidates(int outside,
+                                                                    FootprintIndex &footprints) {
+
+    QSet<const ImageOverlap *> candidates;
+    const ImageOverlap *outsideOverlap = p_lonLatOverlaps.at(outside);
+    const geos::geom::MultiPolygon *outsidePolygon = outsideOverlap->Polygon();
+
+    QList<const ImageOverlap *> nearby = footprints.Nearby(outsidePolygon);
+    QList<const ImageOverlap *> nearbyOverlaps;
+    for (int i = 0; i < nearby.size(); i++) {
+      const ImageOverlap *insideOverlap = nearby[i];
+      if (insideOverlap == outsideOverlap) continue;
+
+      const geos::geom::MultiPolygon *insidePolygon = insideOverlap->Polygon();
+      if (insidePolygon->isEmpty() || insidePolygon->getArea() < 1.0e-14) {
+        candidates.insert(insideOverlap);
+        continue;
+      }
+
+      if (outsidePolygon->isEmpty() || outsideOverlap->HasAnySameSerialNumber(*insideOverlap))
+        continue;
+
+      if (outsidePolygon->getEnvelopeInternal()->intersects(
+              insidePolygon->getEnvelopeInternal())) {
+        nearbyOverlaps.append(insideOverlap);
+      }
+    }
+
+    IntersectsFunctor intersects(outsidePolygon);
+    if (nearbyOverlaps.size() > 1 && QThreadPool::globalInstance()->maxThreadCount() > 1) {
+      nearbyOverlaps = QtConcurrent::blockingFiltered(nearbyOverlaps, intersects);
+      candidates.unite(nearbyOverlaps.toSet());
+    }
+    else {
+      for (int i = 0; i < nearbyOverlaps.size(); i++) {
+        if (intersects(nearbyOverlaps[i])) candidates.insert(nearbyOverlaps[i]);
+      }
+    }
+
+    return candidates;
+  }
+
+
+  /**
+   * Erase an overlap from the overlap list and the footprint index.
+   *
+   * @param position The position of the overlap to erase
+   * @param footprints The index of the overlaps by starting polygon
+   */
+  void ImageOverlapSet::EraseOverlap(int position, FootprintIndex &footprints) {
+    footprints.Remove(p_lonLatOverlaps.at(position));
+
+    p_lonLatOverlapsMutex.lock();
+    p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + position);
+    p_lonLatOverlapsMutex.unlock();
+  }
+
+
   /**
    * Add the serial numbers from the second overlap to the first
    *
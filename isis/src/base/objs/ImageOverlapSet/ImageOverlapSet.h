@@ -29,6 +29,7 @@
 #include <QList>
 #include <QThread>
 #include <QMutex>
+#include <QSet>
 
 #include "geos/geom/MultiPolygon.h"
 #include "geos/geom/LinearRing.h"
@@ -97,6 +98,9 @@ namespace Isis {
    *                          undefined behavior caused by unlocking an unlocked mutex.
    *   @history 2017-05-23 Ian Humphrey - Added a tryLock() to FindAllOverlaps to prevent a
    *                           segfault from occuring on OSX with certain data. Fixes #4810.
+   *   @history 2026-10-19 ISIS Development Team - FindAllOverlaps() only compares the
+   *                           overlaps split from nearby starting polygons, found with a
+   *                           GEOS STRtree of their envelopes.
    * 
    */
   class ImageOverlapSet : private QThread {
@@ -153,6 +157,12 @@ namespace Isis {
 
       void DespikeLonLatOverlaps();
 
+      class IntersectsFunctor;
+      class FootprintIndex;
+
+      QSet<const ImageOverlap *> FindOverlapCandidates(int outside, FootprintIndex &footprints);
+      void EraseOverlap(int position, FootprintIndex &footprints);
+
       QList<ImageOverlap *> p_lonLatOverlaps; //!< The list of lat/lon overlaps
 
       ImageOverlap *CreateNewOverlap(QString serialNumber,
@@ -41,9 +41,12 @@
 #include <geos/operation/distance/DistanceOp.h>
 
 #include "ImagePolygon.h"
+#include "Constants.h"
+#include "Distance.h"
 #include "IString.h"
 #include "SpecialPixel.h"
 #include "PolygonTools.h"
+#include "TProjection.h"
 
 using namespace std;
 
@@ -72,6 +75,11 @@ namespace Isis {
     p_subpixelAccuracy = 50; //An accuracte and quick number
 
     p_ellipsoid = false;
+
+    p_adaptiveTolerance = 0.0;
+
+    p_latitude = Null;
+    p_longitude = Null;
   }
 
 
@@ -117,6 +125,7 @@ namespace Isis {
     p_gMap->SetBand(band);
 
     p_cube = &cube;
+    p_groundPoints.clear();
 
     Camera *cam = NULL;
     p_isProjected = false;
@@ -167,6 +176,9 @@ namespace Isis {
     if (p_ellipsoid && IsLimb() && p_gMap->Camera()) {
       try {
         p_gMap->Camera()->IgnoreElevationModel(true);
+
+        // The limb test was evaluated with the elevation model
+        p_groundPoints.clear();
       }
       catch(IException &) {
         std::string msg = "Cannot use an ellipsoid shape model";
@@ -230,7 +242,9 @@ namespace Isis {
         p_pts = NULL;
         p_pts = new geos::geom::CoordinateArraySequence();
 
-        WalkPoly();
+        if (p_adaptiveTolerance <= 0.0 || !TraceEdges()) {
+          WalkPoly();
+        }
 
         polygonGenerated = true;
       }
@@ -269,6 +283,9 @@ namespace Isis {
 
     if (p_gMap->Camera())
       p_gMap->Camera()->IgnoreElevationModel(false);
+
+    // The ground points are only reused while the polygon is created
+    p_groundPoints.clear();
   }
 
 
@@ -612,7 +629,6 @@ namespace Isis {
 
   void ImagePolygon::WalkPoly() {
     vector<geos::geom::Coordinate> points;
-    double lat, lon, prevLat, prevLon;
 
     // Find the edge of the polygon
     geos::geom::Coordinate firstPoint = FindFirstPoint();
@@ -752,6 +768,175 @@ namespace Isis {
     }
 
     FindSubpixel(points);
+    GroundPoly(points);
+  }
+
+
+  /**
+   * Traces the border of the image and stores its lon lat polygon to p_pts.
+   * Each edge of the image is bisected until the ground position of the
+   * middle of a piece is within p_adaptiveTolerance meters of the straight
+   * lon lat segment between the ends of the piece, or the piece is no longer
+   * than the sample/line increment. Pixels shared by neighboring pieces are
+   * only evaluated once.
+   *
+   * Bisecting can step over an invalid part of the border, so the border is
+   * first checked at the sample/line increments that the walk uses. The
+   * traced edges are only accepted if all of those pixels are valid.
+   *
+   * The edges are traced one after the other because the camera models can
+   * not be used from several threads.
+   *
+   * @return bool False if the image border is not entirely valid, in which
+   *         case nothing was stored and the image must be walked instead.
+   */
+  bool ImagePolygon::TraceEdges() {
+    if (p_cubeSamps <= p_cubeStartSamp || p_cubeLines <= p_cubeStartLine) {
+      return false;
+    }
+
+    // The distance to the center of the target, for converting degrees
+    double radius = 0.0;
+    if (p_gMap->Camera()) {
+      Distance radii[3];
+      p_gMap->Camera()->radii(radii);
+      radius = radii[0].meters();
+    }
+    else if (TProjection *tproj = dynamic_cast<TProjection *>(p_gMap->Projection())) {
+      radius = tproj->EquatorialRadius();
+    }
+
+    if (radius <= 0.0) {
+      return false;
+    }
+
+    for (int sample = p_cubeStartSamp; sample < p_cubeSamps; sample += p_sampinc) {
+      if (!SetImage(sample, p_cubeStartLine) || !SetImage(sample, p_cubeLines)) {
+        return false;
+      }
+    }
+
+    for (int line = p_cubeStartLine; line < p_cubeLines; line += p_lineinc) {
+      if (!SetImage(p_cubeStartSamp, line) || !SetImage(p_cubeSamps, line)) {
+        return false;
+      }
+    }
+
+    // The corners in the order the image is walked
+    geos::geom::Coordinate corners[4] = {
+      geos::geom::Coordinate(p_cubeStartSamp, p_cubeStartLine),
+      geos::geom::Coordinate(p_cubeSamps, p_cubeStartLine),
+      geos::geom::Coordinate(p_cubeSamps, p_cubeLines),
+      geos::geom::Coordinate(p_cubeStartSamp, p_cubeLines)
+    };
+    geos::geom::Coordinate cornerGrounds[4];
+
+    for (int corner = 0; corner < 4; corner++) {
+      if (!SetImage(corners[corner].x, corners[corner].y)) {
+        return false;
+      }
+      cornerGrounds[corner] = geos::geom::Coordinate(p_longitude, p_latitude);
+    }
+
+    vector<geos::geom::Coordinate> points;
+    points.push_back(corners[0]);
+
+    for (int corner = 0; corner < 4; corner++) {
+      int next = (corner + 1) % 4;
+      bool alongSamples = (corners[corner].y == corners[next].y);
+      double length = alongSamples ?
+          fabs(corners[next].x - corners[corner].x) :
+          fabs(corners[next].y - corners[corner].y);
+
+      // A single test in the middle could miss a curved edge, so every edge
+      //   is tested in at least four pieces
+      if (!TraceEdge(corners[corner], cornerGrounds[corner],
+                     corners[next], cornerGrounds[next],
+                     alongSamples ? p_sampinc : p_lineinc, length / 4.0,
+                     radius, points)) {
+        return false;
+      }
+    }
+
+    FindSubpixel(points);
+    GroundPoly(points);
+    return true;
+  }
+
+
+  /**
+   * Appends the points after start up to and including end of one image edge
+   * for TraceEdges().
+   *
+   * @param start The first image position of the piece of the edge
+   * @param startGround The lon lat of start
+   * @param end The last image position of the piece of the edge
+   * @param endGround The lon lat of end
+   * @param minStep Pieces this long, in pixels, are not bisected
+   * @param maxStep Pieces longer than this, in pixels, are always bisected
+   * @param radius The radius of the target in meters
+   * @param points The image positions of the polygon
+   *
+   * @return bool False if an invalid position was found on the edge
+   */
+  bool ImagePolygon::TraceEdge(const geos::geom::Coordinate &start,
+                               const geos::geom::Coordinate &startGround,
+                               const geos::geom::Coordinate &end,
+                               const geos::geom::Coordinate &endGround,
+                               double minStep, double maxStep, double radius,
+                               std::vector<geos::geom::Coordinate> &points) {
+    double length = std::max(fabs(end.x - start.x), fabs(end.y - start.y));
+    if (length <= minStep || length < 2.0) {
+      points.push_back(end);
+      return true;
+    }
+
+    // Stay on pixel centers so the evaluations can be shared
+    geos::geom::Coordinate middle(floor((start.x + end.x) / 2.0),
+                                  floor((start.y + end.y) / 2.0));
+    if (!SetImage(middle.x, middle.y)) {
+      return false;
+    }
+    geos::geom::Coordinate middleGround(p_longitude, p_latitude);
+
+    if (length <= maxStep) {
+      double fraction = std::max(fabs(middle.x - start.x), fabs(middle.y - start.y)) /
+                        length;
+
+      double deltaLon = endGround.x - startGround.x;
+      if (deltaLon > 180.0) deltaLon -= 360.0;
+      if (deltaLon < -180.0) deltaLon += 360.0;
+
+      double lonError = middleGround.x - (startGround.x + fraction * deltaLon);
+      lonError = fmod(lonError + 540.0, 360.0) - 180.0;
+      double latError = middleGround.y -
+                        (startGround.y + fraction * (endGround.y - startGround.y));
+
+      lonError *= cos(middleGround.y * DEG2RAD);
+      double error = radius * DEG2RAD * sqrt(lonError * lonError + latError * latError);
+
+      if (error <= p_adaptiveTolerance) {
+        points.push_back(end);
+        return true;
+      }
+    }
+
+    return TraceEdge(start, startGround, middle, middleGround,
+                     minStep, maxStep, radius, points) &&
+           TraceEdge(middle, middleGround, end, endGround,
+                     minStep, maxStep, radius, points);
+  }
+
+
+  /**
+   * Converts the image positions of the polygon to lon lat and stores them to
+   * p_pts, fixing polygons that contain a pole.
+   *
+   * @param points The image positions of the polygon, the last one being the
+   *               same as the first
+   */
+  void ImagePolygon::GroundPoly(std::vector<geos::geom::Coordinate> &points) {
+    double lat, lon, prevLat, prevLon;
 
     prevLat = 0;
     prevLon = 0;
@@ -761,8 +946,8 @@ namespace Isis {
     for (unsigned int i = 0; i < points.size(); i++) {
       geos::geom::Coordinate *temp = &(points.at(i));
       SetImage(temp->x, temp->y);
-      lon = p_gMap->UniversalLongitude();
-      lat = p_gMap->UniversalLatitude();
+      lon = p_longitude;
+      lat = p_latitude;
       if (abs(lon - prevLon) >= 180 && i != 0) {
         crossingPoints->push_back(geos::geom::Coordinate(prevLon, prevLat));
       }
@@ -1042,7 +1227,10 @@ namespace Isis {
   /**
    * Sets the sample/line values of the cube to get lat/lon values.  This
    * method checks whether the image pixel is Null for level 2 images and
-   * if so, it is considered an invalid pixel.
+   * if so, it is considered an invalid pixel. The result and the lat/lon of
+   * every position are remembered in p_groundPoints, so walking and
+   * bisecting do not evaluate a position twice. The lat/lon are left in
+   * p_latitude and p_longitude rather than in the ground map.
    *
    * @param[in] sample   (const double)  Sample coordinate of the cube
    *
@@ -1052,6 +1240,41 @@ namespace Isis {
    *              was not or if pixel of level 2 images is NULL.
    */
   bool ImagePolygon::SetImage(const double sample, const double line) {
+    QPair<double, double> position(sample, line);
+    QHash< QPair<double, double>, GroundPoint >::const_iterator groundPoint =
+        p_groundPoints.constFind(position);
+
+    if (groundPoint == p_groundPoints.constEnd()) {
+      GroundPoint newPoint;
+      newPoint.valid = ProbeImage(sample, line);
+      newPoint.latitude = Null;
+      newPoint.longitude = Null;
+
+      if (newPoint.valid) {
+        newPoint.latitude = p_gMap->UniversalLatitude();
+        newPoint.longitude = p_gMap->UniversalLongitude();
+      }
+
+      groundPoint = p_groundPoints.insert(position, newPoint);
+    }
+
+    p_latitude = groundPoint->latitude;
+    p_longitude = groundPoint->longitude;
+    return groundPoint->valid;
+  }
+
+
+  /**
+   * Does the work of SetImage() for image positions that were not set before.
+   *
+   * @param[in] sample   (const double)  Sample coordinate of the cube
+   *
+   * @param[in] line     (const double)  Line coordinate of the cube
+   *
+   * @return bool Returns true if the image was set successfully and false if it
+   *              was not or if pixel of level 2 images is NULL.
+   */
+  bool ImagePolygon::ProbeImage(const double sample, const double line) {
     bool found = false;
     if (!p_isProjected) {
       found = p_gMap->SetImage(sample, line);
@@ -26,6 +26,9 @@
 #include <sstream>
 #include <vector>
 
+#include <QHash>
+#include <QPair>
+
 #include "IException.h"
 #include "Cube.h"
 #include "Brick.h"
@@ -162,6 +165,14 @@ namespace Isis {
    *                          periodically due to accessing a vector outside of it's bounds
    *                          (negative indices). This was in the 'triangle' (loop) detection code.
    *                          Fixes #994.
+   *  @history 2026-10-19 ISIS Development Team - Added AdaptiveTolerance() and TraceEdges().
+   *                          With a tolerance above 0, the image edges are bisected only
+   *                          where the ground position of their middle is further than the
+   *                          tolerance from the straight segment between their ends. The
+   *                          border is checked at the SINC/LINC spacing first, and the image
+   *                          is walked if any of those border pixels is invalid. SetImage()
+   *                          now remembers the result of every image position while a
+   *                          polygon is created, so no position is evaluated twice.
    */
 
   class ImagePolygon : public Isis::Blob {
@@ -217,6 +228,23 @@ namespace Isis {
         p_subpixelAccuracy = div;
       }
 
+      /**
+       * Trace the border of the image adaptively instead of walking it. Each
+       * image edge is only subdivided where the ground position of its middle
+       * is further than the given number of meters from the straight
+       * longitude/latitude segment between its end points. Images with an
+       * invalid border pixel, such as limb images, are still walked.
+       *
+       * ImagePolygon's constructor sets a default value of 0, which always
+       * walks the image.
+       *
+       * @param meters The allowed distance on the ground between the polygon
+       *               and the image border
+       */
+      void AdaptiveTolerance(double meters) {
+        p_adaptiveTolerance = meters;
+      }
+
       //!  Return a geos Multipolygon
       geos::geom::MultiPolygon *Polys() {
         return p_polygons;
@@ -244,9 +272,18 @@ namespace Isis {
       // Please do not add new polygon manipulation methods to this class.
       // Polygon manipulation should be done in the PolygonTools class.
       bool SetImage(const double sample, const double line);
+      bool ProbeImage(const double sample, const double line);
 
       geos::geom::Coordinate FindFirstPoint();
       void WalkPoly();
+      bool TraceEdges();
+      bool TraceEdge(const geos::geom::Coordinate &start,
+                     const geos::geom::Coordinate &startGround,
+                     const geos::geom::Coordinate &end,
+                     const geos::geom::Coordinate &endGround,
+                     double minStep, double maxStep, double radius,
+                     std::vector<geos::geom::Coordinate> &points);
+      void GroundPoly(std::vector<geos::geom::Coordinate> &points);
       geos::geom::Coordinate FindNextPoint(geos::geom::Coordinate *currentPoint,
                                            geos::geom::Coordinate lastPoint,
                                            int recursionDepth = 0);
@@ -301,6 +338,20 @@ namespace Isis {
 
       int p_subpixelAccuracy; //!< The subpixel accuracy to use
 
+      double p_adaptiveTolerance; //!< The tolerance in meters for tracing edges, 0 to walk
+
+      //! The result of SetImage() for an image position
+      struct GroundPoint {
+        bool valid;       //!< True if the position is valid
+        double latitude;  //!< The universal latitude, Null if not valid
+        double longitude; //!< The universal longitude, Null if not valid
+      };
+
+      //! The results of SetImage() by sample and line, for the current cube
+      QHash< QPair<double, double>, GroundPoint > p_groundPoints;
+      double p_latitude;  //!< The latitude of the last SetImage() position
+      double p_longitude; //!< The longitude of the last SetImage() position
+
   };
 };
 
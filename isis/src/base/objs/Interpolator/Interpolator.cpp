@@ -21,6 +21,7 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <cmath>
 #include <string>
 #include "IException.h"
 #include "Interpolator.h"
@@ -92,6 +93,233 @@ namespace Isis {
     string message = "Invalid interpolator";
     throw IException(IException::Programmer, message, _FILEINFO_);
   }
+
+  /**
+   * Finds the smallest tile of data that holds the interpolation windows of
+   * an array of coordinates.
+   *
+   * @param isamp The exact sample positions being interpolated.
+   * @param iline The exact line positions being interpolated.
+   * @param count The number of positions, at least one.
+   * @param startSample Receives the sample position of the first tile pixel.
+   * @param startLine Receives the line position of the first tile pixel.
+   * @param tileSamples Receives the number of samples in the tile.
+   * @param tileLines Receives the number of lines in the tile.
+   */
+  void Interpolator::TileExtent(const double isamp[], const double iline[],
+                                const int count, int &startSample,
+                                int &startLine, int &tileSamples,
+                                int &tileLines) {
+    double minSample = isamp[0];
+    double maxSample = isamp[0];
+    double minLine = iline[0];
+    double maxLine = iline[0];
+    for (int i = 1; i < count; i++) {
+      if (isamp[i] < minSample) minSample = isamp[i];
+      if (isamp[i] > maxSample) maxSample = isamp[i];
+      if (iline[i] < minLine) minLine = iline[i];
+      if (iline[i] > maxLine) maxLine = iline[i];
+    }
+
+    startSample = (int) floor(minSample - HotSample());
+    startLine = (int) floor(minLine - HotLine());
+    tileSamples = (int) floor(maxSample - HotSample()) - startSample + Samples();
+    tileLines = (int) floor(maxLine - HotLine()) - startLine + Lines();
+  }
+
+  /**
+   * Interpolates an array of coordinates from a tile of data.  This gives the
+   * same values as reading a Portal at each coordinate and calling the single
+   * coordinate Interpolate, without reading the cube for every pixel.
+   *
+   * The tile holds tileSamples by tileLines pixels, sample by sample and line
+   * by line, with its first pixel at startSample and startLine.  Pixels of an
+   * interpolation window that fall outside the tile are treated as NULL, just
+   * as a Portal is NULL where it falls outside the cube.
+   *
+   * The coordinates are done in blocks.  The weights of a block are computed
+   * into tables first, then the windows that are entirely in the tile and
+   * free of special pixels are weighted straight from the tile.  Any other
+   * window drops down to the lower interpolators one coordinate at a time.
+   *
+   * @param isamp The exact sample positions being interpolated.
+   * @param iline The exact line positions being interpolated.
+   * @param count The number of positions.
+   * @param tile The data to interpolate from.
+   * @param tileSamples The number of samples in the tile.
+   * @param tileLines The number of lines in the tile.
+   * @param startSample The sample position of the first pixel in the tile.
+   * @param startLine The line position of the first pixel in the tile.
+   * @param out Receives the count interpolated values.
+   *
+   * @throws IException::Programmer "Interpolator type not set"
+   */
+  void Interpolator::Interpolate(const double isamp[], const double iline[],
+                                 const int count, const double tile[],
+                                 const int tileSamples, const int tileLines,
+                                 const int startSample, const int startLine,
+                                 double out[]) {
+    if (p_type == None) {
+      string message = "Interpolator type not set";
+      throw IException(IException::Programmer, message, _FILEINFO_);
+    }
+
+    int windowSamples = Samples();
+    int windowLines = Lines();
+    double hotSample = HotSample();
+    double hotLine = HotLine();
+
+    int offsets[BatchSize];
+    double sampleWeights[4 * BatchSize];
+    double lineWeights[4 * BatchSize];
+
+    for (int first = 0; first < count; first += BatchSize) {
+      int size = count - first;
+      if (size > BatchSize) {
+        size = BatchSize;
+      }
+      const double *samples = &isamp[first];
+      const double *lines = &iline[first];
+      double *values = &out[first];
+
+      // Locate each window in the tile, -1 if it is not entirely in the tile
+      for (int i = 0; i < size; i++) {
+        int sample = (int) floor(samples[i] - hotSample) - startSample;
+        int line = (int) floor(lines[i] - hotLine) - startLine;
+        bool inside = (sample >= 0) && (line >= 0) &&
+                      (sample + windowSamples <= tileSamples) &&
+                      (line + windowLines <= tileLines);
+        offsets[i] = inside ? line * tileSamples + sample : -1;
+      }
+
+      if (p_type == NearestNeighborType) {
+        for (int i = 0; i < size; i++) {
+          if (offsets[i] >= 0) {
+            values[i] = tile[offsets[i]];
+          }
+          else {
+            values[i] = InterpolateWindow(samples[i], lines[i], tile, tileSamples,
+                                          tileLines, startSample, startLine);
+          }
+        }
+      }
+      else if (p_type == BiLinearType) {
+        for (int i = 0; i < size; i++) {
+          const double *buf = &tile[offsets[i] < 0 ? 0 : offsets[i]];
+          if (offsets[i] < 0 ||
+              Isis::IsSpecial(buf[0]) || Isis::IsSpecial(buf[1]) ||
+              Isis::IsSpecial(buf[tileSamples]) ||
+              Isis::IsSpecial(buf[tileSamples + 1])) {
+            values[i] = InterpolateWindow(samples[i], lines[i], tile, tileSamples,
+                                          tileLines, startSample, startLine);
+            continue;
+          }
+
+          double a = samples[i] - int (samples[i]);
+          double b = lines[i] - int (lines[i]);
+          values[i] = (1.0 - a) * (1.0 - b) * buf[0] +
+                      a * (1.0 - b) * buf[1] +
+                      (1.0 - a) * b * buf[tileSamples] +
+                      a * b * buf[tileSamples + 1];
+        }
+      }
+      else {
+        CubicWeights(samples, size, sampleWeights);
+        CubicWeights(lines, size, lineWeights);
+
+        for (int i = 0; i < size; i++) {
+          bool special = (offsets[i] < 0);
+          const double *buf = &tile[offsets[i] < 0 ? 0 : offsets[i]];
+          for (int line = 0; line < 4 && !special; line++) {
+            const double *row = &buf[line * tileSamples];
+            special = Isis::IsSpecial(row[0]) || Isis::IsSpecial(row[1]) ||
+                      Isis::IsSpecial(row[2]) || Isis::IsSpecial(row[3]);
+          }
+          if (special) {
+            values[i] = InterpolateWindow(samples[i], lines[i], tile, tileSamples,
+                                          tileLines, startSample, startLine);
+            continue;
+          }
+
+          const double *ws = &sampleWeights[4 * i];
+          const double *wl = &lineWeights[4 * i];
+          double rows[4];
+          for (int line = 0; line < 4; line++) {
+            const double *row = &buf[line * tileSamples];
+            rows[line] = ws[0] * row[0] + ws[1] * row[1] + ws[2] * row[2] +
+                         ws[3] * row[3];
+          }
+          values[i] = wl[0] * rows[0] + wl[1] * rows[1] + wl[2] * rows[2] +
+                      wl[3] * rows[3];
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Computes the cubic convolution weights of the four pixels around each of
+   * an array of coordinates.  The weights are the same terms CubicConvolution
+   * uses, so a window weighted with them gives the same value.
+   *
+   * @param coords The sample or line coordinates.
+   * @param count The number of coordinates.
+   * @param weights Receives four weights for each coordinate.
+   */
+  void Interpolator::CubicWeights(const double coords[], const int count,
+                                  double weights[]) {
+    for (int i = 0; i < count; i++) {
+      double a = coords[i] - int (coords[i]);
+      weights[4 * i] = -a * (1.0 - a) * (1.0 - a);
+      weights[4 * i + 1] = 1.0 - 2.0 * a * a + a * a * a;
+      weights[4 * i + 2] = a * (1.0 + a - a * a);
+      weights[4 * i + 3] = -(a * a * (1.0 - a));
+    }
+  }
+
+
+  /**
+   * Interpolates one coordinate from a tile of data.  The window around the
+   * coordinate is copied out of the tile, with NULLs where it falls outside
+   * the tile, and interpolated with the single coordinate Interpolate.
+   *
+   * @param isamp The exact sample position being interpolated.
+   * @param iline The exact line position being interpolated.
+   * @param tile The data to interpolate from.
+   * @param tileSamples The number of samples in the tile.
+   * @param tileLines The number of lines in the tile.
+   * @param sample The sample position of the first pixel in the tile.
+   * @param line The line position of the first pixel in the tile.
+   *
+   * @return double The interpolated value
+   */
+  double Interpolator::InterpolateWindow(const double isamp, const double iline,
+                                         const double tile[], const int tileSamples,
+                                         const int tileLines, const int sample,
+                                         const int line) {
+    int windowSamples = Samples();
+    int windowLines = Lines();
+    int firstSample = (int) floor(isamp - HotSample()) - sample;
+    int firstLine = (int) floor(iline - HotLine()) - line;
+
+    double buf[16];
+    for (int l = 0; l < windowLines; l++) {
+      for (int s = 0; s < windowSamples; s++) {
+        int ts = firstSample + s;
+        int tl = firstLine + l;
+        if (ts < 0 || tl < 0 || ts >= tileSamples || tl >= tileLines) {
+          buf[l * windowSamples + s] = Isis::Null;
+        }
+        else {
+          buf[l * windowSamples + s] = tile[tl * tileSamples + ts];
+        }
+      }
+    }
+
+    return Interpolate(isamp, iline, buf);
+  }
+
+
   /**
    * Sets the type of interpolation. (NearestNeighbor, BiLinear, CubicConvulsion).
    * @see Interpolator.h
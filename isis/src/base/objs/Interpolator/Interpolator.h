@@ -47,6 +47,9 @@ namespace Isis {
    *   file. (Note: XML files no longer used in documentation.)
    *   @history 2003-05-16 Stuart Sides modified schema from
    *   astrogeology...isis.astrogeology.
+   *   @history 2026-10-19 ISIS Development Team - Added a batch Interpolate
+   *   that interpolates arrays of coordinates from a tile of cube data, and
+   *   TileExtent to find that tile.
    */
   class Interpolator {
     public:
@@ -83,6 +86,17 @@ namespace Isis {
       double CubicConvolution(const double isamp, const double iline,
                               const double buf[]);
 
+      //! Number of coordinates whose weights are computed together
+      static const int BatchSize = 256;
+
+      void CubicWeights(const double coords[], const int count,
+                        double weights[]);
+
+      double InterpolateWindow(const double isamp, const double iline,
+                               const double tile[], const int tileSamples,
+                               const int tileLines, const int sample,
+                               const int line);
+
 
     public:
       // Constructores / destructores
@@ -95,6 +109,18 @@ namespace Isis {
       double Interpolate(const double isamp, const double iline,
                          const double buf[]);
 
+      // Find the tile of data an array of coordinates needs
+      void TileExtent(const double isamp[], const double iline[],
+                      const int count, int &startSample, int &startLine,
+                      int &tileSamples, int &tileLines);
+
+      // Interpolate arrays of coordinates from a tile of data
+      void Interpolate(const double isamp[], const double iline[],
+                       const int count, const double tile[],
+                       const int tileSamples, const int tileLines,
+                       const int startSample, const int startLine,
+                       double out[]);
+
 
       // Set the type of interpolation
       void SetType(const interpType &type);
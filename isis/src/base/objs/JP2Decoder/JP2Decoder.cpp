@@ -20,11 +20,15 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <algorithm>
+#include <cstring>
 #include <float.h>
 #include <iostream>
 #include <string>
 #include <sstream>
 
+#include <QThreadPool>
+
 #include "IException.h"
 #include "IString.h"
 #include "JP2Decoder.h"
@@ -50,7 +54,22 @@ namespace Isis {
 #if ENABLEJP2K
     p_jp2File = jp2file;
     p_resolutionLevel = 1;
+    p_regionSample = 0;
+    p_regionLine = 0;
+    p_regionSamples = 0;
+    p_regionLines = 0;
+    JP2_Stream = NULL;
     JP2_Source = NULL;
+    JPEG2000_Codestream = NULL;
+    p_threadEnv = NULL;
+    p_stripeHeights = NULL;
+    p_maxStripeHeights = NULL;
+    p_precisions = NULL;
+    p_isSigned = NULL;
+    p_stripeData = NULL;
+    p_stripeLines = 0;
+    p_stripeLine = 0;
+    p_linesPulled = 0;
 
     // Register the Kakadu error handler
     Kakadu_Error = new JP2Error;
@@ -61,6 +80,52 @@ namespace Isis {
 #endif
   }
 
+  /**
+   * Decode the image at a reduced resolution. Each level halves the number
+   * of samples and lines. The JPEG2000 codestream holds the reduced
+   * resolutions, so nothing finer than the requested resolution is decoded.
+   * This must be called before OpenFile().
+   *
+   * @param levels The number of resolution levels to discard, 0 for full
+   *               resolution. It must be less than GetResolutionLevels().
+   */
+  void JP2Decoder::SetResolutionReduction(int levels) {
+#if ENABLEJP2K
+    if (levels < 0) {
+      QString msg = "The resolution reduction of [" + p_jp2File + "] can not be negative";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+    p_resolutionLevel = levels + 1;
+#endif
+  }
+
+
+  /**
+   * Decode only a window of the image. Only the code blocks and precincts
+   * that contribute to the window are decoded. This must be called before
+   * OpenFile(). The dimensions returned after OpenFile() are those of the
+   * window at the requested resolution.
+   *
+   * @param sample The first sample of the window at full resolution, 1 based
+   * @param line The first line of the window at full resolution, 1 based
+   * @param samples The number of samples in the window at full resolution
+   * @param lines The number of lines in the window at full resolution
+   */
+  void JP2Decoder::SetRegion(int sample, int line, int samples, int lines) {
+#if ENABLEJP2K
+    if (sample < 1 || line < 1 || samples < 1 || lines < 1) {
+      QString msg = "Invalid region [" + toString(sample) + ", " + toString(line) + ", " +
+                    toString(samples) + ", " + toString(lines) + "] for [" + p_jp2File + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+    p_regionSample = sample - 1;
+    p_regionLine = line - 1;
+    p_regionSamples = samples;
+    p_regionLines = lines;
+#endif
+  }
+
+
   /**
    * Open the JPEG2000 file
    *
@@ -129,41 +194,97 @@ namespace Isis {
       // Get the total available resolution levels and set the effective
       // resolution and image region
       p_highestResLevel = JPEG2000_Codestream->get_min_dwt_levels() + 1;
+      if(p_resolutionLevel > p_highestResLevel) {
+        QString msg = "The resolution of [" + p_jp2File + "] can only be reduced by up to [" +
+                      toString((int)p_highestResLevel - 1) + "] levels";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
       SetResolutionAndRegion();
 
+      // Let Kakadu decode code blocks and tiles on as many threads as the
+      // global thread pool allows
+      int threads = QThreadPool::globalInstance()->maxThreadCount();
+      if(threads > 1) {
+        p_threadEnv = new kdu_thread_env();
+        p_threadEnv->create();
+        for(int i = 1; i < threads; i++) {
+          if(!p_threadEnv->add_thread()) break;
+        }
+      }
+
       // Initialize the JP2 decoder
       // Initialize the codestream stripe decompressor
-      p_decompressor.start(*JPEG2000_Codestream);
+      p_decompressor.start(*JPEG2000_Codestream, false, false, p_threadEnv);
 
-      // Determine optimum stripe heights for accessing data - the
-      // optimum stripe heights are ignored. We are instead reading
-      // the file a line at a time.
+      // Determine optimum stripe heights for accessing data. Whole stripes
+      // are decoded into an internal buffer, which the Read methods hand out
+      // a line at a time.
       p_stripeHeights = new int[p_numBands];
       p_maxStripeHeights = new int[p_numBands];
       p_precisions = new int[p_numBands];
       p_isSigned = new bool[p_numBands];
       p_decompressor.get_recommended_stripe_heights(MIN_STRIPE_HEIGHT,
           MAX_STRIPE_HEIGHT, p_stripeHeights, p_maxStripeHeights);
+
+      BigInt lineBytes = (BigInt)p_numSamples * p_pixelBytes;
+      p_stripeHeight = *std::min_element(p_stripeHeights, p_stripeHeights + p_numBands);
+      p_stripeHeight = std::min((BigInt)p_stripeHeight,
+          std::max((BigInt)1, (BigInt)STRIPE_BUFFER_BYTES / (lineBytes * p_numBands)));
+      p_stripeHeight = std::max(1, std::min(p_stripeHeight, (int)p_numLines));
+
+      p_stripeData = new unsigned char[p_stripeHeight * lineBytes * p_numBands];
       for(unsigned int i = 0; i < p_numBands; i++) {
         p_precisions[i] = p_pixelBits;
-        p_stripeHeights[i] = 1;
         p_isSigned[i] = p_signedData;
+        p_byteStripes.push_back(p_stripeData + i * p_stripeHeight * lineBytes);
+        p_shortStripes.push_back((short int *)p_byteStripes.back());
       }
     }
 #endif
   }
 
+
+  /**
+   * @return The number of resolution levels in the file, including full
+   *         resolution. Only valid after OpenFile().
+   */
+  int JP2Decoder::GetResolutionLevels() const {
+#if ENABLEJP2K
+    return (int)p_highestResLevel;
+#else
+    return 1;
+#endif
+  }
+
   /**
-   * Set resolution level of the JPEG2000 file. This class is currently set
-   * up to only read a file at full resolution.
+   * Set resolution level and region of the JPEG2000 file that will be
+   * decompressed. The whole image is decompressed at full resolution unless
+   * SetResolutionReduction() or SetRegion() were called.
    *
    */
   void JP2Decoder::SetResolutionAndRegion() {
 #if ENABLEJP2K
+    // The region is given on the full resolution canvas, which starts at the
+    // image position
+    kdu_dims region;
+    kdu_dims *regionOfInterest = NULL;
+    if(p_regionSamples > 0) {
+      if(p_regionSample + p_regionSamples > p_imageDims.size.x ||
+         p_regionLine + p_regionLines > p_imageDims.size.y) {
+        QString msg = "The region is outside of the image [" + p_jp2File + "]";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+      region.pos.x = p_imageDims.pos.x + p_regionSample;
+      region.pos.y = p_imageDims.pos.y + p_regionLine;
+      region.size.x = p_regionSamples;
+      region.size.y = p_regionLines;
+      regionOfInterest = &region;
+    }
+
     // Determine size of image at requested resolution and reset requested image
     // area if it falls outside of image boundaries
-    JPEG2000_Codestream->apply_input_restrictions(0, 0, p_resolutionLevel - 1, 0, NULL,
-        KDU_WANT_OUTPUT_COMPONENTS);
+    JPEG2000_Codestream->apply_input_restrictions(0, 0, p_resolutionLevel - 1, 0,
+        regionOfInterest, KDU_WANT_OUTPUT_COMPONENTS);
 
     JPEG2000_Codestream->get_dims(0, p_imageDims, true);
     p_numSamples = p_imageDims.size.x;
@@ -183,8 +304,12 @@ namespace Isis {
    */
   void JP2Decoder::Read(unsigned char **inbuf) {
 #if ENABLEJP2K
-    p_readStripes = p_decompressor.pull_stripe(inbuf, p_stripeHeights, NULL, NULL,
-                    p_precisions);
+    if(p_stripeLine >= p_stripeLines) {
+      PrepareStripe();
+      p_readStripes = p_decompressor.pull_stripe(&p_byteStripes[0], p_stripeHeights, NULL,
+                      NULL, p_precisions);
+    }
+    CopyLine((void **)inbuf);
 #endif
   }
 
@@ -200,8 +325,50 @@ namespace Isis {
    */
   void JP2Decoder::Read(short int **inbuf) {
 #if ENABLEJP2K
-    p_readStripes = p_decompressor.pull_stripe(inbuf, p_stripeHeights, NULL, NULL,
-                    p_precisions, p_isSigned);
+    if(p_stripeLine >= p_stripeLines) {
+      PrepareStripe();
+      p_readStripes = p_decompressor.pull_stripe(&p_shortStripes[0], p_stripeHeights, NULL,
+                      NULL, p_precisions, p_isSigned);
+    }
+    CopyLine((void **)inbuf);
+#endif
+  }
+
+
+  /**
+   * Set the height of the next stripe to decode, which is shorter at the end
+   * of the image.
+   *
+   */
+  void JP2Decoder::PrepareStripe() {
+#if ENABLEJP2K
+    if(p_linesPulled >= (int)p_numLines) {
+      QString msg = "Cannot read past the last line of [" + p_jp2File + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    p_stripeLines = std::min(p_stripeHeight, (int)p_numLines - p_linesPulled);
+    for(unsigned int i = 0; i < p_numBands; i++) {
+      p_stripeHeights[i] = p_stripeLines;
+    }
+    p_stripeLine = 0;
+    p_linesPulled += p_stripeLines;
+#endif
+  }
+
+
+  /**
+   * Copy the next line of every band from the decoded stripe.
+   *
+   * @param inbuf One line buffer for each band
+   */
+  void JP2Decoder::CopyLine(void **inbuf) {
+#if ENABLEJP2K
+    BigInt lineBytes = (BigInt)p_numSamples * p_pixelBytes;
+    for(unsigned int i = 0; i < p_numBands; i++) {
+      memcpy(inbuf[i], p_byteStripes[i] + p_stripeLine * lineBytes, lineBytes);
+    }
+    p_stripeLine++;
 #endif
   }
 
@@ -216,8 +383,17 @@ namespace Isis {
     // inteface that was passed to start."
     // i.e. Make sure to finish the decompressor before destroying the kdu_codestream.
     p_decompressor.finish();
+    if(p_threadEnv) {
+      if(JPEG2000_Codestream) {
+        p_threadEnv->cs_terminate(*JPEG2000_Codestream);
+      }
+      p_threadEnv->destroy();
+      delete p_threadEnv;
+    }
+    p_threadEnv = NULL;
     if(JPEG2000_Codestream) {
       JPEG2000_Codestream->destroy();
+      delete JPEG2000_Codestream;
     }
     JPEG2000_Codestream = NULL;
     if(JP2_Source) {
@@ -237,6 +413,7 @@ namespace Isis {
     delete [] p_maxStripeHeights;
     delete [] p_precisions;
     delete [] p_isSigned;
+    delete [] p_stripeData;
 #endif
   }
 
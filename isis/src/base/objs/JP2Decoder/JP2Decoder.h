@@ -23,6 +23,7 @@
  */
 
 #include <string>
+#include <vector>
 
 #if ENABLEJP2K
 #include "jp2.h"
@@ -31,6 +32,7 @@
 
 #define MIN_STRIPE_HEIGHT 256
 #define MAX_STRIPE_HEIGHT 8192
+#define STRIPE_BUFFER_BYTES 67108864
 
 namespace Isis {
   class JP2Error;
@@ -73,6 +75,12 @@ namespace Isis {
    *   jp.EndProcess();
    * @endcode
    *
+   * A window of the image, or the image at a reduced resolution, can be
+   * decoded without decoding the rest of the image by calling SetRegion() or
+   * SetResolutionReduction() before OpenFile(). The dimensions are then those
+   * of the window at the reduced resolution. Kakadu decodes each stripe on as
+   * many threads as the global thread pool allows.
+   *
    * If you would like to see JP2Decoder being used in implementation,
    * see std2isis.cpp or for a class that implements JP2Decoder,
    * see ProcessImport
@@ -94,6 +102,11 @@ namespace Isis {
    *                          before destroying the kdu_codestream. Caused segfault on OSX 10.11
    *                          for the JP2Importer test, and isis2std and std2isis jpeg2000 tests.
    *                          References #4809.
+   *  @history 2026-10-19 ISIS Development Team - Added SetRegion() and
+   *                          SetResolutionReduction() so that a window or an overview of a
+   *                          large file can be decoded. The file is now decoded in multi-line
+   *                          stripes on the Kakadu thread environment and handed out a line at
+   *                          a time by the Read methods.
    */
   class JP2Decoder {
     public:
@@ -105,9 +118,16 @@ namespace Isis {
         return Kakadu_Error;
       };
 
+      // Select the part of the JP2 file to decode, before OpenFile
+      void SetResolutionReduction(int levels);
+      void SetRegion(int sample, int line, int samples, int lines);
+
       // Open and initialize the JP2 file for reading
       void OpenFile();
 
+      // Get the number of resolution levels in the JP2 file
+      int GetResolutionLevels() const;
+
       // Get the sample dimension of the JP2 file
       inline int GetSampleDimension() const {
         return ((int) p_numSamples);
@@ -151,7 +171,11 @@ namespace Isis {
 
 #if ENABLEJP2K
       unsigned int p_resolutionLevel; //!<Resolution level that file will be decompressed
-      //!<at. Always full resolution.
+      //!<at. 1 is full resolution.
+      int p_regionSample;             //!<First sample of the region to decode, 0 based
+      int p_regionLine;               //!<First line of the region to decode, 0 based
+      int p_regionSamples;            //!<Samples in the region to decode, 0 for all
+      int p_regionLines;              //!<Lines in the region to decode, 0 for all
       unsigned int p_highestResLevel; //!<Total number of available resolution levels in
       //!<JP2 file.
       int *p_maxStripeHeights;        //!<Determines the maximum number of lines that can
@@ -166,6 +190,14 @@ namespace Isis {
       unsigned int p_pixelBits;       //!<Number of bits per pixel in JP2 file.
       bool p_readStripes;             //!<Number of lines read per call to Read methods
 
+      int p_stripeHeight;             //!<Number of lines decoded into the stripe buffer at once
+      int p_stripeLines;              //!<Number of lines in the current stripe
+      int p_stripeLine;               //!<Next line of the current stripe to hand out
+      int p_linesPulled;              //!<Number of lines decoded so far
+      unsigned char *p_stripeData;    //!<The stripe buffer for all bands
+      std::vector<unsigned char *> p_byteStripes; //!<Stripe of each band, for byte data
+      std::vector<short int *> p_shortStripes;    //!<Stripe of each band, for 16-bit data
+
 
       kdu_core::kdu_dims p_imageDims;           //!<Image dimensions of JP2 file
       kdu_supp::jp2_family_src *JP2_Stream;     //!<JP2 file input stream
@@ -173,12 +205,15 @@ namespace Isis {
       kdu_core::kdu_codestream *JPEG2000_Codestream;    //!<Allow access to JP2 file codestream.
       kdu_supp::kdu_stripe_decompressor p_decompressor; //!<High level interface to decompression of
       //!<JP2 file.
+      kdu_core::kdu_thread_env *p_threadEnv;    //!<Kakadu threads, NULL when single threaded
 #endif
       JP2Error *Kakadu_Error;         //!<JP2 Error handling facility
 
       void SetResolutionAndRegion();  //!<Sets resolution of data that will be decompressed.
       //!<Also determines the image dimensions at the requested
       //!<resolution.
+      void PrepareStripe();           //!<Sets the height of the next stripe to decode.
+      void CopyLine(void **inbuf);    //!<Copies the next line out of the stripe buffer.
   };
 };
 #endif
@@ -22,9 +22,13 @@
 
 #include <float.h>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <sstream>
 
+#include <QThreadPool>
+
 #include "IException.h"
 #include "IString.h"
 #include "JP2Encoder.h"
@@ -107,6 +111,18 @@ namespace Isis {
     p_tileSizeWidth = p_sampleDimension; // untiled - size of image
     p_tileSizeHeight = p_lineDimension;
 
+    JP2_Stream = NULL;
+    JP2_Boxes = NULL;
+    JPEG2000_Codestream = NULL;
+    p_threadEnv = NULL;
+    p_stripeHeights = NULL;
+    p_maxStripeHeights = NULL;
+    p_precisions = NULL;
+    p_isSigned = NULL;
+    p_stripeData = NULL;
+    p_stripeLines = 0;
+    p_linesWritten = 0;
+
     // Register the Kakadu error handler
     Kakadu_Error = new JP2Error;
     kdu_customize_errors(Kakadu_Error);
@@ -117,6 +133,26 @@ namespace Isis {
   }
 
 
+  /**
+   * Write the image in tiles instead of as a single tile. Tiles let a
+   * decoder find a window of the image without reading the packets of the
+   * whole image. This must be called before OpenFile().
+   *
+   * @param samples The width of a tile
+   * @param lines The height of a tile
+   */
+  void JP2Encoder::SetTileSize(const unsigned int samples, const unsigned int lines) {
+#if ENABLEJP2K
+    if(samples == 0 || lines == 0) {
+      string msg = "Invalid tile size specified for output file";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+    p_tileSizeWidth = std::min(samples, p_sampleDimension);
+    p_tileSizeHeight = std::min(lines, p_lineDimension);
+#endif
+  }
+
+
   /**
    * Open the JPEG2000 file and initialize it
    *
@@ -163,7 +199,7 @@ namespace Isis {
     // requested for incremental flushing rounded up to the next whole
     // number.
     int TLM_segments;
-    int p_flushLines = 0;
+    p_flushLines = 0;
     long long line_bytes = (long long)p_sampleDimension * p_pixelBytes;
     if(INCREMENTAL_FLUSH_BYTES < (p_lineDimension * line_bytes)) {
       p_flushLines = p_tileSizeHeight;
@@ -246,25 +282,84 @@ namespace Isis {
     kdu_long *layer_sizes = new kdu_long[layers];
     memset(layer_sizes, 0, sizeof(kdu_long)*layers);
 
+    // Let Kakadu encode code blocks and tiles on as many threads as the
+    // global thread pool allows
+    int threads = QThreadPool::globalInstance()->maxThreadCount();
+    if(threads > 1) {
+      p_threadEnv = new kdu_thread_env();
+      p_threadEnv->create();
+      for(int i = 1; i < threads; i++) {
+        if(!p_threadEnv->add_thread()) break;
+      }
+    }
+
     // Initialize the codestream stripe compressor
     p_compressor.start(*JPEG2000_Codestream, layers, layer_sizes, NULL, 0, false,
-                       p_pixelBytes == 4); // Force precise for 32-bit values
+                       p_pixelBytes == 4, // Force precise for 32-bit values
+                       true, 0.0, 0, false, p_threadEnv);
+    delete [] layer_sizes;
 
-    // Determine optimum stripe heights for accessing data
+    // Determine optimum stripe heights for accessing data. Lines are
+    // collected into stripes of about this height before they are pushed to
+    // the compressor.
     p_stripeHeights = new int[p_bandDimension];
     p_maxStripeHeights = new int[p_bandDimension];
     p_precisions = new int[p_bandDimension];
     p_isSigned = new bool[p_bandDimension];
     p_compressor.get_recommended_stripe_heights(MIN_STRIPE_HEIGHT,
         MAX_STRIPE_HEIGHT, p_stripeHeights, p_maxStripeHeights);
+
+    p_stripeHeight = *std::min_element(p_stripeHeights, p_stripeHeights + p_bandDimension);
+    p_stripeHeight = std::min((long long)p_stripeHeight,
+        std::max(1LL, (long long)STRIPE_BUFFER_BYTES / (line_bytes * p_bandDimension)));
+    p_stripeHeight = std::max(1, std::min(p_stripeHeight, (int)p_lineDimension));
+
+    p_stripeData = new unsigned char[p_stripeHeight * line_bytes * p_bandDimension];
     for(unsigned int i = 0; i < p_bandDimension; i++) {
       p_precisions[i] = p_pixelBits;
       p_isSigned[i] = p_signedData;
-      p_stripeHeights[i] = 1;
+      p_byteStripes.push_back(p_stripeData + i * p_stripeHeight * line_bytes);
+      p_shortStripes.push_back((short int *)p_byteStripes.back());
     }
 #endif
   }
 
+
+  /**
+   * Copy a line of every band into the stripe buffer.
+   *
+   * @param inbuf One line buffer for each band
+   *
+   * @return True if the stripe is ready to be pushed to the compressor
+   */
+  bool JP2Encoder::BufferLine(void **inbuf) {
+#if ENABLEJP2K
+    if(p_linesWritten >= (int)p_lineDimension) {
+      QString msg = "Cannot write past the last line of [" + p_jp2File + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    long long lineBytes = (long long)p_sampleDimension * p_pixelBytes;
+    for(unsigned int i = 0; i < p_bandDimension; i++) {
+      memcpy(p_byteStripes[i] + p_stripeLines * lineBytes, inbuf[i], lineBytes);
+    }
+    p_stripeLines++;
+    p_linesWritten++;
+
+    if(p_stripeLines < p_stripeHeight && p_linesWritten < (int)p_lineDimension) {
+      return false;
+    }
+
+    for(unsigned int i = 0; i < p_bandDimension; i++) {
+      p_stripeHeights[i] = p_stripeLines;
+    }
+    p_stripeLines = 0;
+    return true;
+#else
+    return false;
+#endif
+  }
+
   /**
    * Write 8-bit data to JP2 file
    *
@@ -275,7 +370,8 @@ namespace Isis {
    */
   void JP2Encoder::Write(unsigned char **inbuf) {
 #if ENABLEJP2K
-    p_writeStripes = p_compressor.push_stripe(inbuf, p_stripeHeights, NULL, NULL,
+    if(!BufferLine((void **)inbuf)) return;
+    p_writeStripes = p_compressor.push_stripe(&p_byteStripes[0], p_stripeHeights, NULL, NULL,
                      p_precisions, p_flushLines);
 #endif
   }
@@ -290,7 +386,8 @@ namespace Isis {
    */
   void JP2Encoder::Write(short int **inbuf) {
 #if ENABLEJP2K
-    p_writeStripes = p_compressor.push_stripe(inbuf, p_stripeHeights, NULL, NULL,
+    if(!BufferLine((void **)inbuf)) return;
+    p_writeStripes = p_compressor.push_stripe(&p_shortStripes[0], p_stripeHeights, NULL, NULL,
                      p_precisions, p_isSigned, p_flushLines);
 #endif
   }
@@ -302,6 +399,13 @@ namespace Isis {
   JP2Encoder::~JP2Encoder() {
 #if ENABLEJP2K
     p_compressor.finish();
+    if(p_threadEnv) {
+      if(JPEG2000_Codestream) {
+        p_threadEnv->cs_terminate(*JPEG2000_Codestream);
+      }
+      p_threadEnv->destroy();
+      delete p_threadEnv;
+    }
     JPEG2000_Codestream->destroy();
     JP2_Boxes->close();
     JP2_Stream->close();
@@ -309,6 +413,7 @@ namespace Isis {
     delete [] p_maxStripeHeights;
     delete [] p_precisions;
     delete [] p_isSigned;
+    delete [] p_stripeData;
 #endif
   }
 }
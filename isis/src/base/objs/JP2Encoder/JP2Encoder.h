@@ -23,6 +23,7 @@
  */
 
 #include <string>
+#include <vector>
 
 #include "PixelType.h"
 
@@ -34,6 +35,7 @@
 #define MIN_STRIPE_HEIGHT 256
 #define MAX_STRIPE_HEIGHT 8192
 #define INCREMENTAL_FLUSH_BYTES                         (256 * 1024 * 1024)
+#define STRIPE_BUFFER_BYTES 67108864
 
 namespace Isis {
   class JP2Error;
@@ -65,6 +67,11 @@ namespace Isis {
    *   delete JP2_encoder;
    * @endcode
    *
+   * Lines passed to the Write methods are collected into multi-line stripes,
+   * which Kakadu encodes on as many threads as the global thread pool allows.
+   * The image is written as a single tile unless SetTileSize() is called
+   * before OpenFile().
+   *
    * If you would like to see JP2Encoder being used in implementation,
    * see isis2std.cpp
    *
@@ -78,6 +85,10 @@ namespace Isis {
    *                        support for JP2K is disabled
    *  @history 2017-08-21 Tyler Wilson, Ian Humphrey, Summer Stapleton - Added
    *                        support for new kakadu libraries.  References #4809.
+   *  @history 2026-10-19 ISIS Development Team - Added SetTileSize(). Lines are now
+   *                        encoded in multi-line stripes on the Kakadu thread environment.
+   *                        Fixed the incremental flush period, which OpenFile() set on a
+   *                        local variable instead of the member.
    *
    */
   class JP2Encoder {
@@ -92,6 +103,9 @@ namespace Isis {
         return Kakadu_Error;
       };
 
+      // Write the image in tiles, before OpenFile
+      void SetTileSize(const unsigned int samples, const unsigned int lines);
+
       // Open and initialize the JP2 file for writing
       void OpenFile();
 
@@ -131,12 +145,22 @@ namespace Isis {
       bool *p_isSigned;                //!<Determines if the data is signed/unsigned for each
       //!<band in the JP2 file
 
+      int p_stripeHeight;              //!<Number of lines pushed to the compressor at once
+      int p_stripeLines;               //!<Number of lines in the stripe buffer
+      int p_linesWritten;              //!<Number of lines written so far
+      unsigned char *p_stripeData;     //!<The stripe buffer for all bands
+      std::vector<unsigned char *> p_byteStripes; //!<Stripe of each band, for byte data
+      std::vector<short int *> p_shortStripes;    //!<Stripe of each band, for 16-bit data
+
       kdu_supp::jp2_family_tgt *JP2_Stream;      //!<JP2 file output stream
       kdu_supp::jp2_target *JP2_Boxes;           //!<JP2 boxes for the JP2 file output stream
       kdu_core::kdu_codestream *JPEG2000_Codestream; //!<Allow access to JP2 file codestream
       kdu_supp::kdu_stripe_compressor p_compressor;  //!<High level interface to compression of JP2
       //!<file
+      kdu_core::kdu_thread_env *p_threadEnv;     //!<Kakadu threads, NULL when single threaded
 #endif
+
+      bool BufferLine(void **inbuf);   //!<Copies a line into the stripe buffer
   };
 };
 #endif
@@ -2,6 +2,7 @@
 
 #include "FileName.h"
 #include "IException.h"
+#include "IString.h"
 #include "JP2Decoder.h"
 #include "ProcessImport.h"
 
@@ -17,6 +18,11 @@ namespace Isis {
   JP2Importer::JP2Importer(FileName inputName) : ImageImporter(inputName) {
     m_decoder = NULL;
     m_buffer = NULL;
+    m_regionSample = 1;
+    m_regionLine = 1;
+    m_regionSamples = 0;
+    m_regionLines = 0;
+    m_reduction = 0;
 
     try {
       // Determine if input file is a JPEG2000 file
@@ -25,6 +31,8 @@ namespace Isis {
       setSamples(m_decoder->GetSampleDimension());
       setLines(m_decoder->GetLineDimension());
       setBands(m_decoder->GetBandDimension());
+      m_fullSamples = samples();
+      m_fullLines = lines();
 
       int pixelBytes = m_decoder->GetPixelBytes();
       if (pixelBytes == 1) {
@@ -41,11 +49,7 @@ namespace Isis {
             _FILEINFO_);
       }
 
-      int pixelSize = Isis::SizeOf(m_pixelType);
-      int readBytes = pixelSize * samples() * bands();
-
-      m_buffer = new char* [bands()];
-      for (int i = 0; i < bands(); i++) m_buffer[i] = new char [readBytes];
+      allocateBuffer();
     }
     catch (IException &e) {
       throw IException(IException::Programmer,
@@ -60,11 +64,112 @@ namespace Isis {
    * Destruct the importer.
    */
   JP2Importer::~JP2Importer() {
+    freeBuffer();
+
     delete m_decoder;
     m_decoder = NULL;
+  }
 
-    delete [] m_buffer;
-    m_buffer = NULL;
+
+  /**
+   * Import only a window of the image. Only the part of the JPEG 2000
+   * codestream that contributes to the window is decoded.
+   *
+   * @param sample The first sample of the window at full resolution
+   * @param line The first line of the window at full resolution
+   * @param samples The number of samples in the window at full resolution
+   * @param lines The number of lines in the window at full resolution
+   *
+   * @throws IException::User "The subarea is outside of the image"
+   */
+  void JP2Importer::setRegion(int sample, int line, int samples, int lines) {
+    if (sample < 1 || line < 1 || samples < 1 || lines < 1 ||
+        sample + samples - 1 > m_fullSamples || line + lines - 1 > m_fullLines) {
+      throw IException(IException::User,
+          "The subarea starting at sample [" + toString(sample) + "] and line [" +
+          toString(line) + "] with [" + toString(samples) + "] samples and [" +
+          toString(lines) + "] lines is outside of the image [" +
+          filename().expanded() + "]",
+          _FILEINFO_);
+    }
+
+    m_regionSample = sample;
+    m_regionLine = line;
+    m_regionSamples = samples;
+    m_regionLines = lines;
+    reopenDecoder();
+  }
+
+
+  /**
+   * Import the image at a reduced resolution. Each level halves the number of
+   * samples and lines, and only the resolutions down to the requested one are
+   * decoded.
+   *
+   * @param levels The number of resolution levels to discard, 0 for full
+   *               resolution
+   *
+   * @throws IException::User "The resolution can only be reduced by up to
+   *                           [levels] levels"
+   */
+  void JP2Importer::setResolutionReduction(int levels) {
+    if (levels < 0 || levels >= m_decoder->GetResolutionLevels()) {
+      throw IException(IException::User,
+          "The resolution of [" + filename().expanded() +
+          "] can only be reduced by up to [" +
+          toString(m_decoder->GetResolutionLevels() - 1) + "] levels",
+          _FILEINFO_);
+    }
+
+    m_reduction = levels;
+    reopenDecoder();
+  }
+
+
+  /**
+   * Opens the input again with the current region and resolution reduction,
+   * and sets the dimensions of the output to those of the decoded image.
+   */
+  void JP2Importer::reopenDecoder() {
+    freeBuffer();
+    delete m_decoder;
+    m_decoder = NULL;
+
+    m_decoder = new JP2Decoder(filename().expanded());
+    if (m_regionSamples > 0) {
+      m_decoder->SetRegion(m_regionSample, m_regionLine, m_regionSamples, m_regionLines);
+    }
+    m_decoder->SetResolutionReduction(m_reduction);
+    m_decoder->OpenFile();
+    setSamples(m_decoder->GetSampleDimension());
+    setLines(m_decoder->GetLineDimension());
+
+    allocateBuffer();
+  }
+
+
+  /**
+   * Allocates the buffer that holds a line of every band of the input.
+   */
+  void JP2Importer::allocateBuffer() {
+    int pixelSize = Isis::SizeOf(m_pixelType);
+    int readBytes = pixelSize * samples() * bands();
+
+    m_bufferBands = m_decoder->GetBandDimension();
+    m_buffer = new char* [m_bufferBands];
+    for (int i = 0; i < m_bufferBands; i++) m_buffer[i] = new char [readBytes];
+  }
+
+
+  /**
+   * Frees the line buffer.
+   */
+  void JP2Importer::freeBuffer() {
+    if (m_buffer != NULL) {
+      for (int i = 0; i < m_bufferBands; i++) delete [] m_buffer[i];
+      delete [] m_buffer;
+      m_buffer = NULL;
+    }
   }
 
 
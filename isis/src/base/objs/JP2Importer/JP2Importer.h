@@ -41,6 +41,10 @@ namespace Isis {
    *
    * @internal
    *   @history 2012-03-28 Travis Addair - Added documentation.
+   *   @history 2026-10-19 ISIS Development Team - Added setRegion() and
+   *                           setResolutionReduction() to import a subarea or a
+   *                           reduced resolution of the image without decoding
+   *                           the rest of it. The line buffers are now freed.
    *
    */
   class JP2Importer : public ImageImporter {
@@ -52,6 +56,9 @@ namespace Isis {
       virtual bool isRgb() const;
       virtual bool isArgb() const;
 
+      void setRegion(int sample, int line, int samples, int lines);
+      void setResolutionReduction(int levels);
+
     protected:
       virtual void updateRawBuffer(int line, int band) const;
       virtual int getPixel(int s, int l) const;
@@ -65,6 +72,10 @@ namespace Isis {
       int getFromBuffer(int s, int b) const;
 
     private:
+      void reopenDecoder();
+      void allocateBuffer();
+      void freeBuffer();
+
       //! Takes a raw stream of JPEG 2000 data and reads it into a buffer.
       JP2Decoder *m_decoder;
 
@@ -73,6 +84,30 @@ namespace Isis {
 
       //! Pixel type of the input image needed for reading data into the buffer.
       Isis::PixelType m_pixelType;
+
+      //! Number of bands in the buffer.
+      int m_bufferBands;
+
+      //! Samples of the image at full resolution.
+      int m_fullSamples;
+
+      //! Lines of the image at full resolution.
+      int m_fullLines;
+
+      //! First sample of the region to import.
+      int m_regionSample;
+
+      //! First line of the region to import.
+      int m_regionLine;
+
+      //! Samples in the region to import, 0 for the whole image.
+      int m_regionSamples;
+
+      //! Lines in the region to import, 0 for the whole image.
+      int m_regionLines;
+
+      //! Number of resolution levels to discard.
+      int m_reduction;
   };
 };
 
@@ -26,6 +26,7 @@
 #include "OriginalLabel.h"
 #include "Application.h"
 #include "PvlObject.h"
+#include "PvlParser.h"
 
 using namespace std;
 namespace Isis {
@@ -91,6 +92,13 @@ namespace Isis {
    */
   Pvl OriginalLabel::ReturnLabels() {
     Pvl pvl;
+
+    PvlParser parser(p_buffer, p_nbytes);
+    if (parser.parse(pvl)) {
+      return pvl;
+    }
+
+    pvl.clear();
     stringstream os;
     for(int i = 0; i < p_nbytes; i++) os << p_buffer[i];
     os >> pvl;
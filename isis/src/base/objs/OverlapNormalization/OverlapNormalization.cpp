@@ -22,8 +22,11 @@
 
 #include "OverlapNormalization.h"
 
+#include <algorithm>
 #include <iomanip>
 
+#include <armadillo>
+
 #include "BasisFunction.h"
 #include "IException.h"
 #include "LeastSquares.h"
@@ -177,19 +180,13 @@ namespace Isis {
       throw IException(IException::User, msg, _FILEINFO_);
     }
     
-    if ( method == LeastSquares::SPARSE ) {
-      m_offsetLsq = NULL;
-      m_gainLsq = NULL;
-      delete m_offsetLsq;
-      delete m_gainLsq;
-      int sparseMatrixRows = m_overlapList.size() + m_idHoldList.size();
-      int sparseMatrixCols = m_offsetFunction->Coefficients();
-      m_offsetLsq = new LeastSquares(*m_offsetFunction, true, sparseMatrixRows, sparseMatrixCols, true);
-      sparseMatrixCols = m_gainFunction->Coefficients();
-      m_gainLsq = new LeastSquares(*m_gainFunction, true, sparseMatrixRows, sparseMatrixCols, true);
-      const std::vector<double> alphaWeight(sparseMatrixCols, 1/1000.0);
-      m_offsetLsq->SetParameterWeights( alphaWeight );
-      m_gainLsq->SetParameterWeights( alphaWeight );
+    // Every overlap only involves two data sets, so the sparse solution is
+    // formed directly from the overlaps instead of a row per overlap with a
+    // column for every data set
+    if (method == LeastSquares::SPARSE) {
+      SolveSparse(type);
+      m_solved = true;
+      return;
     }
 
     // Calculate offsets
@@ -294,6 +291,162 @@ namespace Isis {
     m_solved = true;
   }
 
+  /**
+   * Solves for the offsets and gains with a sparse least squares solution.
+   *
+   * Each overlap adds a row with a 1 for its first data set and a -1 for its
+   * second data set, and each hold adds a row with a 1 for the held data set,
+   * so the normal equations matrix has a nonzero element for the diagonal and
+   * for each overlapping pair of data sets. It is summed directly from the
+   * overlaps and solved like LeastSquares::SolveSparse() does, including the
+   * 1/1000 parameter weights that were applied when this used LeastSquares, so
+   * the time and memory used grow with the number of overlaps instead of the
+   * number of overlaps times the number of data sets.
+   *
+   * @param type The enumeration clarifying whether the offset, gain, or both
+   *             should be solved
+   */
+  void OverlapNormalization::SolveSparse(SolutionType type) {
+    // Calculate offsets
+    if (type != Gains && type != GainsWithoutNormalization) {
+      m_offsets = SolveSparse(m_deltas, m_weights, 1e30);
+    }
+
+    // Calculate Gains
+    if (type != Offsets) {
+      std::vector<double> logRatios(m_overlapList.size());
+      std::vector<double> weights(m_overlapList.size());
+
+      for (int overlap = 0; overlap < (int)m_overlapList.size(); overlap++) {
+        const Overlap &curOverlap = m_overlapList[overlap];
+        double tanp;
+
+        if (type != GainsWithoutNormalization) {
+          if (curOverlap.area1.StandardDeviation() == 0.0) {
+            tanp = 0.0;    // Set gain to 1.0
+          }
+          else {
+            tanp = curOverlap.area2.StandardDeviation()
+                   / curOverlap.area1.StandardDeviation();
+          }
+        }
+        else {
+          if (curOverlap.area1.Average() == 0.0) {
+            tanp = 0.0;
+          }
+          else {
+            tanp = curOverlap.area2.Average() / curOverlap.area1.Average();
+          }
+        }
+
+        if (tanp > 0.0) {
+          logRatios[overlap] = log(tanp);
+          weights[overlap] = m_weights[overlap];
+        }
+        else {
+          logRatios[overlap] = 0.0;
+          weights[overlap] = 1e10; // Set gain to 1.0
+        }
+      }
+
+      m_gains = SolveSparse(logRatios, weights, 1e10);
+      for (int i = 0; i < (int)m_gains.size(); i++) {
+        m_gains[i] = exp(m_gains[i]);
+      }
+    }
+  }
+
+
+  /**
+   * Solves the sparse least squares equation for one coefficient per data
+   * set.
+   *
+   * @param observations The expected difference of each overlap, the
+   *                     coefficient of its first data set minus the
+   *                     coefficient of its second data set
+   * @param weights The weight of each overlap
+   * @param holdWeight The weight of the zero expected for each held data set
+   *
+   * @return std::vector<double> The coefficient of each data set
+   *
+   * @throws Isis::IException::Unknown - Could not solve sparse least squares
+   *             problem
+   */
+  std::vector<double> OverlapNormalization::SolveSparse(
+      const std::vector<double> &observations, const std::vector<double> &weights,
+      double holdWeight) const {
+    int sets = m_statsList.size();
+
+    // The weighted normal equations. The diagonal gets the same parameter
+    // weights LeastSquares applies when solving a bundle adjustment.
+    std::vector<double> diagonal(sets, 1 / 1000.0);
+    std::vector<double> rhs(sets, 0.0);
+    std::vector< std::pair<std::pair<int, int>, double> > offDiagonal;
+    offDiagonal.reserve(2 * m_overlapList.size());
+
+    for (int overlap = 0; overlap < (int)m_overlapList.size(); overlap++) {
+      int id1 = m_overlapList[overlap].index1;
+      int id2 = m_overlapList[overlap].index2;
+      double weight = weights[overlap];
+
+      diagonal[id1] += weight;
+      diagonal[id2] += weight;
+      rhs[id1] += weight * observations[overlap];
+      rhs[id2] -= weight * observations[overlap];
+      offDiagonal.push_back(std::make_pair(std::make_pair(id2, id1), -weight));
+      offDiagonal.push_back(std::make_pair(std::make_pair(id1, id2), -weight));
+    }
+
+    for (int h = 0; h < (int)m_idHoldList.size(); h++) {
+      diagonal[m_idHoldList[h]] += holdWeight;
+    }
+
+    // Sum the elements of pairs that overlap more than once, in column order
+    std::sort(offDiagonal.begin(), offDiagonal.end());
+
+    std::vector<arma::uword> rows;
+    std::vector<arma::uword> columns;
+    std::vector<double> values;
+    for (int i = 0; i < sets; i++) {
+      rows.push_back(i);
+      columns.push_back(i);
+      values.push_back(diagonal[i]);
+    }
+    for (int i = 0; i < (int)offDiagonal.size(); i++) {
+      int column = offDiagonal[i].first.first;
+      int row = offDiagonal[i].first.second;
+      if (!columns.empty() && columns.back() == (arma::uword)column &&
+          rows.back() == (arma::uword)row) {
+        values.back() += offDiagonal[i].second;
+      }
+      else {
+        rows.push_back(row);
+        columns.push_back(column);
+        values.push_back(offDiagonal[i].second);
+      }
+    }
+
+    arma::umat locations(2, values.size());
+    for (int i = 0; i < (int)values.size(); i++) {
+      locations(0, i) = rows[i];
+      locations(1, i) = columns[i];
+    }
+
+    arma::sp_mat normals(locations, arma::vec(values), sets, sets);
+    arma::vec b(rhs);
+    arma::vec x;
+
+    bool status = spsolve(x, normals, b, "superlu");
+
+    if (status == false) {
+      QString msg = "Could not solve sparse least squares problem.";
+      throw IException(IException::Unknown, msg, _FILEINFO_);
+    }
+
+    return arma::conv_to< std::vector<double> >::from(x);
+  }
+
+
   /**
    * Returns the calculated average DN value for the given
    * data set
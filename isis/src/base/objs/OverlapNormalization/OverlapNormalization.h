@@ -72,6 +72,10 @@ namespace Isis {
    *                           #911.
    *   @history 2019-09-05 Makayla Shepherd & Jesse Mapel - Changed weight for hold images from
    *                           1E30 to 1E10 to avoid poorly conditioned normal matrix.
+   *   @history 2026-10-19 ISIS Development Team - The SPARSE solve method now forms the
+   *                           sparse normal equations directly from the overlaps instead
+   *                           of filling a LeastSquares row with a column for every data
+   *                           set, and no longer leaks the LeastSquares objects.
    */
 
   class OverlapNormalization {
@@ -161,6 +165,10 @@ namespace Isis {
       double Evaluate(double dn, unsigned index) const;
 
     private:
+      void SolveSparse(SolutionType type);
+      std::vector<double> SolveSparse(const std::vector<double> &observations,
+                                      const std::vector<double> &weights,
+                                      double holdWeight) const;
 
       /**
        * Vector of Statistics objects for each data set
@@ -57,7 +57,8 @@ namespace Isis {
    * @param x The first input cube
    * @param y The second input cube
    * @param progressMsg (Default value of "Gathering Overlap Statistics") Text
-   *         for indicating progress during statistic gathering
+   *         for indicating progress during statistic gathering. No progress is
+   *         reported if it is empty, so overlaps can be gathered in parallel.
    * @param sampPercent (Default value of 100.0) Sampling percent, or the percentage
    *       of lines to consider during the statistic gathering procedure
    *
@@ -137,6 +138,7 @@ namespace Isis {
       p_lineRange = p_maxLineX - p_minLineX + 1;
 
       // Print percent processed
+      bool reportProgress = !progressMsg.isEmpty();
       Progress progress;
       progress.SetText(progressMsg);
 
@@ -152,7 +154,7 @@ namespace Isis {
 
 
       progress.SetMaximumSteps(maxSteps);
-      progress.CheckStatus();
+      if (reportProgress) progress.CheckStatus();
 
       // Collect and store off the overlap statistics
       for (int band = 1; band <= p_bands; band++) {
@@ -174,7 +176,7 @@ namespace Isis {
           }
           else i += linc; // Increment the current line by our incrementer
 
-          progress.CheckStatus();
+          if (reportProgress) progress.CheckStatus();
         }
       }
     }
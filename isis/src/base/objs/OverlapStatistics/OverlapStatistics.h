@@ -71,6 +71,9 @@ namespace Isis {
    *                          object from a PvlObject. Added private fromPvl() method to implement
    *                          these details. Updated unitTest to test these changes. References 
    *                          #2282.
+   *  @history 2026-10-19 ISIS Development Team - An empty progress message now
+   *                          turns off progress reporting, so overlaps can be
+   *                          gathered on several threads at once.
    *
    */
 
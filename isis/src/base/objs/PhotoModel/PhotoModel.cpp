@@ -1,6 +1,7 @@
 #include <cmath>
 #include "FileName.h"
 #include "PhotoModel.h"
+#include "PhotometricTable.h"
 #include "Plugin.h"
 #include "Pvl.h"
 #include "IException.h"
@@ -35,6 +36,13 @@ namespace Isis {
     }
 
     p_standardConditions = false;
+    p_table = NULL;
+  }
+
+  //! Destroys the PhotoModel object
+  PhotoModel::~PhotoModel() {
+    delete p_table;
+    p_table = NULL;
   }
 
   /**
@@ -177,11 +185,72 @@ namespace Isis {
     //  throw iException::Message(iException::Programmer,msg,_FILEINFO_);
     //}
 
+    // Use the table unless the parameters are swapped for standard conditions
+    double albedo;
+    if (p_table && !p_standardConditions &&
+        p_table->evaluate(pha, inc, ema, &albedo)) {
+      return albedo;
+    }
+
     // Apply photometric function
-    double albedo = PhotoModelAlgorithm(pha, inc, ema);
+    albedo = PhotoModelAlgorithm(pha, inc, ema);
     return albedo;
   }
 
+  /**
+   * Interpolate the surface brightness computed by CalcSurfAlbedo() in a table
+   * of the photometric function, with nodes about step degrees apart in
+   * phase, incidence and emission angle. The nodes are evaluated as they are
+   * needed. Angles outside of the table and standard conditions still use the
+   * photometric function directly. Call this again after changing the
+   * parameters of the model, since that clears the table.
+   *
+   * @param step The node spacing in degrees, 0 to use the photometric
+   *             function for every pixel
+   *
+   * @see PhotometricTable
+   */
+  void PhotoModel::SetTabulation(double step) {
+    delete p_table;
+    p_table = NULL;
+
+    if (step > 0.0) {
+      p_table = new PhotometricTable(1, TabulatedAlbedo, this);
+      p_table->setStep(step);
+    }
+  }
+
+  /**
+   * @return The node spacing of the surface brightness table in degrees, 0 if
+   *         the surface brightness is not tabulated
+   */
+  double PhotoModel::TabulationStep() const {
+    return p_table ? p_table->step() : 0.0;
+  }
+
+  /**
+   * @return The largest interpolation error of the surface brightness seen so
+   *         far, measured at the center of each table cell used
+   */
+  double PhotoModel::TabulationError() const {
+    return p_table ? p_table->maximumError(0) : 0.0;
+  }
+
+  /**
+   * The function tabulated by SetTabulation().
+   *
+   * @param model The PhotoModel
+   * @param phase Phase angle
+   * @param incidence Incidence angle
+   * @param emission Emission angle
+   * @param values Receives the surface brightness
+   */
+  void PhotoModel::TabulatedAlbedo(void *model, double phase, double incidence,
+                                   double emission, double *values) {
+    values[0] = ((PhotoModel *)model)->PhotoModelAlgorithm(phase, incidence,
+                                                           emission);
+  }
+
   /**
    * Set the Lunar-Lambert function weight.  This is used to govern the
    * limb-darkening in the Lunar-Lambert photometric function.  Values of
@@ -31,6 +31,8 @@
 #include "Pvl.h"
 
 namespace Isis {
+  class PhotometricTable;
+
   /**
    * @brief
    *
@@ -53,11 +55,13 @@ namespace Isis {
    *                      this class and into children classes.
    *  @history 2008-11-05 Jeannie Walldren - Moved PhtAcos() from
    *                      NumericalMethods class.
+   *  @history 2026-10-19 ISIS Development Team - Added SetTabulation() to
+   *                      interpolate CalcSurfAlbedo() in a PhotometricTable.
    */
   class PhotoModel {
     public:
       PhotoModel(Pvl &pvl);
-      virtual ~PhotoModel() {};
+      virtual ~PhotoModel();
 
       //! Return algorithm name found in Pvl file from constructor
       inline QString AlgorithmName() const {
@@ -79,6 +83,11 @@ namespace Isis {
       // Calculate the surface brightness
       double CalcSurfAlbedo(double pha, double inc, double ema);
 
+      // Interpolate the surface brightness in a table
+      void SetTabulation(double step);
+      double TabulationStep() const;
+      double TabulationError() const;
+
       virtual void SetPhotoL(const double l) {
         p_photoL = l;
       }
@@ -244,10 +253,15 @@ namespace Isis {
       NumericalApproximation p_photoBSpline;
 
     private:
+      static void TabulatedAlbedo(void *model, double phase, double incidence,
+                                  double emission, double *values);
+
       //! Unique name of the photometric model
       QString p_photoAlgorithmName;
       //! Indicates whether standard conditions are used
       bool p_standardConditions;
+      //! The tabulated surface brightness, or NULL if it is not tabulated
+      PhotometricTable *p_table;
   };
 };
 
@@ -0,0 +1,304 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "PhotometricTable.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "IException.h"
+
+using namespace std;
+
+namespace Isis {
+  /**
+   * Create an empty table. The table is disabled until setStep() is called.
+   *
+   * @param valueCount The number of values the function returns
+   * @param function The tabulated function
+   * @param model The model passed to the function
+   */
+  PhotometricTable::PhotometricTable(int valueCount, Function function,
+                                     void *model) {
+    if (valueCount < 1) {
+      QString msg = "A photometric table needs at least one value per node";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_function = function;
+    m_model = model;
+    m_valueCount = valueCount;
+
+    m_step = 0.0;
+    m_phaseNodes = 0;
+    m_incidenceNodes = 0;
+    m_emissionNodes = 0;
+    m_phaseStep = 0.0;
+    m_incidenceStep = 0.0;
+    m_emissionStep = 0.0;
+
+    m_maximumError.fill(0.0, m_valueCount);
+  }
+
+
+  //! Destroys the table
+  PhotometricTable::~PhotometricTable() {
+  }
+
+
+  /**
+   * Set the spacing of the nodes and clear the table. Each angle range is
+   * divided into equal steps of at most the given size. The memory used for
+   * a phase angle node is 8 bytes per value for each incidence and emission
+   * angle node, so small steps over a wide phase range can use a lot of
+   * memory.
+   *
+   * @param degrees The node spacing in degrees, 0 to disable the table
+   */
+  void PhotometricTable::setStep(double degrees) {
+    if (degrees > 0.0) {
+      m_step = degrees;
+      m_phaseNodes = (int)ceil(180.0 / degrees - 1.0e-9) + 1;
+      m_incidenceNodes = (int)ceil(90.0 / degrees - 1.0e-9) + 1;
+      m_emissionNodes = m_incidenceNodes;
+      m_phaseStep = 180.0 / (m_phaseNodes - 1);
+      m_incidenceStep = 90.0 / (m_incidenceNodes - 1);
+      m_emissionStep = 90.0 / (m_emissionNodes - 1);
+    }
+    else {
+      m_step = 0.0;
+      m_phaseNodes = 0;
+      m_incidenceNodes = 0;
+      m_emissionNodes = 0;
+    }
+
+    clear();
+  }
+
+
+  /**
+   * @return The requested node spacing in degrees, 0 if the table is disabled
+   */
+  double PhotometricTable::step() const {
+    return m_step;
+  }
+
+
+  /**
+   * @return The number of values the function returns
+   */
+  int PhotometricTable::valueCount() const {
+    return m_valueCount;
+  }
+
+
+  /**
+   * Forget all of the evaluated nodes and the measured error. This must be
+   * done after the parameters of the tabulated model change.
+   */
+  void PhotometricTable::clear() {
+    m_slices.clear();
+    m_slices.resize(m_phaseNodes);
+    m_maximumError.fill(0.0, m_valueCount);
+  }
+
+
+  /**
+   * Interpolate the function values at the given angles.
+   *
+   * @param phase The phase angle in degrees
+   * @param incidence The incidence angle in degrees
+   * @param emission The emission angle in degrees
+   * @param values Receives valueCount() values
+   *
+   * @return False if the table is disabled, the angles are outside of the
+   *         table, or the function is not finite around the angles. The
+   *         values are not set then.
+   */
+  bool PhotometricTable::evaluate(double phase, double incidence,
+                                  double emission, double *values) {
+    // The comparisons also reject NaN angles
+    if (m_step <= 0.0 ||
+        !(phase >= 0.0 && phase <= 180.0) ||
+        !(incidence >= 0.0 && incidence <= 90.0) ||
+        !(emission >= 0.0 && emission <= 90.0)) {
+      return false;
+    }
+
+    double phaseIndex = phase / m_phaseStep;
+    double incidenceIndex = incidence / m_incidenceStep;
+    double emissionIndex = emission / m_emissionStep;
+
+    int phaseNode = min((int)phaseIndex, m_phaseNodes - 2);
+    int incidenceNode = min((int)incidenceIndex, m_incidenceNodes - 2);
+    int emissionNode = min((int)emissionIndex, m_emissionNodes - 2);
+
+    double phaseFraction = phaseIndex - phaseNode;
+    double incidenceFraction = incidenceIndex - incidenceNode;
+    double emissionFraction = emissionIndex - emissionNode;
+
+    Slice &lower = slice(phaseNode);
+    Slice &upper = slice(phaseNode + 1);
+
+    // Corner k is offset by (k >> 2, (k >> 1) & 1, k & 1) nodes
+    const double *corners[8];
+    double weights[8];
+    for (int k = 0; k < 8; k++) {
+      int phaseOffset = k >> 2;
+      int incidenceOffset = (k >> 1) & 1;
+      int emissionOffset = k & 1;
+
+      corners[k] = node(phaseOffset ? upper : lower, phaseNode + phaseOffset,
+                        incidenceNode + incidenceOffset,
+                        emissionNode + emissionOffset);
+      if (!corners[k]) {
+        return false;
+      }
+
+      weights[k] = (phaseOffset ? phaseFraction : 1.0 - phaseFraction) *
+                   (incidenceOffset ? incidenceFraction : 1.0 - incidenceFraction) *
+                   (emissionOffset ? emissionFraction : 1.0 - emissionFraction);
+    }
+
+    int cell = incidenceNode * (m_emissionNodes - 1) + emissionNode;
+    if (!lower.checked[cell]) {
+      checkCell(lower, phaseNode, incidenceNode, emissionNode, corners);
+    }
+
+    for (int i = 0; i < m_valueCount; i++) {
+      double value = 0.0;
+      for (int k = 0; k < 8; k++) {
+        value += weights[k] * corners[k][i];
+      }
+      values[i] = value;
+    }
+
+    return true;
+  }
+
+
+  /**
+   * @param index The index of a function value
+   *
+   * @return The largest difference between the interpolated and the exact
+   *         value seen at the center of the cells used so far
+   */
+  double PhotometricTable::maximumError(int index) const {
+    if (index < 0 || index >= m_valueCount) {
+      QString msg = "Photometric table value index [" + QString::number(index) +
+                    "] is out of range";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    return m_maximumError[index];
+  }
+
+
+  /**
+   * Allocate the nodes of a phase angle the first time they are needed.
+   *
+   * @param phaseNode The phase angle node
+   *
+   * @return The nodes of the phase angle
+   */
+  PhotometricTable::Slice &PhotometricTable::slice(int phaseNode) {
+    Slice &phaseSlice = m_slices[phaseNode];
+
+    if (phaseSlice.state.isEmpty()) {
+      int nodes = m_incidenceNodes * m_emissionNodes;
+      phaseSlice.values.resize(nodes * m_valueCount);
+      phaseSlice.state.fill(0, nodes);
+      phaseSlice.checked.fill(0, (m_incidenceNodes - 1) * (m_emissionNodes - 1));
+    }
+
+    return phaseSlice;
+  }
+
+
+  /**
+   * Evaluate a node the first time it is needed.
+   *
+   * @param phaseSlice The nodes of the phase angle
+   * @param phaseNode The phase angle node
+   * @param incidenceNode The incidence angle node
+   * @param emissionNode The emission angle node
+   *
+   * @return The values of the node, or NULL if they are not finite
+   */
+  const double *PhotometricTable::node(Slice &phaseSlice, int phaseNode,
+                                       int incidenceNode, int emissionNode) {
+    int index = incidenceNode * m_emissionNodes + emissionNode;
+    double *values = phaseSlice.values.data() + index * m_valueCount;
+
+    if (phaseSlice.state[index] == 0) {
+      m_function(m_model,
+                 min(180.0, phaseNode * m_phaseStep),
+                 min(90.0, incidenceNode * m_incidenceStep),
+                 min(90.0, emissionNode * m_emissionStep),
+                 values);
+
+      phaseSlice.state[index] = 1;
+      for (int i = 0; i < m_valueCount; i++) {
+        if (!std::isfinite(values[i])) {
+          phaseSlice.state[index] = 2;
+        }
+      }
+    }
+
+    return (phaseSlice.state[index] == 1) ? values : NULL;
+  }
+
+
+  /**
+   * Compare the interpolated values at the center of a cell with the
+   * function and keep the largest difference.
+   *
+   * @param phaseSlice The nodes of the lower phase angle of the cell
+   * @param phaseNode The lower phase angle node of the cell
+   * @param incidenceNode The lower incidence angle node of the cell
+   * @param emissionNode The lower emission angle node of the cell
+   * @param corners The values at the eight corners of the cell
+   */
+  void PhotometricTable::checkCell(Slice &phaseSlice, int phaseNode,
+                                   int incidenceNode, int emissionNode,
+                                   const double *corners[8]) {
+    phaseSlice.checked[incidenceNode * (m_emissionNodes - 1) + emissionNode] = 1;
+
+    QVector<double> exact(m_valueCount);
+    m_function(m_model,
+               (phaseNode + 0.5) * m_phaseStep,
+               (incidenceNode + 0.5) * m_incidenceStep,
+               (emissionNode + 0.5) * m_emissionStep,
+               exact.data());
+
+    for (int i = 0; i < m_valueCount; i++) {
+      double interpolated = 0.0;
+      for (int k = 0; k < 8; k++) {
+        interpolated += corners[k][i];
+      }
+      interpolated /= 8.0;
+
+      if (std::isfinite(exact[i])) {
+        m_maximumError[i] = max(m_maximumError[i], fabs(interpolated - exact[i]));
+      }
+    }
+  }
+}
@@ -0,0 +1,121 @@
+#ifndef PhotometricTable_h
+#define PhotometricTable_h
+
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QVector>
+
+namespace Isis {
+  /**
+   * @brief Tabulated values of a function of the photometric angles
+   *
+   * This class replaces the evaluation of an expensive function of the phase,
+   * incidence and emission angles, such as a photometric or atmospheric model,
+   * by trilinear interpolation in a table. The table covers phase angles from
+   * 0 to 180 degrees and incidence and emission angles from 0 to 90 degrees
+   * with nodes about step() degrees apart. Each node is evaluated with the
+   * function the first time a lookup needs it, so only the part of the table
+   * an image reaches is ever computed or allocated.
+   *
+   * The function may return several values for a set of angles. They are
+   * interpolated with the same weights.
+   *
+   * For a function with second derivatives bounded by M<sub>p</sub>,
+   * M<sub>i</sub> and M<sub>e</sub> (per square degree), the interpolation
+   * error is at most h<sup>2</sup>/8 (M<sub>p</sub> + M<sub>i</sub> +
+   * M<sub>e</sub>), where h is the node spacing. The error is largest near the
+   * middle of a cell, so the first lookup in a cell also evaluates the
+   * function exactly at the center of the cell and compares it with the
+   * interpolated value. The largest difference seen is reported by
+   * maximumError() and is an estimate of the error of the table for the
+   * angles the image actually used.
+   *
+   * Lookups outside of the table, and lookups in cells where the function is
+   * not finite at a corner, return false so the caller can evaluate the
+   * function exactly.
+   *
+   * A table is not thread safe, just like the models it tabulates.
+   *
+   * @ingroup RadiometricAndPhotometricCorrection
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class PhotometricTable {
+    public:
+      /**
+       * The tabulated function. It receives the model given to the
+       * constructor and writes the values for the angles, in degrees.
+       */
+      typedef void (*Function)(void *model, double phase, double incidence,
+                               double emission, double *values);
+
+      PhotometricTable(int valueCount, Function function, void *model);
+      ~PhotometricTable();
+
+      void setStep(double degrees);
+      double step() const;
+      int valueCount() const;
+      void clear();
+
+      bool evaluate(double phase, double incidence, double emission,
+                    double *values);
+
+      double maximumError(int index) const;
+
+    private:
+      /**
+       * The nodes with the same phase angle, and the cells of greater phase
+       * angles that start at them.
+       */
+      struct Slice {
+        QVector<double> values; //!< The function values of each node
+        QVector<char> state;    //!< 0 not evaluated, 1 finite, 2 not finite
+        QVector<char> checked;  //!< True for cells compared with the function
+      };
+
+      Slice &slice(int phaseNode);
+      const double *node(Slice &phaseSlice, int phaseNode, int incidenceNode,
+                         int emissionNode);
+      void checkCell(Slice &phaseSlice, int phaseNode, int incidenceNode,
+                     int emissionNode, const double *corners[8]);
+
+      Function m_function;          //!< The tabulated function
+      void *m_model;                //!< The model passed to m_function
+      int m_valueCount;             //!< The number of values per node
+
+      double m_step;                //!< The requested node spacing in degrees
+      int m_phaseNodes;             //!< The number of phase angle nodes
+      int m_incidenceNodes;         //!< The number of incidence angle nodes
+      int m_emissionNodes;          //!< The number of emission angle nodes
+      double m_phaseStep;           //!< The phase node spacing in degrees
+      double m_incidenceStep;       //!< The incidence node spacing in degrees
+      double m_emissionStep;        //!< The emission node spacing in degrees
+
+      QVector<Slice> m_slices;      //!< The table, by phase angle node
+      QVector<double> m_maximumError; //!< The largest error seen per value
+  };
+}
+
+#endif
@@ -68,6 +68,24 @@ namespace Isis {
     p_phtNmodel->SetNormWavelength(wl);
   }
 
+  /**
+   * Interpolate the photometric model, and the atmospheric model if there is
+   * one, in tables with nodes about step degrees apart. This must be called
+   * after all model parameters are set.
+   *
+   * @param step The node spacing in degrees, 0 to evaluate the models for
+   *             every pixel
+   *
+   * @see PhotoModel::SetTabulation
+   * @see AtmosModel::SetTabulation
+   */
+  void Photometry::SetTabulation(double step) {
+    p_phtPmodel->SetTabulation(step);
+    if (p_phtAmodel != NULL) {
+      p_phtAmodel->SetTabulation(step);
+    }
+  }
+
   /**
    * Calculate the surface brightness using only ellipsoid
    *
@@ -47,6 +47,8 @@ namespace Isis {
    *  @history 2008-07-09 Steven Lambright - Fixed unit test
    *  @history 2011-08-19 Sharmila Prasad - Implemented brentminimizer using GSL
    *  @history 2011-09-15 Sharmila Prasad - Implemented brent's root solver using GSL
+   *  @history 2026-10-19 ISIS Development Team - Added SetTabulation to interpolate
+   *                      the photometric and atmospheric models in tables
    */
   class Photometry {
     public:
@@ -64,6 +66,9 @@ namespace Isis {
       //! Set the wavelength
       virtual void SetPhotomWl(double wl);
 
+      //! Interpolate the photometric and atmospheric models in tables
+      void SetTabulation(double step);
+
       //! Double precision version of bracketing algorithm ported from Python.
       //! Solution bracketing for 1-D minimization routine.
       static void minbracket(double &xa, double &xb, double &xc, double &fa,
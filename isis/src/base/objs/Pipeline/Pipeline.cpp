@@ -1,12 +1,14 @@
 #include <iostream>
 
 #include <QFile>
+#include <QStringList>
 
 #include "Pipeline.h"
 #include "PipelineApplication.h"
 #include "ProgramLauncher.h"
 #include "IException.h"
 #include "Application.h"
+#include "CubeMemoryHandler.h"
 #include "Preference.h"
 #include "Progress.h"
 #include "TextFile.h"
@@ -33,6 +35,7 @@ namespace Isis {
     p_addedCubeatt = false;
     p_outputListNeedsModifiers = false;
     p_continue = false;
+    p_inProcess = false;
   }
 
 
@@ -202,60 +205,92 @@ namespace Isis {
     pipelineProg.SetMaximumSteps(1);
     pipelineProg.CheckStatus();
 
-    // Go through these programs, executing them
-    for (int i = p_pausePosition; i < Size(); i++) {
-
-      // Return to caller for a pause
-      if (p_apps[i] == NULL) {
-        p_pausePosition = i;
-        return;
+    if (p_inProcess) {
+      foreach (QString cube, TemporaryCubes()) {
+        CubeMemoryHandler::addFile(cube);
       }
+    }
 
-      if (Application(i).Enabled()) {
-        Progress appName;
-        appName.SetText("Running " + Application(i).Name());
-        appName.SetMaximumSteps(1);
-        appName.CheckStatus();
+    try {
+      // Go through these programs, executing them
+      for (int i = p_pausePosition; i < Size(); i++) {
 
-        // grab the sets of parameters this program needs to be run with
-        const vector<QString> &params = Application(i).ParamString();
-        for (int j = 0; j < (int)params.size(); j++) {
+        // Return to caller for a pause
+        if (p_apps[i] == NULL) {
+          p_pausePosition = i;
+          WriteTemporaryCubes(true);
+          return;
+        }
 
-          // check for non-program run special strings
-          QString special(params[j].mid(0, 7));
+        if (Application(i).Enabled()) {
+          Progress appName;
+          appName.SetText("Running " + Application(i).Name());
+          appName.SetMaximumSteps(1);
+          appName.CheckStatus();
 
-          // If ">>LIST", then we need to make a list file
-          if (special == ">>LIST ") {
-            QString cmd = params[j].mid(7);
+          bool inProcess = p_inProcess &&
+                           ProgramLauncher::HasIsisProgramEntry(Application(i).Name());
 
-            QStringList listData = cmd.split(" ");
-            QString listFileName = listData.takeFirst();
-            TextFile listFile(listFileName, "overwrite");
+          // Programs in their own process can only read cubes on disk
+          if (!inProcess) {
+            WriteTemporaryCubes(false);
+          }
 
-            while (!listData.isEmpty()) {
-              listFile.PutLine(listData.takeFirst());
-            }
+          // grab the sets of parameters this program needs to be run with
+          const vector<QString> &params = Application(i).ParamString();
+          for (int j = 0; j < (int)params.size(); j++) {
 
-            listFile.Close();
-          }
-          else {
-            // Nothing special is happening, just execute the program
-            try {
-              ProgramLauncher::RunIsisProgram(Application(i).Name(), params[j]);
+            // check for non-program run special strings
+            QString special(params[j].mid(0, 7));
+
+            // If ">>LIST", then we need to make a list file
+            if (special == ">>LIST ") {
+              QString cmd = params[j].mid(7);
+
+              QStringList listData = cmd.split(" ");
+              QString listFileName = listData.takeFirst();
+              TextFile listFile(listFileName, "overwrite");
+
+              while (!listData.isEmpty()) {
+                listFile.PutLine(listData.takeFirst());
+              }
+
+              listFile.Close();
             }
-            catch (IException &e) {
-              if (!p_continue && !Application(i).Continue()) {
-                throw;
+            else {
+              // Nothing special is happening, just execute the program
+              try {
+                if (inProcess) {
+                  ProgramLauncher::RunIsisProgramInProcess(Application(i).Name(), params[j]);
+                }
+                else {
+                  ProgramLauncher::RunIsisProgram(Application(i).Name(), params[j]);
+                }
               }
-              else {
-                e.print();
-                cerr << "Continuing ......" << endl;
+              catch (IException &e) {
+                if (!p_continue && !Application(i).Continue()) {
+                  throw;
+                }
+                else {
+                  e.print();
+                  cerr << "Continuing ......" << endl;
+                }
               }
             }
           }
         }
       }
     }
+    catch (IException &) {
+      // Leave the temporary cubes on disk as running in processes would
+      WriteTemporaryCubes(true);
+      throw;
+    }
+
+    // Temporary cubes that are kept must be complete on disk
+    if (KeepTemporaryFiles()) {
+      WriteTemporaryCubes(true);
+    }
 
     // Remove temporary files now
     if (!KeepTemporaryFiles()) {
@@ -272,6 +307,12 @@ namespace Isis {
 
     // Reset pause position
     p_pausePosition = -1;
+
+    if (p_inProcess) {
+      foreach (QString cube, TemporaryCubes()) {
+        CubeMemoryHandler::removeFile(cube);
+      }
+    }
   }
 
 
@@ -552,6 +593,19 @@ namespace Isis {
   }
 
 
+  /**
+   * Set whether or not to run applications that registered an entry point with
+   * ProgramLauncher inside of this process. Doing so keeps the DN data of the
+   * temporary cubes in memory, up to the IntermediateCubeMemory performance
+   * preference, instead of writing it to disk for the next application.
+   *
+   * @param inProcess True means run registered applications in this process
+   */
+  void Pipeline::SetInProcess(bool inProcess) {
+    p_inProcess = inProcess;
+  }
+
+
   /**
    * Add a pause to the pipeline.
    *
@@ -877,6 +931,51 @@ namespace Isis {
   }
 
 
+  /**
+   * This method returns the temporary cubes of the enabled applications. Only
+   * valid after Prepare is called.
+   *
+   * @return QStringList The expanded names of the temporary cubes
+   */
+  QStringList Pipeline::TemporaryCubes() {
+    QStringList cubes;
+
+    for (int i = 0; i < Size(); i++) {
+      if (p_apps[i] == NULL) continue;
+      if (Application(i).Enabled()) {
+        vector<QString> tmpFiles = Application(i).TemporaryFiles();
+        for (int file = 0; file < (int)tmpFiles.size(); file++) {
+          FileName tmpFile(tmpFiles[file]);
+          if (tmpFile.extension().toLower() == "cub") {
+            cubes.append(tmpFile.expanded());
+          }
+        }
+      }
+    }
+
+    return cubes;
+  }
+
+
+  /**
+   * This method writes the DN data of the temporary cubes kept in memory to
+   * disk, so they can be read by other processes.
+   *
+   * @param release True to also stop keeping the temporary cubes in memory
+   */
+  void Pipeline::WriteTemporaryCubes(bool release) {
+    if (!p_inProcess) return;
+
+    foreach (QString cube, TemporaryCubes()) {
+      CubeMemoryHandler::writeToDisk(cube);
+
+      if (release) {
+        CubeMemoryHandler::removeFile(cube);
+      }
+    }
+  }
+
+
   /**
    * This method returns the user's temporary folder for temporary files. It's
    * simply a conveinient accessor to the user's preferences.
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include <QString>
+#include <QStringList>
 
 #include "PipelineApplication.h"
 
@@ -62,6 +63,12 @@ namespace Isis {
    *
    * The Pipeline calls cubeatt app inherently if virtual bands are true.
    *
+   * With SetInProcess(true), applications that registered an entry point with
+   * ProgramLauncher are run inside of the pipeline's process and the DN data of
+   * the temporary cubes is kept in memory (see CubeMemoryHandler). Temporary
+   * cubes are written to disk before an application that has to run in its own
+   * process, when the pipeline pauses, and when temporary files are kept.
+   *
    * It is suggested that you "cout" this object in order to debug you're usage of
    * the class.
    *
@@ -283,7 +290,16 @@ namespace Isis {
         p_continue = pbFlag;
       };
 
+      void SetInProcess(bool inProcess);
+      //! Returns true if programs with an entry point are run in this process
+      bool InProcess() {
+        return p_inProcess;
+      }
+
     private:
+      QStringList TemporaryCubes();
+      void WriteTemporaryCubes(bool release);
+
       int p_pausePosition;
       QString p_procAppName; //!< The name of the pipeline
       std::vector<QString> p_originalInput; //!< The original input file
@@ -297,6 +313,7 @@ namespace Isis {
       std::vector< QString > p_appIdentifiers; //!< The strings to identify the pipeline applications
       bool p_outputListNeedsModifiers;
       bool p_continue; //!< continue the execution even if exception is encountered.
+      bool p_inProcess; //!< True if programs with an entry point run in this process
   };
 };
 
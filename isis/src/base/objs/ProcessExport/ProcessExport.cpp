@@ -19,10 +19,16 @@
  *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
  *   http://www.usgs.gov/privacy.html.
  */
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <QCryptographicHash>
+#include <QList>
 #include <QString>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
 
 #include "ProcessExport.h"
 #include "Preference.h"
@@ -31,6 +37,8 @@
 #include "BandManager.h"
 #include "SpecialPixel.h"
 #include "Histogram.h"
+#include "HistogramSketch.h"
+#include "Progress.h"
 #include "Stretch.h"
 #include "Application.h"
 #include "EndianSwapper.h"
@@ -39,6 +47,9 @@
 using namespace std;
 namespace Isis {
 
+  //! The number of pixels read, stretched and encoded together
+  static const int ExportBlockPixels = 1048576;
+
   //! Constructs an Export object
   ProcessExport::ProcessExport() : Isis::Process() {
 
@@ -388,11 +399,13 @@ namespace Isis {
 
       // Or get the automatic parameters
       else if (strType != "NONE") {
-        Isis::Histogram *hist = InputCubes[i]->histogram(0);
-        p_inputMinimum.push_back(hist->Percent(
-                                   Application::GetUserInterface().GetDouble("MINPERCENT")));
-        p_inputMaximum.push_back(hist->Percent(
-                                   Application::GetUserInterface().GetDouble("MAXPERCENT")));
+        double minimum, maximum, median;
+        InputPercentiles(*InputCubes[i],
+                         Application::GetUserInterface().GetDouble("MINPERCENT"),
+                         Application::GetUserInterface().GetDouble("MAXPERCENT"),
+                         minimum, maximum, median);
+        p_inputMinimum.push_back(minimum);
+        p_inputMaximum.push_back(maximum);
         p_inputMiddle.push_back(Isis::NULL8);
         Application::GetUserInterface().Clear("MINIMUM");
         Application::GetUserInterface().Clear("MAXIMUM");
@@ -400,7 +413,7 @@ namespace Isis {
         Application::GetUserInterface().PutDouble("MAXIMUM", p_inputMaximum[i]);
 
         if (strType == "PIECEWISE") {
-          p_inputMiddle[i] = hist->Median();
+          p_inputMiddle[i] = median;
 
           // If the median is the min or max, back off to linear
           if (p_inputMiddle[i] == p_inputMinimum[i] ||
@@ -419,6 +432,65 @@ namespace Isis {
   }
 
 
+  /**
+   * Find the values at two percentages of the histogram of all bands of a
+   * cube, and its median, for SetInputRange().
+   *
+   * Cube::histogram() reads cubes of 32 bit pixels twice, first to find the
+   * range of the bins. If the ExportStretchHistogram keyword of the
+   * Performance preferences is Sketch, a HistogramSketch is used for them
+   * instead, which reads the cube once. Its values can differ from the exact
+   * histogram by a bin, which is a small fraction of the data range.
+   *
+   * @param cube The cube
+   * @param minPercent The percentage of the minimum
+   * @param maxPercent The percentage of the maximum
+   * @param minimum Receives the value at minPercent
+   * @param maximum Receives the value at maxPercent
+   * @param median Receives the median
+   */
+  void ProcessExport::InputPercentiles(Cube &cube, double minPercent,
+                                       double maxPercent, double &minimum,
+                                       double &maximum, double &median) {
+    QString method = "Exact";
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    if (performancePrefs.hasKeyword("ExportStretchHistogram")) {
+      method = performancePrefs["ExportStretchHistogram"][0];
+    }
+
+    // Cubes of 8 and 16 bit pixels have a bin for every DN and are read once
+    // either way
+    PixelType pixelType = cube.pixelType();
+    if (method.toUpper() != "SKETCH" || pixelType == Isis::UnsignedByte ||
+        pixelType == Isis::UnsignedWord || pixelType == Isis::SignedWord) {
+      Isis::Histogram *hist = cube.histogram(0);
+      minimum = hist->Percent(minPercent);
+      maximum = hist->Percent(maxPercent);
+      median = hist->Median();
+      delete hist;
+      return;
+    }
+
+    HistogramSketch sketch;
+    LineManager line(cube);
+
+    Progress progress;
+    progress.SetText("Gathering histogram");
+    progress.SetMaximumSteps(cube.lineCount() * cube.bandCount());
+    progress.CheckStatus();
+
+    for (line.begin(); !line.end(); line++) {
+      cube.read(line);
+      sketch.AddData(line.DoubleBuffer(), line.size());
+      progress.CheckStatus();
+    }
+
+    minimum = sketch.Percent(minPercent);
+    maximum = sketch.Percent(maxPercent);
+    median = sketch.Median();
+  }
+
+
    bool ProcessExport::HasInputRange() const {
      return p_inputMinimum.size() > 0;
    }
@@ -1012,6 +1084,49 @@ namespace Isis {
 
 
 
+  /**
+   * Stretches and encodes one buffer of a block for QtConcurrent.
+   *
+   * @internal
+   */
+  class ProcessExport::EncodeBufferFunctor : public std::unary_function<const int &, void> {
+    public:
+      EncodeBufferFunctor(const ProcessExport *process, ExportBlock *block,
+                          int bufferSize, int pixelBytes) :
+          m_process(process), m_block(block), m_bufferSize(bufferSize),
+          m_pixelBytes(pixelBytes) {
+      }
+
+
+      void operator()(const int &index) const {
+        double *pixels = &m_block->pixels[(BigInt)index * m_bufferSize];
+
+        // Stretch the pixels into the desired range
+        for (int i = 0; i < m_bufferSize; i++) {
+          pixels[i] = m_process->p_str[0]->Map(pixels[i]);
+        }
+
+        if (!m_block->checksumData.empty()) {
+          char *checksumData = &m_block->checksumData[(BigInt)index * m_bufferSize];
+          for (int i = 0; i < m_bufferSize; i++) {
+            checksumData[i] = (char)pixels[i];
+          }
+        }
+
+        if (m_pixelBytes > 0) {
+          m_process->EncodePixels(pixels, m_bufferSize,
+              &m_block->data[(BigInt)index * m_bufferSize * m_pixelBytes]);
+        }
+      }
+
+    private:
+      const ProcessExport *m_process; //!< The export that owns the stretch
+      ExportBlock *m_block;           //!< The block being encoded
+      int m_bufferSize;               //!< The number of pixels in a buffer
+      int m_pixelBytes;               //!< The number of bytes in an output pixel
+  };
+
+
   /**
   * @brief Write an entire cube to an output file stream
   *
@@ -1020,6 +1135,11 @@ namespace Isis {
   * method takes care of writing the input data to an output file stream
   * specified by the user instead of relying on an external function.
   *
+  * The buffers are read in blocks. The buffers of a block are stretched and
+  * encoded in parallel on the global thread pool. A block is written, and
+  * added to the checksum, on another thread while the next block is read and
+  * encoded.
+  *
   * @param &fout An open stream to which the pixel data will be written. After
   *                       calling this method once, the stream will contain all
   *                       of  the pixel data from the input cube.
@@ -1042,216 +1162,185 @@ namespace Isis {
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
 
-    //This if is the changed one
-    if (m_canGenerateChecksum) {
-      // Loop for each line of data
-      for (buff->begin(); !buff->end(); buff->next()) {
-        // Read a line of data
-        InputCubes[0]->read(*buff);
-        QByteArray byteArray;
-        // Stretch the pixels into the desired range
-        for (int i = 0; i < buff->size(); i++) {
-          (*buff)[i] = p_str[0]->Map((*buff)[i]);
-          byteArray.append((*buff)[i]);
-        }
-        if (p_pixelType == Isis::UnsignedByte)
-          isisOut8(*buff, fout);
-        else if (p_pixelType == Isis::UnsignedWord)
-          isisOut16u(*buff, fout);
-        else if (p_pixelType == Isis::SignedWord)
-          isisOut16s(*buff, fout);
-        else if (p_pixelType == Isis::Real)
-          isisOut32(*buff, fout);
-        p_progress->CheckStatus();
-        m_cryptographicHash->addData(byteArray);
+    int bufferSize = buff->size();
+    int pixelBytes = Isis::SizeOf(p_pixelType);
+    int blockBuffers = max(1, ExportBlockPixels / bufferSize);
+
+    // One block is written while the other is read and encoded
+    ExportBlock blocks[2];
+    for (int i = 0; i < 2; i++) {
+      blocks[i].pixels.resize((BigInt)blockBuffers * bufferSize);
+      blocks[i].data.resize((BigInt)blockBuffers * bufferSize * pixelBytes);
+      if (m_canGenerateChecksum) {
+        blocks[i].checksumData.resize((BigInt)blockBuffers * bufferSize);
       }
     }
-    else {
-      for (buff->begin(); !buff->end(); buff->next()) {
-        // Read a line of data
-        InputCubes[0]->read(*buff);
-        // Stretch the pixels into the desired range
-        for (int i = 0; i < buff->size(); i++) {
-          (*buff)[i] = p_str[0]->Map((*buff)[i]);
+
+    QFuture<void> writing;
+    int current = 0;
+
+    try {
+      buff->begin();
+      while (!buff->end()) {
+        ExportBlock &block = blocks[current];
+
+        // Read the buffers of the block, the cube is only read on this thread
+        int buffers = 0;
+        while (!buff->end() && buffers < blockBuffers) {
+          InputCubes[0]->read(*buff);
+          memcpy(&block.pixels[(BigInt)buffers * bufferSize], buff->DoubleBuffer(),
+                 bufferSize * sizeof(double));
+          buffers++;
+          buff->next();
         }
-        if (p_pixelType == Isis::UnsignedByte)
-          isisOut8(*buff, fout);
-        else if (p_pixelType == Isis::UnsignedWord)
-          isisOut16u(*buff, fout);
-        else if (p_pixelType == Isis::SignedWord)
-          isisOut16s(*buff, fout);
-        else if (p_pixelType == Isis::Real)
-          isisOut32(*buff, fout);
-        p_progress->CheckStatus();
+
+        // Stretch and encode the buffers in parallel
+        QList<int> indices;
+        for (int i = 0; i < buffers; i++) {
+          indices.append(i);
+        }
+        QtConcurrent::blockingMap(indices,
+            EncodeBufferFunctor(this, &block, bufferSize, pixelBytes));
+
+        block.dataBytes = (BigInt)buffers * bufferSize * pixelBytes;
+        block.checksumBytes = m_canGenerateChecksum ? buffers * bufferSize : 0;
+
+        // Write the block while the next one is read
+        writing.waitForFinished();
+        writing = QtConcurrent::run(&ProcessExport::WriteBlock, &fout,
+                                    (const ExportBlock *)&block,
+                                    m_canGenerateChecksum ? m_cryptographicHash : NULL);
+
+        for (int i = 0; i < buffers; i++) {
+          p_progress->CheckStatus();
+        }
+        current = 1 - current;
       }
     }
+    catch (...) {
+      writing.waitForFinished();
+      delete buff;
+      throw;
+    }
+
+    writing.waitForFinished();
     delete buff;
     return;
   }
 
 
   /**
-  * @brief Write a buffer of 8-bit pixel data to a stream
-  *
-  * This method takes a buffer of data and assumes that it is 8 bit pixel data.
-  * It will apply the necessary endian swap to the data and write it out to the
-  * output file buffer that the user specifies. The user can only expect to
-  * access this method indirectly by calling the StartProcess method
+  * @brief Write an encoded block to a stream
   *
-  * @param &in Reference to a single buffer of pixel data. Note
-  *            that this buffer will already have had the necessary
-  *            stretching operations, though it will have the
-  *            native endianness of the system.
+  * This runs on a thread of the global thread pool, one block at a time and
+  * in order, so the stream and the checksum see the data in file order.
   *
-  * @param &fout  Name of the file stream to which the buffer
-  *               of pixel data will be written.
+  * @param fout The file stream to which the block will be written
+  * @param block The encoded block
+  * @param hash The checksum to add the block to, or NULL
   */
-  void ProcessExport::isisOut8(Buffer &in, std::ofstream &fout) {
-    char *out8 = new char[in.size()];
-    for (int samp = 0; samp < in.size(); samp++) {
-      double pixel = in[samp];
-      if (pixel <= 0.0) {
-        out8[samp] = 0;
-      }
-      else if (pixel >= 255.0) {
-        out8[samp] = (char)255;
-      }
-      else {
-        out8[samp] = (char)(in[samp] + 0.5);  //Rounds
-      }
+  void ProcessExport::WriteBlock(std::ofstream *fout, const ExportBlock *block,
+                                 QCryptographicHash *hash) {
+    if (block->dataBytes > 0) {
+      fout->write(&block->data[0], block->dataBytes);
+    }
+    if (hash != NULL && block->checksumBytes > 0) {
+      hash->addData(&block->checksumData[0], block->checksumBytes);
     }
-    fout.write(out8, in.size());
-    delete[] out8;
-    return;
   }
 
 
   /**
-  * @brief Write a buffer of 16-bit signed pixel data to a stream
-  *
-  * This method takes a buffer of data and assumes that it is
-  * 16-bit signed pixel data. It will apply the necessary endian
-  * swap to the data and write it out to the output file buffer
-  * that the user specifies. The user can only expect to access
-  * this method indirectly by calling the StartProcess method.
+  * @brief Encode stretched pixels in the output pixel type and byte order
   *
-  * @param &in Reference to a single buffer of pixel data. Note
-  *            that this buffer will already have had the
-  *            necessary stretching operations, though it will
-  *            have the native endianness of the system.
+  * The pixels are rounded and clamped to the range of 8-bit unsigned, 16-bit
+  * signed and unsigned integer output. 32-bit floating point output is clamped
+  * to the range of a float. The bytes are then swapped to the output byte
+  * order. This is thread safe, so buffers can be encoded in parallel.
   *
-  * @param &fout Name of the file stream to which the buffer of pixel data will
-  *              be written.
+  * @param in The stretched pixels, in the native byte order
+  * @param size The number of pixels
+  * @param out Receives size pixels of the output pixel type
   */
-  void ProcessExport::isisOut16s(Buffer &in, std::ofstream &fout) {
-    short *out16s = new short[in.size()];
-    for (int samp = 0; samp < in.size(); samp++) {
-      double pixel = in[samp];
-      short tempShort;
-      if (pixel <= -32768.0) {
-        tempShort = (short)32768;
-        tempShort = -1 * tempShort;
-      }
-      else if (pixel >= 32767.0) {
-        tempShort = (short)32767;
-      }
-      else {
-        //Rounds
-        if (in[samp] < 0.0) {
-          tempShort = (short)(in[samp] - 0.5);
+  void ProcessExport::EncodePixels(const double *in, int size, char *out) const {
+    // EndianSwapper keeps state while swapping, so each call needs its own
+    EndianSwapper swapper(ByteOrderName(p_endianType).toUpper());
+
+    if (p_pixelType == Isis::UnsignedByte) {
+      for (int samp = 0; samp < size; samp++) {
+        double pixel = in[samp];
+        if (pixel <= 0.0) {
+          out[samp] = 0;
+        }
+        else if (pixel >= 255.0) {
+          out[samp] = (char)255;
         }
         else {
-          tempShort = (short)(in[samp] + 0.5);
+          out[samp] = (char)(pixel + 0.5);  //Rounds
         }
       }
-      void *p_swap = &tempShort;
-      out16s[samp] = p_endianSwap->ShortInt(p_swap);
     }
-    fout.write((char *)out16s, in.size() * 2);
-    delete[] out16s;
-    return;
-  }
-
-
-  /**
-  * @brief Write a bufferof 16-bit unsigned pixel data to a stream
-  *
-  * This method takes a buffer of data and assumes that it is 16-bit
-  * unsigned pixel data. It will apply the necessary endian swap
-  * to the data and write it out to the output file buffer that
-  * the user specifies. The user can only expect to access this
-  * method indirectly by calling the StartProcess method.
-  *
-  * @param &in Reference to a single buffer of pixel data. Note that this buffer
-  *          will already have had the necessary stretching operations, though
-  *          it will have the native endianness of the system.
-  *
-  * @param &fout Name of the file stream to which the buffer of pixel data will
-  *              be written.
-  *
-  */
-  void ProcessExport::isisOut16u(Buffer &in, std::ofstream &fout) {
-    unsigned short *out16u = new unsigned short[in.size()];
-    for (int samp = 0; samp < in.size(); samp++) {
-      double pixel = in[samp];
-      unsigned short tempShort;
-      if (pixel <= 0.0) {
-        tempShort = 0;
-      }
-      else if (pixel >= 65535.0) {
-        tempShort = 65535;
-      }
-      else {
-        tempShort = (unsigned short)(in[samp] + 0.5); //Rounds
+    else if (p_pixelType == Isis::UnsignedWord) {
+      unsigned short *out16u = (unsigned short *)out;
+      for (int samp = 0; samp < size; samp++) {
+        double pixel = in[samp];
+        unsigned short tempShort;
+        if (pixel <= 0.0) {
+          tempShort = 0;
+        }
+        else if (pixel >= 65535.0) {
+          tempShort = 65535;
+        }
+        else {
+          tempShort = (unsigned short)(pixel + 0.5); //Rounds
+        }
+        out16u[samp] = swapper.UnsignedShortInt(&tempShort);
       }
-      unsigned short *p_swap = &tempShort;
-      out16u[samp] = p_endianSwap->UnsignedShortInt(p_swap);
     }
-
-    fout.write((char *)out16u, in.size() * 2);
-    delete[] out16u;
-    return;
-  }
-
-
-  /**
-  * @brief Write a buffer of 32-bit floating point pixel data to a stream
-  *
-  * This method takes a buffer of data and assumes that it is 32-bit floating
-  * point pixel data. It will apply the necessary endian swap to the data and
-  * write it out to the output file buffer that the user specifies. The user can only
-  * expect to access this method indirectly by calling the StartProcess method.
-  *
-  * @param &in Reference to a single buffer of pixel data. Note that this buffer
-  *          will already have had the necessary stretching operations, though
-  *          it will have the native endianness of the system.
-  *
-  * @param &fout Name of the file stream to which the buffer of pixel data will
-  *              be written.
-  *
-  */
-  void ProcessExport::isisOut32(Buffer &in, std::ofstream &fout) {
-    int *out32 = new int[in.size()];
-    for (int samp = 0; samp < in.size(); samp++) {
-      double pixel = in[samp];
-      float tempFloat;
-      if (pixel <= -((double)FLT_MAX)) {
-        tempFloat = -((double)FLT_MAX);
-      }
-      else if (pixel >= (double)FLT_MAX) {
-        tempFloat = (double)FLT_MAX;
+    else if (p_pixelType == Isis::SignedWord) {
+      short *out16s = (short *)out;
+      for (int samp = 0; samp < size; samp++) {
+        double pixel = in[samp];
+        short tempShort;
+        if (pixel <= -32768.0) {
+          tempShort = (short)32768;
+          tempShort = -1 * tempShort;
+        }
+        else if (pixel >= 32767.0) {
+          tempShort = (short)32767;
+        }
+        else {
+          //Rounds
+          if (pixel < 0.0) {
+            tempShort = (short)(pixel - 0.5);
+          }
+          else {
+            tempShort = (short)(pixel + 0.5);
+          }
+        }
+        out16s[samp] = swapper.ShortInt(&tempShort);
       }
-      else {
-        tempFloat = (double)in[samp];
+    }
+    else if (p_pixelType == Isis::Real) {
+      int *out32 = (int *)out;
+      for (int samp = 0; samp < size; samp++) {
+        double pixel = in[samp];
+        float tempFloat;
+        if (pixel <= -((double)FLT_MAX)) {
+          tempFloat = -((double)FLT_MAX);
+        }
+        else if (pixel >= (double)FLT_MAX) {
+          tempFloat = (double)FLT_MAX;
+        }
+        else {
+          tempFloat = (double)pixel;
+        }
+        out32[samp] = swapper.ExportFloat(&tempFloat);
       }
-      void *p_swap = &tempFloat;
-      out32[samp] = p_endianSwap->ExportFloat(p_swap);
     }
-    fout.write((char *)out32, in.size() * 4);
-    delete[] out32;
-    return;
   }
 
+
   /**
   * @brief Create a standard world file for the input cube
   *
@@ -26,6 +26,7 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <QCryptographicHash>
 #include <QString>
@@ -121,6 +122,13 @@ namespace Isis {
    *  @history 2018-09-28 Kaitlyn Lee - Added (char) cast to fix implicit conversion. Split up 
    *                          "-(short)32768" into two lines. Fixes build warnings on MacOS 10.13. 
    *                          Updated code up to standards. References #5520.
+   *  @history 2026-10-19 ISIS Development Team - StartProcess(std::ofstream &) now stretches
+   *                          and encodes blocks of buffers in parallel and writes them, and
+   *                          adds them to the checksum, on a separate thread while the next
+   *                          block is read. Replaced isisOut8(), isisOut16s(), isisOut16u() and
+   *                          isisOut32() with the thread safe EncodePixels(). SetInputRange()
+   *                          can gather the histogram of 32 bit cubes in one pass with a
+   *                          HistogramSketch, see the ExportStretchHistogram preference.
    */
   class ProcessExport : public Isis::Process {
 
@@ -283,22 +291,29 @@ namespace Isis {
       bool m_canGenerateChecksum;  /**< Flag to determine if a file checksum will be generated. */
 
     private:
-      //!Method for writing 8-bit unsigned pixel data to a file stream
-      void isisOut8(Buffer &in, std::ofstream &fout);
+      /**
+       * Buffers of the input cube that are stretched, encoded and written
+       * together by StartProcess(std::ofstream &).
+       */
+      struct ExportBlock {
+        std::vector<double> pixels;     //!< The pixels of the buffers, stretched in place
+        std::vector<char> data;         //!< The encoded pixels
+        std::vector<char> checksumData; //!< The bytes added to the checksum
+        BigInt dataBytes;               //!< The number of encoded bytes to write
+        int checksumBytes;              //!< The number of bytes to add to the checksum
+      };
 
-      //!Method for writing 16-bit signed pixel data to a file stream
-      void isisOut16s(Buffer &in, std::ofstream &fout);
+      class EncodeBufferFunctor;
 
-      //!Method for writing 16-bit unsigned pixel data to a file stream
-      void isisOut16u(Buffer &in, std::ofstream &fout);
+      //! Method for encoding stretched pixels in the output type and byte order
+      void EncodePixels(const double *in, int size, char *out) const;
 
-      /**Method for writing 32-bit signed floating point pixels data to a
-      file stream*/
-      void isisOut32(Buffer &in, std::ofstream &fout);
+      //! Method for writing an encoded block to a file stream and the checksum
+      static void WriteBlock(std::ofstream *fout, const ExportBlock *block,
+                             QCryptographicHash *hash);
 
-      /**Method for writing 64-bit signed double precision floating point pixels
-      data to a file stream*/
-      void isisOut64(Buffer &in, std::ofstream &fout);
+      void InputPercentiles(Cube &cube, double minPercent, double maxPercent,
+                            double &minimum, double &maximum, double &median);
 
       /** Convenience method that checks to make sure the user is only using
       valid input to the StartProcess method. Also sets the cube up to be
@@ -21,9 +21,14 @@
  */
 #include "ProcessImport.h"
 
+#include <algorithm>
+#include <cstring>
 #include <float.h>
+#include <fstream>
 #include <iostream>
 #include <QString>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 #include <sstream>
 
 #include "Application.h"
@@ -47,6 +52,72 @@
 using namespace std;
 namespace Isis {
 
+  namespace {
+    //! The number of pixels converted together in a block of input lines
+    const int ImportBlockPixels = 1048576;
+
+    //! The size of the buffer of the input file stream
+    const int ImportStreamBufferBytes = 4194304;
+
+    //! @return The byte, which has no bytes to swap
+    inline quint8 swapBytes(quint8 value) {
+      return value;
+    }
+
+    //! @return The value with the order of its bytes reversed
+    inline quint16 swapBytes(quint16 value) {
+      return (quint16)((value >> 8) | (value << 8));
+    }
+
+    //! @return The value with the order of its bytes reversed
+    inline quint32 swapBytes(quint32 value) {
+      return (value >> 24) | ((value >> 8) & 0x0000ff00u) |
+             ((value << 8) & 0x00ff0000u) | (value << 24);
+    }
+
+    //! @return The value with the order of its bytes reversed
+    inline quint64 swapBytes(quint64 value) {
+      return ((quint64)swapBytes((quint32)value) << 32) |
+             swapBytes((quint32)(value >> 32));
+    }
+
+
+    /**
+     * Convert input pixels of type T to doubles. Unsigned integers of the
+     * same size, U, are used to swap the bytes. The pixels are read with
+     * memcpy and swapped with shifts so that the compiler can vectorize the
+     * loops, which is why the loops are not shared with EndianSwapper.
+     *
+     * @param in The first input pixel
+     * @param stride The number of bytes from one input pixel to the next
+     * @param swap True if the bytes of the pixels need to be swapped
+     * @param out Receives the converted pixels
+     * @param count The number of pixels to convert
+     */
+    template <typename T, typename U>
+    void decodePixels(const char *in, int stride, bool swap, double *out,
+                      int count) {
+      if (swap) {
+        for (int i = 0; i < count; i++) {
+          U bits;
+          memcpy(&bits, in + (BigInt)i * stride, sizeof(U));
+          bits = swapBytes(bits);
+          T value;
+          memcpy(&value, &bits, sizeof(T));
+          out[i] = (double)value;
+        }
+      }
+      else {
+        for (int i = 0; i < count; i++) {
+          T value;
+          memcpy(&value, in + (BigInt)i * stride, sizeof(T));
+          out[i] = (double)value;
+        }
+      }
+    }
+  }
+
+
   //! Constructs an Import object.
   ProcessImport::ProcessImport() : Isis::Process() {
 
@@ -1341,6 +1412,9 @@ namespace Isis {
   /**
    * Process the import data as a band sequential file.
    *
+   * The lines of a band are read in blocks. The lines of a block are
+   * converted in parallel and then written or passed to funct in order.
+   *
    * @param funct Method that accepts Isis::Buffer as an input
    *              parameter, processes the image, and has no
    *              return value.
@@ -1351,9 +1425,8 @@ namespace Isis {
    */
   void ProcessImport::ProcessBsq(void funct(Isis::Buffer &out)) {
     // Figure out the number of bytes to read for a single line
-    int readBytes = Isis::SizeOf(p_pixelType);
-    readBytes = readBytes * p_ns;
-    char *in = new char [readBytes];
+    int pixelBytes = Isis::SizeOf(p_pixelType);
+    int readBytes = pixelBytes * p_ns;
 
     // Set up an Isis::EndianSwapper object
     QString tok(Isis::ByteOrderName(p_byteOrder));
@@ -1361,6 +1434,9 @@ namespace Isis {
     Isis::EndianSwapper swapper(tok);
 
     ifstream fin;
+    vector<char> streamBuffer(ImportStreamBufferBytes);
+    fin.rdbuf()->pubsetbuf(&streamBuffer[0], streamBuffer.size());
+
     // Open input file
     Isis::FileName inFile(p_inFile);
     QString inFileName(inFile.expanded());
@@ -1399,6 +1475,12 @@ namespace Isis {
       out = new Isis::LineManager(*OutputCubes[0]);
     }
 
+    // Space for a block of lines before and after the conversion
+    int blockLines = min(p_nl, max(1, ImportBlockPixels / p_ns));
+    vector<char> block((BigInt)blockLines * readBytes);
+    vector<double> pixels((BigInt)blockLines * p_ns);
+    QVector<PixelRun> runs(blockLines);
+
     // Loop once for each band in the image
     p_progress->SetMaximumSteps(p_nl * p_nb);
     p_progress->CheckStatus();
@@ -1437,110 +1519,41 @@ namespace Isis {
       // Space for storing prefix and suffix data pointers
       vector<char *> tempPre, tempPost;
 
-      // Loop for each line in a band
-      for(int line = 0; line < p_nl; line++) {
-
-        // Handle any line prefix bytes
-        pos = fin.tellg();
-        if (p_saveDataPre) {
-          tempPre.push_back(new char[p_dataPreBytes]);
-          fin.read(tempPre.back(), p_dataPreBytes);
-        }
-        else {
-          fin.seekg(p_dataPreBytes, ios_base::cur);
-        }
-
-        // Check the last io
-        if (!fin.good()) {
-          QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                       toString((int)pos) + "]. Byte count [" +
-                       toString(p_dataPreBytes) + "]" ;
-          throw IException(IException::Io, msg, _FILEINFO_);
-        }
+      // Loop for each block of lines in a band
+      for(int firstLine = 0; firstLine < p_nl; firstLine += blockLines) {
+        int lines = min(blockLines, p_nl - firstLine);
 
-        // Get a line of data from the input file
-        pos = fin.tellg();
-        fin.read(in, readBytes);
-        if (!fin.good()) {
-          QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                       toString((int)pos) + "]. Byte count [" +
-                       toString(readBytes) + "]" ;
-          throw IException(IException::Io, msg, _FILEINFO_);
-        }
+        // Get the lines with their prefix and suffix bytes from the input file
+        ReadRecords(fin, &block[0], lines, readBytes, tempPre, tempPost);
 
         // Swap the bytes if necessary and convert any out of bounds pixels
         // to special pixels
-        for(int samp = 0; samp < p_ns; samp++) {
-          switch(p_pixelType) {
-            case Isis::UnsignedByte:
-              (*out)[samp] = (double)((unsigned char *)in)[samp];
-              break;
-            case Isis::UnsignedWord:
-              (*out)[samp] =
-                (double)swapper.UnsignedShortInt((unsigned short int *)in+samp);
-              break;
-            case Isis::SignedWord:
-              (*out)[samp] = (double)swapper.ShortInt((short int *)in+samp);
-              break;
-            case Isis::SignedInteger:
-              (*out)[samp] = (double)swapper.Int((int *)in+samp);
-              break;
-
-          case Isis::UnsignedInteger:
-            (*out)[samp] = (double)swapper.Uint32_t((unsigned int *)in+samp);
-            break;
-            case Isis::Real:
-              if(p_vax_convert) {
-                (*out)[samp]= VAXConversion( (float *)in+samp );
-              }
-              else {
-                (*out)[samp] = (double)swapper.Float((float *)in+samp);
-              }
-              break;
-            case Isis::Double:
-              (*out)[samp] = (double)swapper.Double((double *)in+samp);
-              break;
-            default:
-              break;
-          }
-
-          (*out)[samp] = TestPixel((*out)[samp]);
-
-          if (Isis::IsValidPixel((*out)[samp])) {
-            (*out)[samp] = mult * ((*out)[samp]) + base;
-          }
-        } // End sample loop
-
-        if (funct == NULL) {
-          // Set the buffer position and write the line to the output file
-          ((Isis::LineManager *)out)->SetLine((band * p_nl) + line + 1);
-          OutputCubes[0]->write(*out);
-        }
-        else {
-          ((Isis::Brick *)out)->SetBaseSample(1);
-          ((Isis::Brick *)out)->SetBaseLine(line + 1);
-          ((Isis::Brick *)out)->SetBaseBand(band + 1);
-          funct(*out);
+        runs.resize(lines);
+        for(int i = 0; i < lines; i++) {
+          runs[i].in = &block[(BigInt)i * readBytes];
+          runs[i].stride = pixelBytes;
+          runs[i].out = &pixels[(BigInt)i * p_ns];
+          runs[i].base = base;
+          runs[i].mult = mult;
         }
+        ConvertRuns(runs, p_ns, swapper.willSwap());
 
-        p_progress->CheckStatus();
+        for(int i = 0; i < lines; i++) {
+          memcpy(out->DoubleBuffer(), runs[i].out, p_ns * sizeof(double));
 
-        // Handle any line suffix bytes
-        pos = fin.tellg();
-        if (p_saveDataPost) {
-          tempPost.push_back(new char[p_dataPostBytes]);
-          fin.read(tempPost.back(), p_dataPostBytes);
-        }
-        else {
-          fin.seekg(p_dataPostBytes, ios_base::cur);
-        }
+          if (funct == NULL) {
+            // Set the buffer position and write the line to the output file
+            ((Isis::LineManager *)out)->SetLine((band * p_nl) + firstLine + i + 1);
+            OutputCubes[0]->write(*out);
+          }
+          else {
+            ((Isis::Brick *)out)->SetBaseSample(1);
+            ((Isis::Brick *)out)->SetBaseLine(firstLine + i + 1);
+            ((Isis::Brick *)out)->SetBaseBand(band + 1);
+            funct(*out);
+          }
 
-        // Check the last io
-        if (!fin.good()) {
-          QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                       toString((int)pos) + "]. Byte count [" +
-                       toString(p_dataPreBytes) + "]" ;
-          throw IException(IException::Io, msg, _FILEINFO_);
+          p_progress->CheckStatus();
         }
       } // End line loop
 
@@ -1581,7 +1594,7 @@ namespace Isis {
     if (p_saveFileTrailer) {
       fin.seekg(0, ios_base::end);
       streampos e = fin.tellg();
-      p_fileTrailerBytes = (int)(e - pos + (streampos)1);
+      p_fileTrailerBytes = (int)(e - pos);
       p_fileTrailer = new char[p_fileTrailerBytes];
       fin.seekg(pos);
       fin.read(p_fileTrailer, p_fileTrailerBytes);
@@ -1598,13 +1611,17 @@ namespace Isis {
 
     // Close the file and clean up
     fin.close();
-    delete [] in;
+    delete out;
   }
 
 
   /**
    * Function to process files stored as Band Interleaved by Line
    *
+   * The lines of all bands are read in blocks in file order. The lines of a
+   * block are converted in parallel and then written or passed to funct in
+   * order.
+   *
    * @param funct Method that accepts Isis::Buffer as an input
    *              parameter, processes the image, and has no
    *              return value.
@@ -1615,9 +1632,8 @@ namespace Isis {
   void ProcessImport::ProcessBil(void funct(Isis::Buffer &someBuf)) {
 
     // Figure out the number of bytes to read for a single line
-    int readBytes = Isis::SizeOf(p_pixelType);
-    readBytes = readBytes * p_ns;
-    char *in = new char [readBytes];
+    int pixelBytes = Isis::SizeOf(p_pixelType);
+    int readBytes = pixelBytes * p_ns;
 
     // Set up an Isis::EndianSwapper object
     QString tok(Isis::ByteOrderName(p_byteOrder));
@@ -1625,6 +1641,9 @@ namespace Isis {
     Isis::EndianSwapper swapper(tok);
 
     ifstream fin;
+    vector<char> streamBuffer(ImportStreamBufferBytes);
+    fin.rdbuf()->pubsetbuf(&streamBuffer[0], streamBuffer.size());
+
     // Open input file
     Isis::FileName inFile(p_inFile);
     QString inFileName(inFile.expanded());
@@ -1666,107 +1685,52 @@ namespace Isis {
       out = new Isis::LineManager(*OutputCubes[0]);
     }
 
+    // Space for a block of lines before and after the conversion. A block
+    // holds lines of all bands in file order.
+    int records = p_nl * p_nb;
+    int blockRecords = min(records, max(1, ImportBlockPixels / p_ns));
+    vector<char> block((BigInt)blockRecords * readBytes);
+    vector<double> pixels((BigInt)blockRecords * p_ns);
+    QVector<PixelRun> runs(blockRecords);
+
     // Loop once for each line in the image
     p_progress->SetMaximumSteps(p_nb * p_nl);
     p_progress->CheckStatus();
 
-    // Loop for each line
-    for(int line = 0; line < p_nl; line++) {
-      // Loop for each band
-      for(int band = 0; band < p_nb; band++) {
-        // Set the base multiplier
-        double base, mult;
-        if (p_base.size() > 1) {
-          base = p_base[band];
-          mult = p_mult[band];
-        }
-        else {
-          base = p_base[0];
-          mult = p_mult[0];
-        }
-
-        // Check the last io
-        if (!fin.good()) {
-          QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                       toString((int)pos) + "]. Byte count [" +
-                       toString(p_dataHeaderBytes) + "]" ;
-          throw IException(IException::Io, msg, _FILEINFO_);
-        }
+    // Loop for each block of lines
+    for(int firstRecord = 0; firstRecord < records; firstRecord += blockRecords) {
+      int blockSize = min(blockRecords, records - firstRecord);
 
-        // Space for storing prefix and suffix data pointers
-        vector<char *> tempPre, tempPost;
+      // Get the lines with their prefix and suffix bytes from the input file
+      vector<char *> tempPre, tempPost;
+      ReadRecords(fin, &block[0], blockSize, readBytes, tempPre, tempPost);
 
-        // Handle any line prefix bytes
-        pos = fin.tellg();
-        if (p_saveDataPre) {
-          tempPre.push_back(new char[p_dataPreBytes]);
-          fin.read(tempPre.back(), p_dataPreBytes);
+      // Swap the bytes if necessary and convert any out of bounds pixels
+      // to special pixels
+      runs.resize(blockSize);
+      for(int i = 0; i < blockSize; i++) {
+        // Set the base multiplier
+        int band = (firstRecord + i) % p_nb;
+        if (p_base.size() > 1) {
+          runs[i].base = p_base[band];
+          runs[i].mult = p_mult[band];
         }
         else {
-          fin.seekg(p_dataPreBytes, ios_base::cur);
-        }
-
-        // Check the last io
-        if (!fin.good()) {
-          QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                       toString((int)pos) + "]. Byte count [" +
-                       toString(p_dataPreBytes) + "]" ;
-          throw IException(IException::Io, msg, _FILEINFO_);
-        }
-
-
-        // Get a line of data from the input file
-        pos = fin.tellg();
-        fin.read(in, readBytes);
-        if (!fin.good()) {
-          QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                       toString((int)pos) + "]. Byte count [" +
-                       toString(readBytes) + "]" ;
-          throw IException(IException::Io, msg, _FILEINFO_);
+          runs[i].base = p_base[0];
+          runs[i].mult = p_mult[0];
         }
 
-        // Swap the bytes if necessary and convert any out of bounds pixels
-        // to special pixels
-        for(int samp = 0; samp < p_ns; samp++) {
-          switch(p_pixelType) {
-            case Isis::UnsignedByte:
-              (*out)[samp] = (double)((unsigned char *)in)[samp];
-              break;
-            case Isis::UnsignedWord:
-              (*out)[samp] =
-                (double)swapper.UnsignedShortInt((unsigned short int *)in+samp);
-              break;
-            case Isis::SignedWord:
-              (*out)[samp] = (double)swapper.ShortInt((short int *)in+samp);
-              break;
-            case Isis::SignedInteger:
-              (*out)[samp] = (double)swapper.Int((int *)in+samp);
-              break;
-          case Isis::UnsignedInteger:
-            (*out)[samp] = (double)swapper.Uint32_t((unsigned int *)in+samp);
-            break;
-            case Isis::Real:
-              if(p_vax_convert) {
-                (*out)[samp]= VAXConversion( (float *)in+samp );
-              }
-              else {
-                (*out)[samp] = (double)swapper.Float((float *)in+samp);
-              }
-              break;
-            case Isis::Double:
-              (*out)[samp] = (double)swapper.Double((double *)in+samp);
-              break;
-            default:
-              break;
-          }
+        runs[i].in = &block[(BigInt)i * readBytes];
+        runs[i].stride = pixelBytes;
+        runs[i].out = &pixels[(BigInt)i * p_ns];
+      }
+      ConvertRuns(runs, p_ns, swapper.willSwap());
 
-          // Sets out to isis special pixel or leaves it if valid
-          (*out)[samp] = TestPixel((*out)[samp]);
+      for(int i = 0; i < blockSize; i++) {
+        int line = (firstRecord + i) / p_nb;
+        int band = (firstRecord + i) % p_nb;
 
-          if (Isis::IsValidPixel((*out)[samp])) {
-            (*out)[samp] = mult * ((*out)[samp]) + base;
-          }
-        } // End sample loop
+        memcpy(out->DoubleBuffer(), runs[i].out, p_ns * sizeof(double));
 
         if (funct == NULL) {
           ((Isis::LineManager *)out)->SetLine((band * p_nl) + line + 1);
@@ -1779,45 +1743,14 @@ namespace Isis {
 
         p_progress->CheckStatus();
 
-        // Handle any line suffix bytes
-        pos = fin.tellg();
-        if (p_saveDataPost) {
-          tempPost.push_back(new char[p_dataPostBytes]);
-          fin.read(tempPost.back(), p_dataPostBytes);
-        }
-        else {
-          fin.seekg(p_dataPostBytes, ios_base::cur);
-        }
-
-        // Check the last io
-        if (!fin.good()) {
-          QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                       toString((int)pos) + "]. Byte count [" +
-                       toString(p_dataPreBytes) + "]" ;
-          throw IException(IException::Io, msg, _FILEINFO_);
-        }
-
-        // Save off the prefix bytes vector
+        // Save off the prefix and suffix bytes of each line
         if (p_saveDataPre) {
-          p_dataPre.push_back(tempPre);
-          tempPre.clear();
+          p_dataPre.push_back(vector<char *>(1, tempPre[i]));
         }
-
-        // Save off the suffix bytes vector
         if (p_saveDataPost) {
-          p_dataPost.push_back(tempPost);
-          tempPost.clear();
+          p_dataPost.push_back(vector<char *>(1, tempPost[i]));
         }
-
-        // Check the last io
-        if (!fin.good()) {
-          QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                       toString((int)pos) + "]. Byte count [" +
-                       toString(p_fileHeaderBytes) + "]" ;
-          throw IException(IException::Io, msg, _FILEINFO_);
-        }
-
-      } // End band loop
+      }
 
     } // End line loop
 
@@ -1826,7 +1759,7 @@ namespace Isis {
     if (p_saveFileTrailer) {
       fin.seekg(0, ios_base::end);
       streampos e = fin.tellg();
-      p_fileTrailerBytes = (int)(e - pos + (streampos)1);
+      p_fileTrailerBytes = (int)(e - pos);
       p_fileTrailer = new char[p_fileTrailerBytes];
       fin.seekg(pos);
       fin.read(p_fileTrailer, p_fileTrailerBytes);
@@ -1843,13 +1776,16 @@ namespace Isis {
 
     // Close the file and clean up
     fin.close();
-    delete [] in;
+    delete out;
   }
 
 
   /**
    * Function to process files stored as Band Interleaved by Pixel
    *
+   * The lines are read in blocks. The bands of the lines of a block are
+   * converted in parallel and then written or passed to funct in order.
+   *
    * @param funct Method that accepts Isis::Buffer as an input
    *              parameter, processes the image, and has no
    *              return value.
@@ -1865,6 +1801,9 @@ namespace Isis {
     Isis::EndianSwapper swapper(tok);
 
     ifstream fin;
+    vector<char> streamBuffer(ImportStreamBufferBytes);
+    fin.rdbuf()->pubsetbuf(&streamBuffer[0], streamBuffer.size());
+
     // Open input file
     Isis::FileName inFile(p_inFile);
     QString inFileName(inFile.expanded());
@@ -1910,131 +1849,187 @@ namespace Isis {
     p_progress->CheckStatus();
 
     // Figure out the number of bytes to read for a single line
-    int sampleBytes = Isis::SizeOf(p_pixelType) * p_nb + p_dataPreBytes + p_dataPostBytes;
+    int pixelBytes = Isis::SizeOf(p_pixelType);
+    int sampleBytes = pixelBytes * p_nb + p_dataPreBytes + p_dataPostBytes;
     int readBytes = p_ns * sampleBytes;
-    char *in = new char [readBytes];
 
-    // Loop for each line
-    for(int line = 0; line < p_nl; line++) {
-      // Check the last io
-      if (!fin.good()) {
-        QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                     toString((int)pos) + "]. Byte count [" +
-                     toString(p_dataHeaderBytes) + "]" ;
-        throw IException(IException::Io, msg, _FILEINFO_);
+    // Space for a block of lines before and after the conversion
+    int blockLines = min(p_nl, max(1, ImportBlockPixels / (p_ns * p_nb)));
+    vector<char> block((BigInt)blockLines * readBytes);
+    vector<double> pixels((BigInt)blockLines * p_nb * p_ns);
+    QVector<PixelRun> runs(blockLines * p_nb);
+
+    // Loop for each block of lines
+    for(int firstLine = 0; firstLine < p_nl; firstLine += blockLines) {
+      int lines = min(blockLines, p_nl - firstLine);
+
+      for(int i = 0; i < lines; i++) {
+        // Get a line of data from the input file
+        char *in = &block[(BigInt)i * readBytes];
+        pos = fin.tellg();
+        fin.read(in, readBytes);
+        if (!fin.good()) {
+          QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
+                       toString((int)pos) + "]. Byte count [" +
+                       toString(readBytes) + "]" ;
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        // Handle the data trailer
+        pos = fin.tellg();
+        if (p_saveDataTrailer) {
+          p_dataTrailer.push_back(new char[p_dataTrailerBytes]);
+          fin.read(p_dataTrailer.back(), p_dataTrailerBytes);
+        }
+        else {
+          fin.seekg(p_dataTrailerBytes, ios_base::cur);
+        }
+
+        // Check the last io
+        if (!fin.good()) {
+          QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
+                       toString((int)pos) + "]. Byte count [" +
+                       toString(p_dataTrailerBytes) + "]" ;
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        // Swap the bytes if necessary and convert any out of bounds pixels
+        // to special pixels. Each band of the line is a strided run.
+        for(int band = 0; band < p_nb; band++) {
+          // Set the base multiplier
+          PixelRun &run = runs[i * p_nb + band];
+          if (p_base.size() > 1) {
+            run.base = p_base[band];
+            run.mult = p_mult[band];
+          }
+          else {
+            run.base = p_base[0];
+            run.mult = p_mult[0];
+          }
+
+          run.in = in + p_dataPreBytes + pixelBytes * band;
+          run.stride = sampleBytes;
+          run.out = &pixels[((BigInt)i * p_nb + band) * p_ns];
+        }
       }
 
-      // Space for storing prefix and suffix data pointers
-      vector<char *> tempPre, tempPost;
+      // Handle record prefix and suffix
+      for(int i = 0; i < lines; i++) {
+        char *in = &block[(BigInt)i * readBytes];
 
-      // Check the last io
-      if (!fin.good()) {
-        QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                     toString((int)pos) + "]. Byte count [" +
-                     toString(p_dataPreBytes) + "]" ;
-        throw IException(IException::Io, msg, _FILEINFO_);
+        if (p_saveDataPre) {
+          vector<char *> tempPre;
+          for(int samp = 0; samp < p_ns; samp++) {
+            char *samplePrefix = new char[p_dataPreBytes];
+            memcpy(samplePrefix, &in[samp*sampleBytes], p_dataPreBytes);
+            tempPre.push_back(samplePrefix);
+          }
+          p_dataPre.push_back(tempPre);
+        }
+        if (p_saveDataPost) {
+          vector<char *> tempPost;
+          for(int samp = 0; samp < p_ns; samp++) {
+            char *sampleSuffix = new char[p_dataPostBytes];
+            int suffixIndex = p_dataPreBytes + pixelBytes * p_nb + samp*sampleBytes;
+            memcpy(sampleSuffix, &in[suffixIndex], p_dataPostBytes);
+            tempPost.push_back(sampleSuffix);
+          }
+          p_dataPost.push_back(tempPost);
+        }
       }
 
-      // Get a line of data from the input file
-      pos = fin.tellg();
-      fin.read(in, readBytes);
+      runs.resize(lines * p_nb);
+      ConvertRuns(runs, p_ns, swapper.willSwap());
+
+      for(int i = 0; i < lines; i++) {
+        for(int band = 0; band < p_nb; band++) {
+          memcpy(out->DoubleBuffer(), runs[i * p_nb + band].out, p_ns * sizeof(double));
+
+          if (funct == NULL) {
+            //Set the buffer position and write the line to the output file
+            ((Isis::LineManager *)out)->SetLine((band * p_nl) + firstLine + i + 1);
+            OutputCubes[0]->write(*out);
+          }
+          else {
+            funct(*out);
+          }
+        } // End band loop
+
+        p_progress->CheckStatus();
+      }
+
+    } // End line loop
+
+    // Handle the file trailer
+    pos = fin.tellg();
+    if (p_saveFileTrailer) {
+      fin.seekg(0, ios_base::end);
+      streampos e = fin.tellg();
+      p_fileTrailerBytes = (int)(e - pos);
+      p_fileTrailer = new char[p_fileTrailerBytes];
+      fin.seekg(pos);
+      fin.read(p_fileTrailer, p_fileTrailerBytes);
+
+      // Check the io
       if (!fin.good()) {
         QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
                      toString((int)pos) + "]. Byte count [" +
-                     toString(readBytes) + "]" ;
+                     toString(p_fileTrailerBytes) + "]" ;
         throw IException(IException::Io, msg, _FILEINFO_);
       }
 
-      // Loop for each band
-      for(int band = 0; band < p_nb; band++) {
-        // Set the base multiplier
-        double base, mult;
-        if (p_base.size() > 1) {
-          base = p_base[band];
-          mult = p_mult[band];
-        }
-        else {
-          base = p_base[0];
-          mult = p_mult[0];
-        }
-
-        // Swap the bytes if necessary and convert any out of bounds pixels
-        // to special pixels
-        int osamp = 0;
+    }
 
-        for(int samp = 0; samp < p_ns; samp++) {
-          int bufferIndex = p_dataPreBytes + Isis::SizeOf(p_pixelType)*band + samp*sampleBytes;
-          switch(p_pixelType) {
-            case Isis::UnsignedByte:
-              (*out)[osamp] = (double)((unsigned char *)in)[bufferIndex];
-              break;
-            case Isis::UnsignedWord:
-              (*out)[osamp] =
-                (double)swapper.UnsignedShortInt(&in[bufferIndex]);
-              break;
-            case Isis::SignedWord:
-              (*out)[osamp] = (double)swapper.ShortInt(&in[bufferIndex]);
-              break;
-            case Isis::SignedInteger:
-              (*out)[samp] = (double)swapper.Int(&in[bufferIndex]);
-              break;            
-          case Isis::UnsignedInteger:
-            (*out)[samp] = (double)swapper.Uint32_t(&in[bufferIndex]);
-            break;
-            case Isis::Real:
-              if(p_vax_convert) {
-                (*out)[osamp]= VAXConversion(&in[bufferIndex]);
-              }
-              else {
-                (*out)[osamp] = (double)swapper.Float(&in[bufferIndex]);
-              }
-              break;
-            case Isis::Double:
-              (*out)[osamp] = (double)swapper.Double(&in[bufferIndex]);
-              break;
-            default:
-              break;
-          }
+    // Close the file and clean up
+    fin.close();
+    delete out;
 
-          // Sets out to isis special pixel or leaves it if valid
-          (*out)[osamp] = TestPixel((*out)[osamp]);
+  }
 
-          if (Isis::IsValidPixel((*out)[osamp])) {
-            (*out)[osamp] = mult * ((*out)[osamp]) + base;
-          }
-          osamp++;
-        } // End sample loop
 
-        if (funct == NULL) {
-          //Set the buffer position and write the line to the output file
-          ((Isis::LineManager *)out)->SetLine((band * p_nl) + line + 1);
-          OutputCubes[0]->write(*out);
-        }
-        else {
-          funct(*out);
-        }
+  /**
+   * Read records made of prefix bytes, a line of pixels and suffix bytes
+   * from the input file. The records follow each other in the file, so when
+   * there are no prefix or suffix bytes all of the lines are read at once.
+   *
+   * @param fin The input file, positioned at the first record
+   * @param data Receives the lines of pixels one after another
+   * @param records The number of records to read
+   * @param dataBytes The number of bytes in a line of pixels
+   * @param pre Receives the prefix bytes of each record if they are saved
+   * @param post Receives the suffix bytes of each record if they are saved
+   *
+   * @throws Isis::iException::Message "Cannot read file.
+   *             Position[]. Byte count[]"
+   */
+  void ProcessImport::ReadRecords(std::ifstream &fin, char *data, int records,
+                                  int dataBytes, std::vector<char *> &pre,
+                                  std::vector<char *> &post) {
+    streampos pos;
 
-      } // End band loop
+    if (p_dataPreBytes == 0 && p_dataPostBytes == 0 &&
+        !p_saveDataPre && !p_saveDataPost) {
+      pos = fin.tellg();
+      BigInt bytes = (BigInt)records * dataBytes;
+      fin.read(data, bytes);
+      if (!fin.good()) {
+        QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
+                     toString((BigInt)pos) + "]. Byte count [" +
+                     toString(bytes) + "]" ;
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+      return;
+    }
 
-      // Handle record prefix and suffix
+    for(int record = 0; record < records; record++) {
+      // Handle any line prefix bytes
+      pos = fin.tellg();
       if (p_saveDataPre) {
-        for(int samp = 0; samp < p_ns; samp++) {
-          char *samplePrefix = new char[p_dataPreBytes];
-          memcpy(samplePrefix, &in[samp*sampleBytes], p_dataPreBytes);
-          tempPre.push_back(samplePrefix);
-        }
-        p_dataPre.push_back(tempPre);
-        tempPre.clear();
+        pre.push_back(new char[p_dataPreBytes]);
+        fin.read(pre.back(), p_dataPreBytes);
       }
-      if (p_saveDataPost) {
-        for(int samp = 0; samp < p_ns; samp++) {
-          char *sampleSuffix = new char[p_dataPostBytes];
-          int suffixIndex = p_dataPreBytes + Isis::SizeOf(p_pixelType)*p_nb + samp*sampleBytes;
-          memcpy(sampleSuffix, &in[suffixIndex], p_dataPostBytes);
-          tempPost.push_back(sampleSuffix);
-        }
-        p_dataPost.push_back(tempPost);
-        tempPost.clear();
+      else {
+        fin.seekg(p_dataPreBytes, ios_base::cur);
       }
 
       // Check the last io
@@ -2045,52 +2040,137 @@ namespace Isis {
         throw IException(IException::Io, msg, _FILEINFO_);
       }
 
-      // Handle the data trailer
+      // Get a line of data from the input file
       pos = fin.tellg();
-      if (p_saveDataTrailer) {
-        p_dataTrailer.push_back(new char[p_dataTrailerBytes]);
-        fin.read(p_dataTrailer.back(), p_dataTrailerBytes);
+      fin.read(data + (BigInt)record * dataBytes, dataBytes);
+      if (!fin.good()) {
+        QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
+                     toString((int)pos) + "]. Byte count [" +
+                     toString(dataBytes) + "]" ;
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      // Handle any line suffix bytes
+      pos = fin.tellg();
+      if (p_saveDataPost) {
+        post.push_back(new char[p_dataPostBytes]);
+        fin.read(post.back(), p_dataPostBytes);
       }
       else {
-        fin.seekg(p_dataTrailerBytes, ios_base::cur);
+        fin.seekg(p_dataPostBytes, ios_base::cur);
       }
 
       // Check the last io
       if (!fin.good()) {
         QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
                      toString((int)pos) + "]. Byte count [" +
-                     toString(p_fileHeaderBytes) + "]" ;
+                     toString(p_dataPostBytes) + "]" ;
         throw IException(IException::Io, msg, _FILEINFO_);
       }
+    }
+  }
 
-      p_progress->CheckStatus();
 
-    } // End line loop
+  /**
+   * Converts one run of pixels for QtConcurrent.
+   *
+   * @internal
+   */
+  class ProcessImport::ConvertRunFunctor :
+      public std::unary_function<ProcessImport::PixelRun &, void> {
+    public:
+      ConvertRunFunctor(ProcessImport *process, int count, bool swap) :
+          m_process(process), m_count(count), m_swap(swap) {
+      }
 
-    // Handle the file trailer
-    pos = fin.tellg();
-    if (p_saveFileTrailer) {
-      fin.seekg(0, ios_base::end);
-      streampos e = fin.tellg();
-      p_fileTrailerBytes = (int)(e - pos + (streampos)1);
-      p_fileTrailer = new char[p_fileTrailerBytes];
-      fin.seekg(pos);
-      fin.read(p_fileTrailer, p_fileTrailerBytes);
 
-      // Check the io
-      if (!fin.good()) {
-        QString msg = "Cannot read file [" + p_inFile + "]. Position [" +
-                     toString((int)pos) + "]. Byte count [" +
-                     toString(p_fileTrailerBytes) + "]" ;
-        throw IException(IException::Io, msg, _FILEINFO_);
+      void operator()(PixelRun &run) const {
+        m_process->ConvertPixels(run, m_count, m_swap);
       }
 
+    private:
+      ProcessImport *m_process; //!< The import that owns the special pixel ranges
+      int m_count;              //!< The number of pixels in each run
+      bool m_swap;              //!< True if the bytes of the pixels are swapped
+  };
+
+
+  /**
+   * Convert runs of input pixels. The runs are independent of each other, so
+   * they are converted in parallel on the global thread pool.
+   *
+   * @param runs The runs of pixels to convert
+   * @param count The number of pixels in each run
+   * @param swap True if the bytes of the input pixels need to be swapped
+   */
+  void ProcessImport::ConvertRuns(QVector<PixelRun> &runs, int count, bool swap) {
+    ConvertRunFunctor functor(this, count, swap);
+
+    if (runs.size() > 1 && QThreadPool::globalInstance()->maxThreadCount() > 1) {
+      QtConcurrent::blockingMap(runs, functor);
+    }
+    else {
+      for(int i = 0; i < runs.size(); i++) {
+        functor(runs[i]);
+      }
     }
+  }
 
-    // Close the file and clean up
-    fin.close();
-    delete [] in;
 
+  /**
+   * Swap the bytes of the input pixels if necessary, convert them to
+   * doubles, convert any out of bounds pixels to special pixels and apply
+   * the base and multiplier to the valid pixels.
+   *
+   * @param run The input pixels and where the converted pixels go
+   * @param count The number of pixels in the run
+   * @param swap True if the bytes of the input pixels need to be swapped
+   */
+  void ProcessImport::ConvertPixels(PixelRun &run, int count, bool swap) {
+    switch(p_pixelType) {
+      case Isis::UnsignedByte:
+        decodePixels<unsigned char, unsigned char>(run.in, run.stride, false,
+                                                   run.out, count);
+        break;
+      case Isis::UnsignedWord:
+        decodePixels<unsigned short int, quint16>(run.in, run.stride, swap,
+                                                  run.out, count);
+        break;
+      case Isis::SignedWord:
+        decodePixels<short int, quint16>(run.in, run.stride, swap, run.out, count);
+        break;
+      case Isis::SignedInteger:
+        decodePixels<int, quint32>(run.in, run.stride, swap, run.out, count);
+        break;
+      case Isis::UnsignedInteger:
+        decodePixels<unsigned int, quint32>(run.in, run.stride, swap, run.out, count);
+        break;
+      case Isis::Real:
+        if(p_vax_convert) {
+          for(int samp = 0; samp < count; samp++) {
+            run.out[samp] = VAXConversion(run.in + (BigInt)samp * run.stride);
+          }
+        }
+        else {
+          decodePixels<float, quint32>(run.in, run.stride, swap, run.out, count);
+        }
+        break;
+      case Isis::Double:
+        decodePixels<double, quint64>(run.in, run.stride, swap, run.out, count);
+        break;
+      default:
+        break;
+    }
+
+    for(int samp = 0; samp < count; samp++) {
+      // Sets out to isis special pixel or leaves it if valid
+      double pixel = TestPixel(run.out[samp]);
+
+      if (Isis::IsValidPixel(pixel)) {
+        pixel = run.mult * pixel + run.base;
+      }
+      run.out[samp] = pixel;
+    }
   }
 
 
@@ -22,7 +22,11 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <fstream>
 #include <string>
+#include <vector>
+
+#include <QVector>
 
 #include "Buffer.h"
 #include "CubeAttribute.h"
@@ -165,6 +169,13 @@ namespace Isis {
    *                           Fixes #5398.
    *   @history 2018-07-19 Tyler Wilson - Added support for 4-byte UnsignedInteger special pixel
    *                            values.
+   *   @history 2026-10-19 ISIS Development Team - ProcessBsq(), ProcessBil() and ProcessBip()
+   *                           now read blocks of lines through a large stream buffer and
+   *                           convert the lines of a block in parallel on the global thread
+   *                           pool before writing them in order. The byte swapping and pixel
+   *                           type conversion was moved into one vectorizable kernel shared
+   *                           by all three organizations. Fixed saving the file trailer,
+   *                           which read one byte past the end of the file.
    *
    */
   class ProcessImport : public Isis::Process {
@@ -338,6 +349,25 @@ namespace Isis {
 
 
     private:
+      /**
+       * A run of input pixels of one line and band, and where the converted
+       * pixels go.
+       */
+      struct PixelRun {
+        char *in;     //!< The first input pixel
+        int stride;   //!< The number of bytes from one input pixel to the next
+        double *out;  //!< Receives the converted pixels
+        double base;  //!< The base of the band
+        double mult;  //!< The multiplier of the band
+      };
+
+      class ConvertRunFunctor;
+
+      void ReadRecords(std::ifstream &fin, char *data, int records, int dataBytes,
+                       std::vector<char *> &pre, std::vector<char *> &post);
+      void ConvertRuns(QVector<PixelRun> &runs, int count, bool swap);
+      void ConvertPixels(PixelRun &run, int count, bool swap);
+
       QString p_inFile;            //!< Input file name
       Isis::PixelType p_pixelType; //!< Pixel type of input data
 
@@ -64,6 +64,50 @@ namespace Isis {
    * Mosaic Processing method, returns false if the cube is not inside the mosaic
    */
   bool ProcessMapMosaic::StartProcess(QString inputFile) {
+    return AddInput(inputFile, NULL);
+  }
+
+
+  /**
+   * Mosaic Processing method for a list of input cubes. The inputs are placed in list order
+   * with the same results as calling StartProcess(QString) for each of them, but the label and
+   * tracking work is done first and the pixels of all inputs are then placed concurrently in
+   * tiles of mosaic lines (see ProcessMosaic::SetTileLines()).
+   *
+   * @param inputFiles The input cubes, in placement order
+   *
+   * @return QStringList The input cubes that are not inside the mosaic
+   *
+   * @throws IException::User "Unable to mosaic cube"
+   */
+  QStringList ProcessMapMosaic::StartProcess(const FileList &inputFiles) {
+    QStringList outside;
+    QList<Placement> placements;
+
+    for (int i = 0; i < inputFiles.size(); i++) {
+      if (!AddInput(inputFiles[i].toString(), &placements)) {
+        outside.append(inputFiles[i].toString());
+      }
+    }
+
+    Progress()->SetText("Mosaicking " + QString::number(inputFiles.size() - outside.size()) +
+                        " cubes");
+    PlaceImages(placements);
+
+    return outside;
+  }
+
+
+  /**
+   * Positions an input cube in the mosaic and either places it or, if placements is given,
+   * only does the label work and appends its placements for ProcessMosaic::PlaceImages().
+   *
+   * @param inputFile The input cube
+   * @param placements Where to append the placements of the input, NULL to place it now
+   *
+   * @return bool False if the cube is not inside the mosaic
+   */
+  bool ProcessMapMosaic::AddInput(QString inputFile, QList<Placement> *placements) {
     if (InputCubes.size() != 0) {
       QString msg = "Input cubes already exist; do not call SetInputCube when using ";
       msg += "ProcessMosaic::StartProcess(QString)";
@@ -164,13 +208,22 @@ namespace Isis {
     }
     else {
       // Place the input in the mosaic
-      Progress()->SetText("Mosaicking " + FileName(inputFile).name());
+      if (!placements) {
+        Progress()->SetText("Mosaicking " + FileName(inputFile).name());
+      }
 
       try {
         do {
           int outBand = 1;
           
-          ProcessMosaic::StartProcess(outSample, outLine, outBand);
+          if (placements) {
+            Placement placement = PreparePlacement(outSample, outLine, outBand);
+            placement.inputFile = inputFile;
+            placements->append(placement);
+          }
+          else {
+            ProcessMosaic::StartProcess(outSample, outLine, outBand);
+          }
           // Reset the creation flag to ensure that the data within the tracking cube written from
           // this call of StartProcess isn't over-written in the next. This needs to occur since the 
           // tracking cube is created in ProcessMosaic if the m_createOutputMosaic flag is set to 
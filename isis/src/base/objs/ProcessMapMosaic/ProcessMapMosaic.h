@@ -26,6 +26,9 @@
 #include "Buffer.h"
 #include "FileList.h"
 
+#include <QList>
+#include <QStringList>
+
 namespace Isis {
   /**
    * @brief Mosaic two cubs together
@@ -162,9 +165,11 @@ namespace Isis {
 
       using Isis::ProcessMosaic::StartProcess;
       virtual bool StartProcess(QString inputFile);
+      QStringList StartProcess(const FileList &inputFiles);
 
     private:
       static void FillNull(Buffer &data);
+      bool AddInput(QString inputFile, QList<Placement> *placements);
 
      /**
       * Internal use; SetOutputMosaic (const QString &) sets to false to
@@ -21,7 +21,17 @@
  */
 #include "Preference.h"
 
+#include <cmath>
+
+#include <QFuture>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+
 #include "Application.h"
+#include "CubeAttribute.h"
+#include "FileName.h"
 #include "IException.h"
 #include "IString.h"
 #include "Portal.h"
@@ -52,6 +62,7 @@ namespace Isis {
     // Initialize the structure Track Info
     m_trackingEnabled    = false;
     m_trackingCube = NULL;
+    m_trackingTable = NULL;
     m_createOutputMosaic   = false;
     m_bandPriorityBandNumber  = 0;
     m_bandPriorityKeyName  = "";
@@ -68,6 +79,8 @@ namespace Isis {
 
     m_enforceMatchDEM = false;
 
+    m_tileLines = 0;
+
     // Initialize the data members
     m_iss = -1;
     m_isl = -1;
@@ -84,11 +97,7 @@ namespace Isis {
 
   //!  Destroys the Mosaic object. It will close all opened cubes.
   ProcessMosaic::~ProcessMosaic() {
-    if (m_trackingCube) {
-      m_trackingCube->close();
-      delete m_trackingCube;
-      m_trackingCube = NULL;
-    }
+    CloseTrackingCube();
   }
 
 
@@ -119,6 +128,42 @@ namespace Isis {
   * @author Sharmila Prasad (8/25/2009)
   */
   void ProcessMosaic::StartProcess(const int &os, const int &ol, const int &ob) {
+    Placement placement = PreparePlacement(os, ol, ob);
+
+    p_progress->SetMaximumSteps(
+        (int)InputCubes[0]->lineCount() * (int)InputCubes[0]->bandCount());
+    p_progress->CheckStatus();
+
+    PlaceImage(InputCubes[0], m_trackingCube, placement,
+               placement.osl, placement.osl + placement.inl - 1, true);
+
+    CloseTrackingCube();
+  } // End StartProcess
+
+
+  /**
+   * Validates the current input against the mosaic and performs all of the
+   * label work of placing it: band bin matching, DEM matching, count band
+   * initialization and tracking table updates. No pixels are moved. The
+   * returned Placement is everything PlaceImage() needs to move the pixels,
+   * so label work can be done serially for many inputs and the pixel work
+   * spread over threads afterwards.
+   *
+   * If tracking is enabled the tracking cube is left open in m_trackingCube.
+   *
+   * @param os The sample position of input cube starting sample relative to
+   *           the output cube.
+   * @param ol The line position of input cube starting line relative to the
+   *           output cube.
+   * @param ob The band position of input cube starting band relative to the
+   *           output cube.
+   *
+   * @return Placement The placement of the current input cube
+   *
+   * @throws IException::Message
+   */
+  ProcessMosaic::Placement ProcessMosaic::PreparePlacement(const int &os, const int &ol,
+                                                           const int &ob) {
     // Error checks ... there must be one input and one output
     if ((OutputCubes.size() != 1) || (InputCubes.size() != 1)) {
       QString m = "You must specify exactly one input and one output cube";
@@ -197,10 +242,6 @@ namespace Isis {
       m_osb = 1;
     }
 
-    p_progress->SetMaximumSteps(
-        (int)InputCubes[0]->lineCount() * (int)InputCubes[0]->bandCount());
-    p_progress->CheckStatus();
-
     // Tracking is done for:
     // (1) Band priority,
     // (2) Ontop and Beneath priority with number of bands equal to 1,
@@ -285,8 +326,7 @@ namespace Isis {
     // Create tracking cube if need-be, add bandbin group, and update tracking table. Add tracking
     // group to mosaic cube. 
     if (m_trackingEnabled) {
-      TrackingTable *trackingTable;
-
+      // The tracking cube and table stay open for the remaining inputs of a mosaic
       if (!m_trackingCube) {
         m_trackingCube = new Cube;
 
@@ -323,7 +363,7 @@ namespace Isis {
           trackingLabel->findObject("IsisCube").addGroup(bandBin);
 
           // Initialize an empty TrackingTable object to manage tracking table in tracking cube
-          trackingTable = new TrackingTable();
+          m_trackingTable = new TrackingTable();
         }
         
         // An existing mosaic cube is being added to
@@ -335,10 +375,9 @@ namespace Isis {
             m_trackingCube->open(trackingPath + "/" + trackingFile, "rw");
 
             // Initialize a TrackingTable object from current mosaic
-            Table *table;
             try {
-              table = new Table(TRACKING_TABLE_NAME, m_trackingCube->fileName());
-              trackingTable = new TrackingTable(*table);
+              Table table(TRACKING_TABLE_NAME, m_trackingCube->fileName());
+              m_trackingTable = new TrackingTable(table);
             }
             catch (IException &e) {
               QString msg = "Unable to find Tracking Table in " + m_trackingCube->fileName() + ".";
@@ -355,18 +394,19 @@ namespace Isis {
           }
         }
         
-        // Add current file to the TrackingTable object
-        iIndex = trackingTable->fileNameToPixel(InputCubes[0]->fileName(), 
-                                       SerialNumber::Compose(*(InputCubes[0])));
-        
-        //  Write the tracking table to the tracking cube, overwriting if need-be
-        if (m_trackingCube->hasTable(Isis::trackingTableName)) {
-         m_trackingCube->deleteBlob("Table", Isis::trackingTableName);
-        }
-        Table table = trackingTable->toTable();
-        m_trackingCube->write(table);
       }
 
+      // Add current file to the TrackingTable object
+      iIndex = m_trackingTable->fileNameToPixel(InputCubes[0]->fileName(),
+                                                SerialNumber::Compose(*(InputCubes[0])));
+
+      //  Write the tracking table to the tracking cube, overwriting if need-be
+      if (m_trackingCube->hasTable(Isis::trackingTableName)) {
+        m_trackingCube->deleteBlob("Table", Isis::trackingTableName);
+      }
+      Table table = m_trackingTable->toTable();
+      m_trackingCube->write(table);
+
     }
     else if (m_imageOverlay == AverageImageWithMosaic && m_createOutputMosaic) {
       ResetCountBands();
@@ -374,15 +414,7 @@ namespace Isis {
 
     m_onb = OutputCubes[0]->bandCount();
 
-    if (m_trackingEnabled) {
-
-      // For mosaic creation, the input is copied onto mosaic by default
-      if (m_imageOverlay == UseBandPlacementCriteria && !m_createOutputMosaic) {
-        BandComparison(iss, isl, ins, inl,
-                       bandPriorityInputBandNumber, bandPriorityOutputBandNumber, iIndex);
-      }
-    }
-    else if (m_imageOverlay == AverageImageWithMosaic) {
+    if (!m_trackingEnabled && m_imageOverlay == AverageImageWithMosaic) {
       m_onb /= 2;
       if (m_onb < 1) {
         QString msg = "The mosaic cube needs a count band.";
@@ -390,44 +422,125 @@ namespace Isis {
       }
     }
 
+    Placement placement;
+    placement.inputFile = InputCubes[0]->fileName();
+    placement.iss = iss;
+    placement.isl = isl;
+    placement.isb = isb;
+    placement.ins = ins;
+    placement.inl = inl;
+    placement.inb = inb;
+    placement.oss = m_oss;
+    placement.osl = m_osl;
+    placement.osb = m_osb;
+    placement.onb = m_onb;
+    placement.trackingIndex = iIndex;
+    placement.bandPriorityInputBandNumber = bandPriorityInputBandNumber;
+    placement.bandPriorityOutputBandNumber = bandPriorityOutputBandNumber;
+    placement.createOutputMosaic = m_createOutputMosaic;
+    placement.trackingEnabled = m_trackingEnabled;
+    return placement;
+  }
+
+
+  /**
+   * Moves the pixels of one input into the mosaic for the output lines
+   * firstOutLine through lastOutLine. The placed pixels only depend on the
+   * input, the mosaic (and count/tracking) values at the same output pixel, so
+   * placing inputs in the same order within disjoint line ranges gives the same
+   * mosaic as placing each input over its full extent.
+   *
+   * @param inCube The input cube of the placement
+   * @param trackingCube The open tracking cube, or NULL if not tracking
+   * @param placement Where and how the input is placed (see PreparePlacement())
+   * @param firstOutLine The first mosaic line to process
+   * @param lastOutLine The last mosaic line to process
+   * @param reportProgress Report progress per line when true
+   */
+  void ProcessMosaic::PlaceImage(Cube *inCube, Cube *trackingCube, const Placement &placement,
+                                 int firstOutLine, int lastOutLine, bool reportProgress) const {
+    // Clip the line range to the lines this placement covers
+    firstOutLine = max(firstOutLine, placement.osl);
+    lastOutLine = min(lastOutLine, placement.osl + placement.inl - 1);
+    if (firstOutLine > lastOutLine) {
+      return;
+    }
+
+    int iss = placement.iss;
+    int isb = placement.isb;
+    int ins = placement.ins;
+    int inb = placement.inb;
+    int oss = placement.oss;
+    int onb = placement.onb;
+    int iIndex = placement.trackingIndex;
+    int bandPriorityInputBandNumber = placement.bandPriorityInputBandNumber;
+    int bandPriorityOutputBandNumber = placement.bandPriorityOutputBandNumber;
+    bool createOutputMosaic = placement.createOutputMosaic;
+    bool trackingEnabled = placement.trackingEnabled;
+
+    // Input line of the first output line processed
+    int isl = placement.isl + (firstOutLine - placement.osl);
+    int inl = lastOutLine - firstOutLine + 1;
+
+    if (trackingEnabled) {
+      // For mosaic creation, the input is copied onto mosaic by default
+      if (m_imageOverlay == UseBandPlacementCriteria && !createOutputMosaic) {
+        BandComparison(inCube, trackingCube, iss, isl, ins, inl, oss, firstOutLine,
+                       bandPriorityInputBandNumber, bandPriorityOutputBandNumber, iIndex);
+      }
+    }
+
     // Process Band Priority with no tracking
-    if (m_imageOverlay == UseBandPlacementCriteria && !m_trackingEnabled ) {
-      BandPriorityWithNoTracking(iss, isl, isb, ins, inl, inb, bandPriorityInputBandNumber,
-                                 bandPriorityOutputBandNumber);
+    if (m_imageOverlay == UseBandPlacementCriteria && !trackingEnabled ) {
+      BandPriorityWithNoTracking(inCube, iss, isl, isb, ins, inl, inb, oss, firstOutLine,
+                                 placement.osb, onb, createOutputMosaic,
+                                 bandPriorityInputBandNumber, bandPriorityOutputBandNumber);
     }
     else {
       // Create portal buffers for the input and output files
-      Portal iPortal(ins, 1, InputCubes[0]->pixelType());
+      Portal iPortal(ins, 1, inCube->pixelType());
       Portal oPortal(ins, 1, OutputCubes[0]->pixelType());
       Portal countPortal(ins, 1, OutputCubes[0]->pixelType());
       Portal trackingPortal(ins, 1, PixelType::UnsignedInteger);
+      Portal iComparePortal(ins, 1, inCube->pixelType());
+      Portal oComparePortal(ins, 1, OutputCubes[0]->pixelType());
 
-      for (int ib = isb, ob = m_osb; ib < (isb + inb) && ob <= m_onb; ib++, ob++) {
-        for (int il = isl, ol = m_osl; il < isl + inl; il++, ol++) {
+      for (int ib = isb, ob = placement.osb; ib < (isb + inb) && ob <= onb; ib++, ob++) {
+        for (int il = isl, ol = firstOutLine; il < isl + inl; il++, ol++) {
           // Set the position of the portals in the input and output cubes
           iPortal.SetPosition(iss, il, ib);
-          InputCubes[0]->read(iPortal);
+          inCube->read(iPortal);
 
-          oPortal.SetPosition(m_oss, ol, ob);
+          oPortal.SetPosition(oss, ol, ob);
           OutputCubes[0]->read(oPortal);
 
-          if (m_trackingEnabled) {
-            trackingPortal.SetPosition(m_oss, ol, 1);
-            m_trackingCube->read(trackingPortal);
+          if (trackingEnabled) {
+            trackingPortal.SetPosition(oss, ol, 1);
+            trackingCube->read(trackingPortal);
           }
           else if (m_imageOverlay == AverageImageWithMosaic) {
-            countPortal.SetPosition(m_oss, ol, (ob+m_onb));
+            countPortal.SetPosition(oss, ol, (ob+onb));
             OutputCubes[0]->read(countPortal);
           }
 
+          // The comparison bands do not change while this line is being processed, so
+          // read them once per line rather than once per pixel
+          if (!createOutputMosaic && trackingEnabled &&
+              m_imageOverlay == UseBandPlacementCriteria) {
+            iComparePortal.SetPosition(iss, il, bandPriorityInputBandNumber);
+            inCube->read(iComparePortal);
+            oComparePortal.SetPosition(oss, ol, bandPriorityOutputBandNumber);
+            OutputCubes[0]->read(oComparePortal);
+          }
+
           bool bChanged = false;
           // Move the input data to the output
           for (int pixel = 0; pixel < oPortal.size(); pixel++) {
             // Creating Mosaic, copy the input onto mosaic
             // regardless of the priority
-            if (m_createOutputMosaic) {
+            if (createOutputMosaic) {
               oPortal[pixel] = iPortal[pixel];
-              if (m_trackingEnabled) {
+              if (trackingEnabled) {
                 trackingPortal[pixel] = iIndex;
                 bChanged = true;
               }
@@ -439,16 +552,9 @@ namespace Isis {
               }
             }
             // Band Priority
-            else if (m_trackingEnabled && m_imageOverlay == UseBandPlacementCriteria) {
+            else if (trackingEnabled && m_imageOverlay == UseBandPlacementCriteria) {
               int iPixelOrigin = qRound(trackingPortal[pixel]);
 
-              Portal iComparePortal( ins, 1, InputCubes[0]->pixelType() );
-              Portal oComparePortal( ins, 1, OutputCubes[0]->pixelType() );
-              iComparePortal.SetPosition(iss, il, bandPriorityInputBandNumber);
-              InputCubes[0]->read(iComparePortal);
-              oComparePortal.SetPosition(m_oss, ol, bandPriorityOutputBandNumber);
-              OutputCubes[0]->read(oComparePortal);
-
               if (iPixelOrigin == iIndex) {
                 if ( ( IsValidPixel(iComparePortal[pixel]) &&
                        IsValidPixel(oComparePortal[pixel]) ) &&
@@ -484,7 +590,7 @@ namespace Isis {
                  (m_placeLowSatPixels  && IsLowPixel(iPortal[pixel]))  ||
                  (m_placeNullPixels    && IsNullPixel(iPortal[pixel]))) {
                 oPortal[pixel] = iPortal[pixel];
-                if (m_trackingEnabled) {
+                if (trackingEnabled) {
                   trackingPortal[pixel] = iIndex;
                   bChanged = true;
                 }
@@ -500,7 +606,7 @@ namespace Isis {
                 oPortal[pixel] = iPortal[pixel];
                 // Set the origin if number of input bands equal to 1
                 // and if the track flag was set
-                if (m_trackingEnabled) {
+                if (trackingEnabled) {
                   trackingPortal[pixel] = iIndex;
                   bChanged = true;
                 }
@@ -508,35 +614,253 @@ namespace Isis {
             }
           } // End sample loop
           if (bChanged) {
-            if (m_trackingEnabled) {
-              m_trackingCube->write(trackingPortal);
+            if (trackingEnabled) {
+              trackingCube->write(trackingPortal);
             }
             if (m_imageOverlay == AverageImageWithMosaic) {
               OutputCubes[0]->write(countPortal);
             }
           }
           OutputCubes[0]->write(oPortal);
-          p_progress->CheckStatus();
+          if (reportProgress) {
+            p_progress->CheckStatus();
+          }
         } // End line loop
       }   // End band loop
     }
+  }
+
+
+  /**
+   * Places one tile of the mosaic for QtConcurrent. A tile is a range of whole mosaic
+   * lines. All placements that intersect the tile are placed in list order.
+   *
+   * @internal
+   */
+  class ProcessMosaic::PlaceTileFunctor : public std::unary_function<const int &, void> {
+    public:
+      PlaceTileFunctor(const ProcessMosaic *process, const QList<Placement> *placements,
+                       Cube *trackingCube, int tileLines, int mosaicLines,
+                       QList<IException> *errors, QMutex *errorMutex) :
+          m_process(process), m_placements(placements), m_trackingCube(trackingCube),
+          m_tileLines(tileLines), m_mosaicLines(mosaicLines), m_errors(errors),
+          m_errorMutex(errorMutex) {
+      }
+
+
+      void operator()(const int &tile) const {
+        int firstLine = tile * m_tileLines + 1;
+        int lastLine = min(firstLine + m_tileLines - 1, m_mosaicLines);
+
+        Cube *inCube = NULL;
+        QString inFile;
+        try {
+          for (int i = 0; i < m_placements->size(); i++) {
+            const Placement &placement = m_placements->at(i);
+            if (placement.osl > lastLine || placement.osl + placement.inl - 1 < firstLine) {
+              continue;
+            }
+
+            // Wrapped placements of the same input are consecutive, keep the cube open for them
+            if (inCube && inFile != placement.inputFile) {
+              delete inCube;
+              inCube = NULL;
+            }
+
+            if (!inCube) {
+              inCube = new Cube;
+              CubeAttributeInput att(placement.inputFile);
+              if (att.bands().size() != 0) {
+                vector<QString> bands = att.bands();
+                inCube->setVirtualBands(bands);
+              }
+              inCube->open(placement.inputFile);
+              inFile = placement.inputFile;
+            }
+
+            m_process->PlaceImage(inCube, m_trackingCube, placement, firstLine, lastLine, false);
+          }
+        }
+        catch (IException &e) {
+          QMutexLocker locker(m_errorMutex);
+          m_errors->append(e);
+        }
+
+        delete inCube;
+      }
+
+    private:
+      const ProcessMosaic *m_process;          //!< The process doing the placing
+      const QList<Placement> *m_placements;    //!< Ordered placements of all inputs
+      Cube *m_trackingCube;                    //!< Open tracking cube or NULL
+      int m_tileLines;                         //!< Number of mosaic lines in a tile
+      int m_mosaicLines;                       //!< Number of lines in the mosaic
+      QList<IException> *m_errors;             //!< Errors from all tiles
+      QMutex *m_errorMutex;                    //!< Protects m_errors
+  };
+
+
+  /**
+   * Places an ordered list of inputs into the mosaic. All label and tracking table work must
+   * already be done by PreparePlacement(), in the same order. The mosaic is split into tiles
+   * of whole lines (see SetTileLines()) which are processed concurrently in the global thread
+   * pool. Input cubes are opened by each tile that needs them, so only a few inputs are open
+   * at any one time.
+   *
+   * Priorities, special pixel flags, count bands and the tracking cube give the same results as
+   * placing the inputs one at a time with StartProcess().
+   *
+   * @param placements The placements in mosaic order
+   *
+   * @throws IException::Message
+   */
+  void ProcessMosaic::PlaceImages(const QList<Placement> &placements) {
+    if (OutputCubes.size() != 1) {
+      QString m = "You must specify exactly one output cube";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    if (placements.isEmpty()) {
+      return;
+    }
+
+    bool tracking = false;
+    for (int i = 0; i < placements.size(); i++) {
+      tracking = tracking || placements[i].trackingEnabled;
+    }
+
+    // PreparePlacement() leaves the tracking cube open, otherwise reopen it from the mosaic label
+    if (tracking && !m_trackingCube) {
+      m_trackingCube = OpenTrackingCube();
+    }
+    Cube *trackingCube = m_trackingCube;
+
+    int mosaicLines = OutputCubes[0]->lineCount();
+    int threads = QThreadPool::globalInstance()->maxThreadCount();
+    int tileLines = m_tileLines;
+    if (tileLines < 1) {
+      // Several tiles per thread for load balancing, in multiples of 128 lines to match
+      // the default cube tile size
+      tileLines = (int)ceil((double)mosaicLines / (4.0 * max(threads, 1)));
+      tileLines = max(128, ((tileLines + 127) / 128) * 128);
+    }
+    int tiles = (mosaicLines + tileLines - 1) / tileLines;
+
+    QList<int> tileIndices;
+    for (int tile = 0; tile < tiles; tile++) {
+      tileIndices.append(tile);
+    }
+
+    p_progress->SetMaximumSteps(tiles);
+    p_progress->CheckStatus();
+
+    QList<IException> errors;
+    QMutex errorMutex;
+    PlaceTileFunctor functor(this, &placements, trackingCube, tileLines, mosaicLines,
+                             &errors, &errorMutex);
+
+    if (threads > 1) {
+      QFuture<void> future = QtConcurrent::map(tileIndices, functor);
+
+      int reportedProgress = 0;
+      QMutex sleeper;
+      sleeper.lock();
+      while (!future.isFinished()) {
+        sleeper.tryLock(100);
+        while (reportedProgress < future.progressValue()) {
+          p_progress->CheckStatus();
+          reportedProgress++;
+        }
+      }
+      while (reportedProgress < future.progressValue()) {
+        p_progress->CheckStatus();
+        reportedProgress++;
+      }
+      sleeper.unlock();
+    }
+    else {
+      for (int tile = 0; tile < tiles; tile++) {
+        functor(tile);
+        p_progress->CheckStatus();
+      }
+    }
+
+    CloseTrackingCube();
+
+    if (!errors.isEmpty()) {
+      throw errors.first();
+    }
+  }
+
+
+  /**
+   * Opens the tracking cube named in the Tracking group of the mosaic for read/write.
+   *
+   * @return Cube* The open tracking cube. The caller takes ownership.
+   *
+   * @throws IException::Message
+   */
+  Cube *ProcessMosaic::OpenTrackingCube() const {
+    if (!OutputCubes[0]->hasGroup("Tracking")) {
+      QString msg = "The mosaic [" + OutputCubes[0]->fileName() + "] does not have a "
+                    "tracking cube";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    QString trackingPath = FileName(OutputCubes[0]->fileName()).path();
+    QString trackingFile = OutputCubes[0]->group("Tracking").findKeyword("FileName")[0];
+
+    Cube *trackingCube = new Cube;
+    try {
+      trackingCube->open(trackingPath + "/" + trackingFile, "rw");
+    }
+    catch (IException &) {
+      delete trackingCube;
+      throw;
+    }
+    return trackingCube;
+  }
+
+
+  /**
+   * Closes the tracking cube, if it is open, and releases its tracking table.
+   */
+  void ProcessMosaic::CloseTrackingCube() {
     if (m_trackingCube) {
       m_trackingCube->close();
       delete m_trackingCube;
       m_trackingCube = NULL;
     }
-  } // End StartProcess
+
+    delete m_trackingTable;
+    m_trackingTable = NULL;
+  }
+
+
+  /**
+   * Set the number of mosaic lines in each tile processed by PlaceImages(). A value less
+   * than one chooses a size from the mosaic size and the number of threads.
+   *
+   * @param tileLines Number of mosaic lines per tile
+   */
+  void ProcessMosaic::SetTileLines(int tileLines) {
+    m_tileLines = tileLines;
+  }
+
+
+  /**
+   * @see SetTileLines()
+   */
+  int ProcessMosaic::GetTileLines() const {
+    return m_tileLines;
+  }
 
 
   /**
    * Cleans up by closing input, output and tracking cubes
    */
   void ProcessMosaic::EndProcess() {
-    if (m_trackingCube) {
-      m_trackingCube->close();
-      delete m_trackingCube;
-      m_trackingCube = NULL;
-    }
+    CloseTrackingCube();
     Process::EndProcess();
   }
 
@@ -1045,7 +1369,7 @@ namespace Isis {
    * @return bool
    */
   bool ProcessMosaic::ProcessAveragePriority(int piPixel, Portal& piPortal, Portal& poPortal,
-                                             Portal& countPortal)
+                                             Portal& countPortal) const
   {
     bool bChanged=false;
     if (IsValidPixel(piPortal[piPixel]) && IsValidPixel(poPortal[piPixel])) {
@@ -1335,34 +1659,40 @@ namespace Isis {
    * input pixel is assigned to the output if the origin pixel equals the current
    * input file index
    *
+   * @param inCube - The input cube
+   * @param trackingCube - The open tracking cube
    * @param iss - Comparison start sample
    * @param isl - Comparison start line
    * @param ins - The number of samples to compare
    * @param inl - The number of lines to compare
+   * @param oss - The mosaic sample of the input start sample
+   * @param osl - The mosaic line of the input start line
    * @param bandPriorityInputBandNumber - The band in the input cube to use for comparison
    * @param bandPriorityOutputBandNumber - The band in the output cube to use for comparison
    * @param index - Tracking index for the input cube
    *
    * @author Sharmila Prasad (9/04/2009)
    */
-  void ProcessMosaic::BandComparison(int iss, int isl, int ins, int inl,
-      int bandPriorityInputBandNumber, int bandPriorityOutputBandNumber, int index) {
+  void ProcessMosaic::BandComparison(Cube *inCube, Cube *trackingCube,
+                                     int iss, int isl, int ins, int inl, int oss, int osl,
+                                     int bandPriorityInputBandNumber,
+                                     int bandPriorityOutputBandNumber, int index) const {
     //
     // Create portal buffers for the input and output files
-    Portal cIportal(ins, 1, InputCubes[0]->pixelType());
+    Portal cIportal(ins, 1, inCube->pixelType());
     Portal cOportal(ins, 1, OutputCubes[0]->pixelType());
     Portal trackingPortal(ins, 1, PixelType::UnsignedInteger);
 
-    for (int iIL = isl, iOL = m_osl; iIL < isl + inl; iIL++, iOL++) {
+    for (int iIL = isl, iOL = osl; iIL < isl + inl; iIL++, iOL++) {
       // Set the position of the portals in the input and output cubes
       cIportal.SetPosition(iss, iIL, bandPriorityInputBandNumber);
-      InputCubes[0]->read(cIportal);
+      inCube->read(cIportal);
 
-      cOportal.SetPosition(m_oss, iOL, bandPriorityOutputBandNumber);
+      cOportal.SetPosition(oss, iOL, bandPriorityOutputBandNumber);
       OutputCubes[0]->read(cOportal);
 
-      trackingPortal.SetPosition(m_oss, iOL, 1);
-      m_trackingCube->read(trackingPortal);
+      trackingPortal.SetPosition(oss, iOL, 1);
+      trackingCube->read(trackingPortal);
 
       // Move the input data to the output
       for (int iPixel = 0; iPixel < cOportal.size(); iPixel++) {
@@ -1381,7 +1711,7 @@ namespace Isis {
           }
         }
       }
-      m_trackingCube->write(trackingPortal);
+      trackingCube->write(trackingPortal);
     }
   }
 
@@ -1389,39 +1719,51 @@ namespace Isis {
   /**
    * Mosaicking for Band Priority with no Tracking
    *
+   * @param inCube - The input cube
+   * @param iss, isl, isb - Input start sample, line and band
+   * @param ins, inl, inb - Number of input samples, lines and bands to place
+   * @param oss, osl, osb - Mosaic sample, line and band of the input start
+   * @param onb - Number of bands in the mosaic
+   * @param createOutputMosaic - True if the mosaic is being created by this input
+   * @param bandPriorityInputBandNumber - The band in the input cube to use for comparison
+   * @param bandPriorityOutputBandNumber - The band in the output cube to use for comparison
+   *
    * @author Sharmila Prasad (1/4/2012)
    */
-void ProcessMosaic::BandPriorityWithNoTracking(int iss, int isl, int isb, int ins, int inl,
-                                                 int inb, int bandPriorityInputBandNumber,
-                                                 int bandPriorityOutputBandNumber) {
+void ProcessMosaic::BandPriorityWithNoTracking(Cube *inCube, int iss, int isl, int isb,
+                                                 int ins, int inl, int inb,
+                                                 int oss, int osl, int osb, int onb,
+                                                 bool createOutputMosaic,
+                                                 int bandPriorityInputBandNumber,
+                                                 int bandPriorityOutputBandNumber) const {
     /*
      * specified band for comparison
      * Create portal buffers for the input and output files pointing to the
      */
-    Portal iComparePortal( ins, 1, InputCubes[0]->pixelType() );
+    Portal iComparePortal( ins, 1, inCube->pixelType() );
     Portal oComparePortal( ins, 1, OutputCubes[0]->pixelType() );
     Portal resultsPortal ( ins, 1, OutputCubes[0]->pixelType() );
 
     // Create portal buffers for the input and output files
-    Portal iPortal( ins, 1, InputCubes[0]->pixelType() );
+    Portal iPortal( ins, 1, inCube->pixelType() );
     Portal oPortal( ins, 1, OutputCubes[0]->pixelType() );
 
-    for (int inLine = isl, outLine = m_osl; inLine < isl + inl; inLine++, outLine++) {
+    for (int inLine = isl, outLine = osl; inLine < isl + inl; inLine++, outLine++) {
 //       Set the position of the portals in the input and output cubes
       iComparePortal.SetPosition(iss, inLine, bandPriorityInputBandNumber);
-      InputCubes[0]->read(iComparePortal);
+      inCube->read(iComparePortal);
 
-      oComparePortal.SetPosition(m_oss, outLine, bandPriorityOutputBandNumber);
+      oComparePortal.SetPosition(oss, outLine, bandPriorityOutputBandNumber);
       OutputCubes[0]->read(oComparePortal);
 
-      Portal iPortal( ins, 1, InputCubes[0]->pixelType() );
+      Portal iPortal( ins, 1, inCube->pixelType() );
       Portal oPortal( ins, 1, OutputCubes[0]->pixelType() );
 
       bool inCopy = false;
 //       Move the input data to the output
       for (int iPixel = 0; iPixel < ins; iPixel++) {
         resultsPortal[iPixel] = false;
-        if (m_createOutputMosaic) {
+        if (createOutputMosaic) {
           resultsPortal[iPixel] = true;
           inCopy = true;
         }
@@ -1440,17 +1782,17 @@ void ProcessMosaic::BandPriorityWithNoTracking(int iss, int isl, int isb, int in
         }
       }
       if (inCopy) {
-        for (int ib = isb, ob = m_osb; ib < (isb + inb) && ob <= m_onb; ib++, ob++) {
+        for (int ib = isb, ob = osb; ib < (isb + inb) && ob <= onb; ib++, ob++) {
 //           Set the position of the portals in the input and output cubes
           iPortal.SetPosition(iss, inLine, ib);
-          InputCubes[0]->read(iPortal);
+          inCube->read(iPortal);
 
-          oPortal.SetPosition(m_oss, outLine, ob);
+          oPortal.SetPosition(oss, outLine, ob);
           OutputCubes[0]->read(oPortal);
 
           for (int iPixel = 0; iPixel < ins; iPixel++) {
             if (resultsPortal[iPixel]) {
-              if (m_createOutputMosaic) {
+              if (createOutputMosaic) {
                 oPortal[iPixel] = iPortal[iPixel];
               }
               else if ( IsValidPixel(iPortal[iPixel]) ||
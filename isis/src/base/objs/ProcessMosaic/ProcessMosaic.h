@@ -22,10 +22,14 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <QList>
+#include <QString>
+
 #include "Process.h"
 
 namespace Isis {
   class Portal;
+  class TrackingTable;
 
   /**
    * @brief Mosaic two cubes together
@@ -205,6 +209,17 @@ namespace Isis {
    *   @history 2018-08-13 Summer Stapleton - Error now being thrown with appropriate message if 
    *                           user attempts to add tracking capabilities to a mosaic that already
    *                           exists without tracking. Fixes #2052.
+   *   @history 2026-10-19 ISIS Development Team - The tracking table is now kept with the
+   *                           open tracking cube and updated for every input, so inputs after
+   *                           the first of a multi-input mosaic get their own tracking index.
+ 
+   *
+   * Placing an input is split into PreparePlacement(), which does all of the label and
+   * tracking table work, and PlaceImage(), which moves the pixels for a range of mosaic
+   * lines. PlaceImages() uses this to place an ordered list of inputs by dividing the mosaic
+   * into tiles of whole lines and processing the tiles concurrently. Each tile places the
+   * inputs that intersect it in list order, so the result is identical to placing the inputs
+   * one at a time with StartProcess().
    */
 
   class ProcessMosaic : public Process {
@@ -296,19 +311,58 @@ namespace Isis {
       static QString OverlayToString(ImageOverlay);
       static ImageOverlay StringToOverlay(QString);
 
+      void SetTileLines(int tileLines);
+      int GetTileLines() const;
+
+    protected:
+      /**
+       * Where and how one input cube is placed in the mosaic. This is created by
+       * PreparePlacement() for the current input cube and holds everything needed to move
+       * its pixels after the input has been closed.
+       */
+      struct Placement {
+        QString inputFile; //!< The input cube file name, including attributes
+        int iss; //!< The starting sample within the input cube
+        int isl; //!< The starting line within the input cube
+        int isb; //!< The starting band within the input cube
+        int ins; //!< The number of samples from the input cube
+        int inl; //!< The number of lines from the input cube
+        int inb; //!< The number of bands from the input cube
+        int oss; //!< The starting sample within the output cube
+        int osl; //!< The starting line within the output cube
+        int osb; //!< The starting band within the output cube
+        int onb; //!< The number of (non-count) bands in the output cube
+        int trackingIndex; //!< Tracking cube value of the input
+        int bandPriorityInputBandNumber;  //!< Input comparison band for band priority
+        int bandPriorityOutputBandNumber; //!< Mosaic comparison band for band priority
+        bool createOutputMosaic; //!< The input creates the mosaic
+        bool trackingEnabled;    //!< Tracking is enabled for the input
+      };
+
+      Placement PreparePlacement(const int &os, const int &ol, const int &ob);
+
+      void PlaceImage(Cube *inCube, Cube *trackingCube, const Placement &placement,
+                      int firstOutLine, int lastOutLine, bool reportProgress) const;
+
+      void PlaceImages(const QList<Placement> &placements);
+
     private:
+      class PlaceTileFunctor;
 
       //Compare the input and mosaic for the specified band based on the criteria and update the
       //  mosaic origin band.
-      void BandComparison(int iss, int isl, int ins, int inl,
+      void BandComparison(Cube *inCube, Cube *trackingCube,
+                          int iss, int isl, int ins, int inl, int oss, int osl,
                           int bandPriorityInputBandNumber, int bandPriorityOutputBandNumber,
-                          int index);
+                          int index) const;
 
       // Mosaicking for Band Priority with no Tracking
-      void BandPriorityWithNoTracking(int iss, int isl, int isb,
+      void BandPriorityWithNoTracking(Cube *inCube, int iss, int isl, int isb,
                                       int ins, int inl, int inb,
+                                      int oss, int osl, int osb, int onb,
+                                      bool createOutputMosaic,
                                       int bandPriorityInputBandNumber,
-                                      int bandPriorityOutputBandNumber);
+                                      int bandPriorityOutputBandNumber) const;
 
       // Get the default origin value based on pixel type for the origin band
       int GetOriginDefaultByPixelType();
@@ -329,7 +383,11 @@ namespace Isis {
       void MatchBandBinGroup(int origIsb, int &inb);
 
       bool ProcessAveragePriority(int piPixel, Portal& pInPortal, Portal& pOutPortal,
-                                  Portal& pOrigPortal);
+                                  Portal& pOrigPortal) const;
+
+      // Open the tracking cube of an existing mosaic for placing tiles
+      Cube *OpenTrackingCube() const;
+      void CloseTrackingCube();
 
       void ResetCountBands();
 
@@ -338,6 +396,7 @@ namespace Isis {
 
       bool m_trackingEnabled;         //!<
       Cube *m_trackingCube;           //!< Output tracking cube. NULL unless tracking is enabled.
+      TrackingTable *m_trackingTable; //!< Tracking table of m_trackingCube, NULL when it is closed
       bool m_createOutputMosaic;      //!<
       int  m_bandPriorityBandNumber;  //!<
       QString m_bandPriorityKeyName;  //!<
@@ -375,6 +434,8 @@ namespace Isis {
       bool m_placeHighSatPixels; //!<
       bool m_placeLowSatPixels;  //!<
       bool m_placeNullPixels;    //!<
+
+      int m_tileLines; //!< Mosaic lines per tile in PlaceImages(), 0 to choose automatically
   };
 };
 
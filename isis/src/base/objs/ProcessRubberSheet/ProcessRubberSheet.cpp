@@ -20,6 +20,7 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -310,22 +311,75 @@ namespace Isis {
     }
 
     // Apply the map to the output tile
-    int outputBand = otile.Band();
+    iportal.SetPosition(1, 1, otile.Band());
+    vector<int> pixels;
+    vector<double> samples;
+    vector<double> lines;
     for (int i = 0, line = 0; line < p_startQuadSize; line++) {
       for (int samp = 0; samp < p_startQuadSize; samp++, i++) {
         double inputLine = p_lineMap[line][samp];
         double inputSamp = p_sampMap[line][samp];
         if (inputLine != NULL8) {
-          iportal.SetPosition(inputSamp, inputLine, outputBand);
-          InputCubes[0]->read(iportal);
-          otile[i] = interp.Interpolate(inputSamp, inputLine,
-                                        iportal.DoubleBuffer());
+          pixels.push_back(i);
+          samples.push_back(inputSamp);
+          lines.push_back(inputLine);
         }
         else {
           otile[i] = NULL8;
         }
       }
     }
+
+    vector<double> values;
+    InterpolatePixels(interp, iportal, samples, lines, values);
+    for (unsigned int i = 0; i < pixels.size(); i++) {
+      otile[pixels[i]] = values[i];
+    }
+  }
+
+
+  /**
+   * Interpolates the input cube at a set of positions in the band of the input
+   * portal. The input data around the positions is read as one tile and
+   * interpolated with the batch Interpolate. Positions spread thinly over the
+   * cube are read a portal at a time instead.
+   *
+   * @param interp The interpolator
+   * @param iportal A portal of the interpolator's size positioned in the band
+   *                to interpolate
+   * @param samples The input samples to interpolate at
+   * @param lines The input lines to interpolate at
+   * @param values Returns the interpolated value at each position
+   */
+  void ProcessRubberSheet::InterpolatePixels(Interpolator &interp, Portal &iportal,
+                                             const std::vector<double> &samples,
+                                             const std::vector<double> &lines,
+                                             std::vector<double> &values) {
+    int count = (int) samples.size();
+    values.resize(count);
+    if (count == 0) {
+      return;
+    }
+
+    int startSample, startLine, tileSamples, tileLines;
+    interp.TileExtent(&samples[0], &lines[0], count, startSample, startLine,
+                      tileSamples, tileLines);
+    int band = iportal.Band();
+
+    if ((double) tileSamples * tileLines > 4.0 * std::max(count, 1024)) {
+      for (int i = 0; i < count; i++) {
+        iportal.SetPosition(samples[i], lines[i], band);
+        InputCubes[0]->read(iportal);
+        values[i] = interp.Interpolate(samples[i], lines[i], iportal.DoubleBuffer());
+      }
+    }
+    else {
+      Brick tile(tileSamples, tileLines, 1, InputCubes[0]->pixelType());
+      tile.SetBasePosition(startSample, startLine, band);
+      InputCubes[0]->read(tile);
+      interp.Interpolate(&samples[0], &lines[0], count, tile.DoubleBuffer(),
+                         tileSamples, tileLines, startSample, startLine, &values[0]);
+    }
   }
 
 
@@ -1069,8 +1123,8 @@ namespace Isis {
     Brick oBrick(*OutputCubes[0], osampMax-osampMin+1, olineMax-olineMin+1, 1);
     oBrick.SetBasePosition(osampMin, olineMin, iportal.Band());
 
-    int brickIndex = 0;
-    bool foundNull = false;
+    vector<double> samples;
+    vector<double> lines;
     for (int oline = olineMin; oline <= olineMax; oline++) {
       double isamp = A * osampMin + B * oline + C;
       double iline = D * osampMin + E * oline + F;
@@ -1078,16 +1132,22 @@ namespace Isis {
       double ilineChangeWRTosamp = D;
       for (int osamp = osampMin; osamp <= osampMax;
             osamp++, isamp += isampChangeWRTosamp, iline += ilineChangeWRTosamp) {
-        // Now read the data around the input coordinate and interpolate a DN
-        iportal.SetPosition(isamp, iline, iportal.Band());
-        InputCubes[0]->read(iportal);
-        double dn = interp.Interpolate(isamp, iline, iportal.DoubleBuffer());
-        oBrick[brickIndex] = dn;
-        if (dn == Null) foundNull = true;
-        brickIndex++;
+        samples.push_back(isamp);
+        lines.push_back(iline);
       }
     }
 
+    // Now read the data around the input coordinates and interpolate the DNs
+    vector<double> values;
+    InterpolatePixels(interp, iportal, samples, lines, values);
+
+    int brickIndex;
+    bool foundNull = false;
+    for (brickIndex = 0; brickIndex < (int) values.size(); brickIndex++) {
+      oBrick[brickIndex] = values[brickIndex];
+      if (values[brickIndex] == Null) foundNull = true;
+    }
+
     // If there are any special pixel Null values in this output brick, we may be
     // up against an edge of the input image where the interpolaters get Nulls from 
     // outside the image. Since the patches have some overlap due to finding the 
@@ -113,6 +113,10 @@ namespace Isis {
    *                                            References #2215.
    *   @history 2017-06-09 Christopher Combs - Changed loop counter int in
                                StartProcess to long long int. References #4611.
+   *   @history 2026-10-19 ISIS Development Team - QuadTree and transformPatch
+   *                           read one tile of input data around their pixels
+   *                           and interpolate it with the batch Interpolate
+   *                           instead of reading a portal for every pixel.
    *
    *   @todo 2005-02-11 Stuart Sides - finish documentation and add coded and
    *                        implementation example to class documentation
@@ -196,6 +200,11 @@ namespace Isis {
       bool TestLine(Transform &trans, int ssamp, int esamp, int sline,
                     int eline, int increment);
 
+      void InterpolatePixels(Interpolator &interp, Portal &iportal,
+                             const std::vector<double> &samples,
+                             const std::vector<double> &lines,
+                             std::vector<double> &values);
+
       void (*p_bandChangeFunct)(const int band);
 
       void transformPatch (double startingSample, double endingSample,
@@ -26,18 +26,42 @@
 #include <sstream>
 #include <sys/wait.h>
 
+#include <QByteArray>
+#include <QList>
 #include <QLocalServer>
 #include <QLocalSocket>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QProcess>
+#include <QStringList>
+#include <QVector>
 
 #include "Application.h"
 #include "FileName.h"
 #include "IException.h"
 #include "IString.h"
+#include "UserInterface.h"
 
 using namespace std;
 
 namespace Isis {
+  namespace {
+    //! Guards the registered entry points
+    QMutex &isisProgramEntryMutex() {
+      static QMutex mutex;
+      return mutex;
+    }
+
+
+    //! The registered entry points by program name
+    QMap<QString, ProgramLauncher::IsisProgramEntry> &isisProgramEntries() {
+      static QMap<QString, ProgramLauncher::IsisProgramEntry> entries;
+      return entries;
+    }
+  }
+
+
   /**
    * Executes the Isis program with the given arguments. This will handle logs,
    *   GUI updates, and similar tasks. Please use this even when there is no
@@ -209,6 +233,169 @@ namespace Isis {
   }
 
 
+  /**
+   * Registers the callable entry point of an Isis program so it can be run with
+   *   RunIsisProgramInProcess(). Programs register themselves when the library
+   *   is loaded, for example:
+   *
+   * <code>
+   * static bool registered = ProgramLauncher::RegisterIsisProgram("crop", cropEntry);
+   * </code>
+   *
+   * @param programName The Isis program name (i.e. crop, stats)
+   * @param entry The function that runs the program with a UserInterface
+   *
+   * @return bool Always true
+   */
+  bool ProgramLauncher::RegisterIsisProgram(QString programName,
+                                            IsisProgramEntry entry) {
+    QMutexLocker locker(&isisProgramEntryMutex());
+    isisProgramEntries().insert(FileName(programName).name(), entry);
+    return true;
+  }
+
+
+  /**
+   * @param programName The Isis program name (i.e. crop, stats)
+   *
+   * @return bool True if the program can be run with RunIsisProgramInProcess()
+   */
+  bool ProgramLauncher::HasIsisProgramEntry(QString programName) {
+    return IsisProgramEntryFor(programName) != NULL;
+  }
+
+
+  /**
+   * Runs a registered Isis program inside of this process. The arguments are
+   *   split the same way RunIsisProgram() splits them and are given to a new
+   *   UserInterface built from the program's xml file, so the program sees the
+   *   same parameters it would see in its own process. Logs and progress go
+   *   directly to the running Application.
+   *
+   * @param programName The Isis program name to be run (i.e. crop, stats)
+   * @param parameters The arguments to give to the program that is being run
+   */
+  void ProgramLauncher::RunIsisProgramInProcess(QString programName,
+                                                QString parameters) {
+    IsisProgramEntry entry = IsisProgramEntryFor(programName);
+
+    if (!entry) {
+      QString msg = "Program [" + programName + "] can not be run inside of "
+          "this process";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    QStringList arguments = SplitArguments(parameters);
+
+    // Without arguments the user interface would start the program's gui
+    if (arguments.isEmpty()) {
+      QString msg = "Running Isis program [" + programName + "] inside of this "
+          "process requires arguments";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    FileName xmlFileName("$ISISROOT/bin/xml/" + FileName(programName).name() + ".xml");
+    if (!xmlFileName.fileExists()) {
+      QString msg = "Program [" + programName + "] does not appear to be a "
+          "valid Isis 3 program";
+      throw IException(IException::Unknown, msg, _FILEINFO_);
+    }
+
+    // The user interface keeps pointers into argv while parsing it
+    QList<QByteArray> argumentData;
+    argumentData.append(FileName(programName).name().toLatin1());
+    foreach (QString argument, arguments) {
+      argumentData.append(argument.toLatin1());
+    }
+
+    QVector<char *> argv;
+    for (int i = 0; i < argumentData.size(); i++) {
+      argv.append(argumentData[i].data());
+    }
+    argv.append(NULL);
+    int argc = argumentData.size();
+
+    try {
+      UserInterface ui(xmlFileName.expanded(), argc, argv.data());
+      ui.VerifyAll();
+      entry(ui);
+    }
+    catch (IException &e) {
+      QString msg = "Running Isis program [" + programName + "] failed";
+      throw IException(e, IException::Unknown, msg, _FILEINFO_);
+    }
+  }
+
+
+  /**
+   * @param programName The Isis program name (i.e. crop, stats)
+   *
+   * @return IsisProgramEntry The registered entry point, or NULL if the
+   *           program did not register one
+   */
+  ProgramLauncher::IsisProgramEntry ProgramLauncher::IsisProgramEntryFor(
+      QString programName) {
+    QMutexLocker locker(&isisProgramEntryMutex());
+    return isisProgramEntries().value(FileName(programName).name(), NULL);
+  }
+
+
+  /**
+   * Splits a string of arguments the way QProcess splits a command. Arguments
+   *   are separated by whitespace, double quotes group an argument with
+   *   whitespace in it and three consecutive double quotes give a literal
+   *   double quote.
+   *
+   * @param arguments The arguments formatted like what you would give to
+   *                  RunIsisProgram()
+   *
+   * @return QStringList The separated arguments, without the grouping quotes
+   */
+  QStringList ProgramLauncher::SplitArguments(QString arguments) {
+    QStringList result;
+    QString argument;
+    int quoteCount = 0;
+    bool inQuote = false;
+
+    for (int i = 0; i < arguments.size(); i++) {
+      if (arguments[i] == '"') {
+        quoteCount++;
+
+        if (quoteCount == 3) {
+          quoteCount = 0;
+          argument += arguments[i];
+        }
+
+        continue;
+      }
+
+      if (quoteCount) {
+        if (quoteCount == 1) {
+          inQuote = !inQuote;
+        }
+
+        quoteCount = 0;
+      }
+
+      if (!inQuote && arguments[i].isSpace()) {
+        if (!argument.isEmpty()) {
+          result.append(argument);
+          argument.clear();
+        }
+      }
+      else {
+        argument += arguments[i];
+      }
+    }
+
+    if (!argument.isEmpty()) {
+      result.append(argument);
+    }
+
+    return result;
+  }
+
+
   /**
    * This runs arbitrary system commands. You can run programs like "qview" with
    *   this, or commands like "ls | grep *.cpp > out.txt". Please do not use
@@ -25,15 +25,24 @@
  */
 
 class QString;
+class QStringList;
 
 namespace Isis {
   class IException;
+  class UserInterface;
 
   /**
    * @brief Execute External Programs and Commands
    *
    * This class is designed to handle running any other programs or commands.
    *
+   * Isis programs that have a callable entry point, taking the UserInterface
+   * to read their parameters from, can register it with RegisterIsisProgram().
+   * Registered programs can be run inside of the calling process with
+   * RunIsisProgramInProcess(), which avoids starting a new process and lets
+   * the program share memory, such as the intermediate cubes of a Pipeline,
+   * with the caller.
+   *
    * @author 2010-12-03 Steven Lambright
    *
    * @internal
@@ -49,11 +58,20 @@ namespace Isis {
    */
   class ProgramLauncher {
     public:
+      //! The callable entry point of an Isis program
+      typedef void (*IsisProgramEntry)(UserInterface &ui);
+
       static void RunIsisProgram(QString isisProgramName, QString arguments);
       static void RunSystemCommand(QString commandLine);
 
+      static bool RegisterIsisProgram(QString isisProgramName, IsisProgramEntry entry);
+      static bool HasIsisProgramEntry(QString isisProgramName);
+      static void RunIsisProgramInProcess(QString isisProgramName, QString arguments);
+
     private:
       static IException ProcessIsisMessageFromChild(QString code, QString msg);
+      static IsisProgramEntry IsisProgramEntryFor(QString isisProgramName);
+      static QStringList SplitArguments(QString arguments);
 
     private:
       //! Construction is not allowed
@@ -26,9 +26,12 @@
 #include <locale>
 #include <fstream>
 
+#include <QFile>
+
 #include "FileName.h"
 #include "IException.h"
 #include "Message.h"
+#include "PvlParser.h"
 #include "PvlTokenizer.h"
 #include "PvlFormat.h"
 
@@ -78,6 +81,32 @@ namespace Isis {
     Isis::FileName temp(file);
     m_filename = temp.expanded();
 
+    // Parse the mapped file in place. Only the label is touched, so this is
+    // cheap for cubes with attached labels. Anything the PvlParser does not
+    // handle, including errors, is read with the stream operator below.
+    if (keywords() == 0 && groups() == 0 && objects() == 0) {
+      QFile mappedFile(m_filename);
+      if (mappedFile.open(QIODevice::ReadOnly)) {
+        qint64 size = mappedFile.size();
+        uchar *data = (size > 0) ? mappedFile.map(0, size) : NULL;
+
+        if (data || size == 0) {
+          PvlParser parser((const char *) data, size);
+          bool parsed = parser.parse(*this);
+
+          if (data) {
+            mappedFile.unmap(data);
+          }
+
+          if (parsed) {
+            return;
+          }
+
+          clear();
+        }
+      }
+    }
+
     // Open the file
     ifstream istm;
     istm.open(m_filename.toLatin1().data(), std::ios::in);
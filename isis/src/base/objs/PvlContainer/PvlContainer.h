@@ -294,6 +294,8 @@ namespace Isis {
       const PvlContainer &operator=(const PvlContainer &other);
 
     protected:
+      friend class PvlParser;
+
       QString m_filename;                   /**<This contains the filename
                                                     used to initialize
                                                     the pvl object. If the
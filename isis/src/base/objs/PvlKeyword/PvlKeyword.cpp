@@ -135,7 +135,14 @@ namespace Isis {
    */
   void PvlKeyword::setName(QString name) {
     QString final = name.trimmed();
-    if (final.contains(QRegExp("\\s"))) {
+
+    // Same test as QRegExp("\\s") without building a regular expression for every keyword
+    bool whiteSpace = false;
+    for (int i = 0; !whiteSpace && i < final.size(); i++) {
+      whiteSpace = final[i].isSpace();
+    }
+
+    if (whiteSpace) {
       QString msg = "[" + name + "] is invalid. Keyword name cannot ";
       msg += "contain whitespace.";
       throw IException(IException::User, msg, _FILEINFO_);
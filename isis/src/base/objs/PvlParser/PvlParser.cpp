@@ -0,0 +1,716 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "PvlParser.h"
+
+#include <cctype>
+#include <cstring>
+
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Returns true for the characters QString::trimmed() removes from ASCII text.
+   *
+   * @param c The character to test
+   *
+   * @return bool True if c is white space
+   */
+  static inline bool isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+  }
+
+
+  /**
+   * Constructs a parser for a buffer. The buffer is not copied and must exist
+   * until parse() returns.
+   *
+   * @param data The PVL text
+   * @param size The number of bytes in data
+   */
+  PvlParser::PvlParser(const char *data, qint64 size) {
+    if (!data) {
+      data = "";
+      size = 0;
+    }
+
+    m_pos = data;
+    m_end = data + size;
+    m_good = true;
+  }
+
+
+  //! Destroys the parser
+  PvlParser::~PvlParser() {
+  }
+
+
+  /**
+   * Parses the buffer into pvl, adding to anything already in it. Reading stops at the
+   * End keyword, at binary data following a top level keyword or at the end of the
+   * buffer, as it does for the stream operator.
+   *
+   * @param pvl The Pvl to add to
+   *
+   * @return bool False if the stream operator must be used instead. pvl may have
+   *              been partially filled in and should be cleared.
+   */
+  bool PvlParser::parse(Pvl &pvl) {
+    try {
+      if (!readKeyword()) {
+        return false;
+      }
+
+      while (!nameIs("END")) {
+        if (nameIs("ENDGROUP") || nameIs("ENDOBJECT")) {
+          return false;
+        }
+
+        if (nameIs("GROUP")) {
+          pvl.addGroup(PvlGroup());
+          if (!readGroup(pvl.group(pvl.groups() - 1))) {
+            return false;
+          }
+        }
+        else if (nameIs("OBJECT")) {
+          pvl.addObject(PvlObject());
+          PvlObject &object = pvl.object(pvl.objects() - 1);
+
+          // Objects only take their parent's file name once they are complete
+          static_cast<PvlContainer &>(object).setFileName("");
+          if (!readObject(object)) {
+            return false;
+          }
+          static_cast<PvlContainer &>(object).setFileName(pvl.fileName());
+        }
+        else {
+          pvl.addKeyword(PvlKeyword());
+          setKeyword(pvl[pvl.keywords() - 1]);
+        }
+
+        // non-whitespace non-ascii says we're done
+        if (m_good && ((unsigned char)*m_pos < 32 || (unsigned char)*m_pos > 126)) {
+          break;
+        }
+
+        if (!m_good) {
+          break;
+        }
+
+        if (!readKeyword()) {
+          return false;
+        }
+      }
+    }
+    catch (IException &) {
+      return false;
+    }
+
+    return true;
+  }
+
+
+  /**
+   * Reads an object whose Object keyword has just been read.
+   *
+   * @param object The object to fill in
+   *
+   * @return bool False if the stream operator must be used instead
+   */
+  bool PvlParser::readObject(PvlObject &object) {
+    if (m_values.size() != 1) {
+      return false;
+    }
+
+    object.setName(m_values[0].value.toString());
+    for (int i = 0; i < m_comments.size(); i++) {
+      object.addComment(m_comments[i].toString());
+    }
+    if (!m_trailingComment.isEmpty()) {
+      object.addComment(m_trailingComment.toString());
+    }
+
+    if (!readKeyword()) {
+      return false;
+    }
+
+    while (!nameIs("ENDOBJECT")) {
+      if (nameIs("ENDGROUP")) {
+        return false;
+      }
+
+      if (nameIs("GROUP")) {
+        object.addGroup(PvlGroup());
+        if (!readGroup(object.group(object.groups() - 1))) {
+          return false;
+        }
+      }
+      else if (nameIs("OBJECT")) {
+        object.addObject(PvlObject());
+        PvlObject &child = object.object(object.objects() - 1);
+
+        static_cast<PvlContainer &>(child).setFileName("");
+        if (!readObject(child)) {
+          return false;
+        }
+        static_cast<PvlContainer &>(child).setFileName(object.fileName());
+      }
+      else {
+        object.addKeyword(PvlKeyword());
+        setKeyword(object[object.keywords() - 1]);
+      }
+
+      if (!m_good) {
+        return false;
+      }
+
+      if (!readKeyword()) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+
+  /**
+   * Reads a group whose Group keyword has just been read.
+   *
+   * @param group The group to fill in
+   *
+   * @return bool False if the stream operator must be used instead
+   */
+  bool PvlParser::readGroup(PvlGroup &group) {
+    if (m_values.size() != 1) {
+      return false;
+    }
+
+    group.setName(m_values[0].value.toString());
+    for (int i = 0; i < m_comments.size(); i++) {
+      group.addComment(m_comments[i].toString());
+    }
+    if (!m_trailingComment.isEmpty()) {
+      group.addComment(m_trailingComment.toString());
+    }
+
+    if (!readKeyword()) {
+      return false;
+    }
+
+    while (m_good && !nameIs("ENDGROUP")) {
+      if (nameIs("GROUP") || nameIs("OBJECT") || nameIs("ENDOBJECT")) {
+        return false;
+      }
+
+      group.addKeyword(PvlKeyword());
+      setKeyword(group[group.keywords() - 1]);
+
+      if (!readKeyword()) {
+        return false;
+      }
+    }
+
+    return nameIs("ENDGROUP");
+  }
+
+
+  /**
+   * Reads the next keyword, including the comment lines before it, into m_name,
+   * m_comments, m_trailingComment and m_values. Lines are joined the same way the
+   * PvlKeyword stream operator joins them: a trailing '-' concatenates the next line,
+   * otherwise an incomplete keyword continues after a space.
+   *
+   * @return bool False if the stream operator must be used instead
+   */
+  bool PvlParser::readKeyword() {
+    static const char endKeyword[] = "End";
+
+    m_name = View();
+    m_comments.clear();
+    m_trailingComment = View();
+    m_values.clear();
+
+    if (!m_good) {
+      return false;
+    }
+
+    View keyword;
+    bool joined = false;
+
+    while (true) {
+      View line;
+      if (!readLine(line)) {
+        return false;
+      }
+
+      // Running out of data between keywords is an implicit End
+      if (line.isEmpty() && !m_good) {
+        if (!keyword.isEmpty()) {
+          return false;
+        }
+        line = View(endKeyword, endKeyword + 3);
+      }
+
+      if (line[0] == '#' || (line.size() > 1 && line[0] == '/' && line[1] == '/')) {
+        if (!keyword.isEmpty()) {
+          return false;
+        }
+        m_comments.append(line);
+        continue;
+      }
+
+      if (keyword.isEmpty()) {
+        keyword = line;
+      }
+      else {
+        if (!joined) {
+          m_joined = QByteArray(keyword.m_begin, keyword.size());
+          joined = true;
+        }
+
+        if (m_joined.endsWith('-')) {
+          m_joined.chop(1);
+        }
+        else {
+          m_joined.append(' ');
+        }
+        m_joined.append(line.m_begin, line.size());
+        keyword = View(m_joined.constData(), m_joined.constData() + m_joined.size());
+      }
+
+      if (line[line.size() - 1] == '-') {
+        continue;
+      }
+
+      Status status = readCleanKeyword(keyword);
+      if (status == Unsupported) {
+        return false;
+      }
+
+      if (status == Complete) {
+        // Units may follow on the next line
+        if (m_good && *m_pos == '<' && !m_values.isEmpty()) {
+          continue;
+        }
+
+        return !m_name.hasWhiteSpace();
+      }
+
+      if (!m_good) {
+        return false;
+      }
+    }
+  }
+
+
+  /**
+   * Reads the next non-empty line, trimmed, and skips the spaces, carriage returns
+   * and newlines that follow it. An empty line is returned at the end of the data.
+   *
+   * @param line The line read
+   *
+   * @return bool False if the line holds data the stream operator treats specially:
+   *              non-ASCII or null characters, or the start of a multi-line comment
+   */
+  bool PvlParser::readLine(View &line) {
+    while (true) {
+      if (m_pos >= m_end) {
+        m_good = false;
+        line = View();
+        return true;
+      }
+
+      const char *newline = (const char *) memchr(m_pos, '\n', m_end - m_pos);
+      const char *lineEnd = newline ? newline : m_end;
+
+      for (const char *c = m_pos; c < lineEnd; c++) {
+        if (*c == '\0' || (unsigned char)*c > 127) {
+          return false;
+        }
+        if (*c == '/' && c + 1 < lineEnd && c[1] == '*') {
+          return false;
+        }
+      }
+
+      View raw(m_pos, lineEnd);
+      View trimmed = raw.trimmed();
+
+      // A last line without a newline is not trimmed by the stream operator
+      if (!newline) {
+        if (trimmed.size() != raw.size()) {
+          return false;
+        }
+
+        m_pos = m_end;
+        m_good = false;
+        line = raw;
+        return true;
+      }
+
+      m_pos = newline + 1;
+      while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\r' || *m_pos == '\n')) {
+        m_pos++;
+      }
+
+      if (m_pos >= m_end) {
+        m_good = false;
+      }
+
+      if (!trimmed.isEmpty() || !m_good) {
+        line = trimmed;
+        return true;
+      }
+    }
+  }
+
+
+  /**
+   * Parses the text of one keyword, with comment lines already removed. This follows
+   * PvlKeyword::readCleanKeyword().
+   *
+   * @param keyword Pvl "Keyword = (Value1,Value2,...) <units>"
+   *
+   * @return Status Whether the keyword is complete
+   */
+  PvlParser::Status PvlParser::readCleanKeyword(View keyword) {
+    m_name = View();
+    m_trailingComment = View();
+    m_values.clear();
+
+    bool explicitIncomplete = false;
+
+    if (keyword.isEmpty()) {
+      return Incomplete;
+    }
+
+    m_name = readValue(keyword, explicitIncomplete, false);
+
+    if (keyword.isEmpty()) {
+      return Complete;
+    }
+
+    if (keyword[0] != '=') {
+      return Unsupported;
+    }
+
+    keyword = keyword.mid(1).trimmed();
+
+    if (keyword.isEmpty()) {
+      return Incomplete;
+    }
+
+    if (keyword[0] == '(' || keyword[0] == '{') {
+      char closingParen = ((keyword[0] == '(') ? ')' : '}');
+      char wrongClosingParen = ((keyword[0] == '(') ? '}' : ')');
+      bool closedProperly = false;
+
+      keyword = keyword.mid(1).trimmed();
+
+      if (!keyword.isEmpty() && keyword[0] == closingParen) {
+        closedProperly = true;
+      }
+
+      while (!keyword.isEmpty() && keyword[0] != closingParen) {
+        bool foundComma = false;
+
+        Value value;
+        value.value = readValue(keyword, explicitIncomplete, true);
+
+        if (!keyword.isEmpty() && keyword[0] == wrongClosingParen) {
+          return Unsupported;
+        }
+
+        if (!keyword.isEmpty() && keyword[0] == '<') {
+          value.units = readValue(keyword, explicitIncomplete, false);
+        }
+
+        if (!keyword.isEmpty() && keyword[0] == ',') {
+          foundComma = true;
+          keyword = keyword.mid(1).trimmed();
+        }
+
+        if (!foundComma && keyword.isEmpty()) {
+          return Incomplete;
+        }
+
+        bool foundCloseParen = (!keyword.isEmpty() && keyword[0] == closingParen);
+
+        if (foundCloseParen) {
+          closedProperly = true;
+        }
+
+        if (foundComma && foundCloseParen) {
+          return Unsupported;
+        }
+
+        if (!foundComma && !foundCloseParen) {
+          return explicitIncomplete ? Incomplete : Unsupported;
+        }
+
+        m_values.append(value);
+      }
+
+      if (!closedProperly) {
+        return Incomplete;
+      }
+
+      if (!keyword.isEmpty()) {
+        keyword = keyword.mid(1).trimmed();
+      }
+
+      // case: (A,B,C) <unit>
+      if (!keyword.isEmpty() && keyword[0] == '<') {
+        View units = readValue(keyword, explicitIncomplete, false);
+        for (int i = 0; i < m_values.size(); i++) {
+          if (m_values[i].units.isEmpty()) {
+            m_values[i].units = units;
+          }
+        }
+      }
+    }
+    else {
+      Value value;
+      value.value = readValue(keyword, explicitIncomplete, false);
+
+      if (!keyword.isEmpty() && keyword[0] == '<') {
+        value.units = readValue(keyword, explicitIncomplete, false);
+      }
+
+      m_values.append(value);
+    }
+
+    if (explicitIncomplete) {
+      return Incomplete;
+    }
+
+    if (!keyword.isEmpty()) {
+      if (keyword.size() > 1 && keyword[0] == '/' && keyword[1] == '*') {
+        return Unsupported;
+      }
+
+      if (keyword[0] == '#' ||
+          (keyword.size() > 1 && keyword[0] == '/' && keyword[1] == '/')) {
+        m_trailingComment = keyword;
+        keyword = View();
+      }
+    }
+
+    return keyword.isEmpty() ? Complete : Unsupported;
+  }
+
+
+  /**
+   * Removes the next data element (a name, value or units) from the front of a
+   * keyword, following PvlKeyword::readValue(). Explicit quotes (', ", <>) are not
+   * part of the element; parentheses and braces around a value in an array are.
+   *
+   * @param keyword Input/Output: The keyword to take the element from
+   * @param quoteProblem Output: Set if a quote is not closed
+   * @param arrayDelimiters Keep parentheses and braces as part of a value
+   *
+   * @return View The element
+   */
+  PvlParser::View PvlParser::readValue(View &keyword, bool &quoteProblem,
+                                       bool arrayDelimiters) const {
+    keyword = keyword.trimmed();
+
+    if (keyword.isEmpty()) {
+      return keyword;
+    }
+
+    bool impliedQuote = true;
+    char quoteEnd = ' ';
+    bool keepQuotes = false;
+
+    if (keyword[0] == '\'' || keyword[0] == '"') {
+      quoteEnd = keyword[0];
+      impliedQuote = false;
+    }
+    else if (keyword[0] == '<') {
+      quoteEnd = '>';
+      impliedQuote = false;
+    }
+    else {
+      for (const char *c = keyword.m_begin; c < keyword.m_end; c++) {
+        if (*c == ')' || *c == '}' || *c == ',' || *c == ' ' || *c == '\t' ||
+            *c == '<' || *c == '=') {
+          quoteEnd = *c;
+          break;
+        }
+      }
+    }
+
+    if (arrayDelimiters && (keyword[0] == '(' || keyword[0] == '{')) {
+      quoteEnd = (keyword[0] == '(') ? ')' : '}';
+      keepQuotes = true;
+      impliedQuote = false;
+    }
+
+    View rest = impliedQuote ? keyword : keyword.mid(1);
+    int quoteEndPos = rest.indexOf(quoteEnd);
+
+    if (quoteEndPos != -1) {
+      View value(rest.m_begin, rest.m_begin + quoteEndPos);
+
+      if (keepQuotes) {
+        value = View(keyword.m_begin, rest.m_begin + quoteEndPos + 1);
+      }
+
+      keyword = (impliedQuote ? rest.mid(quoteEndPos) : rest.mid(quoteEndPos + 1)).trimmed();
+      return value;
+    }
+    else if (!impliedQuote) {
+      quoteProblem = true;
+      return View();
+    }
+
+    View value = keyword;
+    keyword = View();
+    return value;
+  }
+
+
+  /**
+   * Sets the name, comments and values of the last keyword read into a keyword.
+   *
+   * @param keyword The (empty) keyword to fill in
+   */
+  void PvlParser::setKeyword(PvlKeyword &keyword) const {
+    keyword.setName(m_name.toString());
+
+    for (int i = 0; i < m_comments.size(); i++) {
+      keyword.addComment(m_comments[i].toString());
+    }
+    if (!m_trailingComment.isEmpty()) {
+      keyword.addComment(m_trailingComment.toString());
+    }
+
+    for (int i = 0; i < m_values.size(); i++) {
+      keyword.addValue(m_values[i].value.toString(), m_values[i].units.toString());
+    }
+  }
+
+
+  /**
+   * Compares the name of the last keyword read to a name the way
+   * PvlKeyword::stringEqual() does: ignoring case, white space and underscores.
+   *
+   * @param name The name to compare to, upper case without underscores
+   *
+   * @return bool True if the names match
+   */
+  bool PvlParser::nameIs(const char *name) const {
+    for (const char *c = m_name.m_begin; c < m_name.m_end; c++) {
+      if (*c == '_' || *c == '\b' || isSpace(*c)) {
+        continue;
+      }
+
+      if (*name == '\0' || toupper((unsigned char)*c) != *name) {
+        return false;
+      }
+      name++;
+    }
+
+    return *name == '\0';
+  }
+
+
+  /**
+   * Returns the characters from position to the end of the view.
+   *
+   * @param position The first character to keep
+   *
+   * @return View The remaining characters
+   */
+  PvlParser::View PvlParser::View::mid(int position) const {
+    return View(m_begin + position, m_end);
+  }
+
+
+  /**
+   * Returns the view without leading and trailing white space.
+   *
+   * @return View The trimmed view
+   */
+  PvlParser::View PvlParser::View::trimmed() const {
+    const char *begin = m_begin;
+    const char *end = m_end;
+
+    while (begin < end && isSpace(*begin)) {
+      begin++;
+    }
+    while (end > begin && isSpace(*(end - 1))) {
+      end--;
+    }
+
+    return View(begin, end);
+  }
+
+
+  /**
+   * Finds the first occurrence of a character.
+   *
+   * @param c The character to find
+   *
+   * @return int The position of c, or -1 if it is not in the view
+   */
+  int PvlParser::View::indexOf(char c) const {
+    if (isEmpty()) {
+      return -1;
+    }
+
+    const char *found = (const char *) memchr(m_begin, c, m_end - m_begin);
+    return found ? (int)(found - m_begin) : -1;
+  }
+
+
+  /**
+   * Returns true if the view contains white space, which PvlKeyword::setName()
+   * rejects.
+   *
+   * @return bool True if there is white space
+   */
+  bool PvlParser::View::hasWhiteSpace() const {
+    for (const char *c = m_begin; c < m_end; c++) {
+      if (isSpace(*c)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+
+  /**
+   * Converts the view to a QString. Empty views give an empty, not null, QString.
+   *
+   * @return QString The characters of the view
+   */
+  QString PvlParser::View::toString() const {
+    return QString::fromLatin1(m_begin ? m_begin : "", size());
+  }
+}
@@ -0,0 +1,145 @@
+#ifndef PvlParser_h
+#define PvlParser_h
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+namespace Isis {
+  class Pvl;
+  class PvlContainer;
+  class PvlGroup;
+  class PvlKeyword;
+  class PvlObject;
+
+  /**
+   * @brief Parse PVL held in memory
+   *
+   * This parses PVL from a memory buffer (a mapped file, a history or original
+   * label blob) without copying it. Lines are located in place and keyword
+   * names, values, units and comments are ranges of the buffer that are only
+   * converted to QStrings when they are stored. Groups, objects and keywords
+   * are built in place in their parent instead of being copied into it.
+   *
+   * The result is identical to reading the same data with the stream
+   * operators of Pvl, PvlObject, PvlGroup and PvlKeyword. Input those handle
+   * in unusual ways (multi-line comments, non-ASCII data inside a keyword,
+   * anything that is an error) is not parsed here: parse() returns false and
+   * the caller must read the data with the stream operators, which also report
+   * any errors.
+   *
+   * @code
+   *   Pvl pvl;
+   *   PvlParser parser(buffer, size);
+   *   if (!parser.parse(pvl)) {
+   *     pvl.clear();
+   *     istringstream is(string(buffer, size));
+   *     is >> pvl;
+   *   }
+   * @endcode
+   *
+   * @ingroup Parsing
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class PvlParser {
+    public:
+      PvlParser(const char *data, qint64 size);
+      ~PvlParser();
+
+      bool parse(Pvl &pvl);
+
+    private:
+      /**
+       * A range of characters in the buffer being parsed (or in the line
+       * joining buffer). Views are not null terminated.
+       */
+      class View {
+        public:
+          View() : m_begin(NULL), m_end(NULL) { }
+          View(const char *begin, const char *end) : m_begin(begin), m_end(end) { }
+
+          //! Returns true if the view has no characters
+          bool isEmpty() const {
+            return m_begin == m_end;
+          }
+
+          //! Returns the number of characters in the view
+          int size() const {
+            return (int)(m_end - m_begin);
+          }
+
+          //! Returns the character at index
+          char operator[](int index) const {
+            return m_begin[index];
+          }
+
+          View mid(int position) const;
+          View trimmed() const;
+          int indexOf(char c) const;
+          bool hasWhiteSpace() const;
+          QString toString() const;
+
+          const char *m_begin; //!< The first character
+          const char *m_end;   //!< One past the last character
+      };
+
+      //! One keyword value and its units
+      struct Value {
+        View value; //!< The value
+        View units; //!< The units, empty if none
+      };
+
+      //! The outcome of parsing the text of a keyword
+      enum Status {
+        Complete,   //!< The keyword is complete
+        Incomplete, //!< The keyword continues on the next line
+        Unsupported //!< Leave the data to the stream parser
+      };
+
+      bool readObject(PvlObject &object);
+      bool readGroup(PvlGroup &group);
+      bool readKeyword();
+      bool readLine(View &line);
+      Status readCleanKeyword(View keyword);
+      View readValue(View &keyword, bool &quoteProblem, bool arrayDelimiters) const;
+
+      void setKeyword(PvlKeyword &keyword) const;
+      bool nameIs(const char *name) const;
+
+      const char *m_pos;  //!< Current position in the buffer
+      const char *m_end;  //!< End of the buffer
+      bool m_good;        //!< False once the end of the data has been read
+
+      QByteArray m_joined;         //!< The text of a keyword that spans lines
+      View m_name;                 //!< Name of the last keyword read
+      QVector<View> m_comments;    //!< Comment lines before the last keyword read
+      View m_trailingComment;      //!< Comment following the last keyword read
+      QVector<Value> m_values;     //!< Values of the last keyword read
+  };
+};
+
+#endif
@@ -294,4 +294,17 @@ namespace Isis {
       delete [] mdNpts2;
     }
   } 
+
+
+  /**
+   * BlockAverage Operator () overload, parameter for StartProcessInPlace
+   * refer ProcessByLine, ProcessByBrick
+   *
+   * @param out - output buffer
+   */
+  void BlockAverage::operator() (Isis::Buffer & out) const
+  {
+    // The output positions are the input positions reduced by the reduction
+    mInCube->read(out, miReduction);
+  }
 }
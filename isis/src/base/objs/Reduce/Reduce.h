@@ -38,6 +38,9 @@ namespace Isis {
    *                           This only happened with certain values of output lines and scales.
    *                           Also, fixed the the swapping of output samples and lines in the
    *                           Results group in the print.prt file.  Fixes #1385.
+   *   @history 2026-10-19 ISIS Development Team - Added BlockAverage, which reads
+   *                           the input with Cube::read(Buffer &, int) so that
+   *                           cube overviews are used.
    */
   class Reduce {
   public:
@@ -122,6 +125,33 @@ namespace Isis {
       mutable double *mdNpts2;
   };
 
+
+  /**
+   * Functor for reduce that averages the valid pixels of whole blocks of the
+   * input with Cube::read(Buffer &, int). This reads the input cube's overview
+   * for the reduction if it has one. Up to rounding, it gives the same output
+   * as Average with no valid percentage and NULL replacement when the scales
+   * are the same whole number and divide the input dimensions.
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class BlockAverage : public Isis::Reduce {
+    public:
+      //! Constructor
+      BlockAverage(Isis::Cube *pInCube, int piReduction)
+      : Reduce(pInCube, piReduction, piReduction){
+        miReduction = piReduction;
+      }
+
+      //! Operator () overload
+      void operator() (Isis::Buffer & out) const;
+
+    private:
+      int miReduction; //!< The reduction factor
+  };
+
 }
 
 #endif
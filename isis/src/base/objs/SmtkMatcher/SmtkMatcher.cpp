@@ -28,6 +28,8 @@
 #include <iostream>
 #include <iomanip>
 
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSharedPointer>
 
 #include "Camera.h"
@@ -38,6 +40,13 @@
 
 namespace Isis {
 
+  /**
+   * Camera geometry goes through the NAIF toolkit, which is not reentrant, so
+   * geometry calls of all matchers are serialized.  Registration itself runs
+   * in parallel when matchers are used on separate threads.
+   */
+  static QMutex geometryMutex;
+
   /** Construct default matcher */
   SmtkMatcher::SmtkMatcher() : m_lhCube(0), m_rhCube(0), m_gruen(),
                                m_offImage(0), m_spiceErr(0),
@@ -404,6 +413,7 @@ namespace Isis {
       m_gruen->PatternChip()->TackCube(lpnt.getSample(), lpnt.getLine());
       m_gruen->PatternChip()->Load(*m_lhCube);
       m_gruen->SearchChip()->TackCube(rpnt.getSample(), rpnt.getLine());
+      QMutexLocker lock(&geometryMutex);  // Search chip uses both cameras
       m_gruen->SearchChip()->Load(*m_rhCube, *m_gruen->PatternChip(),
                                   *m_lhCube);
     }
@@ -501,6 +511,26 @@ namespace Isis {
     return (spnt);
   }
 
+  /**
+   * @brief Add the error counts and registration statistics of another matcher
+   *
+   * A matcher can not be shared between threads, so parallel matching uses a
+   * matcher per thread.  Merging the matchers afterwards reports the counts
+   * and statistics of all the registrations together.
+   *
+   * @param other Matcher whose counts and statistics are added to this one
+   */
+  void SmtkMatcher::MergeStatistics(const SmtkMatcher &other) {
+    if (!m_gruen.data() || !other.m_gruen.data()) {
+      QString mess = "Match algorithm not initialized!";
+      throw IException(IException::Programmer, mess, _FILEINFO_);
+    }
+
+    m_offImage += other.m_offImage;
+    m_spiceErr += other.m_spiceErr;
+    m_gruen->MergeStatistics(*other.m_gruen);
+  }
+
   /**
    * @brief Initialize the random number generator
    *
@@ -581,6 +611,7 @@ namespace Isis {
     Coordinate geom;
     if (pnt.isValid()) {
       if (inCube(camera, pnt)) {
+        QMutexLocker lock(&geometryMutex);
         if ( camera.SetImage(pnt.getSample(), pnt.getLine()) ) {
           double latitude = camera.UniversalLatitude();
           double longitude = camera.UniversalLongitude();
@@ -606,6 +637,7 @@ namespace Isis {
     // Check if pixel coordinate is in the left image
     Coordinate pnt;
     if (geom.isValid()) {
+      QMutexLocker lock(&geometryMutex);
       if ( camera.SetUniversalGround(geom.getLatitude(), geom.getLongitude()) ) {
         if ( camera.InCube() ) {
           pnt.setLineSamp(camera.Line(), camera.Sample());
@@ -57,6 +57,9 @@ namespace Isis {
  *                           Changed auto_ptr reference to QSharedPointer
  *                           so this class compiles under C++14.  
  *                           References #4809.
+ *   @history 2026-10-19 ISIS Development Team - Added MergeStatistics() to
+ *                           combine the statistics of matchers used on
+ *                           separate threads.
  */
 class SmtkMatcher {
   public:
@@ -116,6 +119,8 @@ class SmtkMatcher {
     /** Return Gruen registration statistics */
     Pvl RegistrationStatistics() { return (m_gruen->RegistrationStatistics()); }
 
+    void MergeStatistics(const SmtkMatcher &other);
+
   private:
     SmtkMatcher &operator=(const SmtkMatcher &matcher); // Assignment disabled
     SmtkMatcher(const SmtkMatcher &matcher);            // Copy const disabled
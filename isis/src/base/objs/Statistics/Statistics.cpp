@@ -203,6 +203,41 @@ namespace Isis {
   }
 
 
+  /**
+   * Add the accumulators and counters of another Statistics object to this
+   * one. The result is the same as if the data added to the other object had
+   * been added to this one, which lets statistics be gathered separately, for
+   * example on several threads, and then combined.
+   *
+   * @param other The statistics to add. They must have the same valid range
+   *              as this object.
+   *
+   * @throws IException::Programmer The valid ranges differ
+   */
+  void Statistics::AddStatistics(const Statistics &other) {
+    if (other.m_validMinimum != m_validMinimum ||
+        other.m_validMaximum != m_validMaximum) {
+      QString msg = "Statistics with different valid ranges can not be added";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_sum += other.m_sum;
+    m_sumsum += other.m_sumsum;
+    if (other.m_minimum < m_minimum) m_minimum = other.m_minimum;
+    if (other.m_maximum > m_maximum) m_maximum = other.m_maximum;
+    m_totalPixels += other.m_totalPixels;
+    m_validPixels += other.m_validPixels;
+    m_nullPixels += other.m_nullPixels;
+    m_lrsPixels += other.m_lrsPixels;
+    m_lisPixels += other.m_lisPixels;
+    m_hrsPixels += other.m_hrsPixels;
+    m_hisPixels += other.m_hisPixels;
+    m_underRangePixels += other.m_underRangePixels;
+    m_overRangePixels += other.m_overRangePixels;
+    m_removedData = m_removedData || other.m_removedData;
+  }
+
+
   /**
    * Remove an array of doubles from the accumulators and counters.
    * Note that is invalidates the absolute minimum and maximum. They
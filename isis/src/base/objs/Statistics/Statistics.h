@@ -98,6 +98,9 @@ namespace Isis {
    *                           Statistics serialization/unserialization. References #2282.
    *   @history 2017-04-20 Makayla Shepherd - Removed the hdf5 code because we are using XML for
    *                           serialization. Fixes #4795.
+   *   @history 2026-10-19 ISIS Development Team - Added AddStatistics() so that
+   *                           statistics gathered on separate threads can be
+   *                           combined.
    *
    *   @todo 2005-02-07 Deborah Lee Soltesz - add example using cube data to the class documentation
    *   @todo 2015-08-13 Jeannie Backer - Clean up header and implementation files once
@@ -119,6 +122,7 @@ namespace Isis {
 
       void AddData(const double *data, const unsigned int count);
       void AddData(const double data);
+      void AddStatistics(const Statistics &other);
 
       void RemoveData(const double *data, const unsigned int count);
       void RemoveData(const double data);
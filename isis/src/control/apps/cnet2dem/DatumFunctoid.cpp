@@ -49,6 +49,7 @@ using namespace std;
 namespace Isis {
 
 DatumFunctoidFactory *DatumFunctoidFactory::m_maker = 0;
+QMutex NaturalNeighborRadius::m_nnMutex;
 
 DatumFunctoidFactory::DatumFunctoidFactory() {
 //  This ensures this singleton is shut down when the application exists
@@ -24,6 +24,8 @@
 
 #include <cmath>
 #include <QList>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QString>
 #include <QSharedPointer>
 
@@ -535,6 +537,8 @@ namespace Isis {
    *
    * @internal
    *   @history 2015-11-16 Kris Becker - Original Version
+   *   @history 2026-10-19 ISIS Development Team - Serialized use of the nn
+   *            library so pixels can be computed in parallel.
    */
   class NaturalNeighborRadius : public DatumFunctoid {
     public:
@@ -555,11 +559,13 @@ namespace Isis {
             getpoint(m.getPoint(i), &points[i]);
           }
 
-          delaunay *d = delaunay_build(npts, &points[0], 0, 0, 0, 0);
-          nnpi *nn = nnpi_create(d);
-
           point pout;
           getpoint(m.getSource(), &pout);
+
+          // The nn library keeps global state, so interpolate one at a time
+          QMutexLocker lock(&m_nnMutex);
+          delaunay *d = delaunay_build(npts, &points[0], 0, 0, 0, 0);
+          nnpi *nn = nnpi_create(d);
           nnpi_interpolate_point(nn, &pout);
 
           // Compute radius and see if its valid
@@ -588,6 +594,8 @@ namespace Isis {
       }
 
     private:
+      static QMutex m_nnMutex; // Serializes use of the nn library
+
       inline point *getpoint(const ControlPointCloudPt &p, point *nnp) const {
         double xyzw[4];
         p.getGroundCoordinates(xyzw);
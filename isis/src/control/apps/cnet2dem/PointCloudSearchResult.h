@@ -55,6 +55,9 @@ namespace Isis {
    *  
    * @internal 
    *   @history 2015-10-11 Kris Becker - Original Version
+   *   @history 2026-10-19 ISIS Development Team - The search radius of a
+   *            nearest neighbor search is the distance to the farthest
+   *            neighbor.
    */
   
   template <class T, class D>
@@ -83,6 +86,8 @@ namespace Isis {
         m_pc            = pc;
   //      std::cout << "kd-tree-NN: Count: " << indices.size() << "\n";
         for (int i = 0; i < indices.size(); i++ ) {
+          // The search radius of a neighbor search reaches the farthest neighbor
+          m_search_radius = qMax(m_search_radius, std::sqrt(distances[i]));
           const T &p = m_pc->point(indices[i]);
           if ( m_source != p) {
             if ( p.isValid() ) {
@@ -1,6 +1,16 @@
 #include "Isis.h"
 
+#include <cfloat>
+#include <cmath>
+#include <functional>
+
 #include <QFile>
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrentMap>
+#include <QThreadPool>
 #include <QtGlobal>
 #include <QTextStream>
 #include <QScopedPointer>
@@ -26,6 +36,7 @@
 #include "Progress.h"
 #include "ProjectionFactory.h"
 #include "Projection.h"
+#include "Pvl.h"
 #include "SerialNumber.h"
 #include "SpecialPixel.h"
 #include "SurfacePoint.h"
@@ -124,6 +135,461 @@ typedef PointCloudTree<PointType, DistanceType>         CNetPointCloudTree;
 typedef PointCloudSearchResult<PointType, DistanceType> ResultType;
 
 
+/**
+ * @brief Control points sorted into cubic cells of body-fixed space
+ *
+ * Distances from a DEM pixel are measured to the control points normalized to
+ * the radius of the DEM.  The normalized points are sorted into cubic cells so
+ * that the points near an output tile are found without looking at every
+ * point in the cloud.
+ *
+ * @author 2026-10-19 ISIS Development Team
+ *
+ * @internal
+ */
+class CloudCells {
+  public:
+    CloudCells(const QVector<PointType> &points, const DistanceType &distance,
+               const double cellSize) : m_cellSize(cellSize),
+                                        m_normal(3 * points.size()), m_cells() {
+      double vmax(0.0);
+      for ( int i = 0 ; i < points.size() ; i++ ) {
+        const PointType &p = points[i];
+        double scale = distance.getZNorm() / distance.radius(p.x(), p.y(), p.z());
+        m_normal[3*i]   = p.x() * scale;
+        m_normal[3*i+1] = p.y() * scale;
+        m_normal[3*i+2] = p.z() * scale;
+        vmax = qMax(vmax, qMax(qAbs(p.x()), qMax(qAbs(p.y()), qAbs(p.z()))) * scale);
+      }
+
+      // Keep the cell indexes within the bits of a cell key
+      m_cellSize = qMax(m_cellSize, vmax / (double) (CellRange / 2));
+
+      for ( int i = 0 ; i < points.size() ; i++ ) {
+        m_cells[key(cell(m_normal[3*i]), cell(m_normal[3*i+1]),
+                    cell(m_normal[3*i+2]))].append(i);
+      }
+    }
+
+    ~CloudCells() { }
+
+    int size() const {
+      return ( m_normal.size() / 3 );
+    }
+
+    /**
+     * Returns the indexes, in ascending order, of the points within margin of
+     * a box.  All points within margin of a location inside the box are
+     * selected.
+     */
+    QVector<int> select(const double lower[3], const double upper[3],
+                        const double margin) const {
+      int low[3], high[3];
+      double ncells(1.0);
+      for ( int d = 0 ; d < 3 ; d++ ) {
+        low[d]  = cell(lower[d] - margin);
+        high[d] = cell(upper[d] + margin);
+        ncells *= (double) (high[d] - low[d] + 1);
+      }
+
+      QVector<int> selected;
+      if ( ncells > m_cells.size() ) {
+        QHash<qint64, QVector<int> >::const_iterator c = m_cells.constBegin();
+        while ( c != m_cells.constEnd() ) {
+          addInside(c.value(), lower, upper, margin, selected);
+          ++c;
+        }
+      }
+      else {
+        for ( int ix = low[0] ; ix <= high[0] ; ix++ ) {
+          for ( int iy = low[1] ; iy <= high[1] ; iy++ ) {
+            for ( int iz = low[2] ; iz <= high[2] ; iz++ ) {
+              QHash<qint64, QVector<int> >::const_iterator c =
+                  m_cells.constFind(key(ix, iy, iz));
+              if ( c != m_cells.constEnd() ) {
+                addInside(c.value(), lower, upper, margin, selected);
+              }
+            }
+          }
+        }
+      }
+
+      qSort(selected);
+      return ( selected );
+    }
+
+  private:
+    enum { CellBits = 21, CellRange = 1 << CellBits };
+
+    int cell(const double v) const {
+      double c = std::floor(v / m_cellSize);
+      c = qBound((double) (-CellRange / 2 + 1), c, (double) (CellRange / 2 - 1));
+      return ( (int) c );
+    }
+
+    qint64 key(const int ix, const int iy, const int iz) const {
+      return ( ( (qint64) (ix + CellRange / 2) << (2 * CellBits) ) |
+               ( (qint64) (iy + CellRange / 2) << CellBits ) |
+                 (qint64) (iz + CellRange / 2) );
+    }
+
+    void addInside(const QVector<int> &points, const double lower[3],
+                   const double upper[3], const double margin,
+                   QVector<int> &selected) const {
+      for ( int i = 0 ; i < points.size() ; i++ ) {
+        const double *v = &m_normal[3*points[i]];
+        bool inside(true);
+        for ( int d = 0 ; d < 3 ; d++ ) {
+          if ( (v[d] < lower[d] - margin) || (v[d] > upper[d] + margin) ) {
+            inside = false;
+          }
+        }
+        if ( inside ) { selected.append(points[i]); }
+      }
+    }
+
+    double                        m_cellSize;  // Size of the cells in meters
+    QVector<double>               m_normal;    // Normalized point coordinates
+    QHash<qint64, QVector<int> >  m_cells;     // Points in each cell
+};
+
+
+/**
+ * @brief Grids the control points of an output DEM tile by tile
+ *
+ * Each tile of the output cube gets its own kd-tree, built from the control
+ * points within the search distance of the tile.  Tiles are gridded in
+ * parallel on the global thread pool, each thread with its own projection and
+ * algorithms, so only the trees of the tiles being gridded are in memory.
+ *
+ * A nearest neighbor search can reach past any distance, so it is checked
+ * against the distance used to select the points of the tile.  When the
+ * farthest neighbor of a pixel is farther away, the tile is gridded again
+ * from points selected at twice the distance.  The results are the same as
+ * searching all the points at once.
+ *
+ * @author 2026-10-19 ISIS Development Team
+ *
+ * @internal
+ */
+class TileGridder {
+  public:
+    /**
+     * The values of the pixels of one output tile
+     *
+     * @author 2026-10-19 ISIS Development Team
+     *
+     * @internal
+     */
+    struct GridTile {
+      GridTile() : values(), failed(false), error() { }
+
+      QVector<double> values; // Pixel values in tile buffer order
+      bool failed;            // Gridding stopped with an error
+      IException error;       // The error, if failed
+    };
+
+    /**
+     * Grids one tile for QtConcurrent
+     *
+     * @author 2026-10-19 ISIS Development Team
+     *
+     * @internal
+     */
+    class GridFunctor : public std::unary_function<const int &, GridTile> {
+      public:
+        GridFunctor(TileGridder *gridder) : m_gridder(gridder) { }
+
+        GridTile operator()(const int &brick) const {
+          return ( m_gridder->grid(brick) );
+        }
+
+      private:
+        TileGridder *m_gridder; // The gridder of the tiles
+    };
+
+    TileGridder(const QVector<PointType> &points, const Pvl &label,
+                const QString &algorithm, const int samples, const int lines,
+                const int tileSamples, const int tileLines, const int bands,
+                const double znorm, const int kdNodes) :
+                m_points(points), m_label(label), m_algorithm(algorithm),
+                m_samples(samples), m_lines(lines),
+                m_tileSamples(tileSamples), m_tileLines(tileLines),
+                m_bands(bands), m_znorm(znorm), m_kdNodes(kdNodes),
+                m_trim(false), m_radialSearch(false), m_bothSearches(false),
+                m_searchRadius(0.0), m_neighbors(0), m_minPoints(0),
+                m_radiusFilter(false), m_sigma(999.0),
+                m_cellSize(0.0), m_cells(),
+                m_workers(), m_idleWorkers(), m_workerMutex() { }
+
+    ~TileGridder() {
+      qDeleteAll(m_workers);
+    }
+
+    void setTrim(const bool trim) {
+      m_trim = trim;
+    }
+
+    void setSearch(const bool radialSearch, const bool bothSearches,
+                   const double searchRadius, const int neighbors,
+                   const int minPoints) {
+      m_radialSearch = radialSearch;
+      m_bothSearches = bothSearches;
+      m_searchRadius = searchRadius;
+      m_neighbors = neighbors;
+      m_minPoints = minPoints;
+    }
+
+    void setRadiusFilter(const bool radiusFilter, const double sigma) {
+      m_radiusFilter = radiusFilter;
+      m_sigma = sigma;
+    }
+
+    /**
+     * Sorts the points into cells about the size of an output tile.  This is
+     * called once the search is set and before any tile is gridded.
+     */
+    void prepare(const double resolution) {
+      m_cellSize = resolution * qMax(m_tileSamples, m_tileLines);
+      if ( m_radialSearch ) { m_cellSize = qMax(m_cellSize, m_searchRadius); }
+      m_cells.reset(new CloudCells(m_points, DistanceType(m_znorm), m_cellSize));
+    }
+
+    /** Grids an output tile, this is thread safe */
+    GridTile grid(const int brick) {
+      GridTile tile;
+      tile.values.fill(Null, m_tileSamples * m_tileLines * m_bands);
+
+      GridWorker *worker = 0;
+      try {
+        worker = acquireWorker();
+        gridTile(brick, *worker, tile.values);
+      }
+      catch (IException &e) {
+        tile.failed = true;
+        tile.error = e;
+      }
+
+      if ( worker ) { releaseWorker(worker); }
+      return ( tile );
+    }
+
+  private:
+    Q_DISABLE_COPY(TileGridder);
+
+    /**
+     * The projection and algorithms used by one thread
+     *
+     * @author 2026-10-19 ISIS Development Team
+     *
+     * @internal
+     */
+    struct GridWorker {
+      QScopedPointer<Projection> projection;  // Projection of the output DEM
+      DatumFunctoidList          functors;    // Algorithms of the output bands
+    };
+
+    GridWorker *acquireWorker() {
+      QMutexLocker lock(&m_workerMutex);
+      if ( !m_idleWorkers.isEmpty() ) { return ( m_idleWorkers.takeLast() ); }
+
+      QScopedPointer<GridWorker> worker(new GridWorker());
+      Pvl label(m_label);
+      worker->projection.reset(ProjectionFactory::CreateFromCube(label));
+      worker->functors = DatumFunctoidFactory::getInstance()->create(m_algorithm);
+      m_workers.append(worker.data());
+      return ( worker.take() );
+    }
+
+    void releaseWorker(GridWorker *worker) {
+      QMutexLocker lock(&m_workerMutex);
+      m_idleWorkers.append(worker);
+    }
+
+    /** Locates the center of an output pixel on the surface */
+    bool locate(TProjection *tproj, const int samp, const int line,
+                double &lat, double &lon, double &radius) const {
+      //  Map only valid projection translation
+      if ( (samp > m_samples) || (line > m_lines) ) { return ( false ); }
+      if ( !tproj->SetWorld(samp, line) ) { return ( false ); }
+
+      // Trim if requested
+      if ( ( m_trim ) && ( tproj->HasGroundRange() ) ) {
+        if ( tproj->Latitude()  < tproj->MinimumLatitude()  ) return ( false );
+        if ( tproj->Latitude()  > tproj->MaximumLatitude()  ) return ( false );
+        if ( tproj->Longitude() < tproj->MinimumLongitude() ) return ( false );
+        if ( tproj->Longitude() > tproj->MaximumLongitude() ) return ( false );
+      }
+
+      lat = tproj->UniversalLatitude();
+      lon = tproj->UniversalLongitude();
+      radius = tproj->LocalRadius(lat);
+      return ( true );
+    }
+
+    void gridTile(const int brick, GridWorker &worker,
+                  QVector<double> &values) const {
+      TProjection *tproj = (TProjection *) worker.projection.data();
+      int sampleTiles = (m_samples + m_tileSamples - 1) / m_tileSamples;
+      int sample0 = ((brick - 1) % sampleTiles) * m_tileSamples + 1;
+      int line0   = ((brick - 1) / sampleTiles) * m_tileLines + 1;
+
+      // Locate the pixels of the tile and the box that holds them
+      QVector<int> pixels;
+      QVector<double> ground;
+      double lower[3] = {  DBL_MAX,  DBL_MAX,  DBL_MAX };
+      double upper[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+      int npixels = m_tileSamples * m_tileLines;
+      for ( int index = 0 ; index < npixels ; index++ ) {
+        double lat, lon, radius;
+        if ( !locate(tproj, sample0 + index % m_tileSamples,
+                     line0 + index / m_tileSamples, lat, lon, radius) ) {
+          continue;
+        }
+
+        SurfacePoint point(Latitude(lat, Angle::Degrees),
+                           Longitude(lon, Angle::Degrees),
+                           Distance(radius, Distance::Meters));
+        double xyz[3];
+        point.ToNaifArray(xyz);
+        for ( int d = 0 ; d < 3 ; d++ ) {
+          lower[d] = qMin(lower[d], xyz[d] * 1000.0);
+          upper[d] = qMax(upper[d], xyz[d] * 1000.0);
+        }
+
+        pixels.append(index);
+        ground.append(lat);
+        ground.append(lon);
+        ground.append(radius);
+      }
+
+      if ( pixels.isEmpty() ) { return; }
+
+      // Neighbors may be farther away than the search radius
+      double margin = m_cellSize;
+      if ( m_radialSearch && !m_bothSearches ) { margin = m_searchRadius; }
+
+      while ( !searchTile(pixels, ground, lower, upper, margin, worker, values) ) {
+        margin *= 2.0;
+      }
+    }
+
+    /**
+     * Computes the pixels of a tile from the points within margin of the
+     * tile.  Returns false if a neighbor search may have missed a point.
+     */
+    bool searchTile(const QVector<int> &pixels, const QVector<double> &ground,
+                    const double lower[3], const double upper[3],
+                    const double margin, GridWorker &worker,
+                    QVector<double> &values) const {
+      QVector<int> selected = m_cells->select(lower, upper, margin);
+      bool complete = ( selected.size() == m_cells->size() );
+      bool neighborSearch = ( m_bothSearches || !m_radialSearch );
+      if ( neighborSearch && !complete && (selected.size() < m_neighbors) ) {
+        return ( false );
+      }
+
+      QScopedPointer<CNetPointCloudTree> tree;
+      if ( !selected.isEmpty() ) {
+        CNetPointCloud *cloud = new CNetPointCloud(selected.size(),
+                                                   DistanceType(m_znorm));
+        for ( int i = 0 ; i < selected.size() ; i++ ) {
+          cloud->addPoint(m_points[selected[i]]);
+        }
+        tree.reset(new CNetPointCloudTree(cloud, m_kdNodes));
+      }
+      int neighbors = qMin(m_neighbors, selected.size());
+
+      int bOffset = m_tileSamples * m_tileLines;
+      for ( int p = 0 ; p < pixels.size() ; p++ ) {
+        SurfacePoint point(Latitude(ground[3*p], Angle::Degrees),
+                           Longitude(ground[3*p+1], Angle::Degrees),
+                           Distance(ground[3*p+2], Distance::Meters));
+
+        // Search the PC cloud
+        ControlPoint pt;
+        pt.SetAprioriSurfacePoint(point);
+        ControlPointCloudPt cpt(&pt, ControlPointCloudPt::Ground,
+                                ControlPointCloudPt::Shared,
+                                "MapPoint");
+
+        // There are several combinations to consider
+        //    1) RADIAL search from RANGE <meters> at the lat/lon pixel center
+        //    2) NEIGHBOR search selecting the NEIGHBORS closest to the center
+        //    3) BOTH searches requested will apply the RADIAL search first, then
+        //        and only if MINPOINTS points resulting from the RADIAL
+        //        search are within RANGE <meters>, otherwise a NEIGHBOR
+        //        search is performed.
+        ResultType results;
+        if ( !tree.isNull() ) {
+          if ( m_bothSearches ) {
+            results = tree->radius_query(cpt, m_searchRadius * m_searchRadius);
+            if ( m_minPoints > results.size() ) {
+              results = tree->neighbor_query(cpt, neighbors);
+            }
+          }
+          else if ( m_radialSearch ) {
+            results = tree->radius_query(cpt, m_searchRadius * m_searchRadius);
+          }
+          else {  // ( neighbor_search == search_type)
+            results = tree->neighbor_query(cpt, neighbors);
+          }
+        }
+
+        // Points outside the margin could be closer than this neighbor
+        if ( (ResultType::NearestNeighbor == results.type()) && !complete &&
+             (results.search_radius() > margin) ) {
+          return ( false );
+        }
+
+        // Extract points and prepare for processing
+        MapPointCollector mpoint;
+        if ( ResultType::Radius == results.type() ) mpoint.setSearchType(MapPointCollector::Radius);
+        else                                        mpoint.setSearchType(MapPointCollector::NearestNeighbor);
+
+        // Extract point set and optionally apply noise filter
+        results.forEachPair(mpoint);
+        if ( m_radiusFilter ) {  mpoint.removeNoise(m_sigma); }
+
+        // Compute values for each functor
+        int ndx = pixels[p];
+        for ( int i = 0 ; i < worker.functors.size() ; i++) {
+          values[ndx] = worker.functors[i]->value(mpoint);
+          ndx += bOffset;
+        }
+      }
+
+      return ( true );
+    }
+
+    const QVector<PointType> &m_points;  // All points of the cloud
+    Pvl             m_label;             // Label of the output DEM
+    QString         m_algorithm;         // Algorithms of the output bands
+    int             m_samples;           // Samples of the output DEM
+    int             m_lines;             // Lines of the output DEM
+    int             m_tileSamples;       // Samples of an output tile
+    int             m_tileLines;         // Lines of an output tile
+    int             m_bands;             // Bands of the output DEM
+    double          m_znorm;             // 3D normalization radius
+    int             m_kdNodes;           // Leaf size of the kd-trees
+
+    bool            m_trim;              // Trim to the ground range
+    bool            m_radialSearch;      // Radial search requested
+    bool            m_bothSearches;      // Radial then neighbor search
+    double          m_searchRadius;      // Radial search distance in meters
+    int             m_neighbors;         // Number of neighbors to search
+    int             m_minPoints;         // Minimum radial points
+    bool            m_radiusFilter;      // Apply the radius noise filter
+    double          m_sigma;             // Noise filter tolerance
+
+    double                      m_cellSize;     // Size of the point cells
+    QScopedPointer<CloudCells>  m_cells;        // Points sorted into cells
+    QList<GridWorker *>         m_workers;      // All the workers created
+    QList<GridWorker *>         m_idleWorkers;  // Workers not in use
+    QMutex                      m_workerMutex;  // Guards the idle workers
+};
+
+
 void IsisMain() {
  
   // We will be processing by line
@@ -157,8 +623,8 @@ void IsisMain() {
     QString mess = "Must enter a control net inc CNET or a list in CNETLIST";
     throw IException(IException::User, mess, _FILEINFO_);
   }
-  // Create the point cloud container and load the control networks
-  QScopedPointer<CNetPointCloud> cloud(new CNetPointCloud()); 
+  // Create the point container and load the control networks
+  QVector<PointType> cloud;
 
   // Collect some stuff from input nets for the output net
   QString netid;
@@ -180,7 +646,7 @@ void IsisMain() {
       ControlPointCloudPt cpt(point, ControlPointCloudPt::Ground, 
                               ControlPointCloudPt::Exclusive);
       if ( cpt.isValid() ) { 
-        cloud->addPoint(cpt); 
+        cloud.append(cpt);
         npoints++;
       }
     }
@@ -192,7 +658,7 @@ void IsisMain() {
     // 
     //  cnetlist.append( QSharedPointer<ControlNet> ( cnet.take() ) );
   }
-  std::cout << "\nTotal " << cloud->size() << " of " << allPoints << "\n";
+  std::cout << "\nTotal " << cloud.size() << " of " << allPoints << "\n";
 
   std::cout << "\nCreating output DEM to determine 3-D normalization...\n";
   //Get the map projection file provided by the user
@@ -211,14 +677,19 @@ void IsisMain() {
   double znorm = tproj->LocalRadius(tproj->TrueScaleLatitude());
   std::cout << "3D Normalization: " << znorm << "\n";
 
-  std::cout << "\nCreating cloud kd-tree..\n";
+  // Get the real tile sizes and allocate the buffer accordingly
+  PvlObject &icube = ocube->label()->findObject("IsisCube");
+  PvlObject &core = icube.findObject("Core");
+  int tsamps = core["TileSamples"];
+  int tlines = core["TileLines"];
+  Brick tile(*ocube, tsamps, tlines, functors.size() );
+
   int kd_nodes = ui.GetInteger("KDNODES");
-  cloud->getDistance().setZNorm(znorm);
-  CNetPointCloudTree cloud_t( cloud.take(), kd_nodes );
-  std::cout << "Done...\n";
+  TileGridder gridder(cloud, *ocube->label(), algorithm, csamps, clines,
+                      tsamps, tlines, functors.size(), znorm, kd_nodes);
 
   //  Set trimming option
-  bool trim = ui.GetBoolean("TRIM");
+  gridder.setTrim(ui.GetBoolean("TRIM"));
 
   //  Set up efficient test variables
   QString search_type = ui.GetString("SEARCH").toLower();
@@ -227,7 +698,6 @@ void IsisMain() {
  // bool neighbor_search = ( both_searches || ( "neighbors" == search_type ) );
 
   double search_radius(Null);
-  double search_radius_sq(Null);
 
   // Only worry about this if a range search is requested
   if ( radial_search) {
@@ -242,12 +712,13 @@ void IsisMain() {
       cout << "Search RANGE computed from Map Resolution: " << search_radius
            << " <meters>\n";
     }
-    search_radius_sq = search_radius * search_radius;
   }
 
   // Determine search criteria
   int neighbors = ui.GetInteger("NEIGHBORS");
   int minpoints = ui.GetInteger("MINPOINTS");
+  gridder.setSearch(radial_search, both_searches, search_radius, neighbors,
+                    minpoints);
 
   // Now determine if radius noise filtering is requested
   bool do_radius_filter = ui.WasEntered("SIGMARADIUS");
@@ -255,118 +726,56 @@ void IsisMain() {
   if ( do_radius_filter ) {
     sigma = ui.GetDouble("SIGMARADIUS");
   }
-  // Get the real tile sizes and allocate the buffer accordingly
-  PvlObject &icube = ocube->label()->findObject("IsisCube");
-  PvlObject &core = icube.findObject("Core");
-  int tsamps = core["TileSamples"];
-  int tlines = core["TileLines"];
-  Brick tile(*ocube, tsamps, tlines, functors.size() );
-  int bOffset = tsamps * tlines;  // Index offset to next band (spectrum) value
+  gridder.setRadiusFilter(do_radius_filter, sigma);
+
+  std::cout << "\nSorting cloud points for tiled kd-trees..\n";
+  gridder.prepare(tproj->Resolution());
+  std::cout << "Done...\n";
 
   Progress mapper;
   mapper.SetText("mapping");
   mapper.SetMaximumSteps(tile.Bricks());
   mapper.CheckStatus();
 
- //  Process data using 3-D brick 
-  int npixels = tsamps * tlines;
-  int nbands = tile.BandDimension();
-  SurfacePoint point;
-  
-  for ( int brick = 1 ; brick <= tile.Bricks() ; brick++ ) {
-    tile.SetBrick(brick);
-
-    // Tile processing...
-    for ( int index = 0 ; index < npixels ; index++ ) {
-
-      int samp, line, band;
-      tile.Position(index, samp, line, band);
-
-      // Intialize output spectrum to NULLs
-      QVector<double> datum(nbands, Null);
-
-      //  Map only valid projection translation
-      if ( (samp <= csamps) && (line <= clines) && 
-           ( tproj->SetWorld(samp, line) ) ) {
-#if 0        
-        std::cout << "Line: " << line << "  Sample: " << samp << "\n";
-        std::cout << "Lat:  " << tproj->UniversalLatitude() 
-                  << " Long: " << tproj->UniversalLongitude() << "\n";
-#endif
-        
-        // Trim if requested
-        bool mapit(true);
-        if ( ( trim ) && ( tproj->HasGroundRange() ) ) {
-          if ( tproj->Latitude()  < tproj->MinimumLatitude()  ) mapit = false;
-          if ( tproj->Latitude()  > tproj->MaximumLatitude()  ) mapit = false;
-          if ( tproj->Longitude() < tproj->MinimumLongitude() ) mapit = false;
-          if ( tproj->Longitude() > tproj->MaximumLongitude() ) mapit = false;
-        }
-
-        // Plot it only if its within mapping boundary conditions
-        if ( mapit ) {
-          double lat = tproj->UniversalLatitude(); 
-          double lon = tproj->UniversalLongitude();
-          double radius = tproj->LocalRadius(lat);
-
-          point.SetSphericalCoordinates(Latitude(lat, Angle::Degrees), 
-                                        Longitude(lon, Angle::Degrees),
-                                        Distance(radius, Distance::Meters));
-
-          // Search the PC cloud
-          ControlPoint pt;
-          pt.SetAprioriSurfacePoint(point);
-          ControlPointCloudPt cpt(&pt, ControlPointCloudPt::Ground,
-                                  ControlPointCloudPt::Shared,
-                                  "MapPoint");
-
-          // There are several combinations to consider
-          //    1) RADIAL search from RANGE <meters> at the lat/lon pixel center 
-          //    2) NEIGHBOR search selecting the NEIGHBORS closest to the center 
-          //    3) BOTH searches requested will apply the RADIAL search first, then
-          //        and only if MINPOINTS points resulting from the RADIAL 
-          //        search are within RANGE <meters>, otherwise a NEIGHBOR 
-          //        search is performed.
-          ResultType results;
-          if ( both_searches ) {
-            results = cloud_t.radius_query(cpt, search_radius_sq); 
-            if ( minpoints > results.size() ) {
-              results = cloud_t.neighbor_query(cpt, neighbors);
-            }
-          }
-          else if ( radial_search ) {
-            results = cloud_t.radius_query(cpt, search_radius_sq);
-          }
-          else {  // ( neighbor_search == search_type)
-            results = cloud_t.neighbor_query(cpt, neighbors);
-          }
+  //  Grid batches of tiles in parallel while the previous batch is written
+  int batch = 2 * QThreadPool::globalInstance()->maxThreadCount();
+  QList<int> bricks;
+  QFuture<TileGridder::GridTile> gridding;
+  QFuture<TileGridder::GridTile> nextGridding;
+  try {
+    for ( int first = 1 ; first <= tile.Bricks() || !bricks.isEmpty() ; first += batch ) {
+      QList<int> nextBricks;
+      for ( int brick = first ; brick < first + batch && brick <= tile.Bricks() ; brick++ ) {
+        nextBricks.append(brick);
+      }
 
-          // Extract points and prepare for processing
-          MapPointCollector mpoint;
-          if ( ResultType::Radius == results.type() ) mpoint.setSearchType(MapPointCollector::Radius);
-          else                                        mpoint.setSearchType(MapPointCollector::NearestNeighbor);
+      nextGridding = QFuture<TileGridder::GridTile>();
+      if ( !nextBricks.isEmpty() ) {
+        nextGridding = QtConcurrent::mapped(nextBricks,
+                                            TileGridder::GridFunctor(&gridder));
+      }
 
-          // Extract point set and optionally apply noise filter
-          results.forEachPair(mpoint);
-          if ( do_radius_filter ) {  mpoint.removeNoise(sigma); }
+      for ( int i = 0 ; i < bricks.size() ; i++ ) {
+        TileGridder::GridTile result = gridding.resultAt(i);
+        if ( result.failed ) { throw result.error; }
 
-          // Compute values for each functor
-          for ( int i = 0 ; i < functors.size() ; i++) {
-            datum[i] = functors[i]->value(mpoint);
-          }
+        // Copy data values to output data brick
+        tile.SetBrick(bricks[i]);
+        for ( int v = 0 ; v < tile.size() ; v++ ) {
+          tile[v] = result.values[v];
         }
+        ocube->write(tile);
+        mapper.CheckStatus();
       }
 
-      // Copy data values to output data brick
-      int ndx = index;
-      for (int v = 0 ; v < datum.size() ; v++) {
-        tile[ndx] = datum[v];
-        ndx += bOffset;
-      }
+      bricks = nextBricks;
+      gridding = nextGridding;
     }
-
-    ocube->write(tile);
-    mapper.CheckStatus();
+  }
+  catch (IException &e) {
+    gridding.waitForFinished();
+    nextGridding.waitForFinished();
+    throw;
   }
 
   PvlKeyword fname("Name");
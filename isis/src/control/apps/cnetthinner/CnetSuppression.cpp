@@ -24,6 +24,7 @@
 #include <cfloat>
 #include <cmath>
 
+#include <QFuture>
 #include <QMap>
 #include <QPair>
 #include <QRectF>
@@ -31,6 +32,7 @@
 #include <QSharedPointer>
 #include <QString>
 #include <QStringList>
+#include <QtConcurrentMap>
 
 #include <boost/foreach.hpp>
 
@@ -123,6 +125,12 @@ namespace Isis {
  * Performs a suppression on all cubes associated with the CnetSuppression object and returns the 
  * results as a Results object. An input bitmask will be used to mask all pointsets associated with 
  * all cubes before running the suppression.  
+ *  
+ * The cubes are suppressed in order of their measure count, from highest to lowest, and the 
+ * points selected in a cube are kept in all later cubes. A cube therefore only depends on the 
+ * earlier cubes it shares points with. Cubes are put in levels, a cube one level above the 
+ * highest of those cubes, and the cubes of a level are suppressed in parallel. The results are 
+ * merged in the original order, so they are the same as suppressing one cube at a time. 
  * 
  * @param minpts minimum points to keep in the result set
  * @param maxpts maximum points to keep in the result set. 
@@ -155,29 +163,61 @@ namespace Isis {
     }
 #endif
 
-    // Suppress points in highest to lowest count
-    m_results.clear();
-    BitMask myBm = bm;
-    Results final;
+    // Gather the points of each cube, their area scale (the first cube sets the area) and the 
+    // level each cube can be suppressed at
+    QVector<PointSet> cubesets(pntcount.size());
+    QVector<double> scales(pntcount.size());
+    QVector<int> pointLevel(size(), -1);
+    QVector<QVector<int> > levels;
     for ( int p = 0 ; p < pntcount.size() ; p++) {
-      QString serialno = pntcount[p].first;
+      cubesets[p] = getCubeMeasureIndices(pntcount[p].first);
+      scales[p] = getScale( domain(cubesets[p]).size() );
 
-#if defined(DEBUG)
-//      int pts = pntcount[p].second;
-      std::cout << "\n--> Serial: " << serialno.toStdString() << "\n";
-#endif
+      int level = 0;
+      BOOST_FOREACH ( const IndexPoint &point, cubesets[p] ) {
+        level = qMax(level, pointLevel[index(point)] + 1);
+      }
+      BOOST_FOREACH ( const IndexPoint &point, cubesets[p] ) {
+        pointLevel[index(point)] = level;
+      }
 
-      Results r = suppress(serialno, minpts, maxpts, min_radius, 
-                           tolerance, myBm);
-      m_results.append(r);
+      if ( level >= levels.size() ) { levels.resize(level + 1); }
+      levels[level].append(p);
+    }
+
+    // Suppress the cubes of each level in parallel. Points selected by earlier cubes are fixed 
+    // in the cubes that contain them. The input mask only applies to the first cube.
+    QVector<Results> results(pntcount.size());
+    BitMask selected(size(), false);
+
+    for ( int l = 0 ; l < levels.size() ; l++) {
+      QFuture<Results> future = QtConcurrent::mapped(levels[l], 
+                                    SuppressFunctor(this, &cubesets, &scales, &bm, &selected,
+                                                    minpts, maxpts, min_radius, tolerance));
+      future.waitForFinished();
+
+      for ( int i = 0 ; i < levels[l].size() ; i++) {
+        Results r = future.resultAt(i);
+        results[levels[l][i]] = r;
+        BOOST_FOREACH ( const IndexPoint &point, r.m_points ) {
+          selected[index(point)] = true;
+        }
+      }
+    }
+
+    // Merge points in highest to lowest count
+    m_results.clear();
+    Results final;
+    for ( int p = 0 ; p < pntcount.size() ; p++) {
 
 #if defined(DEBUG)
-      std::cout << "  Total Saved: " << r.size() << " at cell radius " 
-                << r.m_radius << "\n";
+      std::cout << "\n--> Serial: " << pntcount[p].first.toStdString() << "\n";
+      std::cout << "  Total Saved: " << results[p].size() << " at cell radius " 
+                << results[p].m_radius << "\n";
 #endif
 
-      final = merge(r,final);
-      myBm = final.m_selected;
+      m_results.append(results[p]);
+      final = merge(results[p], final);
     }
    
     return (final);
@@ -233,16 +273,45 @@ namespace Isis {
 
     // Bounding box of control points
     QRectF d = domain(points);
+    return ( suppressPoints(points, d, getScale( d.size() ), minpts, maxpts, min_radius,
+                            tolerance, bm) );
+  }
+
+
+/**
+ * Performs a suppression on the input PointSet with a known bounding box and area scale. This 
+ * does not change the CnetSuppression, so point sets can be suppressed in parallel. 
+ *  
+ * The radius of the cells is found with a binary search. For each radius, the points are taken 
+ * in order and a point is selected if its cell is not yet covered by a selected point. 
+ * 
+ * @param points The point set to run suppression on.
+ * @param d The bounding box of the points.
+ * @param scale The fraction of the network area covered by the bounding box.
+ * @param minpts The minimum possible points to keep after a suppression run. 
+ * @param maxpts The maximum possible points to keep after a suppression run. 
+ * @param min_radius The minimum radius to use for the suppression calculation. 
+ * @param tolerance A tolerance factor which scales the size of the search space for suppression. 
+ * @param bm A BitMask to apply to the input point set. 
+ * 
+ * @return @b CnetSuppression::Results The Result set for the suppression run. 
+ */
+  CnetSuppression::Results CnetSuppression::suppressPoints(const CnetSuppression::PointSet &points,
+                                                           const QRectF &d, const double &scale,
+                                                           const int &minpts, const int &maxpts,
+                                                           const double &min_radius,
+                                                           const double &tolerance,
+                                                           const CnetSuppression::BitMask &bm)
+                                                           const {
 
     double max_radius = qMax(d.width(), d.height());
     int num = qMax(qFloor(max_radius - min_radius), 11); //TODO not sure where the 11 came from...?
     QVector<double> radii = linspace(min_radius, max_radius, num, 
                                      1.0/qSqrt(2.0) );
 
-    QPointF botR = d.bottomRight();
-
 #if defined(DEBUG)
     QPointF topL = d.topLeft();
+    QPointF botR = d.bottomRight();
     std::cout << "  Domain((x), (y)): (" << topL.x() << "," << botR.x() 
               << "), (" << topL.y() << "," << botR.y() << ")\n";
     std::cout << "  Min.Max, count Radius: " << min_radius << ", "
@@ -250,7 +319,7 @@ namespace Isis {
 #endif
 
     // Get scaled points to save
-    int v_maxpts = int ( (double) maxpts * getScale( d.size() ) );
+    int v_maxpts = int ( (double) maxpts * scale );
     v_maxpts = qMax(v_maxpts, minpts);
     int pnttol = qFloor( (v_maxpts * tolerance) + 0.5 );
 
@@ -273,7 +342,6 @@ namespace Isis {
       std::cout << " ++> Initial condition met - return input set\n";
 #endif
 
-      m_results.append(result);
       return (result);
     }
     
@@ -283,42 +351,31 @@ namespace Isis {
     while ( (bmax-bmin) > 1 ) {
       int bmid = (bmin + bmax) / 2;
 
-#if defined(DEBUG)
-//      std::cout << "  \nBSearchIndx: (" << bmin << "," << bmid << "," << bmax << ")\n";
-#endif
-
       double cell_size = radii[bmid];
-      int n_x_cells = qCeil(botR.x() / cell_size);
-      int n_y_cells = qCeil(botR.y() / cell_size);
-      BOOST_ASSERT ( n_x_cells > 0 );
-      BOOST_ASSERT ( n_y_cells > 0 );
 
 #if defined(DEBUG)
-      std::cout << "  CellRadius(x,y): " << cell_size << " - "
-                << "Grid(" << n_x_cells << "," << n_y_cells << ")\n";
+      std::cout << "  CellRadius: " << cell_size << "\n";
 #endif
 
-      // Create initial coverage grid with fixed points
-      GridMask grid(n_x_cells, n_y_cells, false);
+      // Create initial coverage with fixed points. NOTE the cover is a rectangle, NOT euclidean
+      // distance!!!
+      CoverIndex coverage( int(cell_size+0.5) );
       result = Results(size(), d, cell_size);
       result.add(fixed);
-      cover(grid, fixed, cell_size);
 
-#if defined(DEBUG)
-      int nIcov = cover(grid, fixed, cell_size);
-      std::cout << "  InitialCoverage: " << nIcov << "\n";
-#endif
+      int x_center, y_center;
+      BOOST_FOREACH ( const IndexPoint &p, fixed ) {
+        cellIndex(p, cell_size, x_center, y_center);
+        coverage.cover(x_center, y_center);
+      }
 
       // Evaluate all points
-      int x_center, y_center;
       for ( int i = 0 ; i < points.size() ; i++) {
 
         cellIndex(points[i], cell_size, x_center,  y_center);
-        BOOST_ASSERT ( x_center < n_x_cells );
-        BOOST_ASSERT ( y_center < n_y_cells );
 
         // Got one, update result state
-        if ( false == grid[x_center][y_center] ) {
+        if ( !coverage.isCovered(x_center, y_center) ) {
 
           // First check to see if we have exceeded the requested results set
           result.add(points[i]);
@@ -330,19 +387,13 @@ namespace Isis {
           }
 
           // Compute cell coverage
-          cover(grid, x_center, y_center, cell_size);
-
-#if defined(DEBUG)
-          int ncov = cover(grid, x_center, y_center, cell_size);
-          std::cout << "  TotalCovered: " << ncov << "(" << nCovered(grid) 
-                    << ") of " << (n_x_cells*n_y_cells) << "\n"; 
-#endif
-
+          coverage.cover(x_center, y_center);
         }
       }
 
-      // Results of search...
-//      std::cout << "  PointsFound: " << result.size() << "\n";
+#if defined(DEBUG)
+      std::cout << "  CoveringCells: " << coverage.size() << "\n";
+#endif
 
       // Now determine if we have enough points to call it good
       if (  (result.size() >= (v_maxpts - pnttol) ) &&  
@@ -511,81 +562,65 @@ namespace Isis {
 
 
 /**
- * Determine the number of (x,y) positions in the input grid which are set to true. 
+ * Constructs an empty index of covered cells.
  *  
- * @param grid The grid to calculate the number of covered points from. 
+ * @param cellRadius The number of cells, in x and in y, a covering cell covers around itself
+ */
+  CnetSuppression::CoverIndex::CoverIndex(const int &cellRadius) : 
+                                          m_radius(qMax(cellRadius, 0)), m_ncover(0), 
+                                          m_buckets() { }
+
+
+/**
+ * Determines if a cell is covered by a covering cell.
+ * 
+ * @param x The x index of the cell.
+ * @param y The y index of the cell.
  * 
- * @return @b int The number of convered points; the number of (x,y) positions for which the bitmask 
- *                is set to true. 
+ * @return @b bool True if a covering cell is within the radius of the cell in both x and y.
  */
-  int CnetSuppression::nCovered(const CnetSuppression::GridMask &grid) const {
-    int ncov(0);
-    for ( int x = 0 ; x < grid.dim1() ; x++) {
-      for ( int y = 0 ; y < grid.dim2() ; y++) {
-        if ( grid[x][y] == true) ncov++;
+  bool CnetSuppression::CoverIndex::isCovered(const int &x, const int &y) const {
+    int block = qMax(m_radius, 1);
+    int bx = x / block;
+    int by = y / block;
+    for ( int i = bx - 1 ; i <= bx + 1 ; i++) {
+      for ( int j = by - 1 ; j <= by + 1 ; j++) {
+        QHash<QPair<int, int>, QVector<QPoint> >::const_iterator bucket = 
+            m_buckets.find(qMakePair(i, j));
+        if ( bucket == m_buckets.end() ) { continue; }
+
+        BOOST_FOREACH ( const QPoint &cell, bucket.value() ) {
+          if ( (qAbs(cell.x() - x) <= m_radius) && (qAbs(cell.y() - y) <= m_radius) ) {
+            return (true);
+          }
+        }
       }
     }
-    return (ncov);
+    return (false);
   }
 
 
 /**
- * Update a grid to contain true values where it is covered by cells as defined by the input 
- * PointSet.  
- *  
- * @param grid The grid to update by setting to true grid entries which are contained within cells 
- *             definted by the input PointSet. 
- * @param points The input PointSet to use to update the grid. 
- * @param cell_size The size of a cell.
+ * Adds a covering cell to the index.
  * 
- * @return @b int The number of grid entries updated. 
+ * @param x The x index of the cell.
+ * @param y The y index of the cell.
  */
-  int CnetSuppression::cover(CnetSuppression::GridMask &grid, 
-                             const CnetSuppression::PointSet &points, 
-                             const double &cell_size) const {
-
-    int x_center, y_center, ncov(0);
-    BOOST_FOREACH ( const IndexPoint &p, points ) {
-      cellIndex(p, cell_size, x_center, y_center);
-      ncov = cover(grid, x_center, y_center, cell_size);
-    }
-    return (ncov); //ncov should be += for _all_ covered? 
+  void CnetSuppression::CoverIndex::cover(const int &x, const int &y) {
+    int block = qMax(m_radius, 1);
+    m_buckets[qMakePair(x / block, y / block)].append(QPoint(x, y));
+    m_ncover++;
+    return;
   }
 
 
 /**
- * Update a grid to contain true values where it overlaps a rectangle defined by the 
- * input paramters and return the number of values contained in this rectange.  
- *  
- * @param grid The grid to update by setting to true grid entries contained within the 
- *             rectangle defined by the paramters passed to this function.
- * @param x_center The x-coordinate of the center of the grid. 
- * @param y_center The y-coordinate of the center of the grid. 
- * @param cell_size The size of a cell. 
+ * Gets the number of covering cells.
  * 
- * @return @b int The number of covered cells. 
+ * @return @b int The number of cells added with cover()
  */
-  int CnetSuppression::cover(CnetSuppression::GridMask &grid, 
-                             const int &x_center, const int &y_center, 
-                             const double &cell_size) const {
-
-    int n_x_cells = grid.dim1();
-    int n_y_cells = grid.dim2();
-
-    // Compute the cover. NOTE this is a rectangle, NOT euclidean distance!!!
-    int g_x_min = qMax(x_center - int(cell_size+0.5), 0);
-    int g_x_max = qMin(x_center + int(cell_size+0.5), n_x_cells-1);
-    int g_y_min = qMax(y_center - int(cell_size+0.5), 0);
-    int g_y_max = qMin(y_center + int(cell_size+0.5), n_y_cells-1);
-
-#if defined(DEBUG)
-    std::cout << "  CellCover: (" << g_x_min << "," << g_x_max << ")("
-              << g_y_min << "," << g_y_max << ")\n";
-#endif
-
-    grid.subarray(g_x_min, g_x_max, g_y_min, g_y_max) = true;
-    int ncov = (g_x_max-g_x_min+1) * (g_y_max-g_y_min+1);
-    return ( ncov );
+  int CnetSuppression::CoverIndex::size() const {
+    return (m_ncover);
   }
 
 
@@ -24,13 +24,18 @@
 #include <ostream>
 #include <cfloat>
 #include <cmath>
+#include <functional>
 
+#include <QHash>
 #include <QMap>
+#include <QPair>
+#include <QPoint>
 #include <QRectF>
 #include <QSharedPointer>
 #include <QSizeF>
 #include <QString>
 #include <QStringList>
+#include <QVector>
 
 #include <boost/assert.hpp>
 #include <boost/foreach.hpp>
@@ -53,6 +58,10 @@ namespace Isis {
  *   @history 2016-12-28 Kristin Berry - Added documentation and tests for checkin
  *   @history 2017-08-09 Summer Stapleton - Added a try-catch in constructor to throw proper
  *                         error for invalid control net. Fixes #5068.
+ *   @history 2026-10-19 ISIS Development Team - Replaced the coverage grid of a
+ *                         suppression with a bucketed index of the selected
+ *                         cells and suppress images that share no points in
+ *                         parallel. The results are unchanged.
  * 
  */
   class CnetSuppression : public CnetManager {
@@ -179,11 +188,12 @@ namespace Isis {
 
       void cellIndex(const IndexPoint &p, const double &cell_size,
                      int &x_center, int &y_center) const;
-      int nCovered(const GridMask &grid) const;
-      int cover(GridMask &grid, const PointSet &points, 
-                const double &cell_size) const;
-      int cover(GridMask &grid, const int &x_center, const int &y_center, 
-                const double &cell_size) const;
+
+      Results suppressPoints(const PointSet &points, const QRectF &d,
+                             const double &scale, const int &minpts,
+                             const int &maxpts, const double &min_radius,
+                             const double &tolerance,
+                             const BitMask &bm) const;
 
       PointSet merge(const PointSet &s1, const PointSet &s2) const;
       Results  merge(const Results &r1, const Results &r2) const;
@@ -195,6 +205,82 @@ namespace Isis {
                                const int num, const double &scale = 1.0) const;
 
 
+      /**
+       * @brief Index of the cells covered during a suppression
+       *
+       * A cell is covered when it is within cellRadius cells, in both x and
+       * y, of a cell that was covered with cover().  This is the rectangle
+       * the suppression has always marked in a grid of the whole image, but
+       * only the covering cells are kept.  They are bucketed by blocks of
+       * cellRadius cells so that a test looks at the 3x3 blocks around the
+       * cell, which hold a few cells at most, as covering cells are more than
+       * cellRadius apart.  Neither the test nor cover() depends on the size
+       * of the image.
+       *
+       * @author 2026-10-19 ISIS Development Team
+       *
+       * @internal
+       */
+      class CoverIndex {
+        public:
+          CoverIndex(const int &cellRadius);
+
+          bool isCovered(const int &x, const int &y) const;
+          void cover(const int &x, const int &y);
+          int size() const;
+
+        private:
+          int m_radius;  //! Radius, in cells, a covering cell covers
+          int m_ncover;  //! Number of covering cells
+          QHash<QPair<int, int>, QVector<QPoint> > m_buckets; //! Covering cells by block
+      };
+
+
+      /**
+       * @brief Suppresses the points of an image on the global thread pool
+       *
+       * @author 2026-10-19 ISIS Development Team
+       *
+       * @internal
+       */
+      class SuppressFunctor : public std::unary_function<const int &, Results> {
+        public:
+          SuppressFunctor(const CnetSuppression *suppressor,
+                          const QVector<PointSet> *cubesets,
+                          const QVector<double> *scales,
+                          const BitMask *first, const BitMask *selected,
+                          const int &minpts,
+                          const int &maxpts, const double &min_radius,
+                          const double &tolerance) :
+                          m_suppressor(suppressor), m_cubesets(cubesets),
+                          m_scales(scales), m_first(first),
+                          m_selected(selected), m_minpts(minpts),
+                          m_maxpts(maxpts), m_min_radius(min_radius),
+                          m_tolerance(tolerance) { }
+
+          inline Results operator()(const int &image) const {
+            const PointSet &points = (*m_cubesets)[image];
+            const BitMask &bm = (image == 0) ? *m_first : *m_selected;
+            return ( m_suppressor->suppressPoints(points,
+                                                  m_suppressor->domain(points),
+                                                  (*m_scales)[image], m_minpts,
+                                                  m_maxpts, m_min_radius,
+                                                  m_tolerance, bm) );
+          }
+
+        private:
+          const CnetSuppression   *m_suppressor; //! Suppression of the network
+          const QVector<PointSet> *m_cubesets;   //! Points of each image
+          const QVector<double>   *m_scales;     //! Area scale of each image
+          const BitMask           *m_first;      //! Input mask of the first image
+          const BitMask           *m_selected;   //! Points selected so far
+          int                      m_minpts;     //! Minimum points to keep
+          int                      m_maxpts;     //! Maximum points to keep
+          double                   m_min_radius; //! Minimum cell radius
+          double                   m_tolerance;  //! Tolerance on maxpts
+      };
+
+
       /**
        * @brief Descending order sort functor
        * 
@@ -75,7 +75,7 @@ FastGeom::~FastGeom() { }
  * @param train            Train image
  * @return ImageTransform* Pointer to FastGeom transform
  */
-ImageTransform *FastGeom::compute(MatchImage &query, MatchImage &train)  {
+ImageTransform *FastGeom::compute(MatchImage &query, MatchImage &train) const {
   // std::cout << "\nQuery: " << query.source().name() << "\n";
   // std::cout << "Train: " << train.source().name() << "\n";
 
@@ -142,7 +142,7 @@ ImageTransform *FastGeom::compute(MatchImage &query, MatchImage &train)  {
   return ( fastg.take() );
 }
 
-void FastGeom::apply(MatchImage &query, MatchImage &train) {
+void FastGeom::apply(MatchImage &query, MatchImage &train) const {
   // Add the fastggeom mapping transform
   train.addTransform( compute(query, train) );
   return;
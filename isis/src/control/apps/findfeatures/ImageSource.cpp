@@ -60,6 +60,13 @@
 
 namespace Isis {
 
+/**
+ * NAIF toolkit routines are not reentrant, so camera creation and camera
+ * geometry calls must be serialized across all ImageSource instances.
+ * Projections and image I/O only need the per-image mutex.
+ */
+static QMutex naifMutex;
+
 
 ImageSource::ImageSource() :  m_data( new SourceData() ) { }
 
@@ -229,7 +236,7 @@ SurfacePoint ImageSource::getLatLon(const double &line, const double &sample) {
   if ( !hasGeometry() ) return (point);
 
 #if defined(MAKE_THREAD_SAFE)
-  QMutexLocker lock(m_data->m_mutex);  // Thread locking for ISIS Camera activites
+  QMutexLocker lock(geometryMutex());  // Thread locking for ISIS Camera activites
 #endif
 
   // Check for projection first and translate
@@ -267,7 +274,7 @@ bool ImageSource::getLineSamp(const SurfacePoint &point,
 
 
 #if defined(MAKE_THREAD_SAFE)
-  QMutexLocker lock(m_data->m_mutex);  // Thread locking for ISIS Camera activites
+  QMutexLocker lock(geometryMutex());  // Thread locking for ISIS Camera activites
 #endif
 
   // Check for projection first and translate
@@ -379,6 +386,24 @@ cv::Mat ImageSource::getGeometryMapping(ImageSource &match,
   return (mapper);  
 }
 
+/**
+ * @brief Returns the mutex that protects geometry calls for this image
+ *
+ * Camera models call NAIF routines that share global state, so all camera
+ * evaluations are serialized process wide. Map projections are independent
+ * per image and only lock this image. This lets FastGeom computations on
+ * projected images run concurrently.
+ *
+ * @return QMutex* Mutex to lock before a geometry call
+ */
+QMutex *ImageSource::geometryMutex() const {
+  if ( hasCamera() && !hasProjection() ) {
+    return ( &naifMutex );
+  }
+  return ( m_data->m_mutex );
+}
+
+
 Histogram *ImageSource::getHistogram(Cube &cube) const {
   QScopedPointer<Histogram> hist(new Histogram(cube, 1));
   LineManager line(cube);
@@ -417,6 +442,10 @@ bool ImageSource::initGeometry() {
 
 bool ImageSource::initGeometry(Cube &cube) {
 
+#if defined(MAKE_THREAD_SAFE)
+  QMutexLocker lock(&naifMutex);  // Kernel loading is not reentrant
+#endif
+
   // Determine projection capabilities
   bool gotOne(false);
   try {
@@ -147,6 +147,7 @@ class ImageSource {
     QExplicitlySharedDataPointer<SourceData> m_data;
 
     Histogram *getHistogram(Cube &cube) const;
+    QMutex *geometryMutex() const;
 
     bool initGeometry();
     bool initGeometry(Cube &cube);
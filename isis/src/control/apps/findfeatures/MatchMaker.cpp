@@ -30,8 +30,11 @@
 #include <sstream>
 
 #include <QList>
+#include <QMutexLocker>
 #include <QStringList>
 #include <QTime>
+#include <QVector>
+#include <QtConcurrentMap>
 
 #include <boost/foreach.hpp>
 
@@ -52,14 +55,116 @@
 
 namespace Isis {
 
+/**
+ * @brief Loads one image for QtConcurrent::blockingMapped
+ *
+ * @internal
+ */
+class MatchMaker::ImageLoader {
+  public:
+    typedef MatchImage result_type;
+
+    ImageLoader(MatchMaker::ErrorCollector &errors) : m_errors(errors) { }
+
+    MatchImage operator()(const QString &name) const {
+      try {
+        return ( MatchImage(ImageSource(name)) );
+      }
+      catch (IException &ie) {
+        m_errors.add(ie);
+      }
+      return ( MatchImage() );
+    }
+
+  private:
+    MatchMaker::ErrorCollector &m_errors;
+};
+
+
+/**
+ * @brief Runs one matcher for QtConcurrent::blockingMapped
+ *
+ * Each matcher logs to its own string buffer so the debug output of
+ * concurrent matchers is not interleaved. The buffers are written to the
+ * MatchMaker logger in matcher order when all matchers are done.
+ *
+ * @internal
+ */
+class MatchMaker::MatcherFunctor {
+  public:
+    typedef SharedMatcherSolution result_type;
+
+    MatcherFunctor(MatchMaker &maker, const RobustMatcherList &matchers,
+                   QString *logs, MatchMaker::ErrorCollector &errors) :
+                   m_maker(maker), m_matchers(matchers), m_logs(logs),
+                   m_errors(errors) { }
+
+    SharedMatcherSolution operator()(const int &index) const {
+      QDebugStream stream = QDebugLogger::create(&m_logs[index]);
+      QLogger logger(stream, m_maker.isDebug());
+      SharedMatcherSolution solution;
+      try {
+        solution = SharedMatcherSolution(m_maker.match(m_matchers[index], logger));
+      }
+      catch (IException &ie) {
+        m_errors.add(ie);
+      }
+      stream->flush();
+      return ( solution );
+    }
+
+  private:
+    MatchMaker                 &m_maker;
+    const RobustMatcherList    &m_matchers;
+    QString                    *m_logs;
+    MatchMaker::ErrorCollector &m_errors;
+};
+
+
 MatchMaker::MatchMaker() : QLogger(), m_name("MatchMaker"),
                            m_parameters(), m_query(),  m_trainers(),
-                           m_geomFlag(None) { }
+                           m_geomFlag(None), m_networkMutex(new QMutex()) { }
 
 MatchMaker::MatchMaker(const QString &name,const PvlFlatMap &parameters,
                        const QLogger &logger) : QLogger(logger),
                        m_name(name), m_parameters(parameters),
-                       m_query(), m_trainers(), m_geomFlag(None)  { }
+                       m_query(), m_trainers(), m_geomFlag(None),
+                       m_networkMutex(new QMutex())  { }
+
+
+/**
+ * @brief Load a list of images concurrently
+ *
+ * Cube I/O, histograms and stretching of each image run in the global thread
+ * pool. Camera creation is serialized inside ImageSource.
+ *
+ * @param names Image file names to load
+ *
+ * @return MatchImageQList Loaded images in the same order as names
+ */
+MatchImageQList MatchMaker::load(const QStringList &names) {
+  ErrorCollector errors;
+  MatchImageQList images;
+  if ( isConcurrent() ) {
+    images = QtConcurrent::blockingMapped<MatchImageQList>(names,
+                                                           ImageLoader(errors));
+  }
+  else {
+    ImageLoader loader(errors);
+    BOOST_FOREACH ( const QString &name, names ) {
+      images.append( loader(name) );
+      errors.rethrow();
+    }
+  }
+  errors.rethrow();
+  return ( images );
+}
+
+
+/** Returns true if the global thread pool can run work concurrently */
+bool MatchMaker::isConcurrent() {
+  return ( QThreadPool::globalInstance()->maxThreadCount() > 1 );
+}
 
 
 QString MatchMaker::name() const {
@@ -126,9 +231,15 @@ MatchImage MatchMaker::getGeometrySource() const {
 }
 
 MatcherSolution *MatchMaker::match(const SharedRobustMatcher &matcher) {
+  return ( match(matcher, *this) );
+}
+
+
+MatcherSolution *MatchMaker::match(const SharedRobustMatcher &matcher,
+                                   const QLogger &logger) {
 
   // Pass along logging status
-  matcher->setDebugLogger( stream(), isDebug() );
+  matcher->setDebugLogger( logger.stream(), logger.isDebug() );
   MatchImage query_copy = m_query.clone();
   QList<MatchImage> trainers_copy;
   for (int i = 0; i < m_trainers.size();i++) {
@@ -152,12 +263,47 @@ MatcherSolution *MatchMaker::match(const SharedRobustMatcher &matcher) {
   return ( m );
 }
 
+/**
+ * @brief Run all matchers on the query and train images
+ *
+ * Matchers are independent of each other so they are run concurrently in the
+ * global thread pool. Each matcher works on its own clones of the images.
+ *
+ * @param matchers List of matchers to apply
+ *
+ * @return MatcherSolutionList Solutions in the same order as matchers
+ */
 MatcherSolutionList MatchMaker::match(const RobustMatcherList &matchers) {
-  // Thread here!!!!
   MatcherSolutionList solutions;
+  if ( !isConcurrent() || (matchers.size() < 2) ) {
+    for (int i = 0 ; i < matchers.size() ; i++) {
+      solutions.push_back(SharedMatcherSolution( match(matchers[i]) ));
+    }
+    return ( solutions );
+  }
+
+  QList<int> indexes;
+  for (int i = 0 ; i < matchers.size() ; i++) {
+    indexes.append(i);
+  }
+
+  QVector<QString> logs(matchers.size());
+  ErrorCollector errors;
+  solutions = QtConcurrent::blockingMapped<MatcherSolutionList>(indexes,
+                             MatcherFunctor(*this, matchers, logs.data(), errors));
+
+  // Reset the matchers to the common logger and write the buffered output
   for (int i = 0 ; i < matchers.size() ; i++) {
-    solutions.push_back(SharedMatcherSolution( match(matchers[i]) ));
+    matchers[i]->setDebugLogger( stream(), isDebug() );
+    if ( isDebug() ) {
+      logger() << logs[i];
+    }
   }
+  if ( isDebug() ) {
+    logger().flush();
+  }
+
+  errors.rethrow();
   return ( solutions );
 }
 
@@ -196,7 +342,9 @@ MatcherSolutionList MatchMaker::match(const RobustMatcherList &matchers) {
     logger().flush();
   }
 
-  // Create control network
+  // Create control network. Several solutions may be merged into the same
+  // network from different threads.
+  QMutexLocker lock(m_networkMutex.data());
   int nPoints = 0;
   int nBad = 0;
   Statistics pointStats;
@@ -22,15 +22,22 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QString>
+#include <QStringList>
 #include <QScopedPointer>
 #include <QSharedPointer>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 
 #include <opencv2/opencv.hpp>
 
 #include "ControlNet.h"
 #include "FeatureMatcherTypes.h"
 #include "ID.h"
+#include "IException.h"
 #include "MatchImage.h"
 #include "PvlFlatMap.h"
 #include "QDebugLogger.h"
@@ -52,6 +59,11 @@ class ControlMeasure;
  *   @history 2015-08-18 Kris Becker - Original Version 
  *   @history 2015-09-29 Kris Becker - Had line/sample transposed when computing 
  *                           apriori lat/lon
+ *
+ * Image loading (load()), pair processing (foreachPairConcurrent()) and
+ * matching of a list of matchers (match(RobustMatcherList)) are run in the
+ * global QThreadPool when it has more than one thread. The order of results
+ * and of the debug log is the same as a serial run.
  */
 
 class MatchMaker : public QLogger {
@@ -96,6 +108,23 @@ class MatchMaker : public QLogger {
         return ( npairs );
       }
 
+    /**
+     * Apply a process to every query/train pair using the global thread pool.
+     * The process must be safe to call from several threads at once since
+     * a single instance is shared by all pairs.
+     */
+    template <class T> int foreachPairConcurrent( const T &process ) {
+        if ( !isConcurrent() ) {  return ( foreachPair(process) );  }
+
+        ErrorCollector errors;
+        QtConcurrent::blockingMap(m_trainers,
+                                  PairFunctor<T>(m_query, process, errors));
+        errors.rethrow();
+        return ( m_trainers.size() );
+      }
+
+    static MatchImageQList load(const QStringList &names);
+
     void setGeometrySourceFlag(const GeometrySourceFlag &source);
     GeometrySourceFlag getGeometrySourceFlag() const;
     MatchImage getGeometrySource() const;
@@ -109,11 +138,83 @@ class MatchMaker : public QLogger {
   private:
     typedef  QScopedPointer<ControlPoint> ScopedControlPoint;
 
+    /**
+     * @brief Collects exceptions thrown in worker threads
+     *
+     * QtConcurrent only propagates QException types, so workers record
+     * IExceptions here and the calling thread rethrows them when the work is
+     * done.
+     *
+     * @internal
+     */
+    class ErrorCollector {
+      public:
+        ErrorCollector() : m_mutex(new QMutex()), m_errors() { }
+
+        void add(const IException &error) {
+          QMutexLocker lock(m_mutex.data());
+          m_errors.append(error);
+        }
+
+        void rethrow() const {
+          if ( m_errors.isEmpty() ) return;
+          if ( m_errors.size() == 1 ) throw m_errors[0];
+
+          IException ie(IException::Programmer,
+                        QString::number(m_errors.size()) +
+                        " errors occurred in concurrent matching", _FILEINFO_);
+          for (int i = 0 ; i < m_errors.size() ; i++) {
+            ie.append(m_errors[i]);
+          }
+          throw ie;
+        }
+
+      private:
+        QSharedPointer<QMutex> m_mutex;
+        QList<IException>      m_errors;
+    };
+
+    /**
+     * @brief Applies a pair process to one train image for QtConcurrent
+     *
+     * @internal
+     */
+    template <class T> class PairFunctor {
+      public:
+        typedef void result_type;
+
+        PairFunctor(MatchImage &query, const T &process,
+                    ErrorCollector &errors) : m_query(query),
+                    m_process(process), m_errors(errors) { }
+
+        void operator()(MatchImage &train) const {
+          try {
+            m_process.apply(m_query, train);
+          }
+          catch (IException &ie) {
+            m_errors.add(ie);
+          }
+        }
+
+      private:
+        MatchImage     &m_query;
+        const T        &m_process;
+        ErrorCollector &m_errors;
+    };
+
+    class ImageLoader;
+    class MatcherFunctor;
+
     QString             m_name;
     PvlFlatMap          m_parameters;
     MatchImage          m_query;
     MatchImageQList     m_trainers;
     GeometrySourceFlag  m_geomFlag;
+    QSharedPointer<QMutex> m_networkMutex; //!< Serializes network() merges
+
+    static bool isConcurrent();
+    MatcherSolution *match(const SharedRobustMatcher &matcher,
+                           const QLogger &logger);
 
     double getParameter(const QString &name, const PvlFlatMap &parameters, 
                         const double &defaultParm) const;
@@ -109,7 +109,7 @@ class QDebugLogger {
                                const QIODevice::OpenMode &omode = QIODevice::WriteOnly ) {
 
       // Check for string support in debugger
-#if ( STRING_DEBUG_SUPPORT == 0 )
+#if ( STRING_DEBUG_SUPPORTED == 0 )
        throw IException(IException::Programmer, 
                         "QDebugLogger does not support strings as an output device!",
                         _FILEINFO_);
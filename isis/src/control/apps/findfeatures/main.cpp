@@ -10,6 +10,7 @@
 #include <QSharedPointer>
 #include <QFile>
 #include <QTextStream>
+#include <QThreadPool>
 
 // OpenCV stuff
 #include "opencv2/core.hpp"
@@ -198,13 +199,19 @@ void IsisMain() {
   logger->dbugout() << "Number available CPUs:     " << nCPUs << "\n";
   logger->dbugout() << "Number default threads:    " << nthreads << "\n";
 
-  // See if user wants to restrict the number of threads used
+  // See if user wants to restrict the number of threads used. This applies to
+  // both OpenCV and the image loading, fast geom and matcher thread pool.
   int uthreads = nthreads;
   if ( ui.WasEntered("MAXTHREADS") ) {
     uthreads = ui.GetInteger("MAXTHREADS");
     if (uthreads < nthreads) cv::setNumThreads(uthreads);
+    if ( uthreads > 0 ) {
+      QThreadPool::globalInstance()->setMaxThreadCount(uthreads);
+    }
     logger->dbugout() << "User restricted threads:   " << uthreads << "\n";
   }
+  logger->dbugout() << "Matcher pool threads:      "
+                    << QThreadPool::globalInstance()->maxThreadCount() << "\n";
   int total_threads = cv::getNumThreads();
   logger->dbugout() << "Total threads:             " << total_threads << "\n";
   logger->flush();
@@ -215,22 +222,30 @@ void IsisMain() {
   MatchMaker matcher(ui.GetString("NETWORKID"));
   matcher.setDebugLogger(logger, p_debug );
 
-  // Acquire query image
-  matcher.setQueryImage(MatchImage(ImageSource(ui.GetAsString("MATCH"))));
+  // Query image is first in the list, trainer images follow
+  QStringList images;
+  images.append(ui.GetAsString("MATCH"));
 
   // Get the trainer images
   if ( ui.WasEntered("FROM") ) {
-    matcher.addTrainImage(MatchImage(ImageSource(ui.GetAsString("FROM"))));
+    images.append(ui.GetAsString("FROM"));
   }
 
   // If there is a list provided, get that too
   if ( ui.WasEntered("FROMLIST") ) {
     FileList trainers(ui.GetFileName("FROMLIST"));
     BOOST_FOREACH ( FileName tfile, trainers ) {
-      matcher.addTrainImage(MatchImage(ImageSource(tfile.original())));
+      images.append(tfile.original());
     }
   }
 
+  // Load all images in the thread pool
+  MatchImageQList loaded = MatchMaker::load(images);
+  matcher.setQueryImage(loaded.takeFirst());
+  BOOST_FOREACH ( const MatchImage &train, loaded ) {
+    matcher.addTrainImage(train);
+  }
+
   // Got to have both file names provided at this point
   if ( matcher.size() <= 0 ) {
     throw IException(IException::User,
@@ -246,7 +261,7 @@ void IsisMain() {
   // Check for FASTGEOM option
   if ( ui.GetBoolean("FASTGEOM") ) {
     FastGeom geom( factory->globalParameters() );
-    matcher.foreachPair( geom );
+    matcher.foreachPairConcurrent( geom );
   }
 
   // Check for Sobel/Scharr filtering options for both Train and Images
@@ -275,6 +275,7 @@ void IsisMain() {
       cropLines(mainPipeline.FinalOutput(i), eTime1, eTime2, line1, line2, numLines);
       Pipeline pcrop("Crop Pipeline");
       pcrop.KeepTemporaryFiles(false);
+      pcrop.SetInProcess(true);
 
       QString tag = "crop" + toString(i);
       QString inFile(mainPipeline.FinalOutput(i));
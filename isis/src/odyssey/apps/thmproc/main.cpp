@@ -80,6 +80,8 @@ void ProcessVis(bool isRdr) {
   // Set continue to false so that we know if something fails
   p.SetContinue(false);
   p.KeepTemporaryFiles(!ui.GetBoolean("REMOVE"));
+  // thmvisflat and thmvistrim run in this process and keep the flat cubes in memory
+  p.SetInProcess(true);
 
   p.AddToPipeline("thm2isis");
   p.Application("thm2isis").SetInputParameter("FROM", false);
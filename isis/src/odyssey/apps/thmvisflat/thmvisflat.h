@@ -0,0 +1,10 @@
+#ifndef thmvisflat_h
+#define thmvisflat_h
+
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void thmvisflat(UserInterface &ui);
+}
+
+#endif
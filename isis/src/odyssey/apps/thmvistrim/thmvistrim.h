@@ -0,0 +1,10 @@
+#ifndef thmvistrim_h
+#define thmvistrim_h
+
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void thmvistrim(UserInterface &ui);
+}
+
+#endif
@@ -30,6 +30,7 @@
 #include "IString.h"
 #include "iTime.h"
 #include "Kernel.h"
+#include "KernelDbIndex.h"
 #include "Preference.h"
 #include "Preference.h"
 #include "PvlGroup.h"
@@ -87,7 +88,7 @@ namespace Isis {
    * @see KernelDb(int)
    */
   KernelDb::KernelDb(const QString &dbName, const unsigned int allowedKernelTypes) :
-    m_kernelData(dbName) {
+    m_kernelData(Pvl(dbName)) {
     m_filename = dbName;
     m_allowedKernelTypes = allowedKernelTypes;
     m_kernelDbFiles.clear();
@@ -116,7 +117,9 @@ namespace Isis {
    * @see KernelDb(int)
    */
   KernelDb::KernelDb(std::istream &dbStream, const unsigned int allowedKernelTypes) {
-    dbStream >> m_kernelData;
+    Pvl kernelData;
+    dbStream >> kernelData;
+    m_kernelData = KernelDbIndex(kernelData);
     m_filename = "internal stream";
     m_allowedKernelTypes = allowedKernelTypes;
     m_kernelDbFiles.clear();
@@ -364,7 +367,7 @@ namespace Isis {
    * Finds all of the Kernel objects for the given entry value based on the
    * allowed Kernel types. This method returns a list of priority queues.  Each
    * priority queue corresponds to a kernel db file object of the same name as
-   * the entry in the kernelData pvl.
+   * the entry in the kernelData index.
    *
    *
    * @param entry The name of the kernel, dem, or entry that will be searched
@@ -399,6 +402,7 @@ namespace Isis {
     // Get the start and end time for the cube
     iTime start;
     iTime end;
+    QString instrumentId;
 
     if (cube.hasGroup("Instrument")) {
       start = (QString) cube.findGroup("Instrument")["StartTime"];
@@ -409,27 +413,40 @@ namespace Isis {
       else {
         end = ((QString) cube.findGroup("Instrument")["StartTime"]);
       }
+
+      // The InstrumentId narrows the selections searched
+      try {
+        if (cube.findGroup("Instrument").hasKeyword("InstrumentId")) {
+          instrumentId = cube.findGroup("Instrument")["InstrumentId"];
+          instrumentId = instrumentId.simplified().trimmed().toUpper();
+        }
+      }
+      catch (IException &) {
+        instrumentId = "";
+      }
     }
 
     // Loop through the objects to look for all matches to the entry value
     for (int i = 0; i < m_kernelData.objects(); i++) {
-      if (m_kernelData.object(i).isNamed(entry)) {
+      if (PvlKeyword::stringEqual(entry, m_kernelData.objectName(i))) {
         priority_queue<Kernel> filesFound;
-        PvlObject &obj = m_kernelData.object(i);
 
-        for (int groupIndex = obj.groups() - 1; groupIndex >= 0; groupIndex--) {
-          // Get the group and start testing the cases in the keywords
-          // to see if they all match this cube
-          PvlGroup &grp = obj.group(groupIndex);
+        // Only selections that can match the start time can be used, and only
+        // selections that can match the end time can complete them. Both lists
+        // are in decreasing order, which is the order the selections are tried.
+        QList<int> startSelections = m_kernelData.selections(i, start.Et(), instrumentId);
+        QList<int> endSelections = m_kernelData.selections(i, end.Et(), instrumentId);
 
-          // If the group name isn't selection, skip it.
-          if (!grp.isNamed("Selection")) continue;
+        foreach (int groupIndex, startSelections) {
+          // Get the selection and start testing the criteria to see if they
+          // all match this cube
+          const KernelDbIndex::Selection &grp = m_kernelData.selection(i, groupIndex);
 
           QString type = "";
 
           // Make sure the type is allowed
-          if (grp.hasKeyword("Type")) {
-            type = (QString) grp["Type"];
+          if (grp.hasType) {
+            type = grp.type;
             if (!(Kernel::typeEnum(type) & m_allowedKernelTypes)) {
               // will return 1 for each bit that has 1 in both type and allowed and
               // return 0 for all other bits
@@ -441,37 +458,30 @@ namespace Isis {
             }
           }
 
-          bool startMatches = matches(lab, grp, start, cameraVersion);
-          bool endMatches = matches(lab, grp, end, cameraVersion);
+          bool startMatches = matches(cube, grp, start.Et(), cameraVersion);
+          bool endMatches = matches(cube, grp, end.Et(), cameraVersion);
 
           if (startMatches && endMatches) {
             // Simple case - the selection simply matches
             filesFound.push(Kernel(Kernel::typeEnum(type), files(grp)));
-            QStringList kernelfiles = files(grp);
           }
           else if (startMatches) {
             // Well, the selection start matched but not the end.
             // Let's look for a second selection to handle overlap areas.
-            for (int endTimeIndex = obj.groups() - 1;
-                endTimeIndex >= 0;
-                endTimeIndex--) {
-
-              PvlGroup &endTimeGrp = obj.group(endTimeIndex);
+            foreach (int endTimeIndex, endSelections) {
+              const KernelDbIndex::Selection &endTimeGrp =
+                  m_kernelData.selection(i, endTimeIndex);
 
               // The second selection must:
               //   Not be the current selection
-              //   Be a selection
               //   Be of the same quality
               //   Match the end time
               //
               // *If start time is also matched, do not merge and simply take the
               // secondary match
               if (endTimeIndex == groupIndex) continue;
-              if (!endTimeGrp.isNamed("Selection")) continue;
-              if (grp.hasKeyword("Type") != endTimeGrp.hasKeyword("Type")) continue;
-              if (grp.hasKeyword("Type") &&
-                  grp["Type"] != endTimeGrp["Type"]) continue;
-              if (!matches(lab, endTimeGrp, end, cameraVersion)) continue;
+              if (grp.hasType != endTimeGrp.hasType) continue;
+              if (!matches(cube, endTimeGrp, end.Et(), cameraVersion)) continue;
 
               // Better match is true if we find a full overlap
               bool betterMatch = false;
@@ -480,22 +490,17 @@ namespace Isis {
               bool endTimesMatch = true;
 
               // Check for matching time ranges
-              for (int keyIndex = 0;
-                  !betterMatch && keyIndex < grp.keywords();
-                  keyIndex++) {
-                PvlKeyword &key = grp[keyIndex];
-
-                if (!key.isNamed("Time")) continue;
+              for (int timeIndex = 0;
+                  !betterMatch && timeIndex < grp.times.size();
+                  timeIndex++) {
+                double timeRangeEnd = grp.times[timeIndex].second;
 
-                iTime timeRangeStart((QString)key[0]);
-                iTime timeRangeEnd((QString)key[1]);
-
-                bool thisEndMatches = matches(lab, endTimeGrp,
+                bool thisEndMatches = matches(cube, endTimeGrp,
                                               timeRangeEnd, cameraVersion);
                 endTimesMatch = endTimesMatch && thisEndMatches;
 
-                if (matches(lab, endTimeGrp, start, cameraVersion)
-                   && matches(lab, endTimeGrp, end, cameraVersion)) {
+                if (matches(cube, endTimeGrp, start.Et(), cameraVersion)
+                   && matches(cube, endTimeGrp, end.Et(), cameraVersion)) {
                   // If we run into a continuous kernel, we want to take that in all
                   //   cases.
                   betterMatch = true;
@@ -518,7 +523,6 @@ namespace Isis {
               // Found an exact match, use it
               else if (betterMatch) {
                 filesFound.push(Kernel(Kernel::typeEnum(type), files(endTimeGrp)));
-                QStringList kernelfiles = files(endTimeGrp);
               }
             }
           }
@@ -613,70 +617,146 @@ namespace Isis {
       }
       else if (key.isNamed("Match")) {
         try {
-          QString matchGroup = key[0];
-          QString matchKey   = key[1];
-          QString matchValue = key[2];
-
-          QString cubeValue = cube.findGroup(matchGroup)[matchKey];
-          cubeValue = cubeValue.simplified().trimmed().toUpper();
-          matchValue = matchValue.simplified().trimmed().toUpper();
-
-          // If QStrings are not the same, match automatically fails
-          if (cubeValue.compare(matchValue) != 0) {
+          if (!matchesKeyword(cube, key[0], key[1], key[2])) {
             matchKeywords = false;
           }
         }
         catch (IException &e) {
-          // This error is thrown if the group or keyword do not exist in 'lab'
+          // This error is thrown if the Match keyword has too few values
           matchKeywords = false;
         }
       }
       else if (key.isNamed("CameraVersion")) {
-        try {
-          for (int camVersionKeyIndex = 0;
-              camVersionKeyIndex < key.size();
-              camVersionKeyIndex++) {
-
-            bool versionMatch = false;
-            IString val = key[camVersionKeyIndex];
-            IString commaTok;
-
-            while ((commaTok = val.Token(",")).ToQt().length() > 0) {
-              if (commaTok.find('-') != string::npos) {
-                QString dashTok;
-                int start = commaTok.Token("-").ToInteger();
-                int end = commaTok.Token("-").ToInteger();
-                int direction;
-                direction = (start <= end) ? 1 : -1;
-                // Save the entire range of bands
-                for (int version = start;
-                    version != end + direction;
-                    version += direction) {
-                  if (version == cameraVersion) {
-                    versionMatch = true;
-                  }
-                }
-              }
-              // This token is a single band specification
-              else {
-                if (commaTok.ToInteger() == cameraVersion) {
-                  versionMatch = true;
-                }
+        QStringList versions;
+        for (int camVersionKeyIndex = 0;
+            camVersionKeyIndex < key.size();
+            camVersionKeyIndex++) {
+          versions.append(key[camVersionKeyIndex]);
+        }
+
+        if (!matchesCameraVersion(versions, cameraVersion)) {
+          matchKeywords = false;
+        }
+      }
+    }
+
+    return matchKeywords && matchTime;
+  }
+
+
+  /**
+   * Determines whether the given cube label matches a compiled Selection group,
+   * using the same criteria as matches(const Pvl &, PvlGroup &, iTime, int).
+   *
+   * @param cube The IsisCube object of the labels to be searched
+   * @param selection A compiled Selection group from the kernel database
+   * @param et The ephemeris time to match
+   * @param cameraVersion The camera version to be matched with the cube labels
+   *
+   * @return @b bool Indicates whether all of the given criteria was matched.
+   */
+  bool KernelDb::matches(const PvlObject &cube, const KernelDbIndex::Selection &selection,
+                         double et, int cameraVersion) {
+    bool matchTime = selection.times.isEmpty();
+
+    for (int i = 0; !matchTime && i < selection.times.size(); i++) {
+      if ((selection.times[i].first <= et) && (selection.times[i].second >= et)) {
+        matchTime = true;
+      }
+    }
+
+    if (!matchTime) return false;
+
+    foreach (const KernelDbIndex::Match &match, selection.matches) {
+      if (!match.valid || !matchesKeyword(cube, match.group, match.keyword, match.value)) {
+        return false;
+      }
+    }
+
+    return matchesCameraVersion(selection.cameraVersions, cameraVersion);
+  }
+
+
+  /**
+   * Determines whether a keyword in the labels has the given value. Values are
+   * compared after simplifying white space and converting to upper case.
+   *
+   * @param cube The IsisCube object of the labels to be searched
+   * @param group The name of the group in the labels
+   * @param keyword The name of the keyword in the group
+   * @param value The value to compare to the keyword
+   *
+   * @return @b bool False if the values differ or the group or keyword does not
+   *         exist in the labels
+   */
+  bool KernelDb::matchesKeyword(const PvlObject &cube, const QString &group,
+                                const QString &keyword, const QString &value) {
+    try {
+      QString cubeValue = cube.findGroup(group)[keyword];
+      cubeValue = cubeValue.simplified().trimmed().toUpper();
+      QString matchValue = value.simplified().trimmed().toUpper();
+
+      // If QStrings are not the same, match automatically fails
+      return cubeValue.compare(matchValue) == 0;
+    }
+    catch (IException &e) {
+      // This error is thrown if the group or keyword do not exist in 'lab'
+      return false;
+    }
+  }
+
+
+  /**
+   * Determines whether a camera version is in every one of a list of
+   * CameraVersion values. Each value is a comma separated list of versions and
+   * version ranges, such as "1-3, 5".
+   *
+   * @param versions The CameraVersion keyword values
+   * @param cameraVersion The camera version of the cube
+   *
+   * @return @b bool False if any value does not contain the version or can not
+   *         be parsed
+   */
+  bool KernelDb::matchesCameraVersion(const QStringList &versions, int cameraVersion) {
+    try {
+      foreach (QString value, versions) {
+        bool versionMatch = false;
+        IString val = value;
+        IString commaTok;
+
+        while ((commaTok = val.Token(",")).ToQt().length() > 0) {
+          if (commaTok.find('-') != string::npos) {
+            int start = commaTok.Token("-").ToInteger();
+            int end = commaTok.Token("-").ToInteger();
+            int direction;
+            direction = (start <= end) ? 1 : -1;
+            // Save the entire range of bands
+            for (int version = start;
+                version != end + direction;
+                version += direction) {
+              if (version == cameraVersion) {
+                versionMatch = true;
               }
             }
-
-            if (!versionMatch) {
-              matchKeywords = false;
+          }
+          // This token is a single band specification
+          else {
+            if (commaTok.ToInteger() == cameraVersion) {
+              versionMatch = true;
             }
           }
         }
-        catch (IException &) {
-          matchKeywords = false;
+
+        if (!versionMatch) {
+          return false;
         }
       }
     }
+    catch (IException &) {
+      return false;
+    }
 
-    return matchKeywords && matchTime;
+    return true;
   }
 
   /**
@@ -835,7 +915,9 @@ namespace Isis {
   /**
    * This method is called by loadSystemDb() to read kernel database file list
    * compiled by loadKernelDbFiles() and add the contents of these database
-   * files to the kernelData pvl.
+   * files to the kernelData index. Each file is loaded with
+   * KernelDbIndex::load(), which reads a current index file instead of
+   * parsing the database file when one exists.
    *
    * To check which kernel database files will be read in by this method, file
    * names may be accessed by calling kernelDbFiles().
@@ -853,7 +935,7 @@ namespace Isis {
     // read each of the database files appended to the list into m_kernelData
     foreach (FileName kernelDbFile, m_kernelDbFiles) {
       try {
-        m_kernelData.read(kernelDbFile.expanded());
+        m_kernelData.append(KernelDbIndex::load(kernelDbFile));
       }
       catch (IException &e) {
         QString msg = "Unable to read kernel database file ["
@@ -877,19 +959,18 @@ namespace Isis {
 
   /**
    * This method retrieves the values of all of the "File" keywords in the given
-   * PvlGroup.
+   * compiled Selection group.
    *
-   * @param grp The PvlGroup that containing file names to be retrieved
+   * @param grp The Selection group that containing file names to be retrieved
    *
    * @return @b QStringList A list containing the file names found in the
    *         given group.
    */
-  QStringList KernelDb::files(PvlGroup &grp) {
+  QStringList KernelDb::files(const KernelDbIndex::Selection &grp) {
     QStringList files;
 
-    for (int i = 0; i < grp.keywords(); i++) {
-      PvlKeyword kfile = grp[i];
-      if (kfile.name() != "File") continue;
+    for (int i = 0; i < grp.files.size(); i++) {
+      const QStringList &kfile = grp.files[i];
 
       // Two values in the "File" keyword from the DB,
       // indicates an ISIS preference in the DataDirectory section
@@ -911,7 +992,7 @@ namespace Isis {
       }
       else {
         QString msg = "Invalid File keyword value in [Group = ";
-        msg += grp.name() + "] in database file [";
+        msg += "Selection] in database file [";
         msg += m_filename + "]";
         throw IException(IException::Unknown, msg, _FILEINFO_);
       }
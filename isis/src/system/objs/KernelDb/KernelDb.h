@@ -32,6 +32,7 @@
 
 #include "iTime.h"//???
 #include "Kernel.h"
+#include "KernelDbIndex.h"
 #include "Pvl.h"
 
 namespace Isis {
@@ -148,7 +149,15 @@ namespace Isis {
                              const Pvl &lab);
       void readKernelDbFiles();
 
-      QStringList files(PvlGroup &grp);
+      static bool matches(const PvlObject &cube,
+                          const KernelDbIndex::Selection &selection,
+                          double et, int cameraVersion);
+      static bool matchesKeyword(const PvlObject &cube, const QString &group,
+                                 const QString &keyword, const QString &value);
+      static bool matchesCameraVersion(const QStringList &versions,
+                                       int cameraVersion);
+
+      QStringList files(const KernelDbIndex::Selection &grp);
       QString m_filename; /**< The name of the kernel database file. This
                                may be set to "None" or "internal stream".*/
       QList<FileName> m_kernelDbFiles; /**< List of the kernel database file
@@ -162,9 +171,10 @@ namespace Isis {
                                               enumeration types are  expressed
                                               binary numbers, it is clear which
                                               types are allowed.*/
-      Pvl m_kernelData; /**< Pvl containing the information in the kernel
-                             database(s) that is read in from the constructor
-                             and whenever the loadSystemDb() method is called.*/
+      KernelDbIndex m_kernelData; /**< The compiled information in the kernel
+                                       database(s) that is read in from the
+                                       constructor and whenever the
+                                       loadSystemDb() method is called.*/
   };
 };
 
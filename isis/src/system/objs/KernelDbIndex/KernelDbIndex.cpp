@@ -0,0 +1,621 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "KernelDbIndex.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <functional>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "FileName.h"
+#include "IException.h"
+#include "iTime.h"
+#include "Preference.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+
+using namespace std;
+
+namespace Isis {
+
+  //! Identifies kernel database index files ("KDBI")
+  static const quint32 IndexMagic = 0x4B444249;
+
+  //! The version of the index file layout, increase it when the layout changes
+  static const quint32 IndexVersion = 1;
+
+
+  /**
+   * Constructs an empty interval tree.
+   */
+  KernelDbIndex::IntervalTree::IntervalTree() {
+  }
+
+
+  /**
+   * Adds a closed range to the tree. build() must be called after the last
+   * range is added and before the tree is searched.
+   *
+   * @param start The start of the range
+   * @param end The end of the range
+   * @param value The value returned by stab() for this range
+   */
+  void KernelDbIndex::IntervalTree::add(double start, double end, int value) {
+    m_starts.append(start);
+    m_ends.append(end);
+    m_values.append(value);
+    m_maxEnds.clear();
+  }
+
+
+  /**
+   * Sorts the ranges by start and computes the largest range end of every
+   * subtree.
+   */
+  void KernelDbIndex::IntervalTree::build() {
+    QVector<int> order(m_starts.size());
+    for (int i = 0; i < order.size(); i++) {
+      order[i] = i;
+    }
+
+    // A stable sort keeps the tree the same for the same ranges
+    const QVector<double> &starts = m_starts;
+    stable_sort(order.begin(), order.end(),
+                [&starts](int a, int b) { return starts[a] < starts[b]; });
+
+    QVector<double> sortedStarts(order.size());
+    QVector<double> sortedEnds(order.size());
+    QVector<int> sortedValues(order.size());
+    for (int i = 0; i < order.size(); i++) {
+      sortedStarts[i] = m_starts[order[i]];
+      sortedEnds[i] = m_ends[order[i]];
+      sortedValues[i] = m_values[order[i]];
+    }
+
+    m_starts = sortedStarts;
+    m_ends = sortedEnds;
+    m_values = sortedValues;
+
+    m_maxEnds.resize(m_starts.size());
+    buildMaxEnds(0, m_starts.size());
+  }
+
+
+  /**
+   * Finds the values of all ranges that contain a point.
+   *
+   * @param point The point to search for
+   *
+   * @return QList<int> The values of the ranges containing the point, in
+   *         no particular order
+   */
+  QList<int> KernelDbIndex::IntervalTree::stab(double point) const {
+    QList<int> found;
+    stab(0, m_maxEnds.size(), point, found);
+    return found;
+  }
+
+
+  /**
+   * Computes the largest range end of the subtree holding the ranges
+   * [first, last). The root of the subtree is the middle range.
+   *
+   * @param first The first range of the subtree
+   * @param last One past the last range of the subtree
+   *
+   * @return double The largest range end of the subtree
+   */
+  double KernelDbIndex::IntervalTree::buildMaxEnds(int first, int last) {
+    if (first >= last) return -DBL_MAX;
+
+    int middle = (first + last) / 2;
+    double maxEnd = m_ends[middle];
+    maxEnd = max(maxEnd, buildMaxEnds(first, middle));
+    maxEnd = max(maxEnd, buildMaxEnds(middle + 1, last));
+
+    m_maxEnds[middle] = maxEnd;
+    return maxEnd;
+  }
+
+
+  /**
+   * Finds the ranges of the subtree [first, last) that contain a point.
+   *
+   * @param first The first range of the subtree
+   * @param last One past the last range of the subtree
+   * @param point The point to search for
+   * @param found The values of the ranges found are appended to this list
+   */
+  void KernelDbIndex::IntervalTree::stab(int first, int last, double point,
+                                         QList<int> &found) const {
+    if (first >= last) return;
+
+    int middle = (first + last) / 2;
+
+    // Nothing in this subtree ends at or after the point
+    if (m_maxEnds[middle] < point) return;
+
+    stab(first, middle, point, found);
+
+    // Everything after the middle starts after the point when the middle does
+    if (m_starts[middle] <= point) {
+      if (m_ends[middle] >= point) {
+        found.append(m_values[middle]);
+      }
+
+      stab(middle + 1, last, point, found);
+    }
+  }
+
+
+  /**
+   * Constructs an empty kernel database index.
+   */
+  KernelDbIndex::KernelDbIndex() {
+  }
+
+
+  /**
+   * Compiles the objects of a kernel database.
+   *
+   * @param kernelDb The kernel database to compile
+   */
+  KernelDbIndex::KernelDbIndex(const Pvl &kernelDb) {
+    for (int i = 0; i < kernelDb.objects(); i++) {
+      const PvlObject &obj = kernelDb.object(i);
+
+      Object object;
+      object.name = obj.name();
+
+      for (int groupIndex = 0; groupIndex < obj.groups(); groupIndex++) {
+        const PvlGroup &grp = obj.group(groupIndex);
+        if (grp.isNamed("Selection")) {
+          object.selections.append(compile(grp));
+        }
+      }
+
+      buildTrees(object);
+      m_objects.append(object);
+    }
+  }
+
+
+  /**
+   * Destroys the kernel database index.
+   */
+  KernelDbIndex::~KernelDbIndex() {
+  }
+
+
+  /**
+   * Adds the objects of another index after the objects of this one, the same
+   * way reading another kernel database file into a Pvl adds its objects.
+   *
+   * @param other The index to add
+   */
+  void KernelDbIndex::append(const KernelDbIndex &other) {
+    m_objects.append(other.m_objects);
+  }
+
+
+  /**
+   * @return int The number of kernel database objects
+   */
+  int KernelDbIndex::objects() const {
+    return m_objects.size();
+  }
+
+
+  /**
+   * Checks for an object with the given name, compared the same way as
+   * PvlObject::hasObject().
+   *
+   * @param name The object name, such as SpacecraftPointing
+   *
+   * @return bool True if the index has an object with the name
+   */
+  bool KernelDbIndex::hasObject(const QString &name) const {
+    for (int i = 0; i < m_objects.size(); i++) {
+      if (PvlKeyword::stringEqual(name, m_objects[i].name)) return true;
+    }
+
+    return false;
+  }
+
+
+  /**
+   * @param object The index of the object
+   *
+   * @return QString The name of the object
+   */
+  QString KernelDbIndex::objectName(int object) const {
+    return m_objects[object].name;
+  }
+
+
+  /**
+   * @param object The index of the object
+   * @param index The index of the selection in the object
+   *
+   * @return const Selection& The compiled Selection group
+   */
+  const KernelDbIndex::Selection &KernelDbIndex::selection(int object, int index) const {
+    return m_objects[object].selections[index];
+  }
+
+
+  /**
+   * Finds the selections of an object that may match an ephemeris time and
+   * InstrumentId. The result contains every selection with no Time keyword or a
+   * Time range containing the time, and no InstrumentId Match keyword or one
+   * matching the InstrumentId. The other criteria of the selections are not
+   * tested.
+   *
+   * @param object The index of the object
+   * @param et The ephemeris time to match
+   * @param instrumentId The simplified, upper case InstrumentId of the label, or
+   *                     an empty string if the label has none
+   *
+   * @return QList<int> The indices of the selections found, in decreasing order
+   */
+  QList<int> KernelDbIndex::selections(int object, double et,
+                                       const QString &instrumentId) const {
+    const Object &obj = m_objects[object];
+    QList<int> found;
+
+    QMap<QString, IntervalTree>::const_iterator tree = obj.trees.find("");
+    if (tree != obj.trees.end()) {
+      found.append(tree.value().stab(et));
+    }
+
+    if (!instrumentId.isEmpty()) {
+      tree = obj.trees.find(instrumentId);
+      if (tree != obj.trees.end()) {
+        found.append(tree.value().stab(et));
+      }
+    }
+
+    // A selection with more than one Time range can be found more than once
+    sort(found.begin(), found.end(), greater<int>());
+    found.erase(unique(found.begin(), found.end()), found.end());
+
+    return found;
+  }
+
+
+  /**
+   * Writes the compiled objects to a stream.
+   *
+   * @param stream The stream to write to
+   */
+  void KernelDbIndex::write(QDataStream &stream) const {
+    stream << (qint32) m_objects.size();
+
+    foreach (const Object &object, m_objects) {
+      stream << object.name << (qint32) object.selections.size();
+
+      foreach (const Selection &selection, object.selections) {
+        stream << selection.hasType << selection.type << selection.times;
+
+        stream << (qint32) selection.matches.size();
+        foreach (const Match &match, selection.matches) {
+          stream << match.valid << match.group << match.keyword << match.value;
+        }
+
+        stream << selection.cameraVersions << selection.files;
+      }
+    }
+  }
+
+
+  /**
+   * Replaces the objects of this index with compiled objects read from a
+   * stream written by write().
+   *
+   * @param stream The stream to read from
+   *
+   * @throws IException::Io "Unable to read the kernel database index"
+   */
+  void KernelDbIndex::read(QDataStream &stream) {
+    m_objects.clear();
+
+    qint32 objectCount = 0;
+    stream >> objectCount;
+
+    for (int i = 0; stream.status() == QDataStream::Ok && i < objectCount; i++) {
+      Object object;
+      qint32 selectionCount = 0;
+      stream >> object.name >> selectionCount;
+
+      for (int j = 0; stream.status() == QDataStream::Ok && j < selectionCount; j++) {
+        Selection selection;
+        stream >> selection.hasType >> selection.type >> selection.times;
+
+        qint32 matchCount = 0;
+        stream >> matchCount;
+        for (int k = 0; stream.status() == QDataStream::Ok && k < matchCount; k++) {
+          Match match;
+          stream >> match.valid >> match.group >> match.keyword >> match.value;
+          selection.matches.append(match);
+        }
+
+        stream >> selection.cameraVersions >> selection.files;
+        object.selections.append(selection);
+      }
+
+      buildTrees(object);
+      m_objects.append(object);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+      m_objects.clear();
+      QString msg = "Unable to read the kernel database index";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+  }
+
+
+  /**
+   * Loads the compiled form of a kernel database file. If index files are
+   * enabled and the index file of the kernel database is current, it is read
+   * instead of the kernel database. Otherwise the kernel database is read and
+   * compiled, and the index file is rewritten. Failing to read or write the
+   * index file is not an error.
+   *
+   * @param kernelDbFile The kernel database file to load
+   *
+   * @return KernelDbIndex The compiled kernel database
+   */
+  KernelDbIndex KernelDbIndex::load(const FileName &kernelDbFile) {
+    QString indexFile = indexFileName(kernelDbFile);
+    QString currentStamp;
+
+    if (!indexFile.isEmpty()) {
+      try {
+        currentStamp = stamp(kernelDbFile);
+
+        QFile file(indexFile);
+        if (file.open(QIODevice::ReadOnly)) {
+          QDataStream stream(&file);
+          stream.setVersion(QDataStream::Qt_5_0);
+
+          quint32 magic = 0;
+          quint32 version = 0;
+          QString indexStamp;
+          stream >> magic >> version;
+
+          if (magic == IndexMagic && version == IndexVersion) {
+            stream >> indexStamp;
+
+            if (indexStamp == currentStamp) {
+              KernelDbIndex index;
+              index.read(stream);
+              return index;
+            }
+          }
+        }
+      }
+      catch (IException &) {
+        // Compile the kernel database instead
+      }
+    }
+
+    KernelDbIndex index(Pvl(kernelDbFile.expanded()));
+
+    if (!currentStamp.isEmpty()) {
+      // Write the whole index or nothing, other processes may be reading it
+      QSaveFile file(indexFile);
+      if (file.open(QIODevice::WriteOnly)) {
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream << IndexMagic << IndexVersion << currentStamp;
+        index.write(stream);
+
+        if (stream.status() == QDataStream::Ok) {
+          file.commit();
+        }
+        else {
+          file.cancelWriting();
+        }
+      }
+    }
+
+    return index;
+  }
+
+
+  /**
+   * Returns the InstrumentId a Match keyword requires, which is used to key
+   * the interval trees.
+   *
+   * @param match The compiled Match keyword
+   *
+   * @return QString The InstrumentId value of the Match keyword, or an empty
+   *         string if it does not match the Instrument group InstrumentId
+   */
+  QString KernelDbIndex::instrumentId(const Match &match) {
+    if (match.valid &&
+        PvlKeyword::stringEqual(match.group, "Instrument") &&
+        PvlKeyword::stringEqual(match.keyword, "InstrumentId")) {
+      return match.value;
+    }
+
+    return "";
+  }
+
+
+  /**
+   * Compiles a Selection group. Time ranges are converted to ephemeris times
+   * with iTime, which loads the leapsecond kernel.
+   *
+   * @param grp The Selection group to compile
+   *
+   * @return Selection The compiled group
+   */
+  KernelDbIndex::Selection KernelDbIndex::compile(const PvlGroup &grp) {
+    Selection selection;
+    selection.hasType = grp.hasKeyword("Type");
+    if (selection.hasType) {
+      selection.type = (QString) grp["Type"];
+    }
+
+    for (int keyIndex = 0; keyIndex < grp.keywords(); keyIndex++) {
+      const PvlKeyword &key = grp[keyIndex];
+
+      if (key.isNamed("Time")) {
+        iTime start = (QString) key[0];
+        iTime end = (QString) key[1];
+        selection.times.append(qMakePair(start.Et(), end.Et()));
+      }
+      else if (key.isNamed("Match")) {
+        Match match;
+        match.valid = key.size() >= 3;
+        if (match.valid) {
+          match.group = key[0];
+          match.keyword = key[1];
+          match.value = key[2].simplified().trimmed().toUpper();
+        }
+        selection.matches.append(match);
+      }
+      else if (key.isNamed("CameraVersion")) {
+        for (int i = 0; i < key.size(); i++) {
+          selection.cameraVersions.append(key[i]);
+        }
+      }
+
+      if (key.name() == "File") {
+        QStringList values;
+        for (int i = 0; i < key.size(); i++) {
+          values.append(key[i]);
+        }
+        selection.files.append(values);
+      }
+    }
+
+    return selection;
+  }
+
+
+  /**
+   * Puts the Time ranges of the selections of an object into interval trees
+   * keyed by the InstrumentId they match. Selections with no Time keyword
+   * match every time.
+   *
+   * @param object The object to build the trees for
+   */
+  void KernelDbIndex::buildTrees(Object &object) {
+    object.trees.clear();
+
+    for (int i = 0; i < object.selections.size(); i++) {
+      const Selection &selection = object.selections[i];
+
+      QString key;
+      foreach (const Match &match, selection.matches) {
+        key = instrumentId(match);
+        if (!key.isEmpty()) break;
+      }
+
+      IntervalTree &tree = object.trees[key];
+      if (selection.times.isEmpty()) {
+        tree.add(-DBL_MAX, DBL_MAX, i);
+      }
+
+      for (int j = 0; j < selection.times.size(); j++) {
+        tree.add(selection.times[j].first, selection.times[j].second, i);
+      }
+    }
+
+    QMap<QString, IntervalTree>::iterator tree;
+    for (tree = object.trees.begin(); tree != object.trees.end(); ++tree) {
+      tree.value().build();
+    }
+  }
+
+
+  /**
+   * Returns the index file name of a kernel database file. Index files are
+   * named by a hash of the kernel database path and kept in the directory
+   * given by the KernelDbCache keyword of the Performance preferences group.
+   *
+   * @param kernelDbFile The kernel database file
+   *
+   * @return QString The index file name, or an empty string if index files are
+   *         not enabled or the directory can not be created
+   */
+  QString KernelDbIndex::indexFileName(const FileName &kernelDbFile) {
+    Pvl &preferences = Preference::Preferences();
+    if (!preferences.hasGroup("Performance")) return "";
+
+    PvlGroup &performance = preferences.findGroup("Performance");
+    if (!performance.hasKeyword("KernelDbCache")) return "";
+
+    QString cacheDir = performance["KernelDbCache"];
+    if (cacheDir.isEmpty() || cacheDir.toUpper() == "NONE") return "";
+
+    cacheDir = FileName(cacheDir).expanded();
+    if (!QDir().mkpath(cacheDir)) return "";
+
+    QByteArray path = kernelDbFile.expanded().toUtf8();
+    QString hash = QCryptographicHash::hash(path, QCryptographicHash::Md5).toHex();
+
+    return cacheDir + "/" + hash + ".kdbi";
+  }
+
+
+  /**
+   * Returns a string identifying the current contents of a kernel database
+   * file. It holds the path, size and modification time of the kernel database
+   * and of the leapsecond kernel used to convert its times.
+   *
+   * @param kernelDbFile The kernel database file
+   *
+   * @return QString The stamp stored in index files
+   */
+  QString KernelDbIndex::stamp(const FileName &kernelDbFile) {
+    QFileInfo kernelDb(kernelDbFile.expanded());
+
+    // The leapsecond kernel iTime loads
+    PvlGroup &dataDir = Preference::Preferences().findGroup("DataDirectory");
+    QString baseDir = dataDir["Base"];
+    FileName leapSecond(baseDir + "/kernels/lsk/naif????.tls");
+    QFileInfo leapSecondKernel(leapSecond.highestVersion().expanded());
+
+    QStringList stamp;
+    stamp << kernelDb.absoluteFilePath()
+          << QString::number(kernelDb.size())
+          << QString::number(kernelDb.lastModified().toMSecsSinceEpoch())
+          << leapSecondKernel.absoluteFilePath()
+          << QString::number(leapSecondKernel.size())
+          << QString::number(leapSecondKernel.lastModified().toMSecsSinceEpoch());
+
+    return stamp.join("|");
+  }
+}
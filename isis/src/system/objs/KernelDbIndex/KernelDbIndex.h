@@ -0,0 +1,158 @@
+#ifndef KernelDbIndex_h
+#define KernelDbIndex_h
+
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QDataStream;
+
+namespace Isis {
+  class FileName;
+  class Pvl;
+  class PvlGroup;
+
+  /**
+   * @brief A compiled kernel database
+   *
+   * This class holds the Selection groups of kernel database objects in a
+   * compiled form. Time ranges are converted to ephemeris times once, and the
+   * selections of each object are put in interval trees keyed by the
+   * InstrumentId they match, so the selections that can match a time are found
+   * without testing every group.
+   *
+   * The compiled form of a kernel database file can be written to a binary
+   * index file. load() reads the index file instead of the kernel database
+   * when the kernel database and the leapsecond kernel have not been modified
+   * since the index was written. Index files are kept in the directory given
+   * by the KernelDbCache keyword of the Performance preferences group.
+   *
+   * <code>
+   * KernelDbIndex index = KernelDbIndex::load(kernelDbFile);
+   *
+   * for (int i = 0; i < index.objects(); i++) {
+   *   QList<int> found = index.selections(i, et, instrumentId);
+   * }
+   * </code>
+   *
+   * @ingroup System
+   *
+   * @author 2026-10-19 ISIS Development Team
+   *
+   * @internal
+   */
+  class KernelDbIndex {
+    public:
+      /**
+       * A compiled Match keyword of a Selection group.
+       */
+      struct Match {
+        bool valid;      //!< False if the keyword has fewer than three values
+        QString group;   //!< The label group to look in
+        QString keyword; //!< The label keyword to compare
+        QString value;   //!< The simplified, upper case value to match
+      };
+
+      /**
+       * A compiled Selection group of a kernel database object.
+       */
+      struct Selection {
+        bool hasType;   //!< True if the group has a Type keyword
+        QString type;   //!< The value of the Type keyword
+        QList< QPair<double, double> > times; //!< The Time ranges as ephemeris times
+        QList<Match> matches;      //!< The Match keywords
+        QStringList cameraVersions; //!< The values of the CameraVersion keywords
+        QList<QStringList> files;  //!< The values of the File keywords
+      };
+
+      /**
+       * A static interval tree of closed ranges. The ranges are kept in a
+       * balanced binary tree stored in arrays sorted by range start, where each
+       * node also knows the largest range end below it.
+       *
+       * @author 2026-10-19 ISIS Development Team
+       *
+       * @internal
+       */
+      class IntervalTree {
+        public:
+          IntervalTree();
+
+          void add(double start, double end, int value);
+          void build();
+
+          QList<int> stab(double point) const;
+
+        private:
+          double buildMaxEnds(int first, int last);
+          void stab(int first, int last, double point, QList<int> &found) const;
+
+          QVector<double> m_starts;   //!< Range starts, sorted once built
+          QVector<double> m_ends;     //!< Range ends
+          QVector<double> m_maxEnds;  //!< The largest range end in each subtree
+          QVector<int> m_values;      //!< The value of each range
+      };
+
+      KernelDbIndex();
+      KernelDbIndex(const Pvl &kernelDb);
+      ~KernelDbIndex();
+
+      void append(const KernelDbIndex &other);
+
+      int objects() const;
+      bool hasObject(const QString &name) const;
+      QString objectName(int object) const;
+      const Selection &selection(int object, int index) const;
+      QList<int> selections(int object, double et, const QString &instrumentId) const;
+
+      void write(QDataStream &stream) const;
+      void read(QDataStream &stream);
+
+      static KernelDbIndex load(const FileName &kernelDbFile);
+      static QString instrumentId(const Match &match);
+
+    private:
+      /**
+       * A compiled kernel database object.
+       */
+      struct Object {
+        QString name;                 //!< The name of the object
+        QList<Selection> selections;  //!< The Selection groups, in file order
+        QMap<QString, IntervalTree> trees; //!< Selections by matched InstrumentId
+      };
+
+      static Selection compile(const PvlGroup &grp);
+      static void buildTrees(Object &object);
+      static QString indexFileName(const FileName &kernelDbFile);
+      static QString stamp(const FileName &kernelDbFile);
+
+      QList<Object> m_objects; //!< The compiled kernel database objects
+  };
+};
+
+#endif
@@ -0,0 +1,215 @@
+#include "Cube.h"
+#include "CubeCalculator.h"
+#include "CubeInfixToPostfix.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "SpecialPixel.h"
+
+#include <algorithm>
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * The value of a pixel of the test cube. Sample 5 is NULL and sample 6 is HRS
+ * so that special pixels are in the first block of a line.
+ */
+static double calculatorValue(int sample, int line, int band = 1) {
+  if (sample == 5) {
+    return Null;
+  }
+  if (sample == 6) {
+    return Hrs;
+  }
+  return line * 10 + sample % 7;
+}
+
+
+/**
+ * Creates the test cube and runs an equation on each of its lines. The cube
+ * has more samples than a block of compiled calculations.
+ */
+static QVector< QVector<double> > calculate(const QString &equation) {
+  QString fileName = QDir::tempPath() + "/CubeCalculatorTests.cub";
+
+  Cube cube;
+  writeTestCube(cube, fileName, 300, 3, 1, calculatorValue);
+
+  QVector<Cube *> cubes;
+  cubes.push_back(&cube);
+
+  CubeCalculator calculator;
+  CubeInfixToPostfix infixToPostfix;
+  calculator.prepareCalculations(infixToPostfix.convert(equation), cubes, &cube);
+
+  QVector< QVector<double> > results;
+  LineManager line(cube);
+  for (line.begin(); !line.end(); line++) {
+    cube.read(line);
+    QVector<Buffer *> data;
+    data.push_back(&line);
+    results.push_back(calculator.runCalculations(data, line.Line(), line.Band()));
+  }
+
+  cube.close(true);
+  return results;
+}
+
+
+TEST(CubeCalculator, CubeDataAndSample) {
+  QVector< QVector<double> > results = calculate("f1 * 2 + sample");
+
+  ASSERT_EQ(3, results.size());
+  for (int line = 0; line < results.size(); line++) {
+    ASSERT_EQ(300, results[line].size());
+    for (int i = 0; i < 300; i++) {
+      double value = calculatorValue(i + 1, line + 1);
+      if (value == Null) {
+        EXPECT_EQ(Null, results[line][i]);
+      }
+      else if (value == Hrs) {
+        EXPECT_EQ(Hrs, results[line][i]);
+      }
+      else {
+        EXPECT_DOUBLE_EQ(value * 2 + i + 1, results[line][i]);
+      }
+    }
+  }
+}
+
+
+TEST(CubeCalculator, ScalarEquation) {
+  QVector< QVector<double> > results = calculate("line * 2 + band ^ 2 - 1");
+
+  ASSERT_EQ(3, results.size());
+  for (int line = 0; line < results.size(); line++) {
+    ASSERT_EQ(1, results[line].size());
+    EXPECT_DOUBLE_EQ((line + 1) * 2, results[line][0]);
+  }
+}
+
+
+TEST(CubeCalculator, ScalarAndVectorOperands) {
+  QVector< QVector<double> > results = calculate("(10 - f1) / 2 >= line");
+
+  for (int line = 0; line < results.size(); line++) {
+    for (int i = 0; i < 300; i++) {
+      double value = calculatorValue(i + 1, line + 1);
+      if (value == Null) {
+        EXPECT_EQ(0.0, results[line][i]);
+      }
+      else if (value == Hrs) {
+        EXPECT_EQ(0.0, results[line][i]);
+      }
+      else {
+        EXPECT_EQ((10 - value) / 2 >= line + 1 ? 1.0 : 0.0, results[line][i]);
+      }
+    }
+  }
+}
+
+
+TEST(CubeCalculator, MinimumAndMaximum) {
+  QVector< QVector<double> > results = calculate("max(min(f1, 13), 12)");
+
+  for (int i = 0; i < 300; i++) {
+    double value = calculatorValue(i + 1, 1);
+    if (value == Null) {
+      EXPECT_EQ(Null, results[0][i]);
+    }
+    else if (value == Hrs) {
+      EXPECT_EQ(13.0, results[0][i]);
+    }
+    else {
+      EXPECT_EQ(std::max(std::min(value, 13.0), 12.0), results[0][i]);
+    }
+  }
+}
+
+
+TEST(CubeCalculator, LineOperationsAreInterpreted) {
+  QVector< QVector<double> > results = calculate("f1 - linemin(sample)");
+
+  for (int line = 0; line < results.size(); line++) {
+    for (int i = 0; i < 300; i++) {
+      double value = calculatorValue(i + 1, line + 1);
+      if (value == Null) {
+        EXPECT_EQ(Null, results[line][i]);
+      }
+      else if (value == Hrs) {
+        EXPECT_EQ(Hrs, results[line][i]);
+      }
+      else {
+        EXPECT_DOUBLE_EQ(value - 1, results[line][i]);
+      }
+    }
+  }
+}
+
+
+
+/**
+ * Runs an equation on the first lines of a cube with a camera.
+ */
+static QVector< QVector<double> > calculateWithCamera(const QString &equation) {
+  Cube cube("$base/testData/f319b18_ideal_flat.cub");
+  QVector<Cube *> cubes;
+  cubes.push_back(&cube);
+
+  CubeCalculator calculator;
+  CubeInfixToPostfix infixToPostfix;
+  calculator.prepareCalculations(infixToPostfix.convert(equation), cubes, &cube);
+
+  QVector< QVector<double> > results;
+  LineManager line(cube);
+  for (line.begin(); !line.end() && line.Line() <= 3; line++) {
+    cube.read(line);
+    QVector<Buffer *> data;
+    data.push_back(&line);
+    results.push_back(calculator.runCalculations(data, line.Line(), line.Band()));
+  }
+
+  return results;
+}
+
+
+/**
+ * Expects the compiled result of an equation using a center angle to match
+ * the interpreted one. Multiplying by linemin(sample), which is 1, forces
+ * the interpreter.
+ */
+static void expectCenterAngle(const QString &angle) {
+  QVector< QVector<double> > compiled =
+      calculateWithCamera(angle + "(f1) + sample");
+  QVector< QVector<double> > interpreted =
+      calculateWithCamera(angle + "(f1) + sample * linemin(sample)");
+
+  ASSERT_EQ(interpreted.size(), compiled.size());
+  for (int line = 0; line < compiled.size(); line++) {
+    ASSERT_EQ(interpreted[line].size(), compiled[line].size());
+    for (int i = 0; i < compiled[line].size(); i++) {
+      EXPECT_EQ(interpreted[line][i], compiled[line][i]);
+    }
+  }
+}
+
+
+TEST(CubeCalculator, CenterPhaseAngle) {
+  expectCenterAngle("phac");
+}
+
+
+TEST(CubeCalculator, CenterIncidenceAngle) {
+  expectCenterAngle("inac");
+}
+
+
+TEST(CubeCalculator, CenterEmissionAngle) {
+  expectCenterAngle("emac");
+}
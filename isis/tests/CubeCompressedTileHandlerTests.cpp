@@ -0,0 +1,87 @@
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * The value written to a pixel of the test cube. The values repeat so that
+ * the tiles compress, and the right half of the cube is NULL.
+ */
+static double compressibleValue(int sample, int line, int band) {
+  if (sample > 150) {
+    return Null;
+  }
+  return (line % 100) * 10 + sample % 7;
+}
+
+
+TEST(CubeCompressedTileHandler, AttributeSelectsFormat) {
+  CubeAttributeOutput att("+CompressedTile");
+  EXPECT_EQ(Cube::CompressedTile, att.fileFormat());
+  EXPECT_EQ("CompressedTile", att.fileFormatString());
+
+  att.setFileFormat(Cube::Tile);
+  EXPECT_EQ(Cube::Tile, att.fileFormat());
+}
+
+
+TEST(CubeCompressedTileHandler, SignedWordRoundTrip) {
+  QString fileName = QDir::tempPath() + "/CubeCompressedTileHandlerWord.cub";
+  writeTestCube(fileName, 300, 200, 2, compressibleValue, SignedWord, Cube::CompressedTile);
+
+  EXPECT_LT(QFileInfo(fileName).size(), 65536 + 300 * 200 * 2 * 2 / 4);
+  expectTestCube(fileName, compressibleValue);
+
+  Cube cube;
+  cube.open(fileName);
+  const PvlObject &core = cube.label()->findObject("IsisCube").findObject("Core");
+  EXPECT_EQ("CompressedTile", core["Format"][0]);
+  EXPECT_EQ("Horizontal", core["Predictor"][0]);
+  EXPECT_TRUE(core.hasKeyword("TileIndexStartByte"));
+  cube.close();
+
+  QFile::remove(fileName);
+}
+
+
+TEST(CubeCompressedTileHandler, RewriteRealCube) {
+  QString fileName = QDir::tempPath() + "/CubeCompressedTileHandlerReal.cub";
+  writeTestCube(fileName, 300, 200, 2, compressibleValue, Real, Cube::CompressedTile);
+  expectTestCube(fileName, compressibleValue);
+
+  // Tiles written again replace the old ones
+  Cube cube;
+  cube.open(fileName, "rw");
+  EXPECT_EQ(Cube::CompressedTile, cube.format());
+  LineManager line(cube);
+  line.SetLine(5, 2);
+  for (int i = 0; i < line.size(); i++) {
+    line[i] = 1.5;
+  }
+  cube.write(line);
+  cube.close();
+
+  cube.open(fileName);
+  cube.read(line);
+  for (int i = 0; i < line.size(); i++) {
+    EXPECT_EQ(1.5, line[i]);
+  }
+  line.SetLine(5, 1);
+  cube.read(line);
+  EXPECT_EQ(compressibleValue(1, 5, 1), line[0]);
+  cube.close();
+
+  QFile::remove(fileName);
+}
@@ -0,0 +1,57 @@
+#include "Cube.h"
+#include "CubeMemoryHandler.h"
+#include "Fixtures.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+TEST(CubeMemoryHandler, KeepsDataInMemory) {
+  QString fileName = QDir::tempPath() + "/CubeMemoryHandlerTests.cub";
+  BigInt dataBytes = 300 * 200 * 4;
+  BigInt usedBefore = CubeMemoryHandler::memoryUsed();
+
+  CubeMemoryHandler::addFile(fileName);
+  EXPECT_TRUE(CubeMemoryHandler::hasFile(fileName));
+
+  writeTestCube(fileName, 300, 200);
+  EXPECT_EQ(usedBefore + dataBytes, CubeMemoryHandler::memoryUsed());
+  EXPECT_LT(QFileInfo(fileName).size(), 65536 + dataBytes);
+  expectTestCube(fileName);
+
+  // Writing the data completes the file for any reader
+  CubeMemoryHandler::writeToDisk(fileName);
+  EXPECT_EQ(usedBefore, CubeMemoryHandler::memoryUsed());
+  EXPECT_EQ(65536 + dataBytes, QFileInfo(fileName).size());
+
+  CubeMemoryHandler::removeFile(fileName);
+  EXPECT_FALSE(CubeMemoryHandler::hasFile(fileName));
+  expectTestCube(fileName);
+
+  QFile::remove(fileName);
+}
+
+
+TEST(CubeMemoryHandler, DiscardOnRemove) {
+  QString fileName = QDir::tempPath() + "/CubeMemoryHandlerTestsRemove.cub";
+  BigInt usedBefore = CubeMemoryHandler::memoryUsed();
+
+  CubeMemoryHandler::addFile(fileName);
+  writeTestCube(fileName, 300, 200);
+  EXPECT_LT(usedBefore, CubeMemoryHandler::memoryUsed());
+
+  Cube cube;
+  cube.open(fileName, "rw");
+  cube.close(true);
+
+  EXPECT_EQ(usedBefore, CubeMemoryHandler::memoryUsed());
+  EXPECT_TRUE(CubeMemoryHandler::hasFile(fileName));
+  EXPECT_FALSE(QFileInfo(fileName).exists());
+
+  CubeMemoryHandler::removeFile(fileName);
+}
@@ -0,0 +1,151 @@
+#include "Brick.h"
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "CubeOverviews.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+#include <cmath>
+
+#include <QDir>
+#include <QFile>
+#include <QList>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * The value written to a pixel of the test cube. A block in the upper left
+ * corner is NULL.
+ */
+static double overviewValue(int sample, int line, int band) {
+  if (sample <= 4 && line <= 4) {
+    return Null;
+  }
+  return testValue(sample, line, band);
+}
+
+
+TEST(CubeOverviews, ReducedSize) {
+  EXPECT_EQ(151, CubeOverviews::reducedSize(301, 2));
+  EXPECT_EQ(150, CubeOverviews::reducedSize(300, 2));
+  EXPECT_EQ(1, CubeOverviews::reducedSize(301, 512));
+}
+
+
+TEST(CubeOverviews, ReduceAveragesValidPixels) {
+  double pixels[8] = { 1.0, 3.0, Null, Null,
+                       5.0, Lrs, Null, Null };
+  double reduced[2];
+  CubeOverviews::reduce(pixels, 2, 2, reduced);
+  EXPECT_DOUBLE_EQ(3.0, reduced[0]);
+  EXPECT_EQ(Null, reduced[1]);
+}
+
+
+TEST(CubeOverviews, ReadMatchesFullResolution) {
+  QString fileName = QDir::tempPath() + "/CubeOverviewsTest.cub";
+  Cube cube;
+  writeTestCube(cube, fileName, 301, 203, 2, overviewValue);
+
+  // Without overviews the full resolution pixels are reduced
+  Brick expected(40, 30, 2, Real);
+  expected.SetBasePosition(30, 20, 1);
+  cube.read(expected, 4);
+
+  cube.createOverviews(64);
+  EXPECT_EQ(QList<int>() << 2 << 4 << 8, cube.overviewReductions());
+  cube.close();
+
+  cube.open(fileName);
+  EXPECT_EQ(QList<int>() << 2 << 4 << 8, cube.overviewReductions());
+  const PvlGroup &overview = cube.label()->findObject("Overviews").findGroup("Overview");
+  EXPECT_EQ(151, int(overview["Samples"]));
+  EXPECT_EQ(102, int(overview["Lines"]));
+
+  Brick fromOverview(40, 30, 2, Real);
+  fromOverview.SetBasePosition(30, 20, 1);
+  cube.read(fromOverview, 4);
+
+  for (int i = 0; i < expected.size(); i++) {
+    if (IsSpecial(expected[i])) {
+      EXPECT_EQ(expected[i], fromOverview[i]);
+    }
+    else {
+      EXPECT_NEAR(expected[i], fromOverview[i], 1e-6 * fabs(expected[i]));
+    }
+  }
+
+  // The block with the NULL corner averages the other pixels, past the edge is NULL
+  Brick corner(2, 1, 1, Real);
+  corner.SetBasePosition(1, 1, 1);
+  cube.read(corner, 4);
+  EXPECT_EQ(Null, corner[0]);
+  EXPECT_NEAR(6.5 + 2500.0 + 100000.0, corner[1], 0.02);
+
+  Brick edge(2, 1, 1, Real);
+  edge.SetBasePosition(76, 1, 2);
+  cube.read(edge, 4);
+  EXPECT_NEAR(301.0 + 2500.0 + 200000.0, edge[0], 0.02);
+  EXPECT_EQ(Null, edge[1]);
+
+  cube.close();
+  QFile::remove(fileName);
+}
+
+
+TEST(CubeOverviews, WritesReplaceStaleOverviews) {
+  QString fileName = QDir::tempPath() + "/CubeOverviewsWrite.cub";
+  Cube cube;
+  writeTestCube(cube, fileName, 301, 203, 2, overviewValue);
+  cube.createOverviews(64);
+  cube.close();
+
+  // Overwrite the first four lines of band 1
+  cube.open(fileName, "rw");
+  LineManager line(cube);
+  for (int l = 1; l <= 4; l++) {
+    line.SetLine(l, 1);
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = 7.0;
+    }
+    cube.write(line);
+  }
+
+  Brick reduced(2, 1, 1, Real);
+  reduced.SetBasePosition(1, 1, 1);
+  cube.read(reduced, 4);
+  EXPECT_DOUBLE_EQ(7.0, reduced[0]);
+  EXPECT_DOUBLE_EQ(7.0, reduced[1]);
+  cube.close();
+
+  // The overviews are made again at the same sizes
+  cube.open(fileName);
+  EXPECT_EQ(QList<int>() << 2 << 4 << 8, cube.overviewReductions());
+  cube.read(reduced, 4);
+  EXPECT_DOUBLE_EQ(7.0, reduced[0]);
+  EXPECT_DOUBLE_EQ(7.0, reduced[1]);
+  reduced.SetBasePosition(1, 2, 1);
+  cube.read(reduced, 4);
+  EXPECT_NEAR(2.5 + 6500.0 + 100000.0, reduced[0], 0.02);
+
+  cube.close();
+  QFile::remove(fileName);
+}
+
+
+TEST(CubeOverviews, SmallCubeHasNone) {
+  QString fileName = QDir::tempPath() + "/CubeOverviewsSmall.cub";
+  Cube cube;
+  writeTestCube(cube, fileName, 301, 203, 2, overviewValue);
+  cube.createOverviews(400);
+  EXPECT_TRUE(cube.overviewReductions().isEmpty());
+  EXPECT_FALSE(cube.label()->hasObject("Overviews"));
+  cube.close();
+  QFile::remove(fileName);
+}
@@ -0,0 +1,106 @@
+#include "Cube.h"
+#include "DemMinMaxPyramid.h"
+#include "DemTileCache.h"
+#include "Fixtures.h"
+#include "IException.h"
+#include "SpecialPixel.h"
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * The value written to a pixel of the test DEM. The pixels of the last
+ * column are NULL.
+ */
+static double demValue(int sample, int line, int band = 1) {
+  if (sample == 37) {
+    return Null;
+  }
+  return testValue(sample, line, band);
+}
+
+
+TEST(DemMinMaxPyramid, BlocksCoverTheirBorders) {
+  QString fileName = QDir::tempPath() + "/DemMinMaxPyramidTests.cub";
+  writeTestCube(fileName, 37, 21, 1, demValue);
+
+  DemTileCache demCache(fileName, 16, 1024 * 1024);
+  DemMinMaxPyramid pyramid(demCache, 4);
+  EXPECT_EQ(4, pyramid.blockSize());
+  ASSERT_EQ(5, pyramid.levelCount());
+  EXPECT_EQ(10, pyramid.columnCount(0));
+  EXPECT_EQ(6, pyramid.rowCount(0));
+
+  // Every level 0 block against the valid pixels in and around it
+  for (int row = 0; row < pyramid.rowCount(0); row++) {
+    for (int column = 0; column < pyramid.columnCount(0); column++) {
+      double minimum = 1.0e30;
+      double maximum = -1.0e30;
+      for (int line = row * 4; line <= row * 4 + 5; line++) {
+        for (int sample = column * 4; sample <= column * 4 + 5; sample++) {
+          if (sample >= 1 && line >= 1 && sample <= 37 && line <= 21 &&
+              !IsSpecial(demValue(sample, line))) {
+            minimum = qMin(minimum, demValue(sample, line));
+            maximum = qMax(maximum, demValue(sample, line));
+          }
+        }
+      }
+
+      EXPECT_EQ(minimum, pyramid.minimum(0, column, row));
+      EXPECT_EQ(maximum, pyramid.maximum(0, column, row));
+    }
+  }
+
+  QFile::remove(fileName);
+}
+
+
+TEST(DemMinMaxPyramid, LevelsCombineBlocks) {
+  QString fileName = QDir::tempPath() + "/DemMinMaxPyramidTests.cub";
+  writeTestCube(fileName, 37, 21, 1, demValue);
+
+  DemTileCache demCache(fileName, 16, 1024 * 1024);
+  DemMinMaxPyramid pyramid(demCache, 4);
+
+  for (int level = 1; level < pyramid.levelCount(); level++) {
+    EXPECT_EQ((pyramid.columnCount(level - 1) + 1) / 2, pyramid.columnCount(level));
+    EXPECT_EQ((pyramid.rowCount(level - 1) + 1) / 2, pyramid.rowCount(level));
+  }
+
+  int last = pyramid.levelCount() - 1;
+  EXPECT_EQ(1, pyramid.columnCount(last));
+  EXPECT_EQ(1, pyramid.rowCount(last));
+  EXPECT_EQ(demValue(1, 1), pyramid.minimum(last, 0, 0));
+  EXPECT_EQ(demValue(36, 21), pyramid.maximum(last, 0, 0));
+
+  QFile::remove(fileName);
+}
+
+
+TEST(DemMinMaxPyramid, SharedByTheCache) {
+  QString fileName = QDir::tempPath() + "/DemMinMaxPyramidTests.cub";
+  writeTestCube(fileName, 37, 21, 1, demValue);
+
+  DemTileCache demCache(fileName, 16, 1024 * 1024);
+  QSharedPointer<const DemMinMaxPyramid> pyramid = demCache.pyramid();
+  EXPECT_EQ(pyramid, demCache.pyramid());
+  EXPECT_EQ(8, pyramid->blockSize());
+
+  QFile::remove(fileName);
+}
+
+
+TEST(DemMinMaxPyramid, BlockSizeMustBePositive) {
+  QString fileName = QDir::tempPath() + "/DemMinMaxPyramidTests.cub";
+  writeTestCube(fileName, 37, 21, 1, demValue);
+
+  DemTileCache demCache(fileName, 16, 1024 * 1024);
+  EXPECT_THROW(DemMinMaxPyramid(demCache, 0), IException);
+
+  QFile::remove(fileName);
+}
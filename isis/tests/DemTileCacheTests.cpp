@@ -0,0 +1,124 @@
+#include "Cube.h"
+#include "DemTileCache.h"
+#include "Fixtures.h"
+#include "IException.h"
+#include "SpecialPixel.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSharedPointer>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * Reads windows at every position of the DEM and a border around it and
+ * expects the pixel values, or NULL outside of the DEM.
+ */
+static void expectWindows(DemTileCache &demCache) {
+  QSharedPointer<const DemTileCache::Tile> lastTile;
+  double buf[16];
+
+  for (int line = -3; line <= 32; line++) {
+    for (int sample = -3; sample <= 47; sample++) {
+      demCache.readWindow(sample, line, 4, 4, buf, lastTile);
+      for (int l = 0; l < 4; l++) {
+        for (int s = 0; s < 4; s++) {
+          int pixelSample = sample + s;
+          int pixelLine = line + l;
+          bool outside = (pixelSample < 1 || pixelLine < 1 ||
+                          pixelSample > 45 || pixelLine > 30);
+          double expected = outside ? Null : testValue(pixelSample, pixelLine);
+          ASSERT_EQ(expected, buf[l * 4 + s]);
+        }
+      }
+    }
+  }
+}
+
+
+TEST(DemTileCache, ResidentWindows) {
+  QString fileName = QDir::tempPath() + "/DemTileCacheTests.cub";
+  writeTestCube(fileName, 45, 30);
+
+  DemTileCache demCache(fileName, 16, 45 * 30 * sizeof(double));
+  EXPECT_EQ(45, demCache.sampleCount());
+  EXPECT_EQ(30, demCache.lineCount());
+  EXPECT_TRUE(demCache.isResident());
+  expectWindows(demCache);
+
+  // A resident tile is never read again
+  QSharedPointer<const DemTileCache::Tile> first = demCache.tile(1, 1);
+  expectWindows(demCache);
+  EXPECT_EQ(first, demCache.tile(16, 16));
+
+  QFile::remove(fileName);
+}
+
+
+TEST(DemTileCache, EvictingWindows) {
+  QString fileName = QDir::tempPath() + "/DemTileCacheTests.cub";
+  writeTestCube(fileName, 45, 30);
+
+  // Room for four of the six tiles
+  DemTileCache demCache(fileName, 16, 4 * 16 * 16 * sizeof(double));
+  EXPECT_FALSE(demCache.isResident());
+  expectWindows(demCache);
+
+  // A released tile is still valid for whoever holds it
+  QSharedPointer<const DemTileCache::Tile> held = demCache.tile(1, 1);
+  demCache.tile(17, 1);
+  demCache.tile(33, 1);
+  demCache.tile(1, 17);
+  demCache.tile(17, 17);
+  demCache.tile(33, 17);
+  EXPECT_EQ(testValue(16, 16), held->value(16, 16));
+  EXPECT_EQ(testValue(1, 1), demCache.value(1, 1));
+
+  QFile::remove(fileName);
+}
+
+
+TEST(DemTileCache, PartialTiles) {
+  QString fileName = QDir::tempPath() + "/DemTileCacheTests.cub";
+  writeTestCube(fileName, 45, 30);
+
+  DemTileCache demCache(fileName, 16, 1024 * 1024);
+  QSharedPointer<const DemTileCache::Tile> corner = demCache.tile(45, 30);
+  ASSERT_FALSE(corner.isNull());
+  EXPECT_EQ(33, corner->startSample);
+  EXPECT_EQ(17, corner->startLine);
+  EXPECT_EQ(13, corner->samples);
+  EXPECT_EQ(14, corner->lines);
+
+  EXPECT_TRUE(demCache.tile(0, 1).isNull());
+  EXPECT_TRUE(demCache.tile(1, 31).isNull());
+  EXPECT_EQ(Null, demCache.value(46, 1));
+
+  QFile::remove(fileName);
+}
+
+
+TEST(DemTileCache, SharedByFile) {
+  QString fileName = QDir::tempPath() + "/DemTileCacheTests.cub";
+  writeTestCube(fileName, 45, 30);
+
+  QSharedPointer<DemTileCache> first = DemTileCache::cache(fileName);
+  QSharedPointer<DemTileCache> second = DemTileCache::cache(fileName);
+  EXPECT_EQ(first.data(), second.data());
+  EXPECT_EQ(testValue(7, 9), first->value(7, 9));
+
+  QFile::remove(fileName);
+}
+
+
+TEST(DemTileCache, TileSizeMustBePositive) {
+  QString fileName = QDir::tempPath() + "/DemTileCacheTests.cub";
+  writeTestCube(fileName, 45, 30);
+
+  EXPECT_THROW(DemTileCache(fileName, 0, 1024), IException);
+
+  QFile::remove(fileName);
+}
@@ -0,0 +1,118 @@
+#include "EmbreeTargetShape.h"
+#include "FileName.h"
+#include "Preference.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * Points the shape cache at a directory of its own and restores the
+ * preference afterwards.
+ */
+class EmbreeShapeCache : public ::testing::Test {
+  protected:
+    void SetUp() {
+      PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+      m_hadCache = performance.hasKeyword("EmbreeShapeCache");
+      if (m_hadCache) {
+        m_oldCache = performance["EmbreeShapeCache"][0];
+      }
+
+      m_cacheDir = QDir::tempPath() + "/EmbreeTargetShapeTests";
+      QDir(m_cacheDir).removeRecursively();
+      performance.addKeyword(PvlKeyword("EmbreeShapeCache", m_cacheDir), PvlContainer::Replace);
+    }
+
+    void TearDown() {
+      PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+      if (m_hadCache) {
+        performance.addKeyword(PvlKeyword("EmbreeShapeCache", m_oldCache), PvlContainer::Replace);
+      }
+      else {
+        performance.deleteKeyword("EmbreeShapeCache");
+      }
+      QDir(m_cacheDir).removeRecursively();
+    }
+
+    bool m_hadCache;
+    QString m_oldCache;
+    QString m_cacheDir;
+};
+
+
+/**
+ * Intersects a ray from far out on an axis towards the center of a shape.
+ */
+static RayHitInformation hitFromAxis(EmbreeTargetShape &shape, int axis) {
+  std::vector<double> origin(3, 0.0);
+  std::vector<double> direction(3, 0.0);
+  origin[axis] = 10.0;
+  direction[axis] = -1.0;
+
+  RTCMultiHitRay ray(origin, direction);
+  shape.intersectRay(ray);
+  EXPECT_GE(ray.lastHit, 0);
+  return shape.getHitInformation(ray, 0);
+}
+
+
+TEST_F(EmbreeShapeCache, WarmLoadMatchesShapeFile) {
+  QString dskfile("$base/testData/hay_a_amica_5_itokawashape_v1_0_64q.bds");
+  QString cacheFile = EmbreeTargetShape::cacheFileName(FileName(dskfile));
+  ASSERT_TRUE(cacheFile.startsWith(m_cacheDir));
+  EXPECT_FALSE(QFile::exists(cacheFile));
+
+  EmbreeTargetShape cold(dskfile);
+  EXPECT_TRUE(QFile::exists(cacheFile));
+
+  EmbreeTargetShape warm(dskfile);
+  EXPECT_EQ(cold.numberOfPolygons(), warm.numberOfPolygons());
+  EXPECT_EQ(cold.numberOfVertices(), warm.numberOfVertices());
+  EXPECT_EQ(49152, warm.numberOfPolygons());
+  EXPECT_EQ(25350, warm.numberOfVertices());
+  EXPECT_DOUBLE_EQ(cold.maximumSceneDistance(), warm.maximumSceneDistance());
+
+  for (int axis = 0; axis < 3; axis++) {
+    RayHitInformation coldHit = hitFromAxis(cold, axis);
+    RayHitInformation warmHit = hitFromAxis(warm, axis);
+    EXPECT_EQ(coldHit.primID, warmHit.primID);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_DOUBLE_EQ(coldHit.intersection[i], warmHit.intersection[i]);
+      EXPECT_DOUBLE_EQ(coldHit.surfaceNormal[i], warmHit.surfaceNormal[i]);
+    }
+  }
+}
+
+
+TEST_F(EmbreeShapeCache, DamagedCacheIsIgnored) {
+  QString dskfile("$base/testData/hay_a_amica_5_itokawashape_v1_0_64q.bds");
+  QString cacheFile = EmbreeTargetShape::cacheFileName(FileName(dskfile));
+
+  QFile damaged(cacheFile);
+  ASSERT_TRUE(damaged.open(QIODevice::WriteOnly));
+  damaged.write("not a shape cache");
+  damaged.close();
+
+  EmbreeTargetShape shape(dskfile);
+  EXPECT_EQ(49152, shape.numberOfPolygons());
+  EXPECT_EQ(25350, shape.numberOfVertices());
+
+  // The damaged file is replaced
+  EXPECT_GT(QFile(cacheFile).size(), 49152 * 12);
+}
+
+
+TEST_F(EmbreeShapeCache, Disabled) {
+  PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+  performance.addKeyword(PvlKeyword("EmbreeShapeCache", "None"), PvlContainer::Replace);
+
+  EXPECT_EQ("", EmbreeTargetShape::cacheFileName(
+      FileName("$base/testData/hay_a_amica_5_itokawashape_v1_0_64q.bds")));
+}
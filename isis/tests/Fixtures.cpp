@@ -0,0 +1,120 @@
+#include "Fixtures.h"
+
+#include "LineManager.h"
+
+#include <gtest/gtest.h>
+
+namespace Isis {
+
+  /**
+   * The value of an element of a test array. The values repeat every 101
+   * elements and are not in order.
+   *
+   * @param index The index of the element
+   *
+   * @return double The value of the element
+   */
+  double testValue(int index) {
+    return (index * 37 % 101) / 10.0 - 3.0;
+  }
+
+
+  /**
+   * The value of a pixel of a test cube or DEM. Every pixel of a cube with
+   * fewer than 1000 samples has a distinct value that a Real cube stores
+   * exactly.
+   *
+   * @param sample The sample of the pixel
+   * @param line The line of the pixel
+   * @param band The band of the pixel
+   *
+   * @return double The value of the pixel
+   */
+  double testValue(int sample, int line, int band) {
+    return sample + 1000.0 * line + 100000.0 * band;
+  }
+
+
+  /**
+   * Creates a test cube and fills it with values. The cube is left open.
+   *
+   * @param cube The cube to create
+   * @param fileName The file to create the cube in
+   * @param samples The number of samples
+   * @param lines The number of lines
+   * @param bands The number of bands
+   * @param value The value of each pixel
+   * @param pixelType The pixel type of the cube
+   * @param format The format of the cube
+   */
+  void writeTestCube(Cube &cube, const QString &fileName,
+                     int samples, int lines, int bands,
+                     TestPixelFunction value, PixelType pixelType,
+                     Cube::Format format) {
+    cube.setDimensions(samples, lines, bands);
+    cube.setPixelType(pixelType);
+    cube.setFormat(format);
+    cube.create(fileName);
+    LineManager line(cube);
+
+    for (line.begin(); !line.end(); line++) {
+      for (int i = 0; i < line.size(); i++) {
+        line[i] = value(i + 1, line.Line(), line.Band());
+      }
+      cube.write(line);
+    }
+  }
+
+
+  /**
+   * Creates a test cube, fills it with values and closes it.
+   *
+   * @param fileName The file to create the cube in
+   * @param samples The number of samples
+   * @param lines The number of lines
+   * @param bands The number of bands
+   * @param value The value of each pixel
+   * @param pixelType The pixel type of the cube
+   * @param format The format of the cube
+   */
+  void writeTestCube(const QString &fileName,
+                     int samples, int lines, int bands,
+                     TestPixelFunction value, PixelType pixelType,
+                     Cube::Format format) {
+    Cube cube;
+    writeTestCube(cube, fileName, samples, lines, bands, value, pixelType, format);
+    cube.close();
+  }
+
+
+  /**
+   * Reads every line of an open cube and expects the values of a test cube.
+   *
+   * @param cube The cube to read
+   * @param value The expected value of each pixel
+   */
+  void expectTestCube(Cube &cube, TestPixelFunction value) {
+    LineManager line(cube);
+
+    for (line.begin(); !line.end(); line++) {
+      cube.read(line);
+      for (int i = 0; i < line.size(); i++) {
+        ASSERT_EQ(value(i + 1, line.Line(), line.Band()), line[i]);
+      }
+    }
+  }
+
+
+  /**
+   * Opens a cube, reads every line and expects the values of a test cube.
+   *
+   * @param fileName The cube to read
+   * @param value The expected value of each pixel
+   */
+  void expectTestCube(const QString &fileName, TestPixelFunction value) {
+    Cube cube;
+    cube.open(fileName);
+    expectTestCube(cube, value);
+    cube.close();
+  }
+}
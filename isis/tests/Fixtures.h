@@ -0,0 +1,32 @@
+#ifndef Fixtures_h
+#define Fixtures_h
+
+#include <QString>
+
+#include "Cube.h"
+#include "PixelType.h"
+
+namespace Isis {
+
+  //! The value of a pixel of a test cube at a sample, line and band
+  typedef double (*TestPixelFunction)(int sample, int line, int band);
+
+  double testValue(int index);
+  double testValue(int sample, int line, int band = 1);
+
+  void writeTestCube(Cube &cube, const QString &fileName,
+                     int samples, int lines, int bands = 1,
+                     TestPixelFunction value = testValue,
+                     PixelType pixelType = Real,
+                     Cube::Format format = Cube::Tile);
+  void writeTestCube(const QString &fileName,
+                     int samples, int lines, int bands = 1,
+                     TestPixelFunction value = testValue,
+                     PixelType pixelType = Real,
+                     Cube::Format format = Cube::Tile);
+
+  void expectTestCube(Cube &cube, TestPixelFunction value = testValue);
+  void expectTestCube(const QString &fileName, TestPixelFunction value = testValue);
+}
+
+#endif
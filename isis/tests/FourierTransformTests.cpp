@@ -0,0 +1,114 @@
+#include "Fixtures.h"
+#include "FourierTransform.h"
+#include "IException.h"
+
+#include <complex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+TEST(FourierTransform, BatchedRowsMatchVectorTransform) {
+  FourierTransform fft;
+  int n = 64;
+  int rows = 300;
+
+  std::vector< std::complex<double> > data(n * rows);
+  for (int i = 0; i < n * rows; i++) {
+    data[i] = std::complex<double>(testValue(i), testValue(i + 7));
+  }
+  std::vector< std::complex<double> > original(data);
+
+  fft.Transform(&data[0], n, rows);
+
+  for (int row = 0; row < rows; row += 37) {
+    std::vector< std::complex<double> > expected = fft.Transform(
+        std::vector< std::complex<double> >(original.begin() + row * n,
+                                            original.begin() + (row + 1) * n));
+    for (int i = 0; i < n; i++) {
+      EXPECT_NEAR(expected[i].real(), data[row * n + i].real(), 1e-9);
+      EXPECT_NEAR(expected[i].imag(), data[row * n + i].imag(), 1e-9);
+    }
+  }
+
+  fft.Inverse(&data[0], n, rows);
+  for (int i = 0; i < n * rows; i++) {
+    EXPECT_NEAR(original[i].real(), data[i].real(), 1e-12);
+    EXPECT_NEAR(original[i].imag(), data[i].imag(), 1e-12);
+  }
+}
+
+
+TEST(FourierTransform, RealTransformIsHalfSpectrum) {
+  FourierTransform fft;
+  int n = 32;
+  int rows = 5;
+
+  std::vector<double> input(n * rows);
+  for (int i = 0; i < n * rows; i++) {
+    input[i] = testValue(i);
+  }
+
+  std::vector< std::complex<double> > spectrum((n / 2 + 1) * rows);
+  fft.RealTransform(&input[0], &spectrum[0], n, rows);
+
+  for (int row = 0; row < rows; row++) {
+    std::vector< std::complex<double> > expected = fft.Transform(
+        std::vector< std::complex<double> >(input.begin() + row * n,
+                                            input.begin() + (row + 1) * n));
+    for (int i = 0; i <= n / 2; i++) {
+      EXPECT_NEAR(expected[i].real(), spectrum[row * (n / 2 + 1) + i].real(), 1e-10);
+      EXPECT_NEAR(expected[i].imag(), spectrum[row * (n / 2 + 1) + i].imag(), 1e-10);
+    }
+  }
+
+  std::vector<double> inverted(n * rows);
+  fft.RealInverse(&spectrum[0], &inverted[0], n, rows);
+  for (int i = 0; i < n * rows; i++) {
+    EXPECT_NEAR(input[i], inverted[i], 1e-12);
+  }
+}
+
+
+TEST(FourierTransform, RealTransform2DMatchesComplex) {
+  FourierTransform fft;
+  int samples = 16;
+  int lines = 64;
+  int spectrumSamples = samples / 2 + 1;
+
+  std::vector<double> image(samples * lines);
+  std::vector< std::complex<double> > complexImage(samples * lines);
+  for (int i = 0; i < samples * lines; i++) {
+    image[i] = testValue(i);
+    complexImage[i] = image[i];
+  }
+
+  std::vector< std::complex<double> > spectrum(spectrumSamples * lines);
+  fft.RealTransform2D(&image[0], &spectrum[0], samples, lines);
+  fft.Transform2D(&complexImage[0], samples, lines);
+
+  for (int line = 0; line < lines; line++) {
+    for (int i = 0; i < spectrumSamples; i++) {
+      std::complex<double> expected = complexImage[line * samples + i];
+      EXPECT_NEAR(expected.real(), spectrum[line * spectrumSamples + i].real(), 1e-9);
+      EXPECT_NEAR(expected.imag(), spectrum[line * spectrumSamples + i].imag(), 1e-9);
+    }
+  }
+
+  std::vector<double> inverted(samples * lines);
+  fft.RealInverse2D(&spectrum[0], &inverted[0], samples, lines);
+  fft.Inverse2D(&complexImage[0], samples, lines);
+  for (int i = 0; i < samples * lines; i++) {
+    EXPECT_NEAR(image[i], inverted[i], 1e-12);
+    EXPECT_NEAR(image[i], complexImage[i].real(), 1e-12);
+  }
+}
+
+
+TEST(FourierTransform, ArrayLengthMustBePowerOfTwo) {
+  FourierTransform fft;
+  std::vector< std::complex<double> > data(12);
+
+  EXPECT_THROW(fft.Transform(&data[0], 12), IException);
+}
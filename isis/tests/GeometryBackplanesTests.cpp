@@ -0,0 +1,227 @@
+#include "Angle.h"
+#include "Camera.h"
+#include "Constants.h"
+#include "Cube.h"
+#include "Distance.h"
+#include "FileName.h"
+#include "GeometryBackplanes.h"
+#include "IString.h"
+#include "LineManager.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "ShapeModel.h"
+#include "SpecialPixel.h"
+#include "Table.h"
+#include "TableField.h"
+#include "TableRecord.h"
+#include "Target.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * The radius in meters of the test DEM, a smooth variation around the Mars
+ * sphere.
+ */
+static double demRadius(double lat, double lon) {
+  return 3396190.0 + 2000.0 * sin(3.0 * lat * PI / 180.0) * cos(2.0 * lon * PI / 180.0);
+}
+
+
+/**
+ * Writes a global simple cylindrical DEM of Mars at one pixel per degree.
+ */
+static void writeDem(const QString &fileName) {
+  double equatorialRadius = 3396190.0;
+  double resolution = equatorialRadius * PI / 180.0;
+
+  Cube cube;
+  cube.setDimensions(360, 180, 1);
+  cube.setPixelType(Real);
+  cube.create(fileName);
+
+  PvlGroup mapping("Mapping");
+  mapping += PvlKeyword("ProjectionName", "SimpleCylindrical");
+  mapping += PvlKeyword("CenterLongitude", toString(0.0));
+  mapping += PvlKeyword("TargetName", "Mars");
+  mapping += PvlKeyword("EquatorialRadius", toString(equatorialRadius), "meters");
+  mapping += PvlKeyword("PolarRadius", toString(equatorialRadius), "meters");
+  mapping += PvlKeyword("LatitudeType", "Planetocentric");
+  mapping += PvlKeyword("LongitudeDirection", "PositiveEast");
+  mapping += PvlKeyword("LongitudeDomain", toString(360));
+  mapping += PvlKeyword("MinimumLatitude", toString(-90.0));
+  mapping += PvlKeyword("MaximumLatitude", toString(90.0));
+  mapping += PvlKeyword("MinimumLongitude", toString(0.0));
+  mapping += PvlKeyword("MaximumLongitude", toString(360.0));
+  mapping += PvlKeyword("UpperLeftCornerX", toString(0.0), "meters");
+  mapping += PvlKeyword("UpperLeftCornerY", toString(90.0 * resolution), "meters");
+  mapping += PvlKeyword("PixelResolution", toString(resolution), "meters/pixel");
+  mapping += PvlKeyword("Scale", toString(1.0), "pixels/degree");
+  cube.putGroup(mapping);
+
+  double minimum = equatorialRadius;
+  double maximum = equatorialRadius;
+  LineManager line(cube);
+  for (line.begin(); !line.end(); line++) {
+    double lat = 90.0 - (line.Line() - 0.5);
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = demRadius(lat, i + 0.5);
+      minimum = std::min(minimum, line[i]);
+      maximum = std::max(maximum, line[i]);
+    }
+    cube.write(line);
+  }
+
+  // The statistics demprep adds for equatorial cylindrical DEMs
+  TableRecord record;
+  record += TableField("MinimumRadius", TableField::Double);
+  record += TableField("MaximumRadius", TableField::Double);
+  Table table("ShapeModelStatistics", record);
+  record[0] = Distance(minimum, Distance::Meters).kilometers();
+  record[1] = Distance(maximum, Distance::Meters).kilometers();
+  table += record;
+  cube.write(table);
+
+  cube.close();
+}
+
+
+/**
+ * Computes the backplanes of a rectangle of the test image and expects the
+ * phase, incidence and emission angles of each pixel to be within a
+ * tolerance of the angles of Camera::SetImage().
+ */
+static void expectCameraAngles(Cube &cube, double tolerance, double allowed) {
+  Camera *camera = cube.camera();
+
+  int startSample = 301;
+  int startLine = 401;
+  int samples = 64;
+  int lines = 48;
+
+  GeometryBackplanes backplanes(camera);
+  backplanes.setTolerance(tolerance);
+  backplanes.setGridSpacing(8);
+  backplanes.compute(startSample, startLine, samples, lines);
+  ASSERT_EQ(samples * lines, backplanes.size());
+
+  int valid = 0;
+  for (int line = 0; line < lines; line++) {
+    for (int sample = 0; sample < samples; sample++) {
+      int index = line * samples + sample;
+      bool success = camera->SetImage(startSample + sample, startLine + line);
+      ASSERT_EQ(success, backplanes.isValid(index)) << sample << ", " << line;
+      if (!success) {
+        EXPECT_EQ(Null, backplanes.phase(index));
+        continue;
+      }
+
+      valid++;
+      EXPECT_NEAR(camera->PhaseAngle(), backplanes.phase(index), allowed);
+      EXPECT_NEAR(camera->IncidenceAngle(), backplanes.incidence(index), allowed);
+      EXPECT_NEAR(camera->EmissionAngle(), backplanes.emission(index), allowed);
+      EXPECT_EQ(Null, backplanes.localIncidence(index));
+    }
+  }
+
+  EXPECT_GT(valid, 0);
+}
+
+
+/**
+ * Computes the local angles of a rectangle of an image and expects them to
+ * match Camera::LocalPhotometricAngles() for each pixel.
+ */
+static void expectLocalCameraAngles(Cube &cube) {
+  Camera *camera = cube.camera();
+
+  int startSample = 301;
+  int startLine = 401;
+  int samples = 24;
+  int lines = 16;
+
+  GeometryBackplanes backplanes(camera);
+  backplanes.setLocalAngles(true);
+  backplanes.compute(startSample, startLine, samples, lines);
+
+  int valid = 0;
+  for (int line = 0; line < lines; line++) {
+    for (int sample = 0; sample < samples; sample++) {
+      int index = line * samples + sample;
+      if (!camera->SetImage(startSample + sample, startLine + line)) {
+        EXPECT_FALSE(backplanes.isValid(index));
+        continue;
+      }
+
+      EXPECT_NEAR(camera->PhaseAngle(), backplanes.phase(index), 1.0e-10);
+
+      Angle phase, incidence, emission;
+      bool success;
+      camera->LocalPhotometricAngles(phase, incidence, emission, success);
+      if (!success || backplanes.localIncidence(index) == Null) {
+        continue;
+      }
+
+      valid++;
+      EXPECT_NEAR(incidence.degrees(), backplanes.localIncidence(index), 1.0e-8);
+      EXPECT_NEAR(emission.degrees(), backplanes.localEmission(index), 1.0e-8);
+    }
+  }
+
+  EXPECT_GT(valid, 0);
+}
+
+
+TEST(GeometryBackplanes, ExactAnglesMatchTheCamera) {
+  Cube cube("$base/testData/f319b18_ideal_flat.cub");
+  expectCameraAngles(cube, 0.0, 1.0e-10);
+}
+
+
+TEST(GeometryBackplanes, InterpolatedAnglesStayNearTheCamera) {
+  // The tolerance is checked at the center and the middles of the edges of
+  // each cell, so allow twice the tolerance in between
+  Cube cube("$base/testData/f319b18_ideal_flat.cub");
+  expectCameraAngles(cube, 0.01, 0.02);
+}
+
+
+TEST(GeometryBackplanes, EllipsoidLocalAnglesMatchTheCamera) {
+  Cube cube("$base/testData/f319b18_ideal_flat.cub");
+  expectLocalCameraAngles(cube);
+}
+
+
+TEST(GeometryBackplanes, DemLocalAnglesMatchTheCamera) {
+  QString cubeFile = QDir::tempPath() + "/GeometryBackplanesTests.cub";
+  QString demFile = QDir::tempPath() + "/GeometryBackplanesTestsDem.cub";
+  writeDem(demFile);
+
+  QFile::remove(cubeFile);
+  ASSERT_TRUE(QFile::copy(FileName("$base/testData/f319b18_ideal_flat.cub").expanded(),
+                          cubeFile));
+  QFile::setPermissions(cubeFile, QFile::ReadOwner | QFile::WriteOwner);
+
+  Cube cube(cubeFile, "rw");
+  PvlGroup &kernels = cube.label()->findObject("IsisCube").findGroup("Kernels");
+  kernels.addKeyword(PvlKeyword("ShapeModel", demFile), PvlContainer::Replace);
+  cube.close();
+
+  cube.open(cubeFile);
+  ASSERT_TRUE(cube.camera()->target()->shape()->isDEM());
+  expectLocalCameraAngles(cube);
+  cube.close();
+
+  QFile::remove(cubeFile);
+  QFile::remove(demFile);
+}
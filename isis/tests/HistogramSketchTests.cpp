@@ -0,0 +1,81 @@
+#include "Histogram.h"
+#include "HistogramSketch.h"
+#include "SpecialPixel.h"
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+TEST(HistogramSketch, ExactWhileValuesAreKept) {
+  HistogramSketch sketch(16);
+  double data[] = {5.0, Null, 1.0, 4.0, Lrs, 2.0, 3.0};
+  sketch.AddData(data, 7);
+
+  EXPECT_EQ(5, sketch.ValidPixels());
+  EXPECT_EQ(0.0, sketch.BinSize());
+  EXPECT_EQ(1.0, sketch.Minimum());
+  EXPECT_EQ(5.0, sketch.Maximum());
+  EXPECT_EQ(3.0, sketch.Median());
+  EXPECT_EQ(1.0, sketch.Percent(0.0));
+  EXPECT_EQ(2.0, sketch.Percent(40.0));
+  EXPECT_EQ(5.0, sketch.Percent(100.0));
+}
+
+
+TEST(HistogramSketch, EmptyAndInvalidPercent) {
+  HistogramSketch sketch;
+  EXPECT_EQ(Null, sketch.Median());
+  EXPECT_EQ(Null, sketch.Minimum());
+  EXPECT_THROW(sketch.Percent(101.0), IException);
+  EXPECT_THROW(HistogramSketch(1), IException);
+}
+
+
+TEST(HistogramSketch, GrowsToFitLaterValues) {
+  HistogramSketch sketch(64);
+  for (int i = 0; i < 64; i++) {
+    sketch.AddData(100.0 + i);
+  }
+  double firstBinSize = sketch.BinSize();
+  EXPECT_GT(firstBinSize, 0.0);
+
+  // Values on both sides of the first range
+  for (int i = 0; i < 1000; i++) {
+    sketch.AddData(-500.0 + i);
+  }
+  for (int i = 0; i < 1000; i++) {
+    sketch.AddData(1000.0 + i);
+  }
+
+  EXPECT_EQ(2064, sketch.ValidPixels());
+  EXPECT_EQ(-500.0, sketch.Minimum());
+  EXPECT_EQ(1999.0, sketch.Maximum());
+  EXPECT_EQ(-500.0, sketch.Percent(0.0));
+  EXPECT_NEAR(1999.0, sketch.Percent(100.0), sketch.BinSize());
+
+  // The bins are a few times as wide as needed for the whole range at most
+  EXPECT_LE(sketch.BinSize(), 4.0 * 2499.0 / 63.0);
+  EXPECT_NEAR(467.0, sketch.Percent(50.0), sketch.BinSize());
+}
+
+
+TEST(HistogramSketch, AgreesWithHistogram) {
+  std::vector<double> data;
+  for (int i = 0; i < 200000; i++) {
+    data.push_back(std::sin(i * 0.001) * 1000.0 + (i % 97));
+  }
+
+  HistogramSketch sketch(1024);
+  sketch.AddData(data.data(), data.size());
+
+  Histogram histogram(sketch.Minimum(), sketch.Maximum(), 1024);
+  histogram.AddData(data.data(), data.size());
+
+  for (double percent = 0.5; percent < 100.0; percent += 12.25) {
+    EXPECT_NEAR(histogram.Percent(percent), sketch.Percent(percent),
+                sketch.BinSize() + histogram.BinSize());
+  }
+}
@@ -0,0 +1,112 @@
+#include "ImageOverlap.h"
+#include "ImageOverlapSet.h"
+#include "PolygonTools.h"
+
+#include <vector>
+
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/geom/Polygon.h>
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * Creates a two by two degree square with its lower left corner at a position.
+ */
+static geos::geom::MultiPolygon *square(double lon, double lat) {
+  geos::geom::CoordinateSequence *pts = new geos::geom::CoordinateArraySequence();
+  pts->add(geos::geom::Coordinate(lon, lat));
+  pts->add(geos::geom::Coordinate(lon, lat + 2.0));
+  pts->add(geos::geom::Coordinate(lon + 2.0, lat + 2.0));
+  pts->add(geos::geom::Coordinate(lon + 2.0, lat));
+  pts->add(geos::geom::Coordinate(lon, lat));
+
+  std::vector<geos::geom::Geometry *> polys;
+  polys.push_back(globalFactory.createPolygon(globalFactory.createLinearRing(pts), NULL));
+  return globalFactory.createMultiPolygon(polys);
+}
+
+
+/**
+ * Returns the sorted serial numbers of a set of images as one key.
+ */
+static QString serialNumbersKey(QStringList serialNumbers) {
+  serialNumbers.sort();
+  return serialNumbers.join(",");
+}
+
+
+TEST(ImageOverlapSet, OverlapsMatchBruteForce) {
+  // Two clusters of squares on a half degree grid, far enough apart that the
+  // footprint index separates them. The first square is repeated so that
+  // equal polygons are merged.
+  std::vector<double> lons;
+  std::vector<double> lats;
+  for (int i = 0; i < 16; i++) {
+    lons.push_back(10.0 + (i * 7 % 13) * 0.5);
+    lats.push_back(10.0 + (i * 5 % 11) * 0.5);
+  }
+  for (int i = 0; i < 6; i++) {
+    lons.push_back(40.0 + i * 0.5);
+    lats.push_back(20.0 + (i % 2) * 1.5);
+  }
+  lons.push_back(lons[0]);
+  lats.push_back(lats[0]);
+
+  std::vector<QString> sns;
+  std::vector<geos::geom::MultiPolygon *> polygons;
+  for (unsigned int i = 0; i < lons.size(); i++) {
+    sns.push_back("Image" + QString::number(i));
+    polygons.push_back(square(lons[i], lats[i]));
+  }
+
+  // Brute force the area covered by each set of images one grid cell at a time
+  QMap<QString, double> expected;
+  for (double lon = 10.0; lon < 50.0; lon += 0.5) {
+    for (double lat = 10.0; lat < 30.0; lat += 0.5) {
+      QStringList covering;
+      for (unsigned int i = 0; i < lons.size(); i++) {
+        if (lon + 0.25 > lons[i] && lon + 0.25 < lons[i] + 2.0 &&
+            lat + 0.25 > lats[i] && lat + 0.25 < lats[i] + 2.0) {
+          covering.append(sns[i]);
+        }
+      }
+
+      if (!covering.isEmpty()) {
+        expected[serialNumbersKey(covering)] += 0.25;
+      }
+    }
+  }
+
+  ImageOverlapSet overlapSet;
+  overlapSet.FindImageOverlaps(sns, polygons);
+
+  QMap<QString, double> found;
+  for (int i = 0; i < overlapSet.Size(); i++) {
+    const ImageOverlap *overlap = overlapSet[i];
+    if (overlap->Polygon()->isEmpty()) continue;
+
+    QStringList serialNumbers;
+    for (int sn = 0; sn < overlap->Size(); sn++) {
+      serialNumbers.append((*overlap)[sn]);
+    }
+    found[serialNumbersKey(serialNumbers)] += overlap->Polygon()->getArea();
+  }
+
+  EXPECT_EQ(expected.keys(), found.keys());
+  QMap<QString, double>::const_iterator area;
+  for (area = expected.constBegin(); area != expected.constEnd(); ++area) {
+    EXPECT_NEAR(area.value(), found.value(area.key()), 1.0e-9) << area.key().toStdString();
+  }
+
+  for (unsigned int i = 0; i < polygons.size(); i++) {
+    delete polygons[i];
+  }
+}
@@ -0,0 +1,57 @@
+#include "Cube.h"
+#include "ImagePolygon.h"
+#include "PolygonTools.h"
+
+#include <geos/geom/Geometry.h>
+#include <geos/geom/MultiPolygon.h>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * Expects two footprints to cover nearly the same area.
+ */
+static void expectSameFootprint(geos::geom::MultiPolygon *expected,
+                                geos::geom::MultiPolygon *footprint,
+                                double fraction) {
+  ASSERT_TRUE(footprint->isValid());
+  ASSERT_GT(expected->getArea(), 0.0);
+
+  geos::geom::Geometry *overlap = PolygonTools::Intersect(expected, footprint);
+  EXPECT_NEAR(1.0, overlap->getArea() / expected->getArea(), fraction);
+  EXPECT_NEAR(1.0, overlap->getArea() / footprint->getArea(), fraction);
+  delete overlap;
+}
+
+
+TEST(ImagePolygon, TracedFootprintMatchesTheWalk) {
+  Cube cube("$base/testData/f319b18_ideal_flat.cub");
+
+  ImagePolygon walked;
+  walked.Create(cube, 20, 20);
+
+  ImagePolygon traced;
+  traced.AdaptiveTolerance(50.0);
+  traced.Create(cube, 20, 20);
+
+  expectSameFootprint(walked.Polys(), traced.Polys(), 0.01);
+}
+
+
+TEST(ImagePolygon, CreatingAgainGivesTheSameFootprint) {
+  Cube cube("$base/testData/f319b18_ideal_flat.cub");
+
+  ImagePolygon first;
+  first.AdaptiveTolerance(50.0);
+  first.Create(cube, 20, 20);
+
+  // The footprint of a sub-area first must not change the footprint of the
+  // whole image created with the same object
+  ImagePolygon polygon;
+  polygon.AdaptiveTolerance(50.0);
+  polygon.Create(cube, 20, 20, 100, 100, 200, 200);
+  polygon.Create(cube, 20, 20);
+
+  expectSameFootprint(first.Polys(), polygon.Polys(), 1.0e-12);
+}
@@ -0,0 +1,116 @@
+#include "Fixtures.h"
+#include "IException.h"
+#include "Interpolator.h"
+#include "SpecialPixel.h"
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * The value of a pixel of the test tile. Every 23rd pixel is NULL so some
+ * windows drop down to the lower interpolators.
+ */
+static double tileValue(int index) {
+  if (index % 23 == 11) {
+    return Null;
+  }
+  return testValue(index);
+}
+
+
+/**
+ * Interpolates every coordinate one at a time from a window copied out of the
+ * tile, with NULLs outside the tile, and compares them to the batch values.
+ */
+static void compareToSingle(Interpolator::interpType type) {
+  int tileSamples = 21;
+  int tileLines = 17;
+  int startSample = 5;
+  int startLine = 11;
+
+  std::vector<double> tile(tileSamples * tileLines);
+  for (int i = 0; i < (int) tile.size(); i++) {
+    tile[i] = tileValue(i);
+  }
+
+  // Cover the tile and a border around it, more than one batch of weights
+  std::vector<double> samples;
+  std::vector<double> lines;
+  for (double line = startLine - 2.0; line < startLine + tileLines + 2.0; line += 0.37) {
+    for (double samp = startSample - 2.0; samp < startSample + tileSamples + 2.0; samp += 0.41) {
+      samples.push_back(samp);
+      lines.push_back(line);
+    }
+  }
+
+  Interpolator interp(type);
+  std::vector<double> values(samples.size());
+  interp.Interpolate(&samples[0], &lines[0], (int) samples.size(), &tile[0],
+                     tileSamples, tileLines, startSample, startLine, &values[0]);
+
+  int windowSamples = interp.Samples();
+  int windowLines = interp.Lines();
+  for (int i = 0; i < (int) samples.size(); i++) {
+    int firstSample = (int) floor(samples[i] - interp.HotSample()) - startSample;
+    int firstLine = (int) floor(lines[i] - interp.HotLine()) - startLine;
+
+    double buf[16];
+    for (int l = 0; l < windowLines; l++) {
+      for (int s = 0; s < windowSamples; s++) {
+        int ts = firstSample + s;
+        int tl = firstLine + l;
+        bool outside = (ts < 0 || tl < 0 || ts >= tileSamples || tl >= tileLines);
+        buf[l * windowSamples + s] = outside ? Null : tile[tl * tileSamples + ts];
+      }
+    }
+
+    EXPECT_EQ(interp.Interpolate(samples[i], lines[i], buf), values[i]);
+  }
+}
+
+
+TEST(Interpolator, BatchNearestNeighbor) {
+  compareToSingle(Interpolator::NearestNeighborType);
+}
+
+
+TEST(Interpolator, BatchBiLinear) {
+  compareToSingle(Interpolator::BiLinearType);
+}
+
+
+TEST(Interpolator, BatchCubicConvolution) {
+  compareToSingle(Interpolator::CubicConvolutionType);
+}
+
+
+TEST(Interpolator, BatchTypeMustBeSet) {
+  Interpolator interp;
+  double tile[] = {1.0};
+  double sample = 1.0;
+  double line = 1.0;
+  double value;
+
+  EXPECT_THROW(interp.Interpolate(&sample, &line, 1, tile, 1, 1, 1, 1, &value),
+               IException);
+}
+
+
+TEST(Interpolator, TileExtentHoldsEveryWindow) {
+  Interpolator interp(Interpolator::CubicConvolutionType);
+  double samples[] = {3.2, 10.9, 7.5};
+  double lines[] = {-1.4, 4.0, 8.6};
+
+  int startSample, startLine, tileSamples, tileLines;
+  interp.TileExtent(samples, lines, 3, startSample, startLine,
+                    tileSamples, tileLines);
+
+  EXPECT_EQ(2, startSample);
+  EXPECT_EQ(-3, startLine);
+  EXPECT_EQ(11, tileSamples);
+  EXPECT_EQ(14, tileLines);
+}
@@ -0,0 +1,191 @@
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "FileName.h"
+#include "IException.h"
+#include "JP2Decoder.h"
+#include "JP2Encoder.h"
+#include "JP2Importer.h"
+#include "LineManager.h"
+#include "PixelType.h"
+
+#include <vector>
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+#if ENABLEJP2K
+
+/**
+ * The value of a pixel of the test image, or a constant when the image has
+ * to stay the same at every resolution.
+ */
+static int jp2Value(int sample, int line, int band, bool constant) {
+  if (constant) {
+    return 40 * band + 17;
+  }
+  return (sample * 3 + line * 7 + band * 50) % 251;
+}
+
+
+/**
+ * Losslessly encodes a 300 by 260 byte test image.
+ */
+static void writeTestJp2(const QString &fileName, int bands, bool constant = false) {
+  int samples = 300;
+  int lines = 260;
+
+  JP2Encoder encoder(fileName, samples, lines, bands, UnsignedByte);
+  encoder.OpenFile();
+
+  std::vector< std::vector<unsigned char> > data(bands, std::vector<unsigned char>(samples));
+  std::vector<unsigned char *> buffers(bands);
+  for (int line = 1; line <= lines; line++) {
+    for (int band = 0; band < bands; band++) {
+      for (int sample = 1; sample <= samples; sample++) {
+        data[band][sample - 1] = jp2Value(sample, line, band + 1, constant);
+      }
+      buffers[band] = &data[band][0];
+    }
+    encoder.Write(&buffers[0]);
+  }
+}
+
+
+/**
+ * Reads every line of an open decoder.
+ */
+static std::vector< std::vector<unsigned char> > readJp2(JP2Decoder &decoder) {
+  int samples = decoder.GetSampleDimension();
+  int bands = decoder.GetBandDimension();
+
+  std::vector< std::vector<unsigned char> > image(bands);
+  std::vector< std::vector<unsigned char> > line(bands, std::vector<unsigned char>(samples));
+  std::vector<unsigned char *> buffers(bands);
+  for (int band = 0; band < bands; band++) {
+    buffers[band] = &line[band][0];
+  }
+
+  for (int l = 0; l < decoder.GetLineDimension(); l++) {
+    decoder.Read(&buffers[0]);
+    for (int band = 0; band < bands; band++) {
+      image[band].insert(image[band].end(), line[band].begin(), line[band].end());
+    }
+  }
+  return image;
+}
+
+
+TEST(JP2Decoder, RegionMatchesTheFullImage) {
+  QString fileName = QDir::tempPath() + "/JP2ImporterTests.jp2";
+  writeTestJp2(fileName, 2);
+
+  JP2Decoder decoder(fileName);
+  decoder.SetRegion(37, 21, 190, 133);
+  decoder.OpenFile();
+  ASSERT_EQ(190, decoder.GetSampleDimension());
+  ASSERT_EQ(133, decoder.GetLineDimension());
+  ASSERT_EQ(2, decoder.GetBandDimension());
+
+  std::vector< std::vector<unsigned char> > region = readJp2(decoder);
+  for (int band = 0; band < 2; band++) {
+    for (int line = 0; line < 133; line++) {
+      for (int sample = 0; sample < 190; sample++) {
+        ASSERT_EQ(jp2Value(sample + 37, line + 21, band + 1, false),
+                  region[band][line * 190 + sample]);
+      }
+    }
+  }
+
+  QFile::remove(fileName);
+}
+
+
+TEST(JP2Decoder, ResolutionReductionHalvesEachLevel) {
+  QString fileName = QDir::tempPath() + "/JP2ImporterTests.jp2";
+  writeTestJp2(fileName, 2, true);
+
+  JP2Decoder decoder(fileName);
+  decoder.SetResolutionReduction(2);
+  decoder.OpenFile();
+  EXPECT_EQ(4, decoder.GetResolutionLevels());
+  ASSERT_EQ(75, decoder.GetSampleDimension());
+  ASSERT_EQ(65, decoder.GetLineDimension());
+
+  std::vector< std::vector<unsigned char> > reduced = readJp2(decoder);
+  for (int band = 0; band < 2; band++) {
+    ASSERT_EQ(75u * 65u, reduced[band].size());
+    for (unsigned int i = 0; i < reduced[band].size(); i++) {
+      ASSERT_EQ(jp2Value(1, 1, band + 1, true), reduced[band][i]);
+    }
+  }
+
+  QFile::remove(fileName);
+}
+
+
+TEST(JP2Importer, ImportsARegion) {
+  QString fileName = QDir::tempPath() + "/JP2ImporterTests.jp2";
+  QString cubeFile = QDir::tempPath() + "/JP2ImporterTests.cub";
+  writeTestJp2(fileName, 1);
+
+  FileName jp2File(fileName);
+  JP2Importer importer(jp2File);
+  EXPECT_EQ(300, importer.samples());
+  EXPECT_EQ(260, importer.lines());
+  importer.setRegion(101, 51, 150, 80);
+  EXPECT_EQ(150, importer.samples());
+  EXPECT_EQ(80, importer.lines());
+
+  CubeAttributeOutput att;
+  Cube *cube = importer.import(FileName(cubeFile), att);
+  ASSERT_EQ(150, cube->sampleCount());
+  ASSERT_EQ(80, cube->lineCount());
+
+  LineManager line(*cube);
+  for (line.begin(); !line.end(); line++) {
+    cube->read(line);
+    for (int i = 0; i < line.size(); i++) {
+      ASSERT_EQ(jp2Value(i + 101, line.Line() + 50, 1, false), line[i]);
+    }
+  }
+
+  cube->close();
+  QFile::remove(fileName);
+  QFile::remove(cubeFile);
+}
+
+
+TEST(JP2Importer, ImportsAReducedRegion) {
+  QString fileName = QDir::tempPath() + "/JP2ImporterTests.jp2";
+  writeTestJp2(fileName, 1, true);
+
+  FileName jp2File(fileName);
+  JP2Importer importer(jp2File);
+  importer.setRegion(1, 1, 200, 160);
+  importer.setResolutionReduction(1);
+  EXPECT_EQ(100, importer.samples());
+  EXPECT_EQ(80, importer.lines());
+
+  QFile::remove(fileName);
+}
+
+
+TEST(JP2Importer, RejectsARegionOutsideTheImage) {
+  QString fileName = QDir::tempPath() + "/JP2ImporterTests.jp2";
+  writeTestJp2(fileName, 1);
+
+  FileName jp2File(fileName);
+  JP2Importer importer(jp2File);
+  EXPECT_THROW(importer.setRegion(250, 1, 60, 10), IException);
+  EXPECT_THROW(importer.setResolutionReduction(4), IException);
+  EXPECT_EQ(300, importer.samples());
+
+  QFile::remove(fileName);
+}
+
+#endif
@@ -0,0 +1,166 @@
+#include "IException.h"
+#include "KernelDbIndex.h"
+#include "Pvl.h"
+
+#include <cfloat>
+#include <sstream>
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QDataStream>
+#include <QList>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+using namespace std;
+
+/**
+ * Sorts a list of values so results can be compared.
+ */
+static QList<int> sorted(QList<int> values) {
+  qSort(values);
+  return values;
+}
+
+
+TEST(KernelDbIndex, IntervalTreeStab) {
+  KernelDbIndex::IntervalTree tree;
+  tree.add(10.0, 20.0, 0);
+  tree.add(0.0, 5.0, 1);
+  tree.add(15.0, 30.0, 2);
+  tree.add(-DBL_MAX, DBL_MAX, 3);
+  tree.add(20.0, 20.0, 4);
+  tree.build();
+
+  EXPECT_EQ(QList<int>() << 1 << 3, sorted(tree.stab(0.0)));
+  EXPECT_EQ(QList<int>() << 3, sorted(tree.stab(7.5)));
+  EXPECT_EQ(QList<int>() << 0 << 2 << 3, sorted(tree.stab(15.0)));
+  EXPECT_EQ(QList<int>() << 0 << 2 << 3 << 4, sorted(tree.stab(20.0)));
+  EXPECT_EQ(QList<int>() << 2 << 3, sorted(tree.stab(30.0)));
+  EXPECT_EQ(QList<int>() << 3, sorted(tree.stab(1.0e10)));
+}
+
+
+TEST(KernelDbIndex, IntervalTreeMatchesScan) {
+  KernelDbIndex::IntervalTree tree;
+  QList< QPair<double, double> > ranges;
+
+  for (int i = 0; i < 200; i++) {
+    double start = (i * 37) % 101;
+    double end = start + (i * 13) % 17;
+    ranges.append(qMakePair(start, end));
+    tree.add(start, end, i);
+  }
+  tree.build();
+
+  for (double point = -1.0; point < 120.0; point += 0.5) {
+    QList<int> expected;
+    for (int i = 0; i < ranges.size(); i++) {
+      if (ranges[i].first <= point && ranges[i].second >= point) expected.append(i);
+    }
+    EXPECT_EQ(expected, sorted(tree.stab(point))) << point;
+  }
+}
+
+
+TEST(KernelDbIndex, Selections) {
+  stringstream db;
+  db << "Object = SpacecraftPointing\n"
+        "  Group = Selection\n"
+        "    File = (\"Test\", \"a.bc\")\n"
+        "    Type = Reconstructed\n"
+        "  End_Group\n"
+        "  Group = Other\n"
+        "    File = \"ignored.bc\"\n"
+        "  End_Group\n"
+        "  Group = Selection\n"
+        "    Match = (Instrument, InstrumentId, \" hirise \")\n"
+        "    File = \"b.bc\"\n"
+        "    CameraVersion = \"1-2, 4\"\n"
+        "  End_Group\n"
+        "  Group = Selection\n"
+        "    Match = (Instrument, InstrumentId, CTX)\n"
+        "    File = \"c.bc\"\n"
+        "  End_Group\n"
+        "  Group = Selection\n"
+        "    Match = (Instrument)\n"
+        "    File = \"d.bc\"\n"
+        "  End_Group\n"
+        "End_Object\n"
+        "Object = Frame\n"
+        "End_Object\n"
+        "End\n";
+  Pvl pvl;
+  db >> pvl;
+
+  KernelDbIndex index(pvl);
+  ASSERT_EQ(2, index.objects());
+  EXPECT_TRUE(index.hasObject("Spacecraft_Pointing"));
+  EXPECT_FALSE(index.hasObject("Instrument"));
+  EXPECT_EQ("Frame", index.objectName(1));
+
+  const KernelDbIndex::Selection &first = index.selection(0, 0);
+  EXPECT_TRUE(first.hasType);
+  EXPECT_EQ("Reconstructed", first.type);
+  ASSERT_EQ(1, first.files.size());
+  EXPECT_EQ(QStringList() << "Test" << "a.bc", first.files[0]);
+
+  const KernelDbIndex::Selection &second = index.selection(0, 1);
+  EXPECT_FALSE(second.hasType);
+  ASSERT_EQ(1, second.matches.size());
+  EXPECT_EQ("HIRISE", KernelDbIndex::instrumentId(second.matches[0]));
+  EXPECT_EQ(QStringList() << "1-2, 4", second.cameraVersions);
+  EXPECT_FALSE(index.selection(0, 3).matches[0].valid);
+
+  // Selections without Time keywords match every time, newest first
+  EXPECT_EQ(QList<int>() << 3 << 0, index.selections(0, 0.0, ""));
+  EXPECT_EQ(QList<int>() << 3 << 1 << 0, index.selections(0, 0.0, "HIRISE"));
+  EXPECT_EQ(QList<int>() << 3 << 2 << 0, index.selections(0, 1.0e9, "CTX"));
+  EXPECT_TRUE(index.selections(1, 0.0, "CTX").isEmpty());
+}
+
+
+TEST(KernelDbIndex, WriteAndRead) {
+  stringstream db;
+  db << "Object = Instrument\n"
+        "  Group = Selection\n"
+        "    Match = (Instrument, InstrumentId, HiRISE)\n"
+        "    File = (\"mro\", \"kernels/ik/mro_hirise_v??.ti\")\n"
+        "  End_Group\n"
+        "End_Object\n"
+        "End\n";
+  Pvl pvl;
+  db >> pvl;
+  KernelDbIndex index(pvl);
+
+  QByteArray data;
+  QBuffer buffer(&data);
+  buffer.open(QIODevice::WriteOnly);
+  QDataStream out(&buffer);
+  index.write(out);
+  buffer.close();
+
+  buffer.open(QIODevice::ReadOnly);
+  QDataStream in(&buffer);
+  KernelDbIndex read;
+  read.read(in);
+
+  ASSERT_EQ(1, read.objects());
+  EXPECT_EQ("Instrument", read.objectName(0));
+  EXPECT_EQ(QList<int>() << 0, read.selections(0, 0.0, "HIRISE"));
+  EXPECT_TRUE(read.selections(0, 0.0, "CTX").isEmpty());
+  EXPECT_EQ(index.selection(0, 0).files, read.selection(0, 0).files);
+
+  // Appending keeps the objects of both indexes in order
+  read.append(index);
+  EXPECT_EQ(2, read.objects());
+
+  QByteArray truncated = data.left(data.size() / 2);
+  QBuffer truncatedBuffer(&truncated);
+  truncatedBuffer.open(QIODevice::ReadOnly);
+  QDataStream truncatedIn(&truncatedBuffer);
+  KernelDbIndex failed;
+  EXPECT_THROW(failed.read(truncatedIn), IException);
+  EXPECT_EQ(0, failed.objects());
+}
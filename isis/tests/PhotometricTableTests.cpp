@@ -0,0 +1,95 @@
+#include "PhotometricTable.h"
+
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * A function that trilinear interpolation reproduces exactly.
+ */
+static void linearFunction(void *model, double phase, double incidence,
+                           double emission, double *values) {
+  (*(int *)model)++;
+  values[0] = 2.0 * phase - incidence + 0.5 * emission;
+  values[1] = phase * incidence;
+}
+
+
+/**
+ * A function with second derivatives of 2 in each angle.
+ */
+static void quadraticFunction(void *model, double phase, double incidence,
+                              double emission, double *values) {
+  values[0] = phase * phase + incidence * incidence + emission * emission;
+}
+
+
+/**
+ * A function that is not finite at normal incidence.
+ */
+static void singularFunction(void *model, double phase, double incidence,
+                             double emission, double *values) {
+  values[0] = (incidence == 0.0) ? std::numeric_limits<double>::infinity() :
+                                   1.0 / incidence;
+}
+
+
+TEST(PhotometricTable, InterpolatesMultilinearFunctions) {
+  int evaluations = 0;
+  PhotometricTable table(2, linearFunction, &evaluations);
+  double values[2];
+
+  EXPECT_FALSE(table.evaluate(30.0, 20.0, 10.0, values));
+  EXPECT_EQ(0, evaluations);
+
+  table.setStep(1.0);
+  EXPECT_EQ(1.0, table.step());
+  ASSERT_TRUE(table.evaluate(30.25, 20.5, 10.75, values));
+  EXPECT_NEAR(2.0 * 30.25 - 20.5 + 0.5 * 10.75, values[0], 1.0e-10);
+  EXPECT_NEAR(30.25 * 20.5, values[1], 1.0e-10);
+  EXPECT_NEAR(0.0, table.maximumError(0), 1.0e-10);
+
+  // Eight corners and the check at the center of the cell
+  EXPECT_EQ(9, evaluations);
+  ASSERT_TRUE(table.evaluate(30.75, 20.25, 10.5, values));
+  EXPECT_EQ(9, evaluations);
+
+  ASSERT_TRUE(table.evaluate(180.0, 90.0, 90.0, values));
+  EXPECT_NEAR(2.0 * 180.0 - 90.0 + 45.0, values[0], 1.0e-10);
+}
+
+
+TEST(PhotometricTable, MeasuresInterpolationError) {
+  PhotometricTable table(1, quadraticFunction, NULL);
+  table.setStep(2.0);
+
+  double value;
+  ASSERT_TRUE(table.evaluate(41.0, 31.0, 21.0, &value));
+  EXPECT_NEAR(41.0 * 41.0 + 31.0 * 31.0 + 21.0 * 21.0 + 3.0, value, 1.0e-9);
+
+  // The bound is h^2 / 8 times the sum of the second derivatives
+  EXPECT_NEAR(3.0, table.maximumError(0), 1.0e-9);
+  EXPECT_LE(table.maximumError(0), 2.0 * 2.0 / 8.0 * (2.0 + 2.0 + 2.0));
+
+  table.clear();
+  EXPECT_EQ(0.0, table.maximumError(0));
+}
+
+
+TEST(PhotometricTable, RejectsUntabulatedAngles) {
+  PhotometricTable table(1, singularFunction, NULL);
+  table.setStep(5.0);
+
+  double value;
+  EXPECT_FALSE(table.evaluate(-1.0, 30.0, 30.0, &value));
+  EXPECT_FALSE(table.evaluate(30.0, 91.0, 30.0, &value));
+  EXPECT_FALSE(table.evaluate(30.0, 30.0, std::nan(""), &value));
+  EXPECT_FALSE(table.evaluate(30.0, 2.0, 30.0, &value));
+  EXPECT_TRUE(table.evaluate(30.0, 12.0, 30.0, &value));
+
+  table.setStep(0.0);
+  EXPECT_FALSE(table.evaluate(30.0, 12.0, 30.0, &value));
+}
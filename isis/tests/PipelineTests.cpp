@@ -0,0 +1,68 @@
+#include "Cube.h"
+#include "CubeMemoryHandler.h"
+#include "FileName.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "Pipeline.h"
+#include "PipelineApplication.h"
+
+#include <vector>
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+TEST(Pipeline, InProcessCrops) {
+  QString inputFile = QDir::tempPath() + "/PipelineTests.cub";
+  QString outputFile = QDir::tempPath() + "/PipelineTestsOut.cub";
+  writeTestCube(inputFile, 10, 8);
+
+  // The first crop's output is a temporary cube kept in memory
+  Pipeline pipeline("PipelineTests");
+  pipeline.SetInputFile(FileName(inputFile));
+  pipeline.SetOutputFile(FileName(outputFile));
+  pipeline.KeepTemporaryFiles(false);
+  pipeline.SetInProcess(true);
+  EXPECT_TRUE(pipeline.InProcess());
+
+  pipeline.AddToPipeline("crop", "samples");
+  pipeline.Application("samples").SetInputParameter("FROM", false);
+  pipeline.Application("samples").SetOutputParameter("TO", "samples");
+  pipeline.Application("samples").AddConstParameter("SAMPLE", "2");
+  pipeline.Application("samples").AddConstParameter("NSAMPLES", "6");
+
+  pipeline.AddToPipeline("crop", "lines");
+  pipeline.Application("lines").SetInputParameter("FROM", false);
+  pipeline.Application("lines").SetOutputParameter("TO", "lines");
+  pipeline.Application("lines").AddConstParameter("LINE", "3");
+  pipeline.Application("lines").AddConstParameter("NLINES", "4");
+
+  pipeline.Run();
+
+  std::vector<QString> temporary = pipeline.Application("samples").TemporaryFiles();
+  ASSERT_FALSE(temporary.empty());
+  for (unsigned int i = 0; i < temporary.size(); i++) {
+    EXPECT_FALSE(QFile::exists(FileName(temporary[i]).expanded()));
+    EXPECT_FALSE(CubeMemoryHandler::hasFile(FileName(temporary[i]).expanded()));
+  }
+
+  Cube output(outputFile);
+  EXPECT_EQ(6, output.sampleCount());
+  EXPECT_EQ(4, output.lineCount());
+
+  LineManager line(output);
+  for (line.begin(); !line.end(); line++) {
+    output.read(line);
+    for (int i = 0; i < line.size(); i++) {
+      EXPECT_EQ(testValue(i + 2, line.Line() + 2), line[i]);
+    }
+  }
+
+  output.close();
+  QFile::remove(inputFile);
+  QFile::remove(outputFile);
+}
@@ -0,0 +1,407 @@
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "Endian.h"
+#include "LineManager.h"
+#include "PixelType.h"
+#include "ProcessImport.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * The layout of a raw test file.
+ */
+struct RawLayout {
+  ProcessImport::Interleave organization;
+  PixelType pixelType;
+  ByteOrder byteOrder;
+  int samples;
+  int lines;
+  int bands;
+  int fileHeaderBytes;
+  int fileTrailerBytes;
+  int prefixBytes;
+  int suffixBytes;
+};
+
+
+/**
+ * Returns a layout without any bytes around the image data.
+ */
+static RawLayout rawLayout(ProcessImport::Interleave organization,
+                           PixelType pixelType, ByteOrder byteOrder,
+                           int samples = 7, int lines = 5, int bands = 3) {
+  RawLayout layout;
+  layout.organization = organization;
+  layout.pixelType = pixelType;
+  layout.byteOrder = byteOrder;
+  layout.samples = samples;
+  layout.lines = lines;
+  layout.bands = bands;
+  layout.fileHeaderBytes = 0;
+  layout.fileTrailerBytes = 0;
+  layout.prefixBytes = 0;
+  layout.suffixBytes = 0;
+  return layout;
+}
+
+
+/**
+ * The value of an input pixel. The values fill the high and low bytes of
+ * each pixel type so swapping the wrong bytes changes them.
+ */
+static double rawValue(PixelType pixelType, int sample, int line, int band) {
+  int index = (sample + 10 * line + 60 * band) % 256;
+
+  switch (pixelType) {
+    case UnsignedByte:
+      return index;
+    case UnsignedWord:
+      return index * 257;
+    case SignedWord:
+      return index * 251 - 32000;
+    case UnsignedInteger:
+      return index * 16777216.0 + index * 257 + 3;
+    case SignedInteger:
+      return index * 8388608.0 - 1000000000.0 + index;
+    case Real:
+      return index * 0.25 - 30.0;
+    case Double:
+      return index * 1.0e6 + 0.125;
+    default:
+      return 0.0;
+  }
+}
+
+
+/**
+ * The value of a pixel of the imported cube, which stores reals.
+ */
+static double importedValue(PixelType pixelType, int sample, int line, int band) {
+  return (float) rawValue(pixelType, sample, line, band);
+}
+
+
+/**
+ * Appends the bytes of a pixel in a byte order.
+ */
+static void appendPixel(std::vector<char> &data, PixelType pixelType,
+                        ByteOrder byteOrder, double value) {
+  char bytes[8];
+  int size = SizeOf(pixelType);
+
+  switch (pixelType) {
+    case UnsignedByte: {
+        unsigned char pixel = (unsigned char) value;
+        memcpy(bytes, &pixel, size);
+        break;
+      }
+    case UnsignedWord: {
+        unsigned short int pixel = (unsigned short int) value;
+        memcpy(bytes, &pixel, size);
+        break;
+      }
+    case SignedWord: {
+        short int pixel = (short int) value;
+        memcpy(bytes, &pixel, size);
+        break;
+      }
+    case UnsignedInteger: {
+        unsigned int pixel = (unsigned int) value;
+        memcpy(bytes, &pixel, size);
+        break;
+      }
+    case SignedInteger: {
+        int pixel = (int) value;
+        memcpy(bytes, &pixel, size);
+        break;
+      }
+    case Real: {
+        float pixel = (float) value;
+        memcpy(bytes, &pixel, size);
+        break;
+      }
+    default: {
+        memcpy(bytes, &value, size);
+        break;
+      }
+  }
+
+  if ((byteOrder == Lsb) != IsLsb()) {
+    std::reverse(bytes, bytes + size);
+  }
+  data.insert(data.end(), bytes, bytes + size);
+}
+
+
+/**
+ * Appends a run of filler bytes that identify the run.
+ */
+static void appendBytes(std::vector<char> &data, int count, int run) {
+  for (int i = 0; i < count; i++) {
+    data.push_back((char) (run * 7 + i));
+  }
+}
+
+
+/**
+ * Expects saved filler bytes to be the ones written for a run.
+ */
+static void expectBytes(const char *bytes, int count, int run) {
+  for (int i = 0; i < count; i++) {
+    EXPECT_EQ((char) (run * 7 + i), bytes[i]);
+  }
+}
+
+
+/**
+ * Writes a raw file. In BSQ and BIL files each line of each band is a record
+ * with its own prefix and suffix. In BIP files each sample is a record.
+ */
+static void writeRawFile(const QString &fileName, const RawLayout &layout) {
+  std::vector<char> data;
+  appendBytes(data, layout.fileHeaderBytes, 1);
+
+  int record = 0;
+  if (layout.organization == ProcessImport::BSQ) {
+    for (int band = 1; band <= layout.bands; band++) {
+      for (int line = 1; line <= layout.lines; line++, record++) {
+        appendBytes(data, layout.prefixBytes, record);
+        for (int sample = 1; sample <= layout.samples; sample++) {
+          appendPixel(data, layout.pixelType, layout.byteOrder,
+                      rawValue(layout.pixelType, sample, line, band));
+        }
+        appendBytes(data, layout.suffixBytes, record + 1);
+      }
+    }
+  }
+  else if (layout.organization == ProcessImport::BIL) {
+    for (int line = 1; line <= layout.lines; line++) {
+      for (int band = 1; band <= layout.bands; band++, record++) {
+        appendBytes(data, layout.prefixBytes, record);
+        for (int sample = 1; sample <= layout.samples; sample++) {
+          appendPixel(data, layout.pixelType, layout.byteOrder,
+                      rawValue(layout.pixelType, sample, line, band));
+        }
+        appendBytes(data, layout.suffixBytes, record + 1);
+      }
+    }
+  }
+  else {
+    for (int line = 1; line <= layout.lines; line++) {
+      for (int sample = 1; sample <= layout.samples; sample++, record++) {
+        appendBytes(data, layout.prefixBytes, record);
+        for (int band = 1; band <= layout.bands; band++) {
+          appendPixel(data, layout.pixelType, layout.byteOrder,
+                      rawValue(layout.pixelType, sample, line, band));
+        }
+        appendBytes(data, layout.suffixBytes, record + 1);
+      }
+    }
+  }
+
+  appendBytes(data, layout.fileTrailerBytes, 2);
+
+  QFile file(fileName);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  file.write(&data[0], data.size());
+  file.close();
+}
+
+
+/**
+ * Sets up an import of a raw file into a cube of reals, saving any bytes
+ * around the image data.
+ */
+static void setUpImport(ProcessImport &process, const QString &rawFile,
+                        const QString &cubeFile, const RawLayout &layout) {
+  process.SetInputFile(rawFile);
+  process.SetOrganization(layout.organization);
+  process.SetPixelType(layout.pixelType);
+  process.SetByteOrder(layout.byteOrder);
+  process.SetDimensions(layout.samples, layout.lines, layout.bands);
+
+  process.SetFileHeaderBytes(layout.fileHeaderBytes);
+  if (layout.fileHeaderBytes > 0) {
+    process.SaveFileHeader();
+  }
+  process.SetFileTrailerBytes(layout.fileTrailerBytes);
+  if (layout.fileTrailerBytes > 0) {
+    process.SaveFileTrailer();
+  }
+  process.SetDataPrefixBytes(layout.prefixBytes);
+  if (layout.prefixBytes > 0) {
+    process.SaveDataPrefix();
+  }
+  process.SetDataSuffixBytes(layout.suffixBytes);
+  if (layout.suffixBytes > 0) {
+    process.SaveDataSuffix();
+  }
+
+  CubeAttributeOutput att;
+  att.setPixelType(Real);
+  process.SetOutputCube(cubeFile, att);
+}
+
+
+/**
+ * Expects every pixel of an imported cube to hold its input value.
+ */
+static void expectImportedCube(const QString &cubeFile, const RawLayout &layout) {
+  Cube cube(cubeFile);
+  ASSERT_EQ(layout.samples, cube.sampleCount());
+  ASSERT_EQ(layout.lines, cube.lineCount());
+  ASSERT_EQ(layout.bands, cube.bandCount());
+
+  LineManager line(cube);
+  for (line.begin(); !line.end(); line++) {
+    cube.read(line);
+    for (int i = 0; i < line.size(); i++) {
+      ASSERT_EQ(importedValue(layout.pixelType, i + 1, line.Line(), line.Band()), line[i])
+          << PixelTypeName(layout.pixelType).toStdString() << " "
+          << ByteOrderName(layout.byteOrder).toStdString() << " sample " << i + 1
+          << " line " << line.Line() << " band " << line.Band();
+    }
+  }
+  cube.close();
+}
+
+
+/**
+ * Imports a raw file of every pixel type in both byte orders and compares
+ * the cubes to the input values.
+ */
+static void importEveryPixelType(ProcessImport::Interleave organization) {
+  QString rawFile = QDir::tempPath() + "/ProcessImportTests.raw";
+  QString cubeFile = QDir::tempPath() + "/ProcessImportTests.cub";
+
+  PixelType pixelTypes[] = {UnsignedByte, UnsignedWord, SignedWord,
+                            UnsignedInteger, SignedInteger, Real, Double};
+  ByteOrder byteOrders[] = {Lsb, Msb};
+  for (int type = 0; type < 7; type++) {
+    for (int order = 0; order < 2; order++) {
+      RawLayout layout = rawLayout(organization, pixelTypes[type], byteOrders[order]);
+      writeRawFile(rawFile, layout);
+
+      ProcessImport process;
+      setUpImport(process, rawFile, cubeFile, layout);
+      process.StartProcess();
+      process.EndProcess();
+
+      expectImportedCube(cubeFile, layout);
+    }
+  }
+
+  QFile::remove(rawFile);
+  QFile::remove(cubeFile);
+}
+
+
+/**
+ * Imports a raw file with header, trailer, prefix and suffix bytes and
+ * expects the saved bytes to be the ones written.
+ */
+static void importWithExtraBytes(ProcessImport::Interleave organization) {
+  QString rawFile = QDir::tempPath() + "/ProcessImportTests.raw";
+  QString cubeFile = QDir::tempPath() + "/ProcessImportTests.cub";
+
+  RawLayout layout = rawLayout(organization, SignedWord, Msb);
+  layout.fileHeaderBytes = 13;
+  layout.fileTrailerBytes = 11;
+  layout.prefixBytes = 3;
+  layout.suffixBytes = 5;
+  writeRawFile(rawFile, layout);
+
+  ProcessImport process;
+  setUpImport(process, rawFile, cubeFile, layout);
+  process.StartProcess();
+
+  expectBytes(process.FileHeader(), layout.fileHeaderBytes, 1);
+  EXPECT_EQ(layout.fileTrailerBytes, process.FileTrailerBytes());
+  expectBytes(process.FileTrailer(), layout.fileTrailerBytes, 2);
+
+  // The prefixes and suffixes are saved in file order, grouped by band for
+  // BSQ, one per record for BIL and by line for BIP
+  std::vector< std::vector<char *> > prefixes = process.DataPrefix();
+  std::vector< std::vector<char *> > suffixes = process.DataSuffix();
+  int records = (organization == ProcessImport::BIP) ?
+                layout.lines * layout.samples : layout.lines * layout.bands;
+  int record = 0;
+  for (unsigned int group = 0; group < prefixes.size(); group++) {
+    ASSERT_EQ(prefixes[group].size(), suffixes[group].size());
+    for (unsigned int i = 0; i < prefixes[group].size(); i++, record++) {
+      expectBytes(prefixes[group][i], layout.prefixBytes, record);
+      expectBytes(suffixes[group][i], layout.suffixBytes, record + 1);
+    }
+  }
+  EXPECT_EQ(records, record);
+
+  process.EndProcess();
+  expectImportedCube(cubeFile, layout);
+
+  QFile::remove(rawFile);
+  QFile::remove(cubeFile);
+}
+
+
+TEST(ProcessImport, BsqPixelTypesAndByteOrders) {
+  importEveryPixelType(ProcessImport::BSQ);
+}
+
+
+TEST(ProcessImport, BilPixelTypesAndByteOrders) {
+  importEveryPixelType(ProcessImport::BIL);
+}
+
+
+TEST(ProcessImport, BipPixelTypesAndByteOrders) {
+  importEveryPixelType(ProcessImport::BIP);
+}
+
+
+TEST(ProcessImport, BsqHeaderTrailerPrefixAndSuffix) {
+  importWithExtraBytes(ProcessImport::BSQ);
+}
+
+
+TEST(ProcessImport, BilHeaderTrailerPrefixAndSuffix) {
+  importWithExtraBytes(ProcessImport::BIL);
+}
+
+
+TEST(ProcessImport, BipHeaderTrailerPrefixAndSuffix) {
+  importWithExtraBytes(ProcessImport::BIP);
+}
+
+
+TEST(ProcessImport, ImportsSeveralBlocks) {
+  QString rawFile = QDir::tempPath() + "/ProcessImportTests.raw";
+  QString cubeFile = QDir::tempPath() + "/ProcessImportTests.cub";
+
+  // More pixels in a band than a block holds, with a partial last block
+  ProcessImport::Interleave organizations[] = {ProcessImport::BSQ, ProcessImport::BIL,
+                                               ProcessImport::BIP};
+  for (int org = 0; org < 3; org++) {
+    RawLayout layout = rawLayout(organizations[org], UnsignedWord, Msb, 1500, 777, 2);
+    writeRawFile(rawFile, layout);
+
+    ProcessImport process;
+    setUpImport(process, rawFile, cubeFile, layout);
+    process.StartProcess();
+    process.EndProcess();
+
+    expectImportedCube(cubeFile, layout);
+  }
+
+  QFile::remove(rawFile);
+  QFile::remove(cubeFile);
+}
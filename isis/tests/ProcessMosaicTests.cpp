@@ -0,0 +1,138 @@
+#include "Constants.h"
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "FileList.h"
+#include "FileName.h"
+#include "LineManager.h"
+#include "Portal.h"
+#include "ProcessMapMosaic.h"
+#include "ProcessMosaic.h"
+#include "Projection.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "SpecialPixel.h"
+#include "Table.h"
+#include "TrackingTable.h"
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * Creates a 10 by 10 pixel SimpleCylindrical cube at ten pixels per degree,
+ * offset from longitude 0 by a number of pixels.
+ */
+static void writeMapCube(const QString &fileName, int sampleOffset, double value) {
+  double equatorialRadius = 3396190.0;
+  double resolution = equatorialRadius * PI / 180.0 / 10.0;
+
+  Cube cube;
+  cube.setDimensions(10, 10, 1);
+  cube.setPixelType(Real);
+  cube.create(fileName);
+
+  PvlGroup mapping("Mapping");
+  mapping += PvlKeyword("ProjectionName", "SimpleCylindrical");
+  mapping += PvlKeyword("CenterLongitude", toString(0.0));
+  mapping += PvlKeyword("TargetName", "Mars");
+  mapping += PvlKeyword("EquatorialRadius", toString(equatorialRadius), "meters");
+  mapping += PvlKeyword("PolarRadius", toString(equatorialRadius), "meters");
+  mapping += PvlKeyword("LatitudeType", "Planetocentric");
+  mapping += PvlKeyword("LongitudeDirection", "PositiveEast");
+  mapping += PvlKeyword("LongitudeDomain", toString(360));
+  mapping += PvlKeyword("MinimumLatitude", toString(-1.0));
+  mapping += PvlKeyword("MaximumLatitude", toString(0.0));
+  mapping += PvlKeyword("MinimumLongitude", toString(sampleOffset / 10.0));
+  mapping += PvlKeyword("MaximumLongitude", toString(sampleOffset / 10.0 + 1.0));
+  mapping += PvlKeyword("UpperLeftCornerX", toString(sampleOffset * resolution), "meters");
+  mapping += PvlKeyword("UpperLeftCornerY", toString(0.0), "meters");
+  mapping += PvlKeyword("PixelResolution", toString(resolution), "meters/pixel");
+  mapping += PvlKeyword("Scale", toString(10.0), "pixels/degree");
+  cube.putGroup(mapping);
+
+  LineManager line(cube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = value;
+    }
+    cube.write(line);
+  }
+
+  cube.close();
+}
+
+
+/**
+ * Reads the pixel of a cube at the mosaic position of an input pixel. The
+ * tracking cube has no projection of its own and shares that of the mosaic.
+ */
+static double mosaicPixel(Cube &cube, Cube &mosaic, Cube &input, double sample, double line) {
+  Projection *inputProjection = input.projection();
+  Projection *mosaicProjection = mosaic.projection();
+  inputProjection->SetWorld(sample, line);
+  mosaicProjection->SetCoordinate(inputProjection->XCoord(), inputProjection->YCoord());
+
+  Portal portal(1, 1, cube.pixelType());
+  portal.SetPosition(mosaicProjection->WorldX(), mosaicProjection->WorldY(), 1);
+  cube.read(portal);
+  return portal[0];
+}
+
+
+TEST(ProcessMosaic, TracksEveryInputOfAMosaic) {
+  QString mosaicFile = QDir::tempPath() + "/ProcessMosaicTests.cub";
+  QString trackingFile = QDir::tempPath() + "/ProcessMosaicTests_tracking.cub";
+
+  // Three inputs overlapping by half
+  FileList inputs;
+  for (int i = 0; i < 3; i++) {
+    QString inputFile = QDir::tempPath() + "/ProcessMosaicTests" + toString(i + 1) + ".cub";
+    writeMapCube(inputFile, i * 5, i + 1);
+    inputs.append(FileName(inputFile));
+  }
+
+  ProcessMapMosaic process;
+  CubeAttributeOutput outputAttributes;
+  process.SetBandBinMatch(false);
+  process.SetOutputCube(inputs, outputAttributes, mosaicFile);
+  process.SetImageOverlay(ProcessMosaic::PlaceImagesOnTop);
+  process.SetCreateFlag(true);
+  process.SetTrackFlag(true);
+  EXPECT_TRUE(process.StartProcess(inputs).isEmpty());
+  process.EndProcess();
+
+  Cube tracking(trackingFile);
+  Table table(trackingTableName);
+  tracking.read(table);
+  TrackingTable trackingTable(table);
+
+  Cube mosaic(mosaicFile);
+  for (int i = 0; i < inputs.size(); i++) {
+    unsigned int pixel = VALID_MINUI4 + i;
+    EXPECT_EQ(inputs[i].name(), trackingTable.pixelToFileName(pixel).name());
+    EXPECT_EQ(pixel, trackingTable.fileNameToPixel(inputs[i], ""));
+
+    // The right half of each input is under the input after it
+    Cube input(inputs[i].toString());
+    EXPECT_EQ(i + 1, mosaicPixel(mosaic, mosaic, input, 3, 5));
+    EXPECT_EQ(pixel, (unsigned int) mosaicPixel(tracking, mosaic, input, 3, 5));
+    if (i == inputs.size() - 1) {
+      EXPECT_EQ(pixel, (unsigned int) mosaicPixel(tracking, mosaic, input, 8, 5));
+    }
+    else {
+      EXPECT_EQ(pixel + 1, (unsigned int) mosaicPixel(tracking, mosaic, input, 8, 5));
+    }
+  }
+
+  mosaic.close();
+  tracking.close();
+  QFile::remove(mosaicFile);
+  QFile::remove(trackingFile);
+  for (int i = 0; i < inputs.size(); i++) {
+    QFile::remove(inputs[i].expanded());
+  }
+}
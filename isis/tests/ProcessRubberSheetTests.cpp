@@ -0,0 +1,96 @@
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "Fixtures.h"
+#include "Interpolator.h"
+#include "LineManager.h"
+#include "Portal.h"
+#include "ProcessRubberSheet.h"
+#include "Transform.h"
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * A shear and reduction that maps every output pixel well inside the input.
+ */
+class ShearTransform : public Transform {
+  public:
+    int OutputSamples() const {
+      return 100;
+    }
+
+    int OutputLines() const {
+      return 80;
+    }
+
+    bool Xform(double &inSample, double &inLine,
+               const double outSample, const double outLine) {
+      inSample = 0.6 * outSample + 0.2 * outLine + 10.37;
+      inLine = -0.15 * outSample + 0.7 * outLine + 30.13;
+      return true;
+    }
+};
+
+
+/**
+ * Rubber sheets the test cube and compares each output pixel to the input
+ * interpolated one portal at a time.
+ */
+static void compareToPortals(Interpolator::interpType type) {
+  QString inputFile = QDir::tempPath() + "/ProcessRubberSheetTests.cub";
+  QString outputFile = QDir::tempPath() + "/ProcessRubberSheetTestsOut.cub";
+  writeTestCube(inputFile, 150, 120, 2);
+
+  ShearTransform transform;
+  Interpolator interp(type);
+
+  ProcessRubberSheet process;
+  process.SetInputCube(inputFile, CubeAttributeInput());
+  process.SetOutputCube(outputFile, CubeAttributeOutput(),
+                        transform.OutputSamples(), transform.OutputLines(), 2);
+  process.SetTiling(32, 4);
+  process.StartProcess(transform, interp);
+  process.EndProcess();
+
+  Cube input(inputFile);
+  Cube output(outputFile);
+  Portal portal(interp.Samples(), interp.Lines(), input.pixelType(),
+                interp.HotSample(), interp.HotLine());
+  LineManager line(output);
+  for (line.begin(); !line.end(); line++) {
+    output.read(line);
+    for (int i = 0; i < line.size(); i++) {
+      double sample, inputLine;
+      transform.Xform(sample, inputLine, i + 1, line.Line());
+      portal.SetPosition(sample, inputLine, line.Band());
+      input.read(portal);
+      ASSERT_NEAR(interp.Interpolate(sample, inputLine, portal.DoubleBuffer()),
+                  line[i], 1.0e-6);
+    }
+  }
+
+  input.close();
+  output.close();
+  QFile::remove(inputFile);
+  QFile::remove(outputFile);
+}
+
+
+TEST(ProcessRubberSheet, NearestNeighborMatchesPortals) {
+  compareToPortals(Interpolator::NearestNeighborType);
+}
+
+
+TEST(ProcessRubberSheet, BiLinearMatchesPortals) {
+  compareToPortals(Interpolator::BiLinearType);
+}
+
+
+TEST(ProcessRubberSheet, CubicConvolutionMatchesPortals) {
+  compareToPortals(Interpolator::CubicConvolutionType);
+}
@@ -0,0 +1,178 @@
+#include "Pvl.h"
+#include "PvlParser.h"
+#include "IException.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include <fstream>
+#include <sstream>
+#include <stdlib.h>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+using namespace std;
+
+/**
+ * Formats a Pvl for comparison.
+ */
+static string pvlText(Pvl &pvl) {
+  stringstream os;
+  os << pvl;
+  return os.str();
+}
+
+
+/**
+ * Reads PVL text with the stream operator and with PvlParser, expects the
+ * parser to handle it, and expects the same result.
+ */
+static void expectSameAsStream(const string &text) {
+  Pvl streamed;
+  stringstream is(text);
+  is >> streamed;
+
+  Pvl parsed;
+  PvlParser parser(text.data(), text.size());
+  ASSERT_TRUE(parser.parse(parsed)) << text;
+  EXPECT_EQ(pvlText(streamed), pvlText(parsed)) << text;
+}
+
+
+TEST(PvlParser, Keywords) {
+  expectSameAsStream("A = 1\nB = Two\nC = \"three and four\"\nD = 'five'\nE\nEnd\n");
+  expectSameAsStream("Key=Value\nEnd");
+  expectSameAsStream("Key = Value");
+  expectSameAsStream("");
+  expectSameAsStream("\n\n   \n");
+}
+
+
+TEST(PvlParser, ArraysAndUnits) {
+  expectSameAsStream("A = (1, 2, 3)\nB = (1 <m>, 2, 3 <km>) <cm>\nC = 5 <degrees>\n"
+                     "D = {a, \"b c\", 'd'}\nE = ((1, 2), (3, 4))\nF = ()\nEnd\n");
+  expectSameAsStream("A = 5\n<meters>\nB = (1,\n 2,\n 3)\n<pixels>\nEnd\n");
+}
+
+
+TEST(PvlParser, MultipleLines) {
+  expectSameAsStream("A = \"a quoted string\n    over three\n    lines\"\nB = abc-\ndef\nEnd\n");
+  expectSameAsStream("A = (one,\n     two,\n     three)\nEnd\n");
+}
+
+
+TEST(PvlParser, Comments) {
+  expectSameAsStream("# Comment\n// Another\nA = 1 # trailing\nGroup = G\n  # Keyword comment\n"
+                     "  B = 2\nEndGroup\nEnd\n");
+}
+
+
+TEST(PvlParser, GroupsAndObjects) {
+  expectSameAsStream("Object = IsisCube\n  Object = Core\n    StartByte = 65537\n"
+                     "    Group = Dimensions\n      Samples = 2\n      Lines = 3\n"
+                     "    End_Group\n  End_Object\n  Group = Instrument\n"
+                     "    StartTime = 2008-01-14T19:04:19.4\n  End_Group\nEnd_Object\n"
+                     "Object = Label\n  Bytes = 65536\nEnd_Object\nEnd\n");
+}
+
+
+TEST(PvlParser, LineEndings) {
+  expectSameAsStream("Group = A\r\n  B = 1\r\n\r\n  C = (1, 2)\r\nEndGroup\r\nEnd\r\n");
+}
+
+
+TEST(PvlParser, StopsAtBinaryData) {
+  string text("Object = Label\n  Bytes = 1\nEnd_Object\nEnd\n");
+  text += string(16, '\0');
+  text += "\xff\xfe binary";
+  expectSameAsStream(text);
+
+  string noEnd("A = 1\n");
+  noEnd += string(4, '\0');
+  expectSameAsStream(noEnd);
+}
+
+
+TEST(PvlParser, UnsupportedInput) {
+  const char *multiLineComment = "/* A comment\n   over two lines */\nA = 1\nEnd\n";
+  Pvl pvl;
+  PvlParser commentParser(multiLineComment, strlen(multiLineComment));
+  EXPECT_FALSE(commentParser.parse(pvl));
+
+  const char *noEndGroup = "Group = A\n  B = 1\n";
+  pvl.clear();
+  PvlParser groupParser(noEndGroup, strlen(noEndGroup));
+  EXPECT_FALSE(groupParser.parse(pvl));
+
+  const char *badArray = "A = (1, 2,)\nEnd\n";
+  pvl.clear();
+  PvlParser arrayParser(badArray, strlen(badArray));
+  EXPECT_FALSE(arrayParser.parse(pvl));
+}
+
+
+TEST(PvlParser, ReadFile) {
+  QString fileName = QDir::tempPath() + "/PvlParserTests.pvl";
+  QFile file(fileName);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  file.write("Object = O\n  Group = G\n    K = (1, 2) <m>\n  EndGroup\nEndObject\nEnd\n");
+  file.close();
+
+  Pvl pvl(fileName);
+  QFile::remove(fileName);
+
+  ASSERT_TRUE(pvl.hasObject("O"));
+  EXPECT_EQ(fileName, pvl.findObject("O").fileName());
+  PvlKeyword &key = pvl.findObject("O").findGroup("G")["K"];
+  EXPECT_EQ(2, key.size());
+  EXPECT_EQ("2", key[1]);
+  EXPECT_EQ("m", key.unit(1));
+}
+
+
+/**
+ * Compares the parser to the stream operator on every label in the test data
+ * area, when it is available.
+ */
+TEST(PvlParser, TestDataLabels) {
+  const char *testData = getenv("ISIS3TESTDATA");
+  if (!testData) {
+    return;
+  }
+
+  QStringList filters;
+  filters << "*.cub" << "*.lbl" << "*.pvl" << "*.def" << "*.db";
+  QDirIterator files(testData, filters, QDir::Files, QDirIterator::Subdirectories);
+
+  while (files.hasNext()) {
+    QString fileName = files.next();
+
+    Pvl streamed;
+    try {
+      ifstream is(fileName.toLatin1().data());
+      is >> streamed;
+    }
+    catch (IException &) {
+      continue;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+      continue;
+    }
+    uchar *data = file.map(0, file.size());
+    ASSERT_TRUE(data);
+
+    Pvl parsed;
+    PvlParser parser((const char *) data, file.size());
+    if (parser.parse(parsed)) {
+      EXPECT_EQ(pvlText(streamed), pvlText(parsed)) << fileName.toStdString();
+    }
+    file.unmap(data);
+  }
+}
@@ -74,6 +74,39 @@ TEST(Statistics, HandCalculations) {
 
 }
 
+TEST(Statistics, AddStatistics) {
+
+    Statistics all, first, second;
+    double data[] = {10, 20, Null, 30, 45, Lrs};
+
+    for (int i = 0; i < 6; i++) {
+      all.AddData(data[i]);
+      if (i < 3) {
+        first.AddData(data[i]);
+      }
+      else {
+        second.AddData(data[i]);
+      }
+    }
+
+    first.AddStatistics(second);
+
+    EXPECT_DOUBLE_EQ(first.Sum(), all.Sum());
+    EXPECT_DOUBLE_EQ(first.SumSquare(), all.SumSquare());
+    EXPECT_DOUBLE_EQ(first.Average(), all.Average());
+    EXPECT_DOUBLE_EQ(first.StandardDeviation(), all.StandardDeviation());
+    EXPECT_DOUBLE_EQ(first.Minimum(), 10.0);
+    EXPECT_DOUBLE_EQ(first.Maximum(), 45.0);
+    EXPECT_EQ(first.TotalPixels(), 6);
+    EXPECT_EQ(first.ValidPixels(), 4);
+    EXPECT_EQ(first.NullPixels(), 1);
+    EXPECT_EQ(first.LrsPixels(), 1);
+
+    Statistics ranged;
+    ranged.SetValidRange(0, 40);
+    EXPECT_THROW(ranged.AddStatistics(all), IException);
+}
+
 TEST(Statistics,SpecialPixels) {
 
     Statistics t;